@@ -3,12 +3,6 @@
  */
 
 #include "pipe_client.h"
-#include <iostream>
-#include <sstream>
-
-#ifdef _WIN32
-#include <Windows.h>
-#endif
 
 namespace WindowsAiMic {
 
@@ -17,126 +11,36 @@ PipeClient::PipeClient() = default;
 PipeClient::~PipeClient() { disconnect(); }
 
 bool PipeClient::connect() {
-  if (connected_.load()) {
+  if (client_.isConnected()) {
     return true;
   }
-
-#ifdef _WIN32
-  // Try to connect to the named pipe
-  pipe_ = CreateFileA(PIPE_NAME, GENERIC_READ | GENERIC_WRITE, 0, nullptr,
-                      OPEN_EXISTING, 0, nullptr);
-
-  if (pipe_ == INVALID_HANDLE_VALUE || pipe_ == nullptr) {
-    DWORD error = GetLastError();
-    if (error == ERROR_PIPE_BUSY) {
-      // Wait and retry
-      if (WaitNamedPipeA(PIPE_NAME, 2000)) {
-        pipe_ = CreateFileA(PIPE_NAME, GENERIC_READ | GENERIC_WRITE, 0, nullptr,
-                            OPEN_EXISTING, 0, nullptr);
-      }
-    }
-
-    if (pipe_ == INVALID_HANDLE_VALUE || pipe_ == nullptr) {
-      pipe_ = nullptr;
-      return false;
-    }
-  }
-
-  // Set pipe to message mode
-  DWORD mode = PIPE_READMODE_MESSAGE;
-  HANDLE hPipe = static_cast<HANDLE>(pipe_);
-  SetNamedPipeHandleState(hPipe, &mode, nullptr, nullptr);
-
-  connected_ = true;
-
-  // Start reader thread for meter updates
-  readerThread_ = std::thread(&PipeClient::readerThread, this);
-
-  return true;
-#else
-  return false;
-#endif
+  return client_.connect();
 }
 
-void PipeClient::disconnect() {
-  if (!connected_.load()) {
-    return;
-  }
-
-  connected_ = false;
-
-#ifdef _WIN32
-  if (pipe_ != nullptr) {
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    CloseHandle(hPipe);
-    pipe_ = nullptr;
-  }
-#endif
-
-  if (readerThread_.joinable()) {
-    readerThread_.join();
-  }
-}
+void PipeClient::disconnect() { client_.disconnect(); }
 
 bool PipeClient::sendCommand(const std::string &command) {
-  if (!connected_.load()) {
-    return false;
-  }
-
-#ifdef _WIN32
-  DWORD bytesWritten;
-  HANDLE hPipe = static_cast<HANDLE>(pipe_);
-  BOOL success =
-      WriteFile(hPipe, command.c_str(), static_cast<DWORD>(command.size()),
-                &bytesWritten, nullptr);
-
-  return success && bytesWritten == command.size();
-#else
-  return false;
-#endif
+  const uint32_t id = client_.sendCommand(command);
+  Ack ack;
+  return id != 0 && client_.waitAck(id, ack, ACK_TIMEOUT_MS) &&
+         ack.status == AckStatus::Ok;
 }
 
-void PipeClient::setMeterCallback(MeterCallback callback) {
-  meterCallback_ = std::move(callback);
+bool PipeClient::setParameters(const std::vector<ParamUpdate> &updates) {
+  const uint32_t id = client_.sendParameters(updates);
+  Ack ack;
+  return id != 0 && client_.waitAck(id, ack, ACK_TIMEOUT_MS) &&
+         ack.status == AckStatus::Ok;
 }
 
-void PipeClient::readerThread() {
-#ifdef _WIN32
-  char buffer[4096];
-
-  while (connected_.load()) {
-    DWORD bytesRead;
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    BOOL success =
-        ReadFile(hPipe, buffer, sizeof(buffer) - 1, &bytesRead, nullptr);
-
-    if (!success || bytesRead == 0) {
-      if (GetLastError() == ERROR_BROKEN_PIPE) {
-        connected_ = false;
-        break;
-      }
-      continue;
-    }
-
-    buffer[bytesRead] = '\0';
-    std::string message(buffer, bytesRead);
-
-    // Parse message
-    if (message.substr(0, 7) == "METERS:") {
-      // Parse meter values: "METERS:peak,rms,gr"
-      std::string values = message.substr(7);
-      float peak = 0, rms = 0, gr = 0;
-
-      std::istringstream iss(values);
-      char comma;
-      iss >> peak >> comma >> rms >> comma >> gr;
-
-      if (meterCallback_) {
-        meterCallback_(peak, rms, gr);
-      }
-    }
+bool PipeClient::readMeters(TelemetryFrame &frame) {
+  if (telemetry_.isOpen() && !telemetry_.isWriterActive()) {
+    telemetry_.close();
+  }
+  if (!telemetry_.isOpen() && !telemetry_.open()) {
+    return false;
   }
-#endif
+  return telemetry_.readCurrent(frame);
 }
 
 } // namespace WindowsAiMic
@@ -4,15 +4,16 @@
 
 #pragma once
 
-#include <atomic>
-#include <functional>
+#include "ipc/ipc_client.h"
+#include "ipc/telemetry.h"
+
 #include <string>
-#include <thread>
+#include <vector>
 
 namespace WindowsAiMic {
 
 /**
- * Named pipe client for communicating with the audio engine
+ * Client for communicating with the audio engine
  */
 class PipeClient {
 public:
@@ -20,7 +21,7 @@ public:
   ~PipeClient();
 
   /**
-   * Connect to the engine's pipe server
+   * Connect to the engine's IPC server
    * @return true on success
    */
   bool connect();
@@ -33,34 +34,33 @@ public:
   /**
    * Check if connected
    */
-  bool isConnected() const { return connected_.load(); }
+  bool isConnected() const { return client_.isConnected(); }
 
   /**
-   * Send a command to the engine
+   * Send a command to the engine and wait for its acknowledgement
    * @param command Command string
-   * @return true if sent successfully
+   * @return true if the engine accepted it
    */
   bool sendCommand(const std::string &command);
 
   /**
-   * Callback for meter updates from engine
+   * Apply several parameters in one round trip
+   * @return true if the engine applied all of them
    */
-  using MeterCallback =
-      std::function<void(float peak, float rms, float gainReduction)>;
-  void setMeterCallback(MeterCallback callback);
-
-private:
-  void readerThread();
+  bool setParameters(const std::vector<ParamUpdate> &updates);
 
-  static constexpr const char *PIPE_NAME = "\\\\.\\pipe\\WindowsAiMicPipe";
+  /**
+   * Latest meter frame from the engine's shared-memory telemetry
+   * Cheap enough to call from a UI timer; reattaches after engine restarts.
+   * @return false if the engine is not publishing
+   */
+  bool readMeters(TelemetryFrame &frame);
 
-#ifdef _WIN32
-  void *pipe_ = nullptr; // HANDLE
-#endif
+private:
+  static constexpr int ACK_TIMEOUT_MS = 500;
 
-  std::atomic<bool> connected_{false};
-  std::thread readerThread_;
-  MeterCallback meterCallback_;
+  IpcClient client_;
+  TelemetryReader telemetry_;
 };
 
 } // namespace WindowsAiMic
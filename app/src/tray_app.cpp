@@ -222,7 +222,7 @@ void TrayApp::onBypass() {
   CheckMenuItem(hContextMenu_, ID_BYPASS, bypass_ ? MF_CHECKED : MF_UNCHECKED);
 
   if (pipeClient_ && pipeClient_->isConnected()) {
-    pipeClient_->sendCommand("BYPASS:" + std::string(bypass_ ? "1" : "0"));
+    pipeClient_->setParameters({{ParamId::Bypass, bypass_ ? 1.0f : 0.0f}});
   }
 
   updateTrayTooltip(bypass_ ? L"WindowsAiMic - BYPASS"
@@ -0,0 +1,94 @@
+/**
+ * WindowsAiMic - Audio Path Benchmarks
+ *
+ * The resampler at the device rates the engine converts from and to, and
+ * the lock-free ring buffer that sits between the device threads and the
+ * processing thread.
+ */
+
+#include "bench_harness.h"
+
+#include "audio/audio_buffer.h"
+#include "audio/resampler.h"
+
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+namespace Bench {
+
+namespace {
+
+struct RateConversion {
+  int srcRate;
+  int dstRate;
+};
+
+// Capture into the 48 kHz engine rate and render back out
+const RateConversion CONVERSIONS[] = {
+    {44100, 48000}, {48000, 44100}, {16000, 48000},
+    {48000, 16000}, {96000, 48000}, {48000, 96000},
+};
+
+constexpr size_t RING_CAPACITY = 16384;
+
+} // namespace
+
+void registerAudioBenchmarks(BenchRegistry &registry) {
+  // One 10 ms device period per call, as WASAPI delivers it
+  for (const RateConversion &conversion : CONVERSIONS) {
+    const size_t frames = static_cast<size_t>(conversion.srcRate / 100);
+    registry.add("resampler/" + std::to_string(conversion.srcRate) + "-" +
+                     std::to_string(conversion.dstRate),
+                 frames, [conversion, frames](BenchState &state) {
+                   Resampler resampler;
+                   resampler.initialize(conversion.srcRate,
+                                        conversion.dstRate, 1);
+                   const std::vector<float> input = makeSignal(frames);
+                   while (state.keepRunning()) {
+                     std::vector<float> output =
+                         resampler.process(input.data(), frames);
+                     doNotOptimize(output.data());
+                     clobberMemory();
+                   }
+                 });
+  }
+
+  // Single-threaded: the cost of the operations themselves, not of
+  // cache-line transfers between producer and consumer
+  for (const size_t size : BLOCK_SIZES) {
+    const std::string suffix = std::to_string(size);
+    registry.add("ring/write/" + suffix, size, [size](BenchState &state) {
+      LockFreeRingBuffer ring(RING_CAPACITY);
+      const std::vector<float> input = makeSignal(size);
+      while (state.keepRunning()) {
+        if (ring.write(input.data(), size) < size) {
+          ring.clear();
+        }
+        clobberMemory();
+      }
+    });
+    registry.add("ring/write_read/" + suffix, size, [size](BenchState &state) {
+      LockFreeRingBuffer ring(RING_CAPACITY);
+      const std::vector<float> input = makeSignal(size);
+      std::vector<float> output(size);
+      while (state.keepRunning()) {
+        ring.write(input.data(), size);
+        doNotOptimize(ring.read(output.data(), size));
+        clobberMemory();
+      }
+    });
+  }
+
+  registry.add("ring/available", 0, [](BenchState &state) {
+    LockFreeRingBuffer ring(RING_CAPACITY);
+    const std::vector<float> input = makeSignal(BLOCK_SIZES[0]);
+    ring.write(input.data(), input.size());
+    while (state.keepRunning()) {
+      doNotOptimize(ring.availableRead() + ring.availableWrite());
+    }
+  });
+}
+
+} // namespace Bench
+} // namespace WindowsAiMic
@@ -0,0 +1,167 @@
+/**
+ * WindowsAiMic - Processor Benchmarks
+ *
+ * process() of every processor in the chain, and of the whole chain via
+ * the C API, set up from the default config the way the engine does it.
+ * Each iteration copies a fresh block in first so the processors always
+ * see speech-level input; the copy is the same in every case and small
+ * next to the processing.
+ */
+
+#include "bench_harness.h"
+
+#include "ai/rnnoise_processor.h"
+#include "config/config_types.h"
+#include "core/wam_chain.h"
+#include "dsp/biquad_filter.h"
+#include "dsp/compressor.h"
+#include "dsp/equalizer.h"
+#include "dsp/expander.h"
+#include "dsp/limiter.h"
+#include "dsp/metering.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+namespace Bench {
+
+namespace {
+
+constexpr float SAMPLE_RATE = 48000.0f;
+
+/**
+ * Register `name` at every block size; `make` builds a fresh processor
+ * and `process` runs one block through it
+ */
+template <typename Make, typename Process>
+void addProcessor(BenchRegistry &registry, const std::string &name,
+                  Make make, Process process) {
+  for (const size_t size : BLOCK_SIZES) {
+    registry.add("dsp/" + name + "/" + std::to_string(size), size,
+                 [make, process, size](BenchState &state) {
+                   auto processor = make();
+                   const std::vector<float> input = makeSignal(size);
+                   std::vector<float> block(size);
+                   while (state.keepRunning()) {
+                     std::copy(input.begin(), input.end(), block.begin());
+                     process(*processor, block.data(), size);
+                     clobberMemory();
+                   }
+                 });
+  }
+}
+
+template <typename T> void processBlock(T &processor, float *block, size_t n) {
+  processor.process(block, n);
+}
+
+} // namespace
+
+void registerDspBenchmarks(BenchRegistry &registry) {
+  const Config config;
+
+  addProcessor(
+      registry, "expander",
+      [config] {
+        auto expander = std::make_unique<Expander>();
+        expander->setThreshold(config.expander.threshold);
+        expander->setRatio(config.expander.ratio);
+        expander->setAttack(config.expander.attack);
+        expander->setRelease(config.expander.release);
+        expander->setHysteresis(config.expander.hysteresis);
+        return expander;
+      },
+      processBlock<Expander>);
+
+  addProcessor(
+      registry, "compressor",
+      [config] {
+        auto compressor = std::make_unique<Compressor>();
+        compressor->setThreshold(config.compressor.threshold);
+        compressor->setRatio(config.compressor.ratio);
+        compressor->setKnee(config.compressor.knee);
+        compressor->setAttack(config.compressor.attack);
+        compressor->setRelease(config.compressor.release);
+        compressor->setMakeupGain(config.compressor.makeupGain);
+        return compressor;
+      },
+      processBlock<Compressor>);
+
+  addProcessor(
+      registry, "limiter",
+      [config] {
+        auto limiter = std::make_unique<Limiter>();
+        limiter->setCeiling(config.limiter.ceiling);
+        limiter->setRelease(config.limiter.release);
+        limiter->setLookahead(config.limiter.lookahead);
+        return limiter;
+      },
+      processBlock<Limiter>);
+
+  addProcessor(
+      registry, "equalizer",
+      [config] {
+        auto equalizer = std::make_unique<Equalizer>();
+        equalizer->setHighPass(config.equalizer.highPass.freq,
+                               config.equalizer.highPass.q);
+        equalizer->setLowShelf(config.equalizer.lowShelf.freq,
+                               config.equalizer.lowShelf.gain);
+        equalizer->setPresence(config.equalizer.presence.freq,
+                               config.equalizer.presence.gain,
+                               config.equalizer.presence.q);
+        equalizer->setHighShelf(config.equalizer.highShelf.freq,
+                                config.equalizer.highShelf.gain);
+        return equalizer;
+      },
+      processBlock<Equalizer>);
+
+  addProcessor(
+      registry, "biquad",
+      [] {
+        auto filter = std::make_unique<BiquadFilter>();
+        filter->setHighPass(SAMPLE_RATE, 80.0f);
+        return filter;
+      },
+      processBlock<BiquadFilter>);
+
+  addProcessor(
+      registry, "rnnoise",
+      [config] {
+        auto rnnoise = std::make_unique<RNNoiseProcessor>();
+        if (!rnnoise->initialize()) {
+          std::fprintf(stderr, "RNNoise failed to initialize\n");
+        }
+        rnnoise->setAttenuation(config.aiSettings.rnnoise.attenuation);
+        return rnnoise;
+      },
+      processBlock<RNNoiseProcessor>);
+
+  // Metering only reads the block
+  addProcessor(
+      registry, "metering", [] { return std::make_unique<Metering>(); },
+      [](Metering &metering, const float *block, size_t n) {
+        metering.process(block, n);
+        doNotOptimize(metering.getRMSLinear());
+      });
+
+  // The whole chain as embedders see it, through the C API
+  struct ChainDeleter {
+    void operator()(wam_chain *chain) const { wam_chain_destroy(chain); }
+  };
+  addProcessor(
+      registry, "chain",
+      [] {
+        return std::unique_ptr<wam_chain, ChainDeleter>(
+            wam_chain_create(nullptr));
+      },
+      [](wam_chain &chain, float *block, size_t n) {
+        wam_chain_process(&chain, block, n);
+      });
+}
+
+} // namespace Bench
+} // namespace WindowsAiMic
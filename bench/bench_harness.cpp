@@ -0,0 +1,254 @@
+/**
+ * WindowsAiMic - Benchmark Harness Implementation
+ */
+
+#include "bench_harness.h"
+
+#include "platform/cpu_features.h"
+#include "platform/cpu_topology.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+namespace WindowsAiMic {
+namespace Bench {
+
+namespace {
+
+constexpr double REALTIME_RATE = 48000.0; // Engine sample rate
+constexpr uint64_t MAX_ITERATIONS = 1000000000;
+
+int64_t nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+std::string escapeJson(const std::string &text) {
+  std::string escaped;
+  for (const char c : text) {
+    if (c == '"' || c == '\\') {
+      escaped += '\\';
+      escaped += c;
+    } else if (static_cast<unsigned char>(c) < 0x20) {
+      escaped += ' ';
+    } else {
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+std::string compilerName() {
+  char text[64];
+#if defined(__clang__)
+  std::snprintf(text, sizeof(text), "clang %d.%d", __clang_major__,
+                __clang_minor__);
+#elif defined(__GNUC__)
+  std::snprintf(text, sizeof(text), "gcc %d.%d", __GNUC__, __GNUC_MINOR__);
+#elif defined(_MSC_VER)
+  std::snprintf(text, sizeof(text), "msvc %d", _MSC_VER);
+#else
+  std::snprintf(text, sizeof(text), "unknown");
+#endif
+  return text;
+}
+
+// Instruction set the SIMD:: kernels were compiled for
+const char *compiledSimd() {
+#if defined(__AVX512F__)
+  return "avx512";
+#elif defined(__AVX2__)
+  return "avx2";
+#else
+  return "scalar";
+#endif
+}
+
+std::string utcTimestamp() {
+  const std::time_t now = std::time(nullptr);
+  std::tm utc = {};
+#ifdef _WIN32
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  char text[32];
+  std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", &utc);
+  return text;
+}
+
+bool matches(const std::string &name, const std::string &filter) {
+  return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+} // namespace
+
+std::vector<float> makeSignal(size_t samples, uint32_t seed) {
+  std::vector<float> signal(samples);
+  for (size_t i = 0; i < samples; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const float noise = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    signal[i] = 0.45f * std::sin(0.0289f * static_cast<float>(i)) +
+                0.05f * noise;
+  }
+  return signal;
+}
+
+// ============================================================================
+// BenchState
+// ============================================================================
+
+bool BenchState::keepRunning() {
+  if (!started_) {
+    started_ = true;
+    remaining_ = iterations_;
+    startNs_ = nowNs();
+  }
+  if (remaining_ > 0) {
+    --remaining_;
+    return true;
+  }
+  elapsedNs_ = static_cast<double>(nowNs() - startNs_);
+  return false;
+}
+
+// ============================================================================
+// BenchRegistry
+// ============================================================================
+
+void BenchRegistry::add(std::string name, size_t samplesPerIteration,
+                        std::function<void(BenchState &)> run) {
+  benchmarks_.push_back({std::move(name), samplesPerIteration, std::move(run)});
+}
+
+std::vector<BenchResult>
+BenchRegistry::runAll(const BenchOptions &options) const {
+  std::vector<BenchResult> results;
+  const double minNs = std::max(options.minTime, 1e-4) * 1e9;
+  const int repetitions = std::max(options.repetitions, 1);
+
+  std::printf("%-40s %12s %12s %8s %12s\n", "benchmark", "ns/op", "min ns/op",
+              "cv %", "x realtime");
+  for (const Benchmark &benchmark : benchmarks_) {
+    if (!matches(benchmark.name, options.filter)) {
+      continue;
+    }
+
+    // Grow the iteration count until one run takes minTime
+    uint64_t iterations = 1;
+    for (;;) {
+      BenchState state(iterations);
+      benchmark.run(state);
+      const double elapsed = state.elapsedNs();
+      if (elapsed >= minNs || iterations >= MAX_ITERATIONS) {
+        break;
+      }
+      const double scale =
+          elapsed > 0.0 ? std::clamp(1.2 * minNs / elapsed, 2.0, 10.0) : 10.0;
+      iterations = std::min<uint64_t>(
+          MAX_ITERATIONS,
+          static_cast<uint64_t>(static_cast<double>(iterations) * scale));
+    }
+
+    std::vector<double> nsPerOp;
+    for (int rep = 0; rep < repetitions; ++rep) {
+      BenchState state(iterations);
+      benchmark.run(state);
+      nsPerOp.push_back(state.elapsedNs() / static_cast<double>(iterations));
+    }
+
+    BenchResult result;
+    result.name = benchmark.name;
+    result.iterations = iterations;
+    result.repetitions = repetitions;
+
+    double mean = 0.0;
+    for (const double ns : nsPerOp) {
+      mean += ns;
+    }
+    mean /= static_cast<double>(nsPerOp.size());
+    double variance = 0.0;
+    for (const double ns : nsPerOp) {
+      variance += (ns - mean) * (ns - mean);
+    }
+    variance /= static_cast<double>(nsPerOp.size());
+    result.cv = mean > 0.0 ? std::sqrt(variance) / mean : 0.0;
+
+    std::sort(nsPerOp.begin(), nsPerOp.end());
+    result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+    result.nsPerOpMin = nsPerOp.front();
+    if (benchmark.samplesPerIteration > 0 && result.nsPerOp > 0.0) {
+      result.samplesPerSecond =
+          static_cast<double>(benchmark.samplesPerIteration) * 1e9 /
+          result.nsPerOp;
+      result.realtimeFactor = result.samplesPerSecond / REALTIME_RATE;
+    }
+
+    std::printf("%-40s %12.1f %12.1f %8.2f %12.0f\n", result.name.c_str(),
+                result.nsPerOp, result.nsPerOpMin, 100.0 * result.cv,
+                result.realtimeFactor);
+    std::fflush(stdout);
+    results.push_back(result);
+  }
+  return results;
+}
+
+// ============================================================================
+// JSON report
+// ============================================================================
+
+bool writeJson(const std::string &path, const std::vector<BenchResult> &results,
+               const BenchOptions &options, const std::string &label,
+               const std::string &pinnedTo) {
+  std::FILE *file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+
+  const CPUFeatures &cpu = CPUFeatures::get();
+  const CpuTopology &topology = CpuTopology::get();
+  std::fprintf(file, "{\n  \"context\": {\n");
+  std::fprintf(file, "    \"label\": \"%s\",\n", escapeJson(label).c_str());
+  std::fprintf(file, "    \"date\": \"%s\",\n", utcTimestamp().c_str());
+  std::fprintf(file, "    \"cpu\": \"%s\",\n", escapeJson(cpu.brand()).c_str());
+  std::fprintf(file, "    \"vendor\": \"%s\",\n",
+               escapeJson(cpu.vendor()).c_str());
+  std::fprintf(file, "    \"topology\": \"%s\",\n",
+               escapeJson(topology.describe()).c_str());
+  std::fprintf(file, "    \"logicalCores\": %d,\n", topology.logicalCores());
+  std::fprintf(file, "    \"physicalCores\": %d,\n", topology.physicalCores());
+  std::fprintf(file, "    \"hybrid\": %s,\n",
+               topology.isHybrid() ? "true" : "false");
+  std::fprintf(file, "    \"pinnedTo\": \"%s\",\n",
+               escapeJson(pinnedTo).c_str());
+  std::fprintf(file, "    \"avx2\": %s,\n", cpu.hasAVX2() ? "true" : "false");
+  std::fprintf(file, "    \"avx512\": %s,\n",
+               cpu.hasAVX512() ? "true" : "false");
+  std::fprintf(file, "    \"compiledSimd\": \"%s\",\n", compiledSimd());
+  std::fprintf(file, "    \"compiler\": \"%s\",\n", compilerName().c_str());
+  std::fprintf(file, "    \"minTime\": %g,\n", options.minTime);
+  std::fprintf(file, "    \"repetitions\": %d\n", options.repetitions);
+  std::fprintf(file, "  },\n  \"benchmarks\": [");
+
+  for (size_t i = 0; i < results.size(); ++i) {
+    const BenchResult &result = results[i];
+    std::fprintf(file,
+                 "%s\n    {\"name\": \"%s\", \"iterations\": %llu, "
+                 "\"repetitions\": %d, \"nsPerOp\": %.3f, "
+                 "\"nsPerOpMin\": %.3f, \"cv\": %.5f, "
+                 "\"samplesPerSecond\": %.0f, \"realtimeFactor\": %.1f}",
+                 i == 0 ? "" : ",", escapeJson(result.name).c_str(),
+                 static_cast<unsigned long long>(result.iterations),
+                 result.repetitions, result.nsPerOp, result.nsPerOpMin,
+                 result.cv, result.samplesPerSecond, result.realtimeFactor);
+  }
+  std::fprintf(file, "\n  ]\n}\n");
+  return std::fclose(file) == 0;
+}
+
+} // namespace Bench
+} // namespace WindowsAiMic
@@ -0,0 +1,159 @@
+/**
+ * WindowsAiMic - Benchmark Harness Header
+ *
+ * Minimal in-tree micro-benchmark harness: named cases, automatic
+ * iteration calibration, repetitions with median/min, and console plus
+ * JSON reports that can be diffed across commits and machines.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace WindowsAiMic {
+namespace Bench {
+
+/**
+ * Keep `value` alive so the optimiser cannot drop the work producing it
+ */
+template <typename T> inline void doNotOptimize(const T &value) {
+#ifdef _MSC_VER
+  const volatile char *byte = reinterpret_cast<const volatile char *>(&value);
+  (void)*byte;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+/**
+ * As above, and also make the compiler forget what `value` holds, so a
+ * constant such as a unity gain cannot be folded away
+ */
+template <typename T> inline void doNotOptimize(T &value) {
+#ifdef _MSC_VER
+  volatile char *byte = reinterpret_cast<volatile char *>(&value);
+  *byte = *byte;
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : "+m"(value) : : "memory");
+#endif
+}
+
+/**
+ * Make pending stores visible, e.g. after writing an output buffer
+ */
+inline void clobberMemory() {
+#ifdef _MSC_VER
+  _ReadWriteBarrier();
+#else
+  asm volatile("" : : : "memory");
+#endif
+}
+
+/**
+ * Per-run state handed to a benchmark body
+ *
+ * The body does its setup, then loops on keepRunning(); only the loop is
+ * timed.
+ */
+class BenchState {
+public:
+  explicit BenchState(uint64_t iterations) : iterations_(iterations) {}
+
+  bool keepRunning();
+
+  uint64_t iterations() const { return iterations_; }
+  double elapsedNs() const { return elapsedNs_; }
+
+private:
+  uint64_t iterations_;
+  uint64_t remaining_ = 0;
+  bool started_ = false;
+  int64_t startNs_ = 0;
+  double elapsedNs_ = 0.0;
+};
+
+/**
+ * One benchmark case
+ */
+struct Benchmark {
+  std::string name;                     // "group/case/size"
+  size_t samplesPerIteration = 0;       // For throughput; 0 = none
+  std::function<void(BenchState &)> run;
+};
+
+/**
+ * Result of one case over all repetitions
+ */
+struct BenchResult {
+  std::string name;
+  uint64_t iterations = 0; // Per repetition
+  int repetitions = 0;
+  double nsPerOp = 0.0;    // Median over repetitions
+  double nsPerOpMin = 0.0;
+  double cv = 0.0;         // Coefficient of variation of ns/op
+  double samplesPerSecond = 0.0;
+  double realtimeFactor = 0.0; // Samples/s over 48 kHz
+};
+
+struct BenchOptions {
+  std::string filter;    // Substring of the case name; empty = all
+  double minTime = 0.2;  // Seconds per repetition
+  int repetitions = 5;
+};
+
+class BenchRegistry {
+public:
+  void add(std::string name, size_t samplesPerIteration,
+           std::function<void(BenchState &)> run);
+
+  const std::vector<Benchmark> &benchmarks() const { return benchmarks_; }
+
+  /**
+   * Run every case matching the filter, printing one line per case
+   */
+  std::vector<BenchResult> runAll(const BenchOptions &options) const;
+
+private:
+  std::vector<Benchmark> benchmarks_;
+};
+
+/**
+ * Write results plus a machine/build context block as JSON
+ * @return false if the file cannot be written
+ */
+bool writeJson(const std::string &path, const std::vector<BenchResult> &results,
+               const BenchOptions &options, const std::string &label,
+               const std::string &pinnedTo);
+
+/** Block sizes every DSP case runs at: one 10 ms engine block, one large */
+constexpr size_t BLOCK_SIZES[] = {480, 4096};
+
+/**
+ * Deterministic voice-like test signal: a tone with a little noise,
+ * peaking at about 0.5
+ */
+std::vector<float> makeSignal(size_t samples, uint32_t seed = 1);
+
+// Case registration, one function per source file
+void registerSimdBenchmarks(BenchRegistry &registry);
+void registerDspBenchmarks(BenchRegistry &registry);
+void registerAudioBenchmarks(BenchRegistry &registry);
+
+/**
+ * Check every SIMD:: kernel against its scalar reference
+ * @return Number of mismatches (printed to stderr)
+ */
+int verifySimdKernels();
+
+} // namespace Bench
+} // namespace WindowsAiMic
@@ -0,0 +1,142 @@
+/**
+ * WindowsAiMic - Benchmark Runner
+ *
+ * Usage: WindowsAiMicBench [--filter TEXT] [--min-time SECONDS]
+ *                          [--repetitions N] [--json FILE] [--label TEXT]
+ *                          [--core performance|efficiency|any]
+ *                          [--quick] [--list]
+ *
+ * Runs on the calling thread with FTZ/DAZ set, as the audio threads do.
+ * --core pins it to one core type so hybrid CPUs can be measured per
+ * tier. --quick is a smoke run: every case once, briefly. Exits non-zero
+ * if a SIMD kernel disagrees with its scalar reference.
+ */
+
+#include "bench_harness.h"
+
+#include "diagnostics/logger.h"
+#include "platform/cpu_features.h"
+#include "platform/cpu_topology.h"
+#include "platform/thread_utils.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace WindowsAiMic;
+using namespace WindowsAiMic::Bench;
+
+namespace {
+
+void printUsage() {
+  std::printf(
+      "Usage: WindowsAiMicBench [--filter TEXT] [--min-time SECONDS]\n"
+      "                         [--repetitions N] [--json FILE] "
+      "[--label TEXT]\n"
+      "                         [--core performance|efficiency|any]\n"
+      "                         [--quick] [--list]\n");
+}
+
+// Pin to one core type; returns what the JSON should record
+std::string pinToCores(const std::string &core) {
+  const CpuTopology &topology = CpuTopology::get();
+  std::vector<int> cpus;
+  if (core == "performance") {
+    cpus = topology.isHybrid()
+               ? topology.cpusOfType(CoreType::Performance, true)
+               : topology.realtimeCpus();
+  } else if (core == "efficiency") {
+    cpus = topology.cpusOfType(CoreType::Efficiency, true);
+  } else {
+    return "any";
+  }
+
+  if (cpus.empty() || !setThreadCpuSets({cpus.front()})) {
+    std::fprintf(stderr, "No %s core to pin to; running unpinned\n",
+                 core.c_str());
+    return "any";
+  }
+  return core + " (cpu " + std::to_string(cpus.front()) + ")";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  BenchOptions options;
+  std::string jsonPath;
+  std::string label;
+  std::string core = "any";
+  bool list = false;
+
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      options.filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--min-time") == 0 && hasValue) {
+      options.minTime = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--repetitions") == 0 && hasValue) {
+      options.repetitions = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      jsonPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--label") == 0 && hasValue) {
+      label = argv[++i];
+    } else if (std::strcmp(argv[i], "--core") == 0 && hasValue) {
+      core = argv[++i];
+    } else if (std::strcmp(argv[i], "--quick") == 0) {
+      options.minTime = 0.001;
+      options.repetitions = 1;
+    } else if (std::strcmp(argv[i], "--list") == 0) {
+      list = true;
+    } else {
+      printUsage();
+      return 2;
+    }
+  }
+
+  BenchRegistry registry;
+  registerSimdBenchmarks(registry);
+  registerDspBenchmarks(registry);
+  registerAudioBenchmarks(registry);
+
+  if (list) {
+    for (const Benchmark &benchmark : registry.benchmarks()) {
+      std::printf("%s\n", benchmark.name.c_str());
+    }
+    return 0;
+  }
+
+  // Keep the engine's startup logging out of the table
+  Logger::instance().setConsoleOutput(false);
+  CPUFeatures::initialize();
+  const CPUFeatures &cpu = CPUFeatures::get();
+
+#ifdef __AVX2__
+  if (!cpu.hasAVX2()) {
+    std::fprintf(stderr, "Built with AVX2 but the CPU lacks it; rebuild "
+                         "with -DENABLE_AVX2=OFF\n");
+    return 2;
+  }
+#endif
+
+  const std::string pinnedTo = pinToCores(core);
+  std::printf("CPU: %s\n", cpu.brand().c_str());
+  std::printf("Topology: %s\n", CpuTopology::get().describe().c_str());
+  std::printf("Pinned to: %s\n\n", pinnedTo.c_str());
+
+  DenormalGuard denormals;
+
+  const int mismatches = verifySimdKernels();
+  const std::vector<BenchResult> results = registry.runAll(options);
+
+  if (!jsonPath.empty()) {
+    if (!writeJson(jsonPath, results, options, label, pinnedTo)) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+      return 1;
+    }
+    std::printf("\nWrote %zu results to %s\n", results.size(),
+                jsonPath.c_str());
+  }
+  return mismatches == 0 ? 0 : 1;
+}
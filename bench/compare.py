@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+"""Compare two WindowsAiMicBench JSON reports.
+
+Usage: compare.py BASELINE.json CANDIDATE.json [--threshold PERCENT]
+
+Prints the change in median ns/op per benchmark and exits non-zero if any
+case got slower by more than the threshold (default 10%).
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path, encoding="utf-8") as file:
+        report = json.load(file)
+    return report["context"], {b["name"]: b for b in report["benchmarks"]}
+
+
+def describe(context):
+    label = context.get("label") or context.get("date", "")
+    return "%s: %s, %s, pinned to %s" % (
+        label, context.get("cpu", "?"), context.get("compiledSimd", "?"),
+        context.get("pinnedTo", "any"))
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=10.0)
+    args = parser.parse_args()
+
+    base_context, base = load(args.baseline)
+    cand_context, cand = load(args.candidate)
+    print("baseline  " + describe(base_context))
+    print("candidate " + describe(cand_context))
+    print()
+    print("%-40s %12s %12s %9s" % ("benchmark", "base ns/op", "new ns/op",
+                                   "change"))
+
+    regressions = 0
+    for name, before in base.items():
+        after = cand.get(name)
+        if after is None or before["nsPerOp"] <= 0.0:
+            continue
+        change = 100.0 * (after["nsPerOp"] / before["nsPerOp"] - 1.0)
+        flag = ""
+        if change > args.threshold:
+            flag = "  SLOWER"
+            regressions += 1
+        elif change < -args.threshold:
+            flag = "  faster"
+        print("%-40s %12.1f %12.1f %+8.1f%%%s" % (
+            name, before["nsPerOp"], after["nsPerOp"], change, flag))
+
+    missing = sorted(set(base) ^ set(cand))
+    if missing:
+        print("\nIn one report only: " + ", ".join(missing))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
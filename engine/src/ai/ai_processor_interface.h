@@ -11,6 +11,9 @@
 
 namespace WindowsAiMic {
 
+class StateReader;
+class StateWriter;
+
 /**
  * Abstract interface for AI-based audio processors
  */
@@ -55,6 +58,14 @@ public:
    * Get expected frame size (for RNNoise: 480)
    */
   virtual size_t getExpectedFrameSize() const = 0;
+
+  /**
+   * Running state for snapshots: buffered frames and the model's
+   * recurrent state. Same contract as IDSPProcessor::saveState().
+   */
+  virtual size_t stateSize() const { return 0; }
+  virtual void saveState(StateWriter &) const {}
+  virtual void loadState(StateReader &) {}
 };
 
 } // namespace WindowsAiMic
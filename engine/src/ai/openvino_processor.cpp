@@ -7,9 +7,9 @@
  */
 
 #include "openvino_processor.h"
+#include "../diagnostics/logger.h"
 #include "../platform/cpu_features.h"
 #include <algorithm>
-#include <iostream>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -106,27 +106,25 @@ std::vector<std::string> OpenVINOProcessor::getAvailableDevices() {
 }
 
 bool OpenVINOProcessor::initialize() {
-  std::cout << "Initializing OpenVINO processor..." << std::endl;
+  WAM_LOG_INFO("Initializing OpenVINO processor...");
 
   // Check if OpenVINO is available
   if (!isAvailable()) {
-    std::cerr
-        << "OpenVINO runtime not available. Install OpenVINO or use RNNoise."
-        << std::endl;
+    WAM_LOG_ERROR(
+        "OpenVINO runtime not available. Install OpenVINO or use RNNoise.");
     return false;
   }
 
   // Try to load model
   if (!loadModel()) {
-    std::cerr << "Failed to load AI model for OpenVINO" << std::endl;
+    WAM_LOG_ERROR("Failed to load AI model for OpenVINO");
     return false;
   }
 
   initialized_ = true;
   bufferPos_ = 0;
 
-  std::cout << "OpenVINO initialized on device: " << currentDevice_
-            << std::endl;
+  WAM_LOG_INFO("OpenVINO initialized on device: %s", currentDevice_.c_str());
   return true;
 }
 
@@ -175,14 +173,13 @@ bool OpenVINOProcessor::loadModel() {
     return true;
 
   } catch (const std::exception &e) {
-    std::cerr << "OpenVINO error: " << e.what() << std::endl;
+    WAM_LOG_ERROR("OpenVINO error: %s", e.what());
     return false;
   }
 #else
-  std::cout << "OpenVINO not compiled in. This is a stub implementation."
-            << std::endl;
-  std::cout << "To enable: Install OpenVINO and rebuild with -DHAS_OPENVINO=ON"
-            << std::endl;
+  WAM_LOG_INFO("OpenVINO not compiled in. This is a stub implementation.");
+  WAM_LOG_INFO(
+      "To enable: Install OpenVINO and rebuild with -DHAS_OPENVINO=ON");
 
   // In stub mode, pretend we're using CPU
   currentDevice_ = "CPU (stub)";
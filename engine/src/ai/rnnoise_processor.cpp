@@ -3,9 +3,14 @@
  */
 
 #include "rnnoise_processor.h"
+#include "../diagnostics/logger.h"
+#include "../diagnostics/metrics.h"
+#include "../dsp/processor_state.h"
+
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <iostream>
+#include <cstdint>
 
 // Include RNNoise header
 extern "C" {
@@ -14,10 +19,24 @@ extern "C" {
 
 namespace WindowsAiMic {
 
-RNNoiseProcessor::RNNoiseProcessor()
-    : frameBuffer_(FRAME_SIZE, 0.0f),
-      outputBuffer_(FRAME_SIZE * 4, 0.0f) // Buffer for processed output
-{}
+namespace {
+
+// The library's state may point into the library (model weights), so it
+// is only restored where the library sits at the same address
+uint64_t modelOrigin() {
+  return static_cast<uint64_t>(
+      reinterpret_cast<uintptr_t>(&rnnoise_process_frame));
+}
+
+} // namespace
+
+RNNoiseProcessor::RNNoiseProcessor(std::pmr::memory_resource *memory)
+    : frameBuffer_(FRAME_SIZE, 0.0f, memory),
+      outputBuffer_(FRAME_SIZE * 4, 0.0f, memory), // Processed output
+      scaledFrame_(FRAME_SIZE, 0.0f, memory),
+      frameTime_(&MetricsRegistry::instance().histogram(
+          "wam_model_frame_us", "AI model inference time per frame",
+          "model=\"rnnoise\"")) {}
 
 RNNoiseProcessor::~RNNoiseProcessor() {
   if (state_) {
@@ -33,22 +52,22 @@ bool RNNoiseProcessor::initialize() {
 
   state_ = rnnoise_create(nullptr);
   if (!state_) {
-    std::cerr << "Failed to create RNNoise state" << std::endl;
+    WAM_LOG_ERROR("Failed to create RNNoise state");
     return false;
   }
 
   bufferPos_ = 0;
   outputPos_ = 0;
 
-  std::cout << "RNNoise initialized (frame size: " << FRAME_SIZE << " samples)"
-            << std::endl;
+  WAM_LOG_INFO("RNNoise initialized (frame size: %d samples)",
+               static_cast<int>(FRAME_SIZE));
   return true;
 }
 
 void RNNoiseProcessor::reset() {
+  // Cleared in place: reset() may run on the audio thread
   if (state_) {
-    rnnoise_destroy(state_);
-    state_ = rnnoise_create(nullptr);
+    rnnoise_init(state_, nullptr);
   }
 
   std::fill(frameBuffer_.begin(), frameBuffer_.end(), 0.0f);
@@ -57,6 +76,67 @@ void RNNoiseProcessor::reset() {
   outputPos_ = 0;
 }
 
+size_t RNNoiseProcessor::stateSize() const {
+  if (!state_) {
+    return 0;
+  }
+  return 2 * sizeof(uint64_t) + sizeof(float) +
+         (frameBuffer_.size() + outputBuffer_.size()) * sizeof(float) +
+         2 * sizeof(uint64_t) + static_cast<size_t>(rnnoise_get_size());
+}
+
+void RNNoiseProcessor::saveState(StateWriter &writer) const {
+  if (!state_) {
+    return;
+  }
+  writer.write(static_cast<uint64_t>(bufferPos_));
+  writer.write(static_cast<uint64_t>(outputPos_));
+  writer.write(lastVAD_);
+  writer.writeFloats(frameBuffer_.data(), frameBuffer_.size());
+  writer.writeFloats(outputBuffer_.data(), outputBuffer_.size());
+  // The network's recurrent state, as the library lays it out
+  const uint64_t modelBytes = static_cast<uint64_t>(rnnoise_get_size());
+  writer.write(modelOrigin());
+  writer.write(modelBytes);
+  writer.writeBytes(state_, static_cast<size_t>(modelBytes));
+}
+
+void RNNoiseProcessor::loadState(StateReader &reader) {
+  if (!state_) {
+    reader.fail();
+    return;
+  }
+  uint64_t bufferPos = 0;
+  uint64_t outputPos = 0;
+  reader.read(bufferPos);
+  reader.read(outputPos);
+  if (bufferPos >= FRAME_SIZE || outputPos >= outputBuffer_.size()) {
+    reader.fail();
+    return;
+  }
+  bufferPos_ = static_cast<size_t>(bufferPos);
+  outputPos_ = static_cast<size_t>(outputPos);
+  reader.read(lastVAD_);
+  reader.readFloats(frameBuffer_.data(), frameBuffer_.size());
+  reader.readFloats(outputBuffer_.data(), outputBuffer_.size());
+  uint64_t origin = 0;
+  uint64_t modelBytes = 0;
+  reader.read(origin);
+  reader.read(modelBytes);
+  if (modelBytes != static_cast<uint64_t>(rnnoise_get_size())) {
+    reader.fail();
+    return;
+  }
+  if (origin == modelOrigin()) {
+    reader.readBytes(state_, static_cast<size_t>(modelBytes));
+  } else {
+    // Saved by another process: the frames carry over, the network
+    // re-converges from a clear state
+    reader.skip(static_cast<size_t>(modelBytes));
+    rnnoise_init(state_, nullptr);
+  }
+}
+
 void RNNoiseProcessor::setAttenuation(float db) {
   // Convert dB to linear scale
   // 0 dB = 1.0 (no change), -60 dB ≈ 0.001 (maximum suppression)
@@ -115,18 +195,22 @@ void RNNoiseProcessor::process(float *buffer, size_t frames) {
 void RNNoiseProcessor::processFrame(float *frame) {
   // Convert to 16-bit range that RNNoise expects
   // RNNoise processes 16-bit PCM scaled to float
-  std::vector<float> scaledFrame(FRAME_SIZE);
   for (size_t i = 0; i < FRAME_SIZE; ++i) {
-    scaledFrame[i] = frame[i] * 32767.0f;
+    scaledFrame_[i] = frame[i] * 32767.0f;
   }
 
   // Process with RNNoise
+  const auto start = std::chrono::steady_clock::now();
   lastVAD_ =
-      rnnoise_process_frame(state_, scaledFrame.data(), scaledFrame.data());
+      rnnoise_process_frame(state_, scaledFrame_.data(), scaledFrame_.data());
+  frameTime_->record(static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start)
+          .count()));
 
   // Convert back to normalized float and apply attenuation blending
   for (size_t i = 0; i < FRAME_SIZE; ++i) {
-    float processed = scaledFrame[i] / 32767.0f;
+    float processed = scaledFrame_[i] / 32767.0f;
     float original = frame[i];
 
     // Blend between processed and original based on attenuation
@@ -9,6 +9,7 @@
 
 #include "ai_processor_interface.h"
 #include <memory>
+#include <memory_resource>
 #include <vector>
 
 // Forward declare RNNoise types
@@ -16,6 +17,8 @@ struct DenoiseState;
 
 namespace WindowsAiMic {
 
+class Histogram;
+
 /**
  * RNNoise noise suppression processor
  *
@@ -24,7 +27,11 @@ namespace WindowsAiMic {
  */
 class RNNoiseProcessor : public IAIProcessor {
 public:
-  RNNoiseProcessor();
+  /**
+   * @param memory Where the frame, output and scratch buffers live
+   */
+  explicit RNNoiseProcessor(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
   ~RNNoiseProcessor() override;
 
   // Non-copyable
@@ -39,6 +46,9 @@ public:
   bool isInitialized() const override { return state_ != nullptr; }
   int getExpectedSampleRate() const override { return 48000; }
   size_t getExpectedFrameSize() const override { return FRAME_SIZE; }
+  size_t stateSize() const override;
+  void saveState(StateWriter &writer) const override;
+  void loadState(StateReader &reader) override;
 
   /**
    * Set noise attenuation level
@@ -62,16 +72,21 @@ private:
   DenoiseState *state_ = nullptr;
 
   // Frame buffering for non-aligned inputs
-  std::vector<float> frameBuffer_;
+  std::pmr::vector<float> frameBuffer_;
   size_t bufferPos_ = 0;
 
   // Output buffer for processed frames
-  std::vector<float> outputBuffer_;
+  std::pmr::vector<float> outputBuffer_;
   size_t outputPos_ = 0;
 
+  // Frame scaled to the 16-bit range RNNoise works in
+  std::pmr::vector<float> scaledFrame_;
+
   // Parameters
   float attenuation_ = 1.0f; // 0.0 = full suppression, 1.0 = no change to noise
   float lastVAD_ = 0.0f;
+
+  Histogram *frameTime_ = nullptr; // Owned by MetricsRegistry
 };
 
 } // namespace WindowsAiMic
@@ -103,6 +103,12 @@ size_t LockFreeRingBuffer::availableWrite() const {
   }
 }
 
+void LockFreeRingBuffer::resize(size_t capacity) {
+  buffer_.assign(capacity + 1, 0.0f);
+  capacity_ = capacity;
+  clear();
+}
+
 void LockFreeRingBuffer::clear() {
   readPos_.store(0, std::memory_order_release);
   writePos_.store(0, std::memory_order_release);
@@ -51,6 +51,12 @@ public:
    */
   void clear();
 
+  /**
+   * Change the capacity; contents are dropped
+   * Not thread-safe: only while neither side is running.
+   */
+  void resize(size_t capacity);
+
   /**
    * Get buffer capacity
    */
@@ -0,0 +1,161 @@
+/**
+ * WindowsAiMic - Audio Device Interface Header
+ *
+ * Capture and render device interfaces the engine talks to, so WASAPI can
+ * be swapped for another backend (simulated devices in the stress tests).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Audio input device delivering float32 packets from its own thread
+ */
+class CaptureDevice {
+public:
+  virtual ~CaptureDevice() = default;
+
+  /**
+   * Audio callback type
+   * Parameters: buffer, frames, sampleRate, channels
+   */
+  using AudioCallback = std::function<void(float *, size_t, int, int)>;
+
+  /**
+   * Open a device
+   * @param deviceId Device ID (empty for default device)
+   * @return true on success
+   */
+  virtual bool initialize(const std::wstring &deviceId = L"") = 0;
+
+  virtual void start() = 0;
+  virtual void stop() = 0;
+  virtual bool isCapturing() const = 0;
+
+  virtual int getSampleRate() const = 0;
+  virtual int getChannels() const = 0;
+
+  /**
+   * Number of capture gaps (device position discontinuities) so far
+   */
+  virtual uint64_t getGapCount() const = 0;
+
+  /**
+   * Total frames skipped by capture gaps
+   */
+  virtual uint64_t getGapFrames() const = 0;
+
+  /**
+   * Set callback for captured audio (before start)
+   */
+  virtual void setCallback(AudioCallback callback) = 0;
+
+  /**
+   * Wake on a timer every `intervalUs` and deliver everything captured
+   * since, instead of on every device period (before initialize)
+   * @return false if the device only runs event-driven
+   */
+  virtual bool setWakeInterval(float intervalUs) {
+    (void)intervalUs;
+    return false;
+  }
+
+  /**
+   * Enumerate available capture devices
+   * @return Vector of (name, deviceId) pairs
+   */
+  virtual std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() = 0;
+};
+
+/**
+ * Audio output device pulling from a ring the engine writes into
+ */
+class RenderDevice {
+public:
+  virtual ~RenderDevice() = default;
+
+  /**
+   * Open a device
+   * @param deviceId Device ID (should be the Virtual Speaker device)
+   * @return true on success
+   */
+  virtual bool initialize(const std::wstring &deviceId) = 0;
+
+  virtual void start() = 0;
+  virtual void stop() = 0;
+
+  /**
+   * Check if ready to write
+   */
+  virtual bool isReady() const = 0;
+
+  /**
+   * Queue mono float32 audio for the device
+   */
+  virtual void write(const float *buffer, size_t frames) = 0;
+
+  /**
+   * Frames queued and not yet handed to the device
+   */
+  virtual size_t getQueuedFrames() const = 0;
+
+  /**
+   * Drop up to `frames` of the oldest queued audio
+   * @return Frames dropped
+   */
+  virtual size_t discardQueued(size_t frames) {
+    (void)frames;
+    return 0;
+  }
+
+  /**
+   * Hand audio to the device from write() itself, which the caller
+   * promises about every `writeIntervalUs`, instead of from a device
+   * thread woken every period (before initialize)
+   * @return false if the device needs its own thread
+   */
+  virtual bool setFillOnWrite(float writeIntervalUs) {
+    (void)writeIntervalUs;
+    return false;
+  }
+
+  /**
+   * Number of periods where the device ran dry after being primed
+   */
+  virtual uint64_t getUnderrunCount() const = 0;
+
+  /**
+   * Number of writes that overwrote unplayed audio
+   */
+  virtual uint64_t getOverrunCount() const = 0;
+
+  virtual int getSampleRate() const = 0;
+  virtual int getChannels() const = 0;
+
+  /**
+   * Enumerate available render devices
+   * @return Vector of (name, deviceId) pairs
+   */
+  virtual std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() = 0;
+};
+
+/**
+ * Device factories for the engine; empty members fall back to WASAPI
+ */
+struct AudioBackend {
+  std::function<std::unique_ptr<CaptureDevice>()> createCapture;
+  std::function<std::unique_ptr<RenderDevice>()> createRender;
+};
+
+} // namespace WindowsAiMic
@@ -6,14 +6,14 @@
 
 #pragma once
 
-#include <memory>
+#include <cstddef>
 #include <vector>
 
 namespace WindowsAiMic {
 
 /**
- * High-quality audio resampler
- * Uses polyphase FIR filter implementation
+ * Audio resampler
+ * Uses linear interpolation between input frames
  */
 class Resampler {
 public:
@@ -54,15 +54,10 @@ private:
   int dstRate_ = 0;
   int channels_ = 0;
 
-  // State for fractional sample position
+  // Fractional read position; -1 up to 0 interpolates from the last
+  // frame of the previous block
   double position_ = 0.0;
-  float lastSample_ = 0.0f;
-
-  // Polyphase filter coefficients (for high quality)
-  std::vector<std::vector<float>> filterBank_;
-  std::vector<float> history_;
-  int historySize_ = 0;
-  int historyPos_ = 0;
+  std::vector<float> lastFrame_;
 };
 
 } // namespace WindowsAiMic
@@ -0,0 +1,584 @@
+/**
+ * WindowsAiMic - Simulated Audio Device Implementation
+ *
+ * Capture and render threads that follow a period clock and apply the
+ * configured lateness, missed events and bursts to each event.
+ */
+
+#include "simulated_device.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+#include "../platform/clock.h"
+#include "../platform/thread_utils.h"
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr double TWO_PI = 6.283185307179586;
+constexpr double TONE_HZ = 220.0;
+
+/**
+ * Per-event decisions for one device thread
+ */
+class EventPattern {
+public:
+  enum class Event { Fire, Missing, Held };
+
+  explicit EventPattern(const CallbackTiming &timing)
+      : timing_(timing), rng_(timing.seed) {}
+
+  /**
+   * What happens at the end of the next period
+   */
+  Event next() {
+    if (holding_) {
+      if (holdLeft_ > 0) {
+        --holdLeft_;
+        return Event::Held;
+      }
+      holding_ = false;
+      return Event::Fire;
+    }
+    if (chance(timing_.missingProbability)) {
+      return Event::Missing;
+    }
+    if (chance(timing_.burstProbability)) {
+      // 2 or 3 packets arrive together: hold this event and 0-1 more
+      holding_ = true;
+      holdLeft_ = static_cast<int>(rng_() % 2);
+      return Event::Held;
+    }
+    return Event::Fire;
+  }
+
+  bool drop() { return chance(timing_.dropProbability); }
+
+  /**
+   * How late a firing event is, in nanoseconds
+   */
+  uint64_t latenessNs() {
+    const float width = std::max(timing_.jitterUs, 0.0f);
+    float lateUs = 0.0f;
+    switch (timing_.jitter) {
+    case JitterModel::None:
+      break;
+    case JitterModel::Uniform:
+      lateUs = std::uniform_real_distribution<float>(0.0f, width)(rng_);
+      break;
+    case JitterModel::Normal:
+      lateUs = std::abs(std::normal_distribution<float>(0.0f, width)(rng_));
+      break;
+    case JitterModel::Exponential:
+      if (width > 0.0f) {
+        lateUs = std::exponential_distribution<float>(1.0f / width)(rng_);
+      }
+      break;
+    }
+    lateUs = std::clamp(lateUs, 0.0f, timing_.maxLateUs);
+    return static_cast<uint64_t>(lateUs * 1000.0f);
+  }
+
+private:
+  bool chance(float probability) {
+    return probability > 0.0f &&
+           std::uniform_real_distribution<float>(0.0f, 1.0f)(rng_) <
+               probability;
+  }
+
+  CallbackTiming timing_;
+  std::mt19937 rng_;
+  bool holding_ = false;
+  int holdLeft_ = 0;
+};
+
+/**
+ * Raise the calling device thread like WASAPI's MMCSS "Pro Audio" task
+ */
+std::unique_ptr<RealtimeContext> makeDeviceRealtime(bool enabled) {
+  if (!enabled) {
+    return nullptr;
+  }
+  RealtimeOptions options;
+  options.lockMemory = false; // The engine's processing thread does this
+  return std::make_unique<RealtimeContext>(options);
+}
+
+} // namespace
+
+bool parseJitterModel(const std::string &name, JitterModel &model) {
+  if (name == "none") {
+    model = JitterModel::None;
+  } else if (name == "uniform") {
+    model = JitterModel::Uniform;
+  } else if (name == "normal") {
+    model = JitterModel::Normal;
+  } else if (name == "exponential") {
+    model = JitterModel::Exponential;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// ============================================================================
+// SimulatedCapture
+// ============================================================================
+
+SimulatedCapture::SimulatedCapture(SimulatedDeviceConfig config)
+    : config_(std::move(config)),
+      packet_(config_.periodFrames * std::max(config_.channels, 1)),
+      readyNs_(std::make_unique<std::atomic<uint64_t>[]>(READY_HISTORY)),
+      callbackInterval_(&MetricsRegistry::instance().histogram(
+          "wam_device_callback_interval_us",
+          "Time between device event wake-ups", "device=\"capture\"")),
+      wakeups_(&MetricsRegistry::instance().counter(
+          "wam_audio_wakeups_total", "Audio thread wake-ups",
+          "thread=\"capture\"")) {}
+
+SimulatedCapture::~SimulatedCapture() { stop(); }
+
+bool SimulatedCapture::initialize(const std::wstring &) { return true; }
+
+void SimulatedCapture::start() {
+  if (capturing_.load()) {
+    return;
+  }
+  capturing_ = true;
+  captureThread_ = std::thread(&SimulatedCapture::captureThread, this);
+}
+
+void SimulatedCapture::stop() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    if (!capturing_.load()) {
+      return;
+    }
+    capturing_ = false;
+  }
+  wakeCv_.notify_all();
+  if (captureThread_.joinable()) {
+    captureThread_.join();
+  }
+}
+
+void SimulatedCapture::setCallback(AudioCallback callback) {
+  callback_ = std::move(callback);
+}
+
+bool SimulatedCapture::setWakeInterval(float intervalUs) {
+  if (capturing_.load() || intervalUs <= 0.0f) {
+    return false;
+  }
+  const float frames =
+      intervalUs * 1e-6f * static_cast<float>(config_.sampleRate);
+  config_.periodFrames =
+      std::max<size_t>(1, static_cast<size_t>(std::lround(frames)));
+  packet_.assign(config_.periodFrames * std::max(config_.channels, 1), 0.0f);
+  return true;
+}
+
+std::vector<std::pair<std::string, std::wstring>>
+SimulatedCapture::enumerateDevices() {
+  return {{config_.name, L"simulated-capture"}};
+}
+
+uint64_t SimulatedCapture::frameCaptureNs(uint64_t frame) const {
+  const uint64_t delivered = deliveredFrames_.load(std::memory_order_acquire);
+  const uint64_t period = frame / config_.periodFrames;
+  if (frame >= delivered ||
+      delivered / config_.periodFrames - period >= READY_HISTORY) {
+    return 0;
+  }
+  return readyNs_[period % READY_HISTORY].load(std::memory_order_relaxed);
+}
+
+void SimulatedCapture::deliver(uint64_t readyNs) {
+  const int channels = std::max(config_.channels, 1);
+  const double step = TWO_PI * TONE_HZ / config_.sampleRate;
+  std::uniform_real_distribution<float> noise(-0.01f, 0.01f);
+  for (size_t i = 0; i < config_.periodFrames; ++i) {
+    const float sample =
+        config_.level * (static_cast<float>(std::sin(phase_)) +
+                         10.0f * noise(noise_));
+    phase_ = std::fmod(phase_ + step, TWO_PI);
+    for (int c = 0; c < channels; ++c) {
+      packet_[i * channels + c] = sample;
+    }
+  }
+
+  // Publish the capture time before the engine can see the frames
+  const uint64_t delivered = deliveredFrames_.load(std::memory_order_relaxed);
+  readyNs_[(delivered / config_.periodFrames) % READY_HISTORY].store(
+      readyNs, std::memory_order_relaxed);
+  deliveredFrames_.store(delivered + config_.periodFrames,
+                         std::memory_order_release);
+  callbackCount_.fetch_add(1, std::memory_order_relaxed);
+
+  if (callback_) {
+    callback_(packet_.data(), config_.periodFrames, config_.sampleRate,
+              channels);
+  }
+}
+
+void SimulatedCapture::captureThread() {
+  setThreadName("SimulatedCapture");
+  Logger::instance().registerThread("SimulatedCapture");
+  Tracer::instance().registerThread("SimulatedCapture");
+  DenormalGuard denormals; // The engine callback runs the input resampler
+  const auto realtime = makeDeviceRealtime(config_.realtime);
+
+  EventPattern pattern(config_.timing);
+  const auto periodDuration = std::chrono::nanoseconds(
+      static_cast<int64_t>(config_.periodFrames * 1000000000ull /
+                           static_cast<uint64_t>(config_.sampleRate)));
+  const auto start = std::chrono::steady_clock::now() +
+                     std::chrono::microseconds(
+                         static_cast<int64_t>(config_.phaseUs));
+  auto lastWake = std::chrono::steady_clock::time_point{};
+
+  std::vector<uint64_t> pending; // Capture times of undelivered periods
+  pending.reserve(16);
+
+  for (uint64_t period = 1; capturing_.load(); ++period) {
+    // The period's audio exists once it ends; the event may come later
+    const auto ready = start + periodDuration * period;
+    const EventPattern::Event event = pattern.next();
+    auto wake = ready;
+    if (event == EventPattern::Event::Fire) {
+      wake += std::chrono::nanoseconds(pattern.latenessNs());
+    }
+    {
+      std::unique_lock<std::mutex> lock(wakeMutex_);
+      wakeCv_.wait_until(lock, wake, [this]() { return !capturing_.load(); });
+    }
+    if (!capturing_.load()) {
+      break;
+    }
+
+    if (pattern.drop()) {
+      gapCount_.fetch_add(1, std::memory_order_relaxed);
+      gapFrames_.fetch_add(config_.periodFrames, std::memory_order_relaxed);
+    } else {
+      pending.push_back(toNs(ready));
+    }
+
+    if (event == EventPattern::Event::Missing) {
+      missedEvents_.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (event == EventPattern::Event::Held) {
+      if (pending.size() == 1) {
+        bursts_.fetch_add(1, std::memory_order_relaxed);
+      }
+      continue;
+    }
+    WAM_TRACE_SCOPE("CaptureDrain");
+
+    const auto now = std::chrono::steady_clock::now();
+    if (lastWake.time_since_epoch().count() != 0) {
+      callbackInterval_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                                lastWake)
+              .count()));
+    }
+    lastWake = now;
+    wakeups_->add();
+
+    // Everything queued goes out back to back, one packet per callback
+    for (const uint64_t readyNs : pending) {
+      deliver(readyNs);
+    }
+    pending.clear();
+  }
+}
+
+// ============================================================================
+// SimulatedRender
+// ============================================================================
+
+SimulatedRender::SimulatedRender(SimulatedDeviceConfig config)
+    : config_(std::move(config)),
+      ringBuffer_(static_cast<size_t>(config_.sampleRate) * 2), // 2 seconds
+      callbackInterval_(&MetricsRegistry::instance().histogram(
+          "wam_device_callback_interval_us",
+          "Time between device event wake-ups", "device=\"render\"")),
+      wakeups_(&MetricsRegistry::instance().counter(
+          "wam_audio_wakeups_total", "Audio thread wake-ups",
+          "thread=\"render\"")) {}
+
+SimulatedRender::~SimulatedRender() { stop(); }
+
+bool SimulatedRender::initialize(const std::wstring &) {
+  initialized_ = true;
+  return true;
+}
+
+void SimulatedRender::setLatencySource(const SimulatedCapture *source,
+                                       float deadlineUs) {
+  source_ = source;
+  deadlineNs_ = static_cast<uint64_t>(std::max(deadlineUs, 0.0f) * 1000.0f);
+}
+
+bool SimulatedRender::setFillOnWrite(float writeIntervalUs) {
+  if (running_.load() || writeIntervalUs <= 0.0f) {
+    return false;
+  }
+  const float frames =
+      writeIntervalUs * 1e-6f * static_cast<float>(config_.sampleRate);
+  fillFrames_ =
+      std::max<uint64_t>(1, static_cast<uint64_t>(std::lround(frames)));
+  return true;
+}
+
+void SimulatedRender::start() {
+  if (!initialized_.load() || running_.load()) {
+    return;
+  }
+  running_ = true;
+  if (fillFrames_ > 0) {
+    filled_ = false;
+    startNs_.store(toNs(std::chrono::steady_clock::now()),
+                   std::memory_order_release);
+    return;
+  }
+  renderThread_ = std::thread(&SimulatedRender::renderThread, this);
+}
+
+void SimulatedRender::stop() {
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    if (!running_.load()) {
+      return;
+    }
+    running_ = false;
+  }
+  wakeCv_.notify_all();
+  if (renderThread_.joinable()) {
+    renderThread_.join();
+  }
+}
+
+std::vector<std::pair<std::string, std::wstring>>
+SimulatedRender::enumerateDevices() {
+  return {{config_.name, L"simulated-render"}};
+}
+
+void SimulatedRender::resetLatency() {
+  playoutLatencyUs_.reset();
+  arrivalLatencyUs_.reset();
+  lateBlocks_ = 0;
+}
+
+size_t SimulatedRender::getQueuedFrames() const {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  return (writePos_ + ringBuffer_.size() - readPos_) % ringBuffer_.size();
+}
+
+size_t SimulatedRender::discardQueued(size_t frames) {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  const size_t queued =
+      (writePos_ + ringBuffer_.size() - readPos_) % ringBuffer_.size();
+  const size_t dropped = std::min(frames, queued);
+  readPos_ = (readPos_ + dropped) % ringBuffer_.size();
+  readFrames_ += dropped;
+  return dropped;
+}
+
+size_t SimulatedRender::getDevicePadding() const {
+  const uint64_t startNs = startNs_.load(std::memory_order_acquire);
+  const uint64_t nowNs = toNs(std::chrono::steady_clock::now());
+  if (startNs == 0 || nowNs < startNs) {
+    return 0;
+  }
+  const uint64_t played = (nowNs - startNs) *
+                          static_cast<uint64_t>(config_.sampleRate) /
+                          1000000000ull;
+  const uint64_t written = deviceFrames_.load(std::memory_order_relaxed);
+  return written > played ? static_cast<size_t>(written - played) : 0;
+}
+
+void SimulatedRender::write(const float *buffer, size_t frames) {
+  if (!initialized_.load() || frames == 0) {
+    return;
+  }
+
+  uint64_t lastFrame = 0;
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+
+    bool overran = false;
+    for (size_t i = 0; i < frames; ++i) {
+      ringBuffer_[writePos_] = buffer[i];
+      writePos_ = (writePos_ + 1) % ringBuffer_.size();
+
+      // Overwrite oldest data if buffer full
+      if (writePos_ == readPos_) {
+        readPos_ = (readPos_ + 1) % ringBuffer_.size();
+        ++readFrames_;
+        overran = true;
+      }
+    }
+    writtenFrames_ += frames;
+    lastFrame = writtenFrames_ - 1;
+
+    if (overran) {
+      overrunCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  primed_.store(true, std::memory_order_relaxed);
+
+  // How long after its last frame was captured this block got here
+  if (source_) {
+    const uint64_t captureNs = source_->frameCaptureNs(
+        lastFrame * static_cast<uint64_t>(source_->getSampleRate()) /
+        static_cast<uint64_t>(config_.sampleRate));
+    const uint64_t nowNs = toNs(std::chrono::steady_clock::now());
+    if (captureNs != 0 && nowNs > captureNs) {
+      arrivalLatencyUs_.record((nowNs - captureNs) / 1000);
+      if (nowNs - captureNs > deadlineNs_) {
+        lateBlocks_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  if (fillFrames_ > 0 && running_.load(std::memory_order_relaxed)) {
+    fillOnWrite(toNs(std::chrono::steady_clock::now()));
+  }
+}
+
+void SimulatedRender::fillOnWrite(uint64_t nowNs) {
+  WAM_TRACE_SCOPE("RenderFill");
+  callbackCount_.fetch_add(1, std::memory_order_relaxed);
+  const uint64_t startNs = startNs_.load(std::memory_order_acquire);
+  const uint64_t played = (nowNs - startNs) *
+                          static_cast<uint64_t>(config_.sampleRate) /
+                          1000000000ull;
+
+  // Dry before this write: it played silence up to now. Queue one write
+  // of silence ahead of the audio so the next write has slack to be late.
+  uint64_t deviceFrames = deviceFrames_.load(std::memory_order_relaxed);
+  if (deviceFrames <= played) {
+    if (filled_) {
+      underrunCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+    deviceFrames = played + fillFrames_;
+  }
+
+  const uint64_t bufferFrames = 3 * fillFrames_;
+  const uint64_t padding = deviceFrames - played;
+  if (padding < bufferFrames) {
+    deviceFrames += moveToDevice(deviceFrames, bufferFrames - padding,
+                                 startNs);
+    filled_ = true;
+  }
+  deviceFrames_.store(deviceFrames, std::memory_order_relaxed);
+}
+
+uint64_t SimulatedRender::moveToDevice(uint64_t deviceFrames,
+                                       uint64_t framesAvailable,
+                                       uint64_t startNs) {
+  const uint64_t rate = static_cast<uint64_t>(config_.sampleRate);
+  uint64_t framesRead = 0;
+  uint64_t lastFrame = 0;
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+    const size_t queued =
+        (writePos_ + ringBuffer_.size() - readPos_) % ringBuffer_.size();
+    framesRead = std::min<uint64_t>(framesAvailable, queued);
+    readPos_ = (readPos_ + framesRead) % ringBuffer_.size();
+    readFrames_ += framesRead;
+    lastFrame = readFrames_ - 1;
+  }
+
+  // The last real frame plays once everything ahead of it has
+  if (framesRead > 0 && source_) {
+    const uint64_t playNs =
+        startNs + (deviceFrames + framesRead) * 1000000000ull / rate;
+    const uint64_t captureNs = source_->frameCaptureNs(
+        lastFrame * static_cast<uint64_t>(source_->getSampleRate()) / rate);
+    if (captureNs != 0 && playNs > captureNs) {
+      playoutLatencyUs_.record((playNs - captureNs) / 1000);
+    }
+  }
+  return framesRead;
+}
+
+void SimulatedRender::renderThread() {
+  setThreadName("SimulatedRender");
+  Logger::instance().registerThread("SimulatedRender");
+  Tracer::instance().registerThread("SimulatedRender");
+  DenormalGuard denormals;
+  const auto realtime = makeDeviceRealtime(config_.realtime);
+
+  EventPattern pattern(config_.timing);
+  const uint64_t rate = static_cast<uint64_t>(config_.sampleRate);
+  const uint64_t bufferFrames = config_.periodFrames * config_.bufferPeriods;
+  const auto periodDuration = std::chrono::nanoseconds(static_cast<int64_t>(
+      config_.periodFrames * 1000000000ull / rate));
+  const auto start = std::chrono::steady_clock::now() +
+                     std::chrono::microseconds(
+                         static_cast<int64_t>(config_.phaseUs));
+  const uint64_t startNs = toNs(start);
+  startNs_.store(startNs, std::memory_order_release);
+  auto lastWake = std::chrono::steady_clock::time_point{};
+
+  for (uint64_t period = 1; running_.load(); ++period) {
+    const EventPattern::Event event = pattern.next();
+    auto wake = start + periodDuration * period;
+    if (event == EventPattern::Event::Fire) {
+      wake += std::chrono::nanoseconds(pattern.latenessNs());
+    }
+    {
+      std::unique_lock<std::mutex> lock(wakeMutex_);
+      wakeCv_.wait_until(lock, wake, [this]() { return !running_.load(); });
+    }
+    if (!running_.load()) {
+      break;
+    }
+    if (event != EventPattern::Event::Fire) {
+      continue; // The device keeps playing what it has
+    }
+    WAM_TRACE_SCOPE("RenderFill");
+
+    const auto now = std::chrono::steady_clock::now();
+    if (lastWake.time_since_epoch().count() != 0) {
+      callbackInterval_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(now -
+                                                                lastWake)
+              .count()));
+    }
+    lastWake = now;
+    wakeups_->add();
+    callbackCount_.fetch_add(1, std::memory_order_relaxed);
+
+    // Device position: what has been played since start. If the device
+    // ran completely dry it played silence, which moves the position on.
+    const uint64_t played = (toNs(now) - startNs) * rate / 1000000000ull;
+    uint64_t deviceFrames = std::max(
+        deviceFrames_.load(std::memory_order_relaxed), played);
+    const uint64_t padding = deviceFrames - played;
+    if (padding >= bufferFrames) {
+      continue;
+    }
+    const uint64_t framesAvailable = bufferFrames - padding;
+    const uint64_t framesRead =
+        moveToDevice(deviceFrames, framesAvailable, startNs);
+
+    // Running dry after audio has started flowing is an underrun
+    if (framesRead < framesAvailable &&
+        primed_.load(std::memory_order_relaxed)) {
+      underrunCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // The rest of the device buffer is filled with silence
+    deviceFrames += framesAvailable;
+    deviceFrames_.store(deviceFrames, std::memory_order_relaxed);
+  }
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,273 @@
+/**
+ * WindowsAiMic - Simulated Audio Device Header
+ *
+ * Clock-driven capture and render devices that replay configurable
+ * callback timing (jitter, missed events, bursts) without audio hardware.
+ * Used by the real-time stress harness in tests/rt_stress.cpp.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../diagnostics/metrics.h"
+#include "audio_device.h"
+
+namespace WindowsAiMic {
+
+/**
+ * Distribution of how late a device event fires after its period ends
+ */
+enum class JitterModel {
+  None,
+  Uniform,    // 0 .. jitterUs
+  Normal,     // |N(0, jitterUs)|
+  Exponential // Mean jitterUs; a long tail of very late events
+};
+
+/**
+ * Callback timing pattern replayed by a simulated device
+ */
+struct CallbackTiming {
+  JitterModel jitter = JitterModel::None;
+  float jitterUs = 0.0f;
+  float maxLateUs = 40000.0f;      // Cap on one event's lateness
+  float missingProbability = 0.0f; // Event never fires; data waits
+  float burstProbability = 0.0f;  // Hold 2-3 periods, then deliver
+  float dropProbability = 0.0f;   // Capture only: period lost (a gap)
+  uint32_t seed = 1;
+};
+
+/**
+ * Parse "none", "uniform", "normal" or "exponential"
+ * @return false if the name is unknown
+ */
+bool parseJitterModel(const std::string &name, JitterModel &model);
+
+struct SimulatedDeviceConfig {
+  std::string name = "WindowsAiMic Simulated Device";
+  int sampleRate = 48000;
+  int channels = 1;
+  size_t periodFrames = 480;
+  size_t bufferPeriods = 2; // Render: device buffer behind the ring
+  float phaseUs = 0.0f;     // Offset of this device's period clock
+  float level = 0.1f;       // Capture: tone amplitude, 0 = digital silence
+  CallbackTiming timing;
+  bool realtime = true; // Device thread gets real-time priority
+};
+
+/**
+ * Capture device producing a test tone on a simulated period clock
+ *
+ * Each period's audio is "captured" when the period ends; its callback
+ * fires after the configured lateness. Missed and held events deliver
+ * the queued periods back to back, like WASAPI draining several packets
+ * on one event. The capture time of every delivered frame is kept, so a
+ * SimulatedRender can measure end-to-end latency.
+ */
+class SimulatedCapture : public CaptureDevice {
+public:
+  explicit SimulatedCapture(SimulatedDeviceConfig config = {});
+  ~SimulatedCapture() override;
+
+  // Non-copyable
+  SimulatedCapture(const SimulatedCapture &) = delete;
+  SimulatedCapture &operator=(const SimulatedCapture &) = delete;
+
+  bool initialize(const std::wstring &deviceId = L"") override;
+  void start() override;
+  void stop() override;
+  bool isCapturing() const override { return capturing_.load(); }
+
+  int getSampleRate() const override { return config_.sampleRate; }
+  int getChannels() const override { return config_.channels; }
+  uint64_t getGapCount() const override { return gapCount_.load(); }
+  uint64_t getGapFrames() const override { return gapFrames_.load(); }
+
+  void setCallback(AudioCallback callback) override;
+
+  /**
+   * The simulated period becomes `intervalUs`: one event, one packet
+   */
+  bool setWakeInterval(float intervalUs) override;
+
+  std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() override;
+
+  /**
+   * steady_clock time (ns) at which a delivered frame was captured
+   * @param frame Index into the delivered stream (gaps excluded)
+   * @return 0 if the frame is not delivered yet or too old
+   */
+  uint64_t frameCaptureNs(uint64_t frame) const;
+
+  uint64_t getDeliveredFrames() const { return deliveredFrames_.load(); }
+  uint64_t getCallbackCount() const { return callbackCount_.load(); }
+  uint64_t getMissedEvents() const { return missedEvents_.load(); }
+  uint64_t getBursts() const { return bursts_.load(); }
+
+private:
+  void captureThread();
+  void deliver(uint64_t readyNs);
+
+  SimulatedDeviceConfig config_;
+  AudioCallback callback_;
+
+  std::atomic<bool> capturing_{false};
+  std::thread captureThread_;
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCv_; // Cuts the wait short on stop()
+
+  std::vector<float> packet_;
+  double phase_ = 0.0;
+  std::minstd_rand noise_{7};
+
+  // Capture time of each delivered period, by period index mod the size
+  static constexpr size_t READY_HISTORY = 4096;
+  std::unique_ptr<std::atomic<uint64_t>[]> readyNs_;
+  std::atomic<uint64_t> deliveredFrames_{0};
+
+  std::atomic<uint64_t> gapCount_{0};
+  std::atomic<uint64_t> gapFrames_{0};
+  std::atomic<uint64_t> callbackCount_{0};
+  std::atomic<uint64_t> missedEvents_{0};
+  std::atomic<uint64_t> bursts_{0};
+
+  Histogram *callbackInterval_ = nullptr; // Owned by MetricsRegistry
+  Counter *wakeups_ = nullptr;            // Owned by MetricsRegistry
+};
+
+/**
+ * Render device draining its ring on a simulated period clock
+ *
+ * Mirrors WasapiRender: write() fills a ring, and each device event moves
+ * as much as the device buffer has room for, padding with silence. A
+ * short fill once audio has flowed counts as an underrun. In fill-on-write
+ * mode there is no device thread: write() moves the ring into a device
+ * buffer of three writes, and a device that ran dry before a write is the
+ * underrun, refilled behind one write of silence. With a source
+ * attached, every event also records capture-to-playout latency, and
+ * every write() how long after capture a block arrived.
+ */
+class SimulatedRender : public RenderDevice {
+public:
+  explicit SimulatedRender(SimulatedDeviceConfig config = {});
+  ~SimulatedRender() override;
+
+  // Non-copyable
+  SimulatedRender(const SimulatedRender &) = delete;
+  SimulatedRender &operator=(const SimulatedRender &) = delete;
+
+  bool initialize(const std::wstring &deviceId) override;
+  void start() override;
+  void stop() override;
+  bool isReady() const override { return initialized_.load(); }
+
+  void write(const float *buffer, size_t frames) override;
+  size_t getQueuedFrames() const override;
+  size_t discardQueued(size_t frames) override;
+  uint64_t getUnderrunCount() const override {
+    return underrunCount_.load();
+  }
+  uint64_t getOverrunCount() const override { return overrunCount_.load(); }
+  bool setFillOnWrite(float writeIntervalUs) override;
+
+  int getSampleRate() const override { return config_.sampleRate; }
+  int getChannels() const override { return config_.channels; }
+
+  std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() override;
+
+  /**
+   * Measure latency against this capture device (before start)
+   * @param source Must outlive this device; nullptr disables latency
+   * @param deadlineUs Capture to write() limit for a block
+   */
+  void setLatencySource(const SimulatedCapture *source, float deadlineUs);
+
+  /**
+   * Frames handed to the device and not yet played
+   */
+  size_t getDevicePadding() const;
+
+  /**
+   * Capture of a block's last frame to playout of that frame (us)
+   */
+  const Histogram &playoutLatency() const { return playoutLatencyUs_; }
+
+  /**
+   * Capture of a block's last frame to its write() (us)
+   */
+  const Histogram &arrivalLatency() const { return arrivalLatencyUs_; }
+
+  /**
+   * Blocks whose write() came later than the deadline
+   */
+  uint64_t getLateBlocks() const { return lateBlocks_.load(); }
+
+  /**
+   * Device events, or device fills from write() in fill-on-write mode
+   */
+  uint64_t getCallbackCount() const { return callbackCount_.load(); }
+
+  /**
+   * Clear the latency histograms and late block count (after warm-up)
+   */
+  void resetLatency();
+
+private:
+  void renderThread();
+  void fillOnWrite(uint64_t nowNs);
+
+  /**
+   * Move up to `framesAvailable` frames from the ring to the device, whose
+   * clock stands at `deviceFrames`, and record their playout latency
+   * @return Frames moved
+   */
+  uint64_t moveToDevice(uint64_t deviceFrames, uint64_t framesAvailable,
+                        uint64_t startNs);
+
+  SimulatedDeviceConfig config_;
+  const SimulatedCapture *source_ = nullptr;
+  uint64_t deadlineNs_ = 0;
+  uint64_t fillFrames_ = 0; // Fill-on-write: frames per write, 0 = off
+  bool filled_ = false;     // Fill-on-write: the device has had audio
+
+  std::atomic<bool> initialized_{false};
+  std::atomic<bool> running_{false};
+  std::thread renderThread_;
+  std::mutex wakeMutex_;
+  std::condition_variable wakeCv_;
+
+  // Ring buffer for audio data
+  std::vector<float> ringBuffer_;
+  size_t writePos_ = 0;
+  size_t readPos_ = 0;
+  uint64_t writtenFrames_ = 0; // Into the ring, overwritten ones included
+  uint64_t readFrames_ = 0;    // Out of the ring or overwritten
+  mutable std::mutex bufferMutex_;
+
+  // Device clock: frames handed over (silence included) since start
+  std::atomic<uint64_t> startNs_{0};
+  std::atomic<uint64_t> deviceFrames_{0};
+
+  std::atomic<bool> primed_{false}; // Set once audio has been written
+  std::atomic<uint64_t> underrunCount_{0};
+  std::atomic<uint64_t> overrunCount_{0};
+  std::atomic<uint64_t> callbackCount_{0};
+  std::atomic<uint64_t> lateBlocks_{0};
+
+  Histogram playoutLatencyUs_;
+  Histogram arrivalLatencyUs_;
+  Histogram *callbackInterval_ = nullptr; // Owned by MetricsRegistry
+  Counter *wakeups_ = nullptr;            // Owned by MetricsRegistry
+};
+
+} // namespace WindowsAiMic
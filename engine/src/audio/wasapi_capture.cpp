@@ -1,13 +1,18 @@
 /**
  * WindowsAiMic - WASAPI Capture Implementation
  *
- * Event-driven WASAPI audio capture implementation.
+ * Event-driven (or timer-polled) WASAPI audio capture implementation.
  */
 
 #include "wasapi_capture.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <iostream>
+
+#include "../diagnostics/logger.h"
+#include "../diagnostics/metrics.h"
+#include "../diagnostics/tracer.h"
+#include "../platform/thread_utils.h"
 
 #ifdef _WIN32
 #include <Audioclient.h>
@@ -23,7 +28,13 @@ DEFINE_PROPERTYKEY(PKEY_Device_FriendlyName, 0xa45c254e, 0xdf1c, 0x4efd, 0x80,
 
 namespace WindowsAiMic {
 
-WasapiCapture::WasapiCapture() = default;
+WasapiCapture::WasapiCapture()
+    : callbackInterval_(&MetricsRegistry::instance().histogram(
+          "wam_device_callback_interval_us",
+          "Time between device event wake-ups", "device=\"capture\"")),
+      wakeups_(&MetricsRegistry::instance().counter(
+          "wam_audio_wakeups_total", "Audio thread wake-ups",
+          "thread=\"capture\"")) {}
 
 WasapiCapture::~WasapiCapture() {
   stop();
@@ -56,6 +67,10 @@ void WasapiCapture::cleanup() {
     CloseHandle(audioEvent_);
     audioEvent_ = nullptr;
   }
+  if (wakeTimer_) {
+    CloseHandle(wakeTimer_);
+    wakeTimer_ = nullptr;
+  }
 #endif
 }
 
@@ -73,8 +88,8 @@ bool WasapiCapture::initializeDevice(const std::wstring &deviceId) {
                         __uuidof(IMMDeviceEnumerator),
                         reinterpret_cast<void **>(&deviceEnumerator_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to create device enumerator: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to create device enumerator: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -88,8 +103,8 @@ bool WasapiCapture::initializeDevice(const std::wstring &deviceId) {
   }
 
   if (FAILED(hr)) {
-    std::cerr << "Failed to get audio device: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to get audio device: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -97,15 +112,16 @@ bool WasapiCapture::initializeDevice(const std::wstring &deviceId) {
   hr = device_->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
                          reinterpret_cast<void **>(&audioClient_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to activate audio client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to activate audio client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
   // Get mix format
   hr = audioClient_->GetMixFormat(&waveFormat_);
   if (FAILED(hr)) {
-    std::cerr << "Failed to get mix format: 0x" << std::hex << hr << std::endl;
+    WAM_LOG_ERROR("Failed to get mix format: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -113,43 +129,63 @@ bool WasapiCapture::initializeDevice(const std::wstring &deviceId) {
   channels_ = waveFormat_->nChannels;
   bitsPerSample_ = waveFormat_->wBitsPerSample;
 
-  std::cout << "Capture format: " << sampleRate_ << " Hz, " << channels_
-            << " channels, " << bitsPerSample_ << " bits" << std::endl;
+  WAM_LOG_INFO("Capture format: %d Hz, %d channels, %d bits", sampleRate_,
+               channels_, bitsPerSample_);
 
   // Create event for audio callbacks
   audioEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
   if (!audioEvent_) {
-    std::cerr << "Failed to create audio event" << std::endl;
+    WAM_LOG_ERROR("Failed to create audio event");
     return false;
   }
 
   // Initialize audio client in shared mode with event callback
   // Use a 20ms buffer for low latency
   REFERENCE_TIME bufferDuration = 200000; // 20ms in 100ns units
+  DWORD streamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+  if (wakeIntervalUs_ > 0.0f) {
+    // Polled: the buffer holds four intervals, so a late timer loses nothing
+    bufferDuration = std::max<REFERENCE_TIME>(
+        bufferDuration,
+        static_cast<REFERENCE_TIME>(wakeIntervalUs_ * 10.0f) * 4);
+    streamFlags = 0;
+    wakeTimer_ = CreateWaitableTimerExW(
+        nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION,
+        TIMER_ALL_ACCESS);
+    if (!wakeTimer_) {
+      // Before Windows 10 1803; coarser, but still one wake per interval
+      wakeTimer_ = CreateWaitableTimerW(nullptr, FALSE, nullptr);
+    }
+    if (!wakeTimer_) {
+      WAM_LOG_ERROR("Failed to create capture wake timer");
+      return false;
+    }
+  }
 
-  hr = audioClient_->Initialize(AUDCLNT_SHAREMODE_SHARED,
-                                AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+  hr = audioClient_->Initialize(AUDCLNT_SHAREMODE_SHARED, streamFlags,
                                 bufferDuration, 0, waveFormat_, nullptr);
   if (FAILED(hr)) {
-    std::cerr << "Failed to initialize audio client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to initialize audio client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
   // Set event handle
-  hr = audioClient_->SetEventHandle(audioEvent_);
-  if (FAILED(hr)) {
-    std::cerr << "Failed to set event handle: 0x" << std::hex << hr
-              << std::endl;
-    return false;
+  if (!wakeTimer_) {
+    hr = audioClient_->SetEventHandle(audioEvent_);
+    if (FAILED(hr)) {
+      WAM_LOG_ERROR("Failed to set event handle: 0x%08lx",
+                    static_cast<unsigned long>(hr));
+      return false;
+    }
   }
 
   // Get capture client
   hr = audioClient_->GetService(__uuidof(IAudioCaptureClient),
                                 reinterpret_cast<void **>(&captureClient_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to get capture client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to get capture client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -174,8 +210,8 @@ void WasapiCapture::start() {
 #ifdef _WIN32
   HRESULT hr = audioClient_->Start();
   if (FAILED(hr)) {
-    std::cerr << "Failed to start audio capture: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to start audio capture: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return;
   }
 #endif
@@ -213,26 +249,68 @@ void WasapiCapture::setCallback(AudioCallback callback) {
   callback_ = std::move(callback);
 }
 
+bool WasapiCapture::setWakeInterval(float intervalUs) {
+  if (capturing_.load() || intervalUs <= 0.0f) {
+    return false;
+  }
+  wakeIntervalUs_ = intervalUs;
+  return true;
+}
+
 void WasapiCapture::captureThread() {
+  Logger::instance().registerThread("WasapiCapture");
+  Tracer::instance().registerThread("WasapiCapture");
+  DenormalGuard denormals; // The engine callback runs the input resampler
+
 #ifdef _WIN32
   // Boost thread priority for real-time audio
   DWORD taskIndex = 0;
   HANDLE hTask = AvSetMmThreadCharacteristics(L"Pro Audio", &taskIndex);
   if (!hTask) {
-    std::cerr << "Warning: Failed to set thread characteristics" << std::endl;
+    WAM_LOG_WARNING("Failed to set thread characteristics");
+  }
+
+  // Device position expected for the next packet (0 = no packet yet)
+  UINT64 expectedPosition = 0;
+  bool havePosition = false;
+  auto lastWake = std::chrono::steady_clock::time_point{};
+
+  // Polling: a periodic timer, with the event still there for stop()
+  if (wakeTimer_) {
+    LARGE_INTEGER due;
+    due.QuadPart = -static_cast<LONGLONG>(wakeIntervalUs_ * 10.0f);
+    const LONG periodMs =
+        std::max(1L, std::lround(wakeIntervalUs_ / 1000.0f));
+    if (!SetWaitableTimer(wakeTimer_, &due, periodMs, nullptr, nullptr,
+                          FALSE)) {
+      WAM_LOG_ERROR("Failed to arm capture wake timer");
+    }
   }
+  const HANDLE waits[] = {audioEvent_, wakeTimer_};
+  const DWORD waitCount = wakeTimer_ ? 2 : 1;
 
   while (capturing_.load()) {
     // Wait for audio data
-    DWORD result = WaitForSingleObject(audioEvent_, 100);
+    DWORD result = WaitForMultipleObjects(waitCount, waits, FALSE, 100);
 
     if (!capturing_.load()) {
       break;
     }
 
-    if (result != WAIT_OBJECT_0) {
+    if (result >= WAIT_OBJECT_0 + waitCount) {
       continue;
     }
+    WAM_TRACE_SCOPE("CaptureDrain");
+
+    const auto wake = std::chrono::steady_clock::now();
+    if (lastWake.time_since_epoch().count() != 0) {
+      callbackInterval_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(wake -
+                                                                lastWake)
+              .count()));
+    }
+    lastWake = wake;
+    wakeups_->add();
 
     // Get captured data
     UINT32 packetLength = 0;
@@ -243,12 +321,28 @@ void WasapiCapture::captureThread() {
       UINT32 numFrames = 0;
       DWORD flags = 0;
 
-      hr = captureClient_->GetBuffer(&data, &numFrames, &flags, nullptr,
-                                     nullptr);
+      UINT64 devicePosition = 0;
+      hr = captureClient_->GetBuffer(&data, &numFrames, &flags,
+                                     &devicePosition, nullptr);
       if (FAILED(hr)) {
         break;
       }
 
+      // Capture gap: the device position skipped past the frames we were
+      // handed last time, or the engine flagged a discontinuity. The very
+      // first packet after Start() routinely carries the flag, so ignore it.
+      if (havePosition) {
+        if (devicePosition > expectedPosition) {
+          gapCount_.fetch_add(1, std::memory_order_relaxed);
+          gapFrames_.fetch_add(devicePosition - expectedPosition,
+                               std::memory_order_relaxed);
+        } else if (flags & AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY) {
+          gapCount_.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+      expectedPosition = devicePosition + numFrames;
+      havePosition = true;
+
       if (callback_ && numFrames > 0) {
         // Convert to float if needed
         if (waveFormat_->wFormatTag == WAVE_FORMAT_IEEE_FLOAT ||
@@ -315,6 +409,9 @@ void WasapiCapture::captureThread() {
     }
   }
 
+  if (wakeTimer_) {
+    CancelWaitableTimer(wakeTimer_);
+  }
   if (hTask) {
     AvRevertMmThreadCharacteristics(hTask);
   }
@@ -13,6 +13,8 @@
 #include <thread>
 #include <vector>
 
+#include "audio_device.h"
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <audioclient.h>
@@ -21,14 +23,18 @@
 
 namespace WindowsAiMic {
 
+class Counter;
+class Histogram;
+
 /**
  * WASAPI audio capture from input devices (microphones)
- * Uses event-driven shared mode for low latency
+ * Uses event-driven shared mode for low latency, or a waitable timer
+ * draining a deeper buffer when a wake interval is set
  */
-class WasapiCapture {
+class WasapiCapture : public CaptureDevice {
 public:
   WasapiCapture();
-  ~WasapiCapture();
+  ~WasapiCapture() override;
 
   // Non-copyable
   WasapiCapture(const WasapiCapture &) = delete;
@@ -39,49 +45,59 @@ public:
    * @param deviceId Device ID (empty for default device)
    * @return true on success
    */
-  bool initialize(const std::wstring &deviceId = L"");
+  bool initialize(const std::wstring &deviceId = L"") override;
 
   /**
    * Start capturing audio
    */
-  void start();
+  void start() override;
 
   /**
    * Stop capturing
    */
-  void stop();
+  void stop() override;
 
   /**
    * Check if capturing
    */
-  bool isCapturing() const { return capturing_.load(); }
+  bool isCapturing() const override { return capturing_.load(); }
 
   /**
    * Get sample rate of the capture device
    */
-  int getSampleRate() const { return sampleRate_; }
+  int getSampleRate() const override { return sampleRate_; }
 
   /**
    * Get number of channels
    */
-  int getChannels() const { return channels_; }
+  int getChannels() const override { return channels_; }
+
+  /**
+   * Number of capture gaps (device position discontinuities) so far
+   */
+  uint64_t getGapCount() const override { return gapCount_.load(); }
 
   /**
-   * Audio callback type
-   * Parameters: buffer, frames, sampleRate, channels
+   * Total frames skipped by capture gaps
    */
-  using AudioCallback = std::function<void(float *, size_t, int, int)>;
+  uint64_t getGapFrames() const override { return gapFrames_.load(); }
 
   /**
    * Set callback for captured audio
    */
-  void setCallback(AudioCallback callback);
+  void setCallback(AudioCallback callback) override;
+
+  /**
+   * Poll on a high-resolution timer every `intervalUs` (before initialize)
+   */
+  bool setWakeInterval(float intervalUs) override;
 
   /**
    * Enumerate available capture devices
    * @return Vector of (name, deviceId) pairs
    */
-  std::vector<std::pair<std::string, std::wstring>> enumerateDevices();
+  std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() override;
 
 private:
   void captureThread();
@@ -93,10 +109,13 @@ private:
   IMMDevice *device_ = nullptr;
   IAudioClient *audioClient_ = nullptr;
   IAudioCaptureClient *captureClient_ = nullptr;
-  HANDLE audioEvent_ = nullptr;
+  HANDLE audioEvent_ = nullptr; // Device event, or stop() only when polling
+  HANDLE wakeTimer_ = nullptr;  // Polling mode
   WAVEFORMATEX *waveFormat_ = nullptr;
 #endif
 
+  float wakeIntervalUs_ = 0.0f; // 0 = event-driven
+
   int sampleRate_ = 0;
   int channels_ = 0;
   int bitsPerSample_ = 0;
@@ -106,6 +125,13 @@ private:
   AudioCallback callback_;
 
   std::vector<float> conversionBuffer_;
+
+  // Gap detection (capture thread writes, any thread reads)
+  std::atomic<uint64_t> gapCount_{0};
+  std::atomic<uint64_t> gapFrames_{0};
+
+  Histogram *callbackInterval_ = nullptr; // Owned by MetricsRegistry
+  Counter *wakeups_ = nullptr;            // Owned by MetricsRegistry
 };
 
 } // namespace WindowsAiMic
@@ -6,8 +6,13 @@
 
 #include "wasapi_render.h"
 #include <algorithm>
+#include <chrono>
 #include <cmath>
-#include <iostream>
+
+#include "../diagnostics/logger.h"
+#include "../diagnostics/metrics.h"
+#include "../diagnostics/tracer.h"
+#include "../platform/thread_utils.h"
 
 #ifdef _WIN32
 #include <Audioclient.h>
@@ -24,8 +29,13 @@ DEFINE_PROPERTYKEY(PKEY_Device_FriendlyName, 0xa45c254e, 0xdf1c, 0x4efd, 0x80,
 namespace WindowsAiMic {
 
 WasapiRender::WasapiRender()
-    : ringBuffer_(48000 * 2) // 2 seconds at 48kHz mono
-{}
+    : ringBuffer_(48000 * 2), // 2 seconds at 48kHz mono
+      callbackInterval_(&MetricsRegistry::instance().histogram(
+          "wam_device_callback_interval_us",
+          "Time between device event wake-ups", "device=\"render\"")),
+      wakeups_(&MetricsRegistry::instance().counter(
+          "wam_audio_wakeups_total", "Audio thread wake-ups",
+          "thread=\"render\"")) {}
 
 WasapiRender::~WasapiRender() {
   stop();
@@ -76,8 +86,8 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
                         __uuidof(IMMDeviceEnumerator),
                         reinterpret_cast<void **>(&deviceEnumerator_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to create device enumerator: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to create device enumerator: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -89,8 +99,8 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
     hr = deviceEnumerator_->GetDevice(deviceId.c_str(), &device_);
   }
   if (FAILED(hr)) {
-    std::cerr << "Failed to get audio device: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to get audio device: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -98,15 +108,16 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
   hr = device_->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr,
                          reinterpret_cast<void **>(&audioClient_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to activate audio client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to activate audio client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
   // Get mix format
   hr = audioClient_->GetMixFormat(&waveFormat_);
   if (FAILED(hr)) {
-    std::cerr << "Failed to get mix format: 0x" << std::hex << hr << std::endl;
+    WAM_LOG_ERROR("Failed to get mix format: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -114,40 +125,51 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
   channels_ = waveFormat_->nChannels;
   bitsPerSample_ = waveFormat_->wBitsPerSample;
 
-  std::cout << "Render format: " << sampleRate_ << " Hz, " << channels_
-            << " channels, " << bitsPerSample_ << " bits" << std::endl;
+  WAM_LOG_INFO("Render format: %d Hz, %d channels, %d bits", sampleRate_,
+               channels_, bitsPerSample_);
 
   // Create event for audio callbacks
   audioEvent_ = CreateEvent(nullptr, FALSE, FALSE, nullptr);
   if (!audioEvent_) {
-    std::cerr << "Failed to create audio event" << std::endl;
+    WAM_LOG_ERROR("Failed to create audio event");
     return false;
   }
 
   // Initialize audio client in shared mode
   REFERENCE_TIME bufferDuration = 200000; // 20ms in 100ns units
+  DWORD streamFlags = AUDCLNT_STREAMFLAGS_EVENTCALLBACK;
+  if (fillIntervalUs_ > 0.0f) {
+    bufferDuration = std::max<REFERENCE_TIME>(
+        bufferDuration,
+        static_cast<REFERENCE_TIME>(fillIntervalUs_ * 10.0f) * 3);
+    streamFlags = 0;
+    fillFrames_ = static_cast<uint32_t>(
+        std::lround(fillIntervalUs_ * 1e-6f * static_cast<float>(sampleRate_)));
+  }
 
-  hr = audioClient_->Initialize(AUDCLNT_SHAREMODE_SHARED,
-                                AUDCLNT_STREAMFLAGS_EVENTCALLBACK,
+  hr = audioClient_->Initialize(AUDCLNT_SHAREMODE_SHARED, streamFlags,
                                 bufferDuration, 0, waveFormat_, nullptr);
   if (FAILED(hr)) {
-    std::cerr << "Failed to initialize audio client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to initialize audio client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
   // Set event handle
-  hr = audioClient_->SetEventHandle(audioEvent_);
-  if (FAILED(hr)) {
-    std::cerr << "Failed to set event handle: 0x" << std::hex << hr
-              << std::endl;
-    return false;
+  if (streamFlags & AUDCLNT_STREAMFLAGS_EVENTCALLBACK) {
+    hr = audioClient_->SetEventHandle(audioEvent_);
+    if (FAILED(hr)) {
+      WAM_LOG_ERROR("Failed to set event handle: 0x%08lx",
+                    static_cast<unsigned long>(hr));
+      return false;
+    }
   }
 
   // Get buffer size
   hr = audioClient_->GetBufferSize(&bufferFrameCount_);
   if (FAILED(hr)) {
-    std::cerr << "Failed to get buffer size: 0x" << std::hex << hr << std::endl;
+    WAM_LOG_ERROR("Failed to get buffer size: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -155,8 +177,8 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
   hr = audioClient_->GetService(__uuidof(IAudioRenderClient),
                                 reinterpret_cast<void **>(&renderClient_));
   if (FAILED(hr)) {
-    std::cerr << "Failed to get render client: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to get render client: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return false;
   }
 
@@ -166,6 +188,7 @@ bool WasapiRender::initializeDevice(const std::wstring &deviceId) {
   std::lock_guard<std::mutex> lock(bufferMutex_);
   writePos_ = 0;
   readPos_ = 0;
+  primed_ = false;
 
   return true;
 #else
@@ -181,16 +204,28 @@ void WasapiRender::start() {
 #ifdef _WIN32
   HRESULT hr = audioClient_->Start();
   if (FAILED(hr)) {
-    std::cerr << "Failed to start audio render: 0x" << std::hex << hr
-              << std::endl;
+    WAM_LOG_ERROR("Failed to start audio render: 0x%08lx",
+                  static_cast<unsigned long>(hr));
     return;
   }
 #endif
 
   running_ = true;
+  if (fillIntervalUs_ > 0.0f) {
+    filled_ = false;
+    return;
+  }
   renderThread_ = std::thread(&WasapiRender::renderThread, this);
 }
 
+bool WasapiRender::setFillOnWrite(float writeIntervalUs) {
+  if (running_.load() || writeIntervalUs <= 0.0f) {
+    return false;
+  }
+  fillIntervalUs_ = writeIntervalUs;
+  return true;
+}
+
 void WasapiRender::stop() {
   if (!running_.load()) {
     return;
@@ -218,35 +253,70 @@ void WasapiRender::stop() {
 #endif
 }
 
+size_t WasapiRender::getQueuedFrames() const {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  return (writePos_ + ringBuffer_.size() - readPos_) % ringBuffer_.size();
+}
+
+size_t WasapiRender::discardQueued(size_t frames) {
+  std::lock_guard<std::mutex> lock(bufferMutex_);
+  const size_t queued =
+      (writePos_ + ringBuffer_.size() - readPos_) % ringBuffer_.size();
+  const size_t dropped = std::min(frames, queued);
+  readPos_ = (readPos_ + dropped) % ringBuffer_.size();
+  return dropped;
+}
+
 void WasapiRender::write(const float *buffer, size_t frames) {
   if (!initialized_.load()) {
     return;
   }
 
-  std::lock_guard<std::mutex> lock(bufferMutex_);
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
 
-  for (size_t i = 0; i < frames; ++i) {
-    ringBuffer_[writePos_] = buffer[i];
-    writePos_ = (writePos_ + 1) % ringBuffer_.size();
+    bool overran = false;
+    for (size_t i = 0; i < frames; ++i) {
+      ringBuffer_[writePos_] = buffer[i];
+      writePos_ = (writePos_ + 1) % ringBuffer_.size();
 
-    // Overwrite oldest data if buffer full
-    if (writePos_ == readPos_) {
-      readPos_ = (readPos_ + 1) % ringBuffer_.size();
+      // Overwrite oldest data if buffer full
+      if (writePos_ == readPos_) {
+        readPos_ = (readPos_ + 1) % ringBuffer_.size();
+        overran = true;
+      }
+    }
+
+    if (overran) {
+      overrunCount_.fetch_add(1, std::memory_order_relaxed);
     }
+    primed_.store(true, std::memory_order_relaxed);
   }
 
+  if (fillIntervalUs_ > 0.0f) {
+    if (running_.load(std::memory_order_relaxed)) {
+      fillDevice();
+    }
+    return;
+  }
   bufferCv_.notify_one();
 }
 
 void WasapiRender::renderThread() {
+  Logger::instance().registerThread("WasapiRender");
+  Tracer::instance().registerThread("WasapiRender");
+  DenormalGuard denormals; // Sample conversion for the device runs here
+
 #ifdef _WIN32
   // Boost thread priority for real-time audio
   DWORD taskIndex = 0;
   HANDLE hTask = AvSetMmThreadCharacteristics(L"Pro Audio", &taskIndex);
   if (!hTask) {
-    std::cerr << "Warning: Failed to set thread characteristics" << std::endl;
+    WAM_LOG_WARNING("Failed to set thread characteristics");
   }
 
+  auto lastWake = std::chrono::steady_clock::time_point{};
+
   while (running_.load()) {
     // Wait for audio buffer ready
     DWORD result = WaitForSingleObject(audioEvent_, 100);
@@ -258,52 +328,64 @@ void WasapiRender::renderThread() {
     if (result != WAIT_OBJECT_0) {
       continue;
     }
-
-    // Get buffer padding (how much is still queued)
-    UINT32 padding = 0;
-    HRESULT hr = audioClient_->GetCurrentPadding(&padding);
-    if (FAILED(hr)) {
-      continue;
+    WAM_TRACE_SCOPE("RenderFill");
+
+    const auto wake = std::chrono::steady_clock::now();
+    if (lastWake.time_since_epoch().count() != 0) {
+      callbackInterval_->record(static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::microseconds>(wake -
+                                                                lastWake)
+              .count()));
     }
+    lastWake = wake;
+    wakeups_->add();
 
-    // Calculate available space
-    UINT32 framesAvailable = bufferFrameCount_ - padding;
-    if (framesAvailable == 0) {
-      continue;
-    }
-
-    // Get render buffer
-    BYTE *data = nullptr;
-    hr = renderClient_->GetBuffer(framesAvailable, &data);
-    if (FAILED(hr)) {
-      continue;
-    }
-
-    // Read from ring buffer and convert/copy to render buffer
-    size_t framesRead = 0;
-    float *floatData = reinterpret_cast<float *>(data);
+    fillDevice();
+  }
 
-    {
-      std::lock_guard<std::mutex> lock(bufferMutex_);
+  if (hTask) {
+    AvRevertMmThreadCharacteristics(hTask);
+  }
+#endif
+}
 
-      while (framesRead < framesAvailable && readPos_ != writePos_) {
-        float sample = ringBuffer_[readPos_];
-        readPos_ = (readPos_ + 1) % ringBuffer_.size();
+void WasapiRender::fillDevice() {
+#ifdef _WIN32
+  // Get buffer padding (how much is still queued)
+  UINT32 padding = 0;
+  HRESULT hr = audioClient_->GetCurrentPadding(&padding);
+  if (FAILED(hr)) {
+    return;
+  }
 
-        // If output is stereo, duplicate mono to both channels
-        if (channels_ == 2) {
-          floatData[framesRead * 2] = sample;
-          floatData[framesRead * 2 + 1] = sample;
-        } else {
-          floatData[framesRead] = sample;
-        }
+  // Calculate available space
+  UINT32 framesAvailable = bufferFrameCount_ - padding;
+  if (framesAvailable == 0) {
+    return;
+  }
 
-        ++framesRead;
-      }
+  // Fill-on-write: a device that ran dry since the last write played
+  // silence. One write of silence goes ahead of the audio, so the next
+  // write has slack to be late.
+  const bool onWrite = fillIntervalUs_ > 0.0f;
+  size_t framesSilent = 0;
+  if (onWrite && padding == 0) {
+    if (filled_) {
+      underrunCount_.fetch_add(1, std::memory_order_relaxed);
     }
+    framesSilent = std::min<size_t>(fillFrames_, framesAvailable);
+  }
 
-    // Fill remaining with silence if needed
-    for (size_t i = framesRead; i < framesAvailable; ++i) {
+  // Get render buffer
+  BYTE *data = nullptr;
+  hr = renderClient_->GetBuffer(framesAvailable, &data);
+  if (FAILED(hr)) {
+    return;
+  }
+
+  float *floatData = reinterpret_cast<float *>(data);
+  auto silence = [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
       if (channels_ == 2) {
         floatData[i * 2] = 0.0f;
         floatData[i * 2 + 1] = 0.0f;
@@ -311,17 +393,52 @@ void WasapiRender::renderThread() {
         floatData[i] = 0.0f;
       }
     }
+  };
+  silence(0, framesSilent);
 
-    // Release buffer
-    hr = renderClient_->ReleaseBuffer(framesAvailable, 0);
-    if (FAILED(hr)) {
-      std::cerr << "Failed to release buffer: 0x" << std::hex << hr
-                << std::endl;
+  // Read from ring buffer and convert/copy to render buffer
+  size_t framesRead = framesSilent;
+  {
+    std::lock_guard<std::mutex> lock(bufferMutex_);
+
+    while (framesRead < framesAvailable && readPos_ != writePos_) {
+      float sample = ringBuffer_[readPos_];
+      readPos_ = (readPos_ + 1) % ringBuffer_.size();
+
+      // If output is stereo, duplicate mono to both channels
+      if (channels_ == 2) {
+        floatData[framesRead * 2] = sample;
+        floatData[framesRead * 2 + 1] = sample;
+      } else {
+        floatData[framesRead] = sample;
+      }
+
+      ++framesRead;
     }
   }
 
-  if (hTask) {
-    AvRevertMmThreadCharacteristics(hTask);
+  UINT32 framesWritten = framesAvailable;
+  if (onWrite) {
+    // Only what there is: the device stays as deep as the writes keep it
+    framesWritten = static_cast<UINT32>(framesRead);
+    filled_ = filled_ || framesRead > framesSilent;
+  } else {
+    // Running dry after audio has started flowing is an underrun
+    if (framesRead < framesAvailable &&
+        primed_.load(std::memory_order_relaxed)) {
+      underrunCount_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Fill remaining with silence if needed
+    silence(framesRead, framesAvailable);
+  }
+
+  // Release buffer
+  hr = renderClient_->ReleaseBuffer(framesWritten, 0);
+  if (FAILED(hr)) {
+    WAM_LOG_EVERY_MS(LogLevel::Error, 1000,
+                     "Failed to release buffer: 0x%08lx",
+                     static_cast<unsigned long>(hr));
   }
 #endif
 }
@@ -13,6 +13,8 @@
 #include <thread>
 #include <vector>
 
+#include "audio_device.h"
+
 #ifdef _WIN32
 #include <Windows.h>
 #include <audioclient.h>
@@ -22,13 +24,16 @@
 
 namespace WindowsAiMic {
 
+class Counter;
+class Histogram;
+
 /**
  * WASAPI audio render to output devices (Virtual Speaker)
  */
-class WasapiRender {
+class WasapiRender : public RenderDevice {
 public:
   WasapiRender();
-  ~WasapiRender();
+  ~WasapiRender() override;
 
   // Non-copyable
   WasapiRender(const WasapiRender &) = delete;
@@ -39,48 +44,80 @@ public:
    * @param deviceId Device ID (should be the Virtual Speaker device)
    * @return true on success
    */
-  bool initialize(const std::wstring &deviceId);
+  bool initialize(const std::wstring &deviceId) override;
 
   /**
    * Start rendering audio
    */
-  void start();
+  void start() override;
 
   /**
    * Stop rendering
    */
-  void stop();
+  void stop() override;
 
   /**
    * Check if ready to write
    */
-  bool isReady() const { return initialized_.load(); }
+  bool isReady() const override { return initialized_.load(); }
 
   /**
    * Write audio data
    * @param buffer Audio data (float32)
    * @param frames Number of frames
    */
-  void write(const float *buffer, size_t frames);
+  void write(const float *buffer, size_t frames) override;
+
+  /**
+   * Fill the device from write() instead of a render thread; the device
+   * buffer holds three writes (before initialize)
+   */
+  bool setFillOnWrite(float writeIntervalUs) override;
+
+  /**
+   * Frames queued in the ring buffer and not yet handed to the device
+   */
+  size_t getQueuedFrames() const override;
+
+  /**
+   * Drop up to `frames` of the oldest audio in the ring buffer
+   */
+  size_t discardQueued(size_t frames) override;
+
+  /**
+   * Number of periods where the device ran dry after being primed
+   */
+  uint64_t getUnderrunCount() const override {
+    return underrunCount_.load();
+  }
+
+  /**
+   * Number of writes that overwrote unplayed audio
+   */
+  uint64_t getOverrunCount() const override {
+    return overrunCount_.load();
+  }
 
   /**
    * Get sample rate of the render device
    */
-  int getSampleRate() const { return sampleRate_; }
+  int getSampleRate() const override { return sampleRate_; }
 
   /**
    * Get number of channels
    */
-  int getChannels() const { return channels_; }
+  int getChannels() const override { return channels_; }
 
   /**
    * Enumerate available render devices
    * @return Vector of (name, deviceId) pairs
    */
-  std::vector<std::pair<std::string, std::wstring>> enumerateDevices();
+  std::vector<std::pair<std::string, std::wstring>>
+  enumerateDevices() override;
 
 private:
   void renderThread();
+  void fillDevice();
   bool initializeDevice(const std::wstring &deviceId);
   void cleanup();
 
@@ -94,6 +131,11 @@ private:
   UINT32 bufferFrameCount_ = 0;
 #endif
 
+  // Fill-on-write mode (0 = render thread on the device event)
+  float fillIntervalUs_ = 0.0f;
+  uint32_t fillFrames_ = 0; // One write at the device rate
+  bool filled_ = false;     // The device has had audio since start
+
   int sampleRate_ = 0;
   int channels_ = 0;
   int bitsPerSample_ = 0;
@@ -106,8 +148,16 @@ private:
   std::vector<float> ringBuffer_;
   size_t writePos_ = 0;
   size_t readPos_ = 0;
-  std::mutex bufferMutex_;
+  mutable std::mutex bufferMutex_;
   std::condition_variable bufferCv_;
+
+  // Xrun statistics
+  std::atomic<bool> primed_{false}; // Set once audio has been written
+  std::atomic<uint64_t> underrunCount_{0};
+  std::atomic<uint64_t> overrunCount_{0};
+
+  Histogram *callbackInterval_ = nullptr; // Owned by MetricsRegistry
+  Counter *wakeups_ = nullptr;            // Owned by MetricsRegistry
 };
 
 } // namespace WindowsAiMic
@@ -0,0 +1,137 @@
+/**
+ * WindowsAiMic - WAV File Implementation
+ */
+
+#include "wav_file.h"
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+
+namespace WindowsAiMic {
+
+namespace {
+
+void writeU32(std::ofstream &file, uint32_t value) {
+  const char bytes[4] = {static_cast<char>(value & 0xFF),
+                         static_cast<char>((value >> 8) & 0xFF),
+                         static_cast<char>((value >> 16) & 0xFF),
+                         static_cast<char>((value >> 24) & 0xFF)};
+  file.write(bytes, 4);
+}
+
+void writeU16(std::ofstream &file, uint16_t value) {
+  const char bytes[2] = {static_cast<char>(value & 0xFF),
+                         static_cast<char>((value >> 8) & 0xFF)};
+  file.write(bytes, 2);
+}
+
+uint32_t readU32(const char *bytes) {
+  const auto *b = reinterpret_cast<const uint8_t *>(bytes);
+  return static_cast<uint32_t>(b[0]) | (static_cast<uint32_t>(b[1]) << 8) |
+         (static_cast<uint32_t>(b[2]) << 16) |
+         (static_cast<uint32_t>(b[3]) << 24);
+}
+
+uint16_t readU16(const char *bytes) {
+  const auto *b = reinterpret_cast<const uint8_t *>(bytes);
+  return static_cast<uint16_t>(b[0] | (b[1] << 8));
+}
+
+} // namespace
+
+bool writeWavFloat32(const std::string &path, const float *samples,
+                     size_t frames, int sampleRate, int channels) {
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return false;
+  }
+
+  const uint16_t formatFloat = 3; // WAVE_FORMAT_IEEE_FLOAT
+  const uint16_t bitsPerSample = 32;
+  const uint16_t blockAlign =
+      static_cast<uint16_t>(channels * bitsPerSample / 8);
+  const uint32_t dataBytes =
+      static_cast<uint32_t>(frames * static_cast<size_t>(blockAlign));
+
+  // RIFF header
+  file.write("RIFF", 4);
+  writeU32(file, 36 + dataBytes);
+  file.write("WAVE", 4);
+
+  // Format chunk
+  file.write("fmt ", 4);
+  writeU32(file, 16);
+  writeU16(file, formatFloat);
+  writeU16(file, static_cast<uint16_t>(channels));
+  writeU32(file, static_cast<uint32_t>(sampleRate));
+  writeU32(file, static_cast<uint32_t>(sampleRate) * blockAlign);
+  writeU16(file, blockAlign);
+  writeU16(file, bitsPerSample);
+
+  // Data chunk (little-endian float32, matching x86/x64 memory layout)
+  file.write("data", 4);
+  writeU32(file, dataBytes);
+  file.write(reinterpret_cast<const char *>(samples), dataBytes);
+
+  return file.good();
+}
+
+bool readWav(const std::string &path, std::vector<float> &samples,
+             int &sampleRate, int &channels) {
+  std::ifstream file(path, std::ios::binary);
+  char header[12];
+  if (!file.read(header, sizeof(header)) ||
+      std::memcmp(header, "RIFF", 4) != 0 ||
+      std::memcmp(header + 8, "WAVE", 4) != 0) {
+    return false;
+  }
+
+  uint16_t format = 0;
+  uint16_t bitsPerSample = 0;
+  channels = 0;
+  sampleRate = 0;
+
+  // Walk the chunks; "fmt " must precede "data"
+  char chunk[8];
+  while (file.read(chunk, sizeof(chunk))) {
+    const uint32_t size = readU32(chunk + 4);
+    if (std::memcmp(chunk, "fmt ", 4) == 0) {
+      char fmt[16];
+      if (size < sizeof(fmt) || !file.read(fmt, sizeof(fmt))) {
+        return false;
+      }
+      format = readU16(fmt);
+      channels = readU16(fmt + 2);
+      sampleRate = static_cast<int>(readU32(fmt + 4));
+      bitsPerSample = readU16(fmt + 14);
+      file.seekg(size - sizeof(fmt) + (size & 1), std::ios::cur);
+    } else if (std::memcmp(chunk, "data", 4) == 0) {
+      const bool isFloat = format == 3 && bitsPerSample == 32;
+      const bool isPcm16 = format == 1 && bitsPerSample == 16;
+      if (channels <= 0 || (!isFloat && !isPcm16)) {
+        return false;
+      }
+      std::vector<char> data(size);
+      if (!file.read(data.data(), static_cast<std::streamsize>(size))) {
+        return false;
+      }
+      if (isFloat) {
+        samples.resize(size / sizeof(float));
+        std::memcpy(samples.data(), data.data(),
+                    samples.size() * sizeof(float));
+      } else {
+        samples.resize(size / 2);
+        for (size_t i = 0; i < samples.size(); ++i) {
+          const auto value = static_cast<int16_t>(readU16(&data[i * 2]));
+          samples[i] = static_cast<float>(value) / 32768.0f;
+        }
+      }
+      return true;
+    } else {
+      file.seekg(size + (size & 1), std::ios::cur);
+    }
+  }
+  return false;
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,39 @@
+/**
+ * WindowsAiMic - WAV File Header
+ *
+ * Minimal RIFF/WAVE reader and writer for diagnostic audio dumps and
+ * test fixtures.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Write interleaved float32 samples as an IEEE-float WAV file
+ * @param path Destination file path
+ * @param samples Interleaved sample data
+ * @param frames Number of frames (samples per channel)
+ * @param sampleRate Sample rate in Hz
+ * @param channels Number of channels
+ * @return true on success
+ */
+bool writeWavFloat32(const std::string &path, const float *samples,
+                     size_t frames, int sampleRate, int channels = 1);
+
+/**
+ * Read an IEEE-float (32-bit) or PCM (16-bit) WAV file
+ * @param path Source file path
+ * @param samples Receives interleaved samples as float in [-1, 1]
+ * @param sampleRate Receives the sample rate in Hz
+ * @param channels Receives the number of channels
+ * @return false if the file is missing, truncated or in another format
+ */
+bool readWav(const std::string &path, std::vector<float> &samples,
+             int &sampleRate, int &channels);
+
+} // namespace WindowsAiMic
@@ -3,19 +3,45 @@
  */
 
 #include "config_manager.h"
+#include "config_schema.h"
+#include "../diagnostics/logger.h"
+
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
-#include <iostream>
 #include <sstream>
+#include <system_error>
 
-// Simple JSON handling without external dependency
-// In production, use nlohmann/json
 namespace {
-std::string trim(const std::string &str) {
-  size_t start = str.find_first_not_of(" \t\n\r");
-  size_t end = str.find_last_not_of(" \t\n\r");
-  if (start == std::string::npos)
-    return "";
-  return str.substr(start, end - start + 1);
+
+// Write to a sibling temp file, then rename over the target so a crash or
+// power cut mid-write never leaves a truncated config behind
+bool writeAtomically(const std::string &path, const std::string &content) {
+  const std::string tempPath = path + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      WAM_LOG_ERROR("Could not open config file for writing: %s",
+                    tempPath.c_str());
+      return false;
+    }
+    file.write(content.data(), static_cast<std::streamsize>(content.size()));
+    file.flush();
+    if (!file) {
+      WAM_LOG_ERROR("Failed to write config file: %s", tempPath.c_str());
+      return false;
+    }
+  }
+
+  std::error_code error;
+  std::filesystem::rename(tempPath, path, error);
+  if (error) {
+    WAM_LOG_ERROR("Failed to replace config file %s: %s", path.c_str(),
+                  error.message().c_str());
+    std::filesystem::remove(tempPath, error);
+    return false;
+  }
+  return true;
 }
 } // namespace
 
@@ -23,6 +49,8 @@ namespace WindowsAiMic {
 
 ConfigManager::ConfigManager() { loadDefaults(); }
 
+ConfigManager::~ConfigManager() { stopPersistThread(); }
+
 void ConfigManager::loadDefaults() {
   std::lock_guard<std::mutex> lock(mutex_);
 
@@ -44,6 +72,7 @@ void ConfigManager::loadDefaults() {
   config_.expander.attack = 5.0f;
   config_.expander.release = 100.0f;
   config_.expander.hysteresis = 3.0f;
+  config_.expander.lookahead = 0.0f;
 
   // Default compressor
   config_.compressor.enabled = true;
@@ -53,6 +82,7 @@ void ConfigManager::loadDefaults() {
   config_.compressor.attack = 10.0f;
   config_.compressor.release = 100.0f;
   config_.compressor.makeupGain = 6.0f;
+  config_.compressor.lookahead = 0.0f;
 
   // Default limiter
   config_.limiter.enabled = true;
@@ -69,120 +99,82 @@ void ConfigManager::loadDefaults() {
   config_.equalizer.deEsser = {6000.0f, -20.0f};
   config_.equalizer.deEsserEnabled = false;
 
+  // Default diagnostics
+  config_.diagnostics.flightRecorder = true;
+  config_.diagnostics.recorderSeconds = 10.0f;
+  config_.diagnostics.dumpDirectory = "diagnostics";
+  config_.diagnostics.tracing = false;
+  config_.diagnostics.logLevel = "info";
+  config_.diagnostics.logFile.clear();
+
+  // Default audio export
+  config_.audioExport.enabled = true;
+  config_.audioExport.bufferSeconds = 2.0f;
+
   config_.activePreset = "podcast";
 }
 
 bool ConfigManager::load(const std::string &path) {
-  std::ifstream file(path);
+  std::ifstream file(path, std::ios::binary);
   if (!file.is_open()) {
-    std::cerr << "Could not open config file: " << path << std::endl;
+    WAM_LOG_ERROR("Could not open config file: %s", path.c_str());
     return false;
   }
 
-  configPath_ = path;
-
   // Read entire file
   std::stringstream buffer;
   buffer << file.rdbuf();
-  std::string content = buffer.str();
-
-  // Very basic JSON parsing - in production use nlohmann/json
-  // For now, just load defaults and return true to indicate file exists
-  std::cout << "Config file found: " << path << std::endl;
-  std::cout << "Using default configuration (full JSON parsing requires "
-               "nlohmann/json)"
-            << std::endl;
+  const std::string content = buffer.str();
 
-  loadDefaults();
-  return true;
-}
+  // Watched even if invalid, so fixing the file takes effect live
+  configPath_ = path;
 
-bool ConfigManager::save(const std::string &path) const {
-  std::lock_guard<std::mutex> lock(mutex_);
+  // Missing fields keep their defaults
+  Config config;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config = config_;
+  }
+  const ConfigParseResult result = parseConfig(content, config);
 
-  std::ofstream file(path);
-  if (!file.is_open()) {
-    std::cerr << "Could not open config file for writing: " << path
-              << std::endl;
+  for (const std::string &warning : result.warnings) {
+    WAM_LOG_WARNING("Config %s: %s", path.c_str(), warning.c_str());
+  }
+  if (!result.ok) {
+    for (const std::string &error : result.errors) {
+      WAM_LOG_ERROR("Config %s: %s", path.c_str(), error.c_str());
+    }
+    // Keep the defaults, and never overwrite the file until it parses
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    fileRejected_ = true;
     return false;
   }
 
-  // Write JSON manually (in production use nlohmann/json)
-  file << "{\n";
-  file << "  \"version\": " << config_.version << ",\n";
-  file << "  \"aiModel\": \"" << config_.aiModel << "\",\n";
-  file << "  \"activePreset\": \"" << config_.activePreset << "\",\n";
-
-  // AI Settings
-  file << "  \"aiSettings\": {\n";
-  file << "    \"rnnoise\": { \"attenuation\": "
-       << config_.aiSettings.rnnoise.attenuation << " },\n";
-  file << "    \"deepfilter\": { \"strength\": "
-       << config_.aiSettings.deepfilter.strength << " }\n";
-  file << "  },\n";
-
-  // Expander
-  file << "  \"expander\": {\n";
-  file << "    \"enabled\": " << (config_.expander.enabled ? "true" : "false")
-       << ",\n";
-  file << "    \"threshold\": " << config_.expander.threshold << ",\n";
-  file << "    \"ratio\": " << config_.expander.ratio << ",\n";
-  file << "    \"attack\": " << config_.expander.attack << ",\n";
-  file << "    \"release\": " << config_.expander.release << ",\n";
-  file << "    \"hysteresis\": " << config_.expander.hysteresis << "\n";
-  file << "  },\n";
-
-  // Compressor
-  file << "  \"compressor\": {\n";
-  file << "    \"enabled\": " << (config_.compressor.enabled ? "true" : "false")
-       << ",\n";
-  file << "    \"threshold\": " << config_.compressor.threshold << ",\n";
-  file << "    \"ratio\": " << config_.compressor.ratio << ",\n";
-  file << "    \"knee\": " << config_.compressor.knee << ",\n";
-  file << "    \"attack\": " << config_.compressor.attack << ",\n";
-  file << "    \"release\": " << config_.compressor.release << ",\n";
-  file << "    \"makeupGain\": " << config_.compressor.makeupGain << "\n";
-  file << "  },\n";
-
-  // Limiter
-  file << "  \"limiter\": {\n";
-  file << "    \"enabled\": " << (config_.limiter.enabled ? "true" : "false")
-       << ",\n";
-  file << "    \"ceiling\": " << config_.limiter.ceiling << ",\n";
-  file << "    \"release\": " << config_.limiter.release << ",\n";
-  file << "    \"lookahead\": " << config_.limiter.lookahead << "\n";
-  file << "  },\n";
-
-  // Equalizer
-  file << "  \"equalizer\": {\n";
-  file << "    \"enabled\": " << (config_.equalizer.enabled ? "true" : "false")
-       << ",\n";
-  file << "    \"highPass\": { \"freq\": " << config_.equalizer.highPass.freq
-       << ", \"q\": " << config_.equalizer.highPass.q << " },\n";
-  file << "    \"lowShelf\": { \"freq\": " << config_.equalizer.lowShelf.freq
-       << ", \"gain\": " << config_.equalizer.lowShelf.gain << " },\n";
-  file << "    \"presence\": { \"freq\": " << config_.equalizer.presence.freq
-       << ", \"gain\": " << config_.equalizer.presence.gain
-       << ", \"q\": " << config_.equalizer.presence.q << " },\n";
-  file << "    \"highShelf\": { \"freq\": " << config_.equalizer.highShelf.freq
-       << ", \"gain\": " << config_.equalizer.highShelf.gain << " },\n";
-  file << "    \"deEsser\": { \"freq\": " << config_.equalizer.deEsser.freq
-       << ", \"threshold\": " << config_.equalizer.deEsser.threshold << " },\n";
-  file << "    \"deEsserEnabled\": "
-       << (config_.equalizer.deEsserEnabled ? "true" : "false") << "\n";
-  file << "  }\n";
-
-  file << "}\n";
-
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = std::move(config);
+  }
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    fileRejected_ = false;
+  }
+  WAM_LOG_INFO("Loaded config: %s", path.c_str());
   return true;
 }
 
+bool ConfigManager::save(const std::string &path) const {
+  return writeAtomically(path, serializeConfig(getConfig()));
+}
+
 Config ConfigManager::getConfig() const {
   std::lock_guard<std::mutex> lock(mutex_);
   return config_;
 }
 
 void ConfigManager::applyConfig(const Config &config) {
+  // Serialise appliers so the callback observes changes in the order they
+  // were made
+  std::lock_guard<std::mutex> applyLock(applyMutex_);
   {
     std::lock_guard<std::mutex> lock(mutex_);
     config_ = config;
@@ -192,14 +184,198 @@ void ConfigManager::applyConfig(const Config &config) {
     changeCallback_(config);
   }
 
-  // Auto-save
-  if (!configPath_.empty()) {
-    save(configPath_);
+  // Persisted later by the writer thread; no file I/O on this path
+  schedulePersist();
+}
+
+bool ConfigManager::reload(ConfigDiff &changes) {
+  changes = ConfigDiff{};
+  if (configPath_.empty()) {
+    return false;
+  }
+
+  std::ifstream file(configPath_, std::ios::binary);
+  if (!file.is_open()) {
+    WAM_LOG_WARNING("Config file not readable: %s", configPath_.c_str());
+    return false;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string content = buffer.str();
+
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    if (content == lastWritten_) {
+      return true; // Our own persistence write, nothing new
+    }
+  }
+
+  std::lock_guard<std::mutex> applyLock(applyMutex_);
+  const Config live = getConfig();
+  Config config = live;
+  const ConfigParseResult result = parseConfig(content, config);
+
+  for (const std::string &warning : result.warnings) {
+    WAM_LOG_WARNING("Config %s: %s", configPath_.c_str(), warning.c_str());
+  }
+  if (!result.ok) {
+    for (const std::string &error : result.errors) {
+      WAM_LOG_ERROR("Config %s: %s", configPath_.c_str(), error.c_str());
+    }
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    fileRejected_ = true;
+    return false;
+  }
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    fileRejected_ = false;
+  }
+
+  changes = diff(live, config);
+  if (changes.empty()) {
+    return true;
+  }
+
+  // Came from the file, so there is nothing to persist
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    config_ = config;
+  }
+  if (changeCallback_) {
+    changeCallback_(config);
   }
+  return true;
 }
 
 void ConfigManager::setChangeCallback(ConfigChangeCallback callback) {
   changeCallback_ = std::move(callback);
 }
 
+// ============================================================================
+// Background persistence
+// ============================================================================
+
+void ConfigManager::schedulePersist() {
+  if (configPath_.empty()) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(persistMutex_);
+  const auto now = PersistClock::now();
+  if (!dirty_) {
+    dirty_ = true;
+    firstChange_ = now;
+  }
+  lastChange_ = now;
+  ++changeGeneration_;
+
+  if (!persistRunning_) {
+    persistRunning_ = true;
+    persistThread_ = std::thread(&ConfigManager::persistThread, this);
+  }
+  persistCv_.notify_all();
+}
+
+void ConfigManager::flush() {
+  std::unique_lock<std::mutex> lock(persistMutex_);
+  if (!dirty_ && savedGeneration_ == changeGeneration_) {
+    return;
+  }
+
+  if (!persistRunning_) {
+    lock.unlock();
+    persistNow();
+    return;
+  }
+
+  const uint64_t target = changeGeneration_;
+  flushRequested_ = true;
+  persistCv_.notify_all();
+  persistCv_.wait(lock, [this, target] {
+    return savedGeneration_ >= target || !persistRunning_;
+  });
+}
+
+void ConfigManager::stopPersistThread() {
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    if (!persistRunning_) {
+      return;
+    }
+    persistRunning_ = false;
+  }
+  persistCv_.notify_all();
+
+  if (persistThread_.joinable()) {
+    persistThread_.join();
+  }
+
+  // Changes made while the writer was shutting down
+  persistNow();
+}
+
+bool ConfigManager::persistNow() {
+  uint64_t generation;
+  bool rejected;
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    if (!dirty_) {
+      return true;
+    }
+    dirty_ = false;
+    flushRequested_ = false;
+    generation = changeGeneration_;
+    rejected = fileRejected_;
+  }
+
+  // A file that failed to parse is the user's to fix, not ours to replace
+  bool ok = true;
+  if (!rejected) {
+    // Snapshot after clearing dirty_: a change racing with us re-marks it
+    const std::string content = serializeConfig(getConfig());
+    {
+      std::lock_guard<std::mutex> lock(persistMutex_);
+      lastWritten_ = content; // Lets reload() recognise our own write
+    }
+    ok = writeAtomically(configPath_, content);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(persistMutex_);
+    savedGeneration_ = std::max(savedGeneration_, generation);
+  }
+  persistCv_.notify_all();
+  return ok;
+}
+
+void ConfigManager::persistThread() {
+  Logger::instance().registerThread("ConfigWriter");
+
+  std::unique_lock<std::mutex> lock(persistMutex_);
+  while (persistRunning_) {
+    persistCv_.wait(lock, [this] { return dirty_ || !persistRunning_; });
+    if (!persistRunning_) {
+      break;
+    }
+
+    // Trailing-edge debounce: wait for a quiet period so a slider drag
+    // becomes one write, but never hold a change longer than the cap
+    while (persistRunning_ && !flushRequested_) {
+      const auto deadline = std::min(lastChange_ + PERSIST_DEBOUNCE,
+                                     firstChange_ + PERSIST_MAX_DELAY);
+      if (PersistClock::now() >= deadline) {
+        break;
+      }
+      persistCv_.wait_until(lock, deadline);
+    }
+    if (!persistRunning_) {
+      break; // stopPersistThread() writes what is left
+    }
+
+    lock.unlock();
+    persistNow();
+    lock.lock();
+  }
+}
+
 } // namespace WindowsAiMic
@@ -6,10 +6,15 @@
 
 #pragma once
 
+#include "config_schema.h"
 #include "config_types.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <string>
+#include <thread>
 
 namespace WindowsAiMic {
 
@@ -17,21 +22,27 @@ namespace WindowsAiMic {
  * Configuration manager
  *
  * Loads/saves configuration from JSON file and provides
- * thread-safe access to configuration values.
+ * thread-safe access to configuration values. Changes are written back
+ * by a background thread that coalesces bursts into a single write.
  */
 class ConfigManager {
 public:
   ConfigManager();
+  ~ConfigManager(); // Flushes pending changes
 
   /**
    * Load configuration from file
+   * The file is validated against the schema in config_schema.h: unknown
+   * keys are ignored, bad values keep their defaults or are clamped.
+   * An invalid file keeps every default but is still the config path:
+   * reload() picks it up once fixed, and it is not written until then.
    * @param path Path to JSON config file
-   * @return true on success
+   * @return false if the file is missing or not valid JSON
    */
   bool load(const std::string &path);
 
   /**
-   * Save configuration to file
+   * Save configuration to file now (temp file + rename)
    * @param path Path to JSON config file
    * @return true on success
    */
@@ -49,12 +60,28 @@ public:
 
   /**
    * Apply new configuration
+   * Does no file I/O; the change is persisted after PERSIST_DEBOUNCE.
    * @param config New configuration to apply
    */
   void applyConfig(const Config &config);
 
+  /**
+   * Re-read the config file after an external change
+   * The file is validated and diffed against the live config, which is
+   * left untouched if the file is rejected. Nothing is written back.
+   * @param changes Receives the fields that differ from the live config
+   * @return false if the file is unreadable or invalid
+   */
+  bool reload(ConfigDiff &changes);
+
+  /**
+   * Write any pending change now and wait for it (call before shutdown)
+   */
+  void flush();
+
   /**
    * Set callback for configuration changes
+   * Invoked in apply order; must not call applyConfig() itself.
    */
   using ConfigChangeCallback = std::function<void(const Config &)>;
   void setChangeCallback(ConfigChangeCallback callback);
@@ -64,11 +91,38 @@ public:
    */
   std::string getConfigPath() const { return configPath_; }
 
+  /** Quiet period after the last change before it is written */
+  static constexpr std::chrono::milliseconds PERSIST_DEBOUNCE{500};
+  /** Longest a continuous burst of changes can delay a write */
+  static constexpr std::chrono::milliseconds PERSIST_MAX_DELAY{5000};
+
 private:
+  using PersistClock = std::chrono::steady_clock;
+
+  void schedulePersist();
+  bool persistNow();
+  void persistThread();
+  void stopPersistThread();
+
   Config config_;
   std::string configPath_;
   mutable std::mutex mutex_;
+  std::mutex applyMutex_; // Orders applyConfig() + change callback
   ConfigChangeCallback changeCallback_;
+
+  // Background writer
+  std::mutex persistMutex_;
+  std::condition_variable persistCv_;
+  std::thread persistThread_;
+  bool persistRunning_ = false;
+  bool dirty_ = false;
+  bool flushRequested_ = false;
+  uint64_t changeGeneration_ = 0;
+  uint64_t savedGeneration_ = 0;
+  PersistClock::time_point firstChange_;
+  PersistClock::time_point lastChange_;
+  std::string lastWritten_; // Content of our most recent write
+  bool fileRejected_ = false; // The file on disk failed to parse
 };
 
 } // namespace WindowsAiMic
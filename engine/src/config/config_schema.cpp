@@ -0,0 +1,489 @@
+/**
+ * WindowsAiMic - Configuration Schema Implementation
+ */
+
+#include "config_schema.h"
+#include "json_reader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+
+namespace WindowsAiMic {
+
+namespace {
+
+const char *const AI_MODELS[] = {"rnnoise", "deepfilter", nullptr};
+const char *const LOG_LEVELS[] = {"debug", "info",  "warning",
+                                  "warn",  "error", "off", nullptr};
+const char *const POWER_MODES[] = {"latency", "efficiency", "auto", nullptr};
+
+constexpr float NO_MAX = 1e9f;
+
+#define WAM_FIELD(path, type, section, min, max, choices, member)              \
+  ConfigField {                                                                \
+    path, ConfigFieldType::type, ConfigSection::section, min, max, choices,    \
+        [](Config &c) -> void * { return &c.member; }                          \
+  }
+#define WAM_FLOAT(path, section, min, max, member)                             \
+  WAM_FIELD(path, Float, section, min, max, nullptr, member)
+#define WAM_BOOL(path, section, member)                                        \
+  WAM_FIELD(path, Bool, section, 0.0f, 1.0f, nullptr, member)
+#define WAM_STRING(path, section, choices, member)                             \
+  WAM_FIELD(path, String, section, 0.0f, 0.0f, choices, member)
+
+// Numeric ranges mirror the clamps in the DSP processors, so a value that
+// validates here is also one the processor will actually use
+const ConfigField FIELDS[] = {
+    WAM_FIELD("version", Int, General, 1.0f, NO_MAX, nullptr, version),
+
+    WAM_FIELD("devices.inputDevice", WideString, Devices, 0.0f, 0.0f, nullptr,
+              devices.inputDevice),
+    WAM_FIELD("devices.outputDevice", WideString, Devices, 0.0f, 0.0f,
+              nullptr, devices.outputDevice),
+
+    WAM_STRING("aiModel", AiModel, AI_MODELS, aiModel),
+    WAM_FLOAT("aiSettings.rnnoise.attenuation", RNNoise, -60.0f, 0.0f,
+              aiSettings.rnnoise.attenuation),
+    WAM_STRING("aiSettings.deepfilter.modelPath", DeepFilter, nullptr,
+               aiSettings.deepfilter.modelPath),
+    WAM_FLOAT("aiSettings.deepfilter.strength", DeepFilter, 0.0f, 1.0f,
+              aiSettings.deepfilter.strength),
+
+    WAM_BOOL("expander.enabled", Expander, expander.enabled),
+    WAM_FLOAT("expander.threshold", Expander, -60.0f, 0.0f,
+              expander.threshold),
+    WAM_FLOAT("expander.ratio", Expander, 1.0f, 10.0f, expander.ratio),
+    WAM_FLOAT("expander.attack", Expander, 0.1f, 100.0f, expander.attack),
+    WAM_FLOAT("expander.release", Expander, 10.0f, 1000.0f, expander.release),
+    WAM_FLOAT("expander.hysteresis", Expander, 0.0f, 10.0f,
+              expander.hysteresis),
+    WAM_FLOAT("expander.lookahead", Expander, 0.0f, 10.0f, expander.lookahead),
+
+    WAM_BOOL("compressor.enabled", Compressor, compressor.enabled),
+    WAM_FLOAT("compressor.threshold", Compressor, -40.0f, 0.0f,
+              compressor.threshold),
+    WAM_FLOAT("compressor.ratio", Compressor, 1.0f, 20.0f, compressor.ratio),
+    WAM_FLOAT("compressor.knee", Compressor, 0.0f, 12.0f, compressor.knee),
+    WAM_FLOAT("compressor.attack", Compressor, 0.1f, 100.0f,
+              compressor.attack),
+    WAM_FLOAT("compressor.release", Compressor, 10.0f, 1000.0f,
+              compressor.release),
+    WAM_FLOAT("compressor.makeupGain", Compressor, 0.0f, 24.0f,
+              compressor.makeupGain),
+    WAM_FLOAT("compressor.lookahead", Compressor, 0.0f, 10.0f,
+              compressor.lookahead),
+
+    WAM_BOOL("limiter.enabled", Limiter, limiter.enabled),
+    WAM_FLOAT("limiter.ceiling", Limiter, -6.0f, 0.0f, limiter.ceiling),
+    WAM_FLOAT("limiter.release", Limiter, 10.0f, 500.0f, limiter.release),
+    WAM_FLOAT("limiter.lookahead", Limiter, 0.0f, 10.0f, limiter.lookahead),
+
+    WAM_BOOL("equalizer.enabled", Equalizer, equalizer.enabled),
+    WAM_FLOAT("equalizer.highPass.freq", EqHighPass, 20.0f, 500.0f,
+              equalizer.highPass.freq),
+    WAM_FLOAT("equalizer.highPass.q", EqHighPass, 0.5f, 2.0f,
+              equalizer.highPass.q),
+    WAM_FLOAT("equalizer.lowShelf.freq", EqLowShelf, 80.0f, 300.0f,
+              equalizer.lowShelf.freq),
+    WAM_FLOAT("equalizer.lowShelf.gain", EqLowShelf, -12.0f, 12.0f,
+              equalizer.lowShelf.gain),
+    WAM_FLOAT("equalizer.presence.freq", EqPresence, 2000.0f, 6000.0f,
+              equalizer.presence.freq),
+    WAM_FLOAT("equalizer.presence.gain", EqPresence, -12.0f, 12.0f,
+              equalizer.presence.gain),
+    WAM_FLOAT("equalizer.presence.q", EqPresence, 0.5f, 4.0f,
+              equalizer.presence.q),
+    WAM_FLOAT("equalizer.highShelf.freq", EqHighShelf, 6000.0f, 16000.0f,
+              equalizer.highShelf.freq),
+    WAM_FLOAT("equalizer.highShelf.gain", EqHighShelf, -12.0f, 12.0f,
+              equalizer.highShelf.gain),
+    WAM_FLOAT("equalizer.deEsser.freq", EqDeEsser, 4000.0f, 10000.0f,
+              equalizer.deEsser.freq),
+    WAM_FLOAT("equalizer.deEsser.threshold", EqDeEsser, -40.0f, 0.0f,
+              equalizer.deEsser.threshold),
+    WAM_BOOL("equalizer.deEsserEnabled", EqDeEsser, equalizer.deEsserEnabled),
+
+    WAM_BOOL("diagnostics.flightRecorder", Diagnostics,
+             diagnostics.flightRecorder),
+    WAM_FLOAT("diagnostics.recorderSeconds", Diagnostics, 1.0f, 300.0f,
+              diagnostics.recorderSeconds),
+    WAM_STRING("diagnostics.dumpDirectory", Diagnostics, nullptr,
+               diagnostics.dumpDirectory),
+    WAM_BOOL("diagnostics.tracing", Diagnostics, diagnostics.tracing),
+    WAM_STRING("diagnostics.logLevel", Diagnostics, LOG_LEVELS,
+               diagnostics.logLevel),
+    WAM_STRING("diagnostics.logFile", Diagnostics, nullptr,
+               diagnostics.logFile),
+    WAM_BOOL("diagnostics.denormalCheck", Diagnostics,
+             diagnostics.denormalCheck),
+
+    WAM_BOOL("audioExport.enabled", AudioExport, audioExport.enabled),
+    WAM_FLOAT("audioExport.bufferSeconds", AudioExport, 0.1f, 60.0f,
+              audioExport.bufferSeconds),
+
+    WAM_BOOL("tuning.autoTune", Tuning, tuning.autoTune),
+    WAM_FLOAT("tuning.calibrationMs", Tuning, 50.0f, 2000.0f,
+              tuning.calibrationMs),
+    WAM_STRING("tuning.powerMode", Tuning, POWER_MODES, tuning.powerMode),
+
+    WAM_STRING("activePreset", General, nullptr, activePreset),
+};
+
+#undef WAM_STRING
+#undef WAM_BOOL
+#undef WAM_FLOAT
+#undef WAM_FIELD
+
+// ============================================================================
+// UTF-8 <-> wide strings (device IDs)
+// ============================================================================
+
+std::wstring utf8ToWide(std::string_view text) {
+  std::wstring out;
+  out.reserve(text.size());
+  for (size_t i = 0; i < text.size();) {
+    const auto lead = static_cast<unsigned char>(text[i]);
+    const size_t length = lead < 0x80   ? 1
+                          : lead < 0xE0 ? 2
+                          : lead < 0xF0 ? 3
+                                        : 4;
+    uint32_t codePoint = length == 1   ? lead
+                         : length == 2 ? lead & 0x1F
+                         : length == 3 ? lead & 0x0F
+                                       : lead & 0x07;
+    for (size_t k = 1; k < length && i + k < text.size(); ++k) {
+      codePoint = (codePoint << 6) |
+                  (static_cast<unsigned char>(text[i + k]) & 0x3F);
+    }
+    i += length;
+
+    if constexpr (sizeof(wchar_t) == 2) {
+      if (codePoint >= 0x10000) {
+        codePoint -= 0x10000;
+        out += static_cast<wchar_t>(0xD800 + (codePoint >> 10));
+        out += static_cast<wchar_t>(0xDC00 + (codePoint & 0x3FF));
+        continue;
+      }
+    }
+    out += static_cast<wchar_t>(codePoint);
+  }
+  return out;
+}
+
+std::string wideToUtf8(const std::wstring &text) {
+  std::string out;
+  out.reserve(text.size());
+  for (size_t i = 0; i < text.size(); ++i) {
+    uint32_t codePoint = static_cast<uint32_t>(text[i]);
+    if (sizeof(wchar_t) == 2 && codePoint >= 0xD800 && codePoint <= 0xDBFF &&
+        i + 1 < text.size()) {
+      const uint32_t low = static_cast<uint32_t>(text[++i]);
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    }
+
+    if (codePoint < 0x80) {
+      out += static_cast<char>(codePoint);
+    } else if (codePoint < 0x800) {
+      out += static_cast<char>(0xC0 | (codePoint >> 6));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint < 0x10000) {
+      out += static_cast<char>(0xE0 | (codePoint >> 12));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+      out += static_cast<char>(0xF0 | (codePoint >> 18));
+      out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+      out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+      out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+  }
+  return out;
+}
+
+// ============================================================================
+// Serialisation helpers
+// ============================================================================
+
+void appendEscaped(std::string &out, std::string_view text) {
+  out += '"';
+  for (const char c : text) {
+    switch (c) {
+    case '"':
+      out += "\\\"";
+      break;
+    case '\\':
+      out += "\\\\";
+      break;
+    case '\n':
+      out += "\\n";
+      break;
+    case '\r':
+      out += "\\r";
+      break;
+    case '\t':
+      out += "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20) {
+        char escape[8];
+        std::snprintf(escape, sizeof(escape), "\\u%04x",
+                      static_cast<unsigned>(c));
+        out += escape;
+      } else {
+        out += c;
+      }
+      break;
+    }
+  }
+  out += '"';
+}
+
+void appendValue(std::string &out, const ConfigField &field,
+                 const Config &config) {
+  void *value = field.locate(const_cast<Config &>(config));
+  char number[32];
+
+  switch (field.type) {
+  case ConfigFieldType::Int:
+    out += std::to_string(*static_cast<int *>(value));
+    break;
+  case ConfigFieldType::Bool:
+    out += *static_cast<bool *>(value) ? "true" : "false";
+    break;
+  case ConfigFieldType::Float: {
+    // Shortest representation that round-trips the float exactly
+    const auto result = std::to_chars(number, number + sizeof(number),
+                                      *static_cast<float *>(value));
+    out.append(number, result.ptr);
+    break;
+  }
+  case ConfigFieldType::String:
+    appendEscaped(out, *static_cast<std::string *>(value));
+    break;
+  case ConfigFieldType::WideString:
+    appendEscaped(out, wideToUtf8(*static_cast<std::wstring *>(value)));
+    break;
+  }
+}
+
+void appendIndent(std::string &out, size_t level) {
+  out.append(level * 2, ' ');
+}
+
+bool valuesEqual(const ConfigField &field, const Config &a, const Config &b) {
+  const void *x = field.locate(const_cast<Config &>(a));
+  const void *y = field.locate(const_cast<Config &>(b));
+
+  switch (field.type) {
+  case ConfigFieldType::Int:
+    return *static_cast<const int *>(x) == *static_cast<const int *>(y);
+  case ConfigFieldType::Bool:
+    return *static_cast<const bool *>(x) == *static_cast<const bool *>(y);
+  case ConfigFieldType::Float:
+    return *static_cast<const float *>(x) == *static_cast<const float *>(y);
+  case ConfigFieldType::String:
+    return *static_cast<const std::string *>(x) ==
+           *static_cast<const std::string *>(y);
+  case ConfigFieldType::WideString:
+    return *static_cast<const std::wstring *>(x) ==
+           *static_cast<const std::wstring *>(y);
+  }
+  return true;
+}
+
+} // namespace
+
+std::span<const ConfigField> configSchema() { return FIELDS; }
+
+const ConfigField *findConfigField(std::string_view path) {
+  for (const ConfigField &field : FIELDS) {
+    if (path == field.path) {
+      return &field;
+    }
+  }
+  return nullptr;
+}
+
+// ============================================================================
+// Parsing and validation
+// ============================================================================
+
+ConfigParseResult parseConfig(std::string_view json, Config &config) {
+  ConfigParseResult result;
+  Config parsed = config;
+  char message[256];
+
+  auto warn = [&](const char *format, std::string_view path) {
+    std::snprintf(message, sizeof(message), format,
+                  static_cast<int>(path.size()), path.data());
+    result.warnings.emplace_back(message);
+  };
+
+  JsonReader reader;
+  const bool syntaxOk = reader.parse(
+      json, [&](std::string_view path, const JsonValue &value) {
+        const ConfigField *field = findConfigField(path);
+        if (!field) {
+          warn("unknown key '%.*s' ignored", path);
+          return;
+        }
+
+        void *target = field->locate(parsed);
+        switch (field->type) {
+        case ConfigFieldType::Bool:
+          if (value.type != JsonType::Bool) {
+            warn("'%.*s' must be true or false", path);
+            return;
+          }
+          *static_cast<bool *>(target) = value.boolean;
+          return;
+
+        case ConfigFieldType::Int:
+        case ConfigFieldType::Float: {
+          if (value.type != JsonType::Number) {
+            warn("'%.*s' must be a number", path);
+            return;
+          }
+          double number = value.number;
+          if (field->type == ConfigFieldType::Int &&
+              number != std::floor(number)) {
+            warn("'%.*s' must be an integer", path);
+            return;
+          }
+          if (number < field->min || number > field->max) {
+            warn("'%.*s' out of range, clamped", path);
+            number = std::clamp(number, static_cast<double>(field->min),
+                                static_cast<double>(field->max));
+          }
+          if (field->type == ConfigFieldType::Int) {
+            *static_cast<int *>(target) =
+                static_cast<int>(std::min(number, double{INT_MAX}));
+          } else {
+            *static_cast<float *>(target) = static_cast<float>(number);
+          }
+          return;
+        }
+
+        case ConfigFieldType::String:
+        case ConfigFieldType::WideString:
+          if (value.type != JsonType::String) {
+            warn("'%.*s' must be a string", path);
+            return;
+          }
+          if (field->choices) {
+            bool allowed = false;
+            for (auto choice = field->choices; *choice; ++choice) {
+              allowed = allowed || value.string == *choice;
+            }
+            if (!allowed) {
+              warn("'%.*s' has an unsupported value", path);
+              return;
+            }
+          }
+          if (field->type == ConfigFieldType::String) {
+            static_cast<std::string *>(target)->assign(value.string);
+          } else {
+            *static_cast<std::wstring *>(target) = utf8ToWide(value.string);
+          }
+          return;
+        }
+      });
+
+  if (!syntaxOk) {
+    const JsonError &error = reader.error();
+    std::snprintf(message, sizeof(message), "line %zu, column %zu: %s",
+                  error.line, error.column, error.message.c_str());
+    result.errors.emplace_back(message);
+    return result;
+  }
+
+  if (parsed.version > Config{}.version) {
+    result.warnings.emplace_back(
+        "config written by a newer version; unknown fields were ignored");
+  }
+
+  config = std::move(parsed);
+  result.ok = true;
+  return result;
+}
+
+// ============================================================================
+// Serialisation
+// ============================================================================
+
+std::string serializeConfig(const Config &config) {
+  std::string out;
+  out.reserve(2048);
+  out += '{';
+
+  // Names of the objects currently open, outermost first
+  std::vector<std::string_view> open;
+  bool needComma = false;
+
+  for (const ConfigField &field : FIELDS) {
+    std::string_view path = field.path;
+    std::vector<std::string_view> parents;
+    for (size_t dot; (dot = path.find('.')) != std::string_view::npos;) {
+      parents.push_back(path.substr(0, dot));
+      path.remove_prefix(dot + 1);
+    }
+
+    size_t common = 0;
+    while (common < open.size() && common < parents.size() &&
+           open[common] == parents[common]) {
+      ++common;
+    }
+    while (open.size() > common) {
+      out += '\n';
+      appendIndent(out, open.size());
+      out += '}';
+      open.pop_back();
+    }
+
+    if (needComma) {
+      out += ',';
+    }
+    out += '\n';
+    for (size_t i = common; i < parents.size(); ++i) {
+      appendIndent(out, open.size() + 1);
+      appendEscaped(out, parents[i]);
+      out += ": {\n";
+      open.push_back(parents[i]);
+    }
+
+    appendIndent(out, open.size() + 1);
+    appendEscaped(out, path);
+    out += ": ";
+    appendValue(out, field, config);
+    needComma = true;
+  }
+
+  while (!open.empty()) {
+    out += '\n';
+    appendIndent(out, open.size());
+    out += '}';
+    open.pop_back();
+  }
+  out += "\n}\n";
+  return out;
+}
+
+// ============================================================================
+// Diff
+// ============================================================================
+
+ConfigDiff diff(const Config &before, const Config &after) {
+  ConfigDiff result;
+  for (const ConfigField &field : FIELDS) {
+    if (!valuesEqual(field, before, after)) {
+      result.sections |= static_cast<uint32_t>(field.section);
+      result.fields.push_back(&field);
+    }
+  }
+  return result;
+}
+
+} // namespace WindowsAiMic
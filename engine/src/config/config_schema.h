@@ -0,0 +1,114 @@
+/**
+ * WindowsAiMic - Configuration Schema Header
+ *
+ * One table describing every persisted Config field: its JSON path, type,
+ * valid range and the processor section it belongs to. Loading, saving,
+ * validation and diffing are all driven from it.
+ */
+
+#pragma once
+
+#include "config_types.h"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Groups of fields that are applied together
+ * Equalizer bands are separate so one band's coefficients can be
+ * recomputed without touching the others.
+ */
+enum class ConfigSection : uint32_t {
+  None = 0,
+  General = 1 << 0, // version, activePreset
+  Devices = 1 << 1,
+  AiModel = 1 << 2,
+  RNNoise = 1 << 3,
+  DeepFilter = 1 << 4,
+  Expander = 1 << 5,
+  Compressor = 1 << 6,
+  Limiter = 1 << 7,
+  Equalizer = 1 << 8, // Master enable
+  EqHighPass = 1 << 9,
+  EqLowShelf = 1 << 10,
+  EqPresence = 1 << 11,
+  EqHighShelf = 1 << 12,
+  EqDeEsser = 1 << 13, // Band and its enable
+  Diagnostics = 1 << 14,
+  AudioExport = 1 << 15,
+  Tuning = 1 << 16,
+};
+
+enum class ConfigFieldType { Int, Bool, Float, String, WideString };
+
+/**
+ * Schema entry for one leaf field
+ */
+struct ConfigField {
+  const char *path; // Dotted JSON path
+  ConfigFieldType type;
+  ConfigSection section;
+  float min; // Numeric range (ignored for strings/bools)
+  float max;
+  const char *const *choices; // Allowed strings, nullptr-terminated
+  void *(*locate)(Config &config);
+};
+
+/**
+ * All persisted fields, in file order
+ */
+std::span<const ConfigField> configSchema();
+
+/**
+ * Look up a field by dotted path
+ * @return nullptr if the path is not part of the schema
+ */
+const ConfigField *findConfigField(std::string_view path);
+
+/**
+ * Outcome of parsing a config document
+ * Syntax errors fail the parse; schema problems (unknown keys, wrong
+ * types, out-of-range values) are reported and the field keeps its
+ * default or is clamped.
+ */
+struct ConfigParseResult {
+  bool ok = false;
+  std::vector<std::string> errors;   // Document rejected
+  std::vector<std::string> warnings; // Document used, field(s) corrected
+};
+
+/**
+ * Parse and validate a JSON config on top of `config`
+ * Fields missing from the document keep their current values.
+ */
+ConfigParseResult parseConfig(std::string_view json, Config &config);
+
+/**
+ * Serialise every schema field as pretty-printed JSON
+ */
+std::string serializeConfig(const Config &config);
+
+/**
+ * Fields that differ between two configs
+ */
+struct ConfigDiff {
+  uint32_t sections = 0;
+  std::vector<const ConfigField *> fields;
+
+  bool empty() const { return fields.empty(); }
+  bool has(ConfigSection section) const {
+    return (sections & static_cast<uint32_t>(section)) != 0;
+  }
+};
+
+/**
+ * Compare two configs field by field
+ */
+ConfigDiff diff(const Config &before, const Config &after);
+
+} // namespace WindowsAiMic
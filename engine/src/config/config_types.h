@@ -38,6 +38,7 @@ struct ExpanderConfig {
   float attack = 5.0f;     // ms
   float release = 100.0f;  // ms
   float hysteresis = 3.0f; // dB
+  float lookahead = 0.0f;  // ms
 };
 
 struct CompressorConfig {
@@ -48,6 +49,7 @@ struct CompressorConfig {
   float attack = 10.0f;    // ms
   float release = 100.0f;  // ms
   float makeupGain = 6.0f; // dB
+  float lookahead = 0.0f;  // ms
 };
 
 struct LimiterConfig {
@@ -86,6 +88,29 @@ struct DevicesConfig {
   std::wstring outputDevice = L""; // Virtual Speaker device ID
 };
 
+struct DiagnosticsConfig {
+  bool flightRecorder = true;                // Keep recent audio in memory
+  float recorderSeconds = 10.0f;             // History length
+  std::string dumpDirectory = "diagnostics"; // Where glitch dumps go
+  bool tracing = false;                      // Record Chrome trace events
+  std::string logLevel = "info";             // debug/info/warning/error/off
+  std::string logFile;                       // Empty = console only
+  bool denormalCheck = false;                // Count subnormal DSP state
+};
+
+struct AudioExportConfig {
+  bool enabled = true;        // Publish processed audio to shared memory
+  float bufferSeconds = 2.0f; // Ring length readers can lag behind
+};
+
+struct TuningConfig {
+  bool autoTune = true;         // Calibrate block size at start-up
+  float calibrationMs = 300.0f; // Time spent measuring the chain
+  // "latency", "efficiency" (30 ms quantum, one wake-up per quantum) or
+  // "auto" (efficiency while on battery)
+  std::string powerMode = "latency";
+};
+
 struct Config {
   int version = 1;
   DevicesConfig devices;
@@ -95,6 +120,9 @@ struct Config {
   CompressorConfig compressor;
   LimiterConfig limiter;
   EqualizerConfig equalizer;
+  DiagnosticsConfig diagnostics;
+  AudioExportConfig audioExport;
+  TuningConfig tuning;
   std::string activePreset = "podcast";
 };
 
@@ -0,0 +1,245 @@
+/**
+ * WindowsAiMic - Config File Watcher Implementation
+ */
+
+#include "config_watcher.h"
+#include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+#include "../platform/clock.h"
+
+#include <chrono>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace WindowsAiMic {
+
+ConfigWatcher::~ConfigWatcher() { stop(); }
+
+bool ConfigWatcher::start(const std::string &path, ChangeCallback callback) {
+  if (running_.load()) {
+    return true;
+  }
+
+  const std::filesystem::path filePath(path);
+  directory_ = filePath.has_parent_path() ? filePath.parent_path().string()
+                                          : std::string(".");
+  fileName_ = filePath.filename().string();
+  callback_ = std::move(callback);
+
+#ifdef _WIN32
+  HANDLE directory = CreateFileA(
+      directory_.c_str(), FILE_LIST_DIRECTORY,
+      FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+      OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED,
+      nullptr);
+  if (directory == INVALID_HANDLE_VALUE) {
+    WAM_LOG_WARNING("Cannot watch %s: %lu", directory_.c_str(),
+                    static_cast<unsigned long>(GetLastError()));
+    return false;
+  }
+  directoryHandle_ = directory;
+  stopEvent_ = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+#else
+  inotifyFd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (inotifyFd_ < 0 || wakeFd_ < 0 ||
+      inotify_add_watch(inotifyFd_, directory_.c_str(),
+                        IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    WAM_LOG_WARNING("Cannot watch %s: %s", directory_.c_str(),
+                    std::strerror(errno));
+    closeHandles();
+    return false;
+  }
+#endif
+
+  running_ = true;
+  thread_ = std::thread(&ConfigWatcher::watchThread, this);
+  WAM_LOG_INFO("Watching %s for config changes", path.c_str());
+  return true;
+}
+
+void ConfigWatcher::stop() {
+  if (running_.exchange(false)) {
+#ifdef _WIN32
+    SetEvent(stopEvent_);
+#else
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = write(wakeFd_, &one, sizeof(one));
+#endif
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+  closeHandles();
+}
+
+void ConfigWatcher::closeHandles() {
+#ifdef _WIN32
+  if (directoryHandle_) {
+    CloseHandle(static_cast<HANDLE>(directoryHandle_));
+    directoryHandle_ = nullptr;
+  }
+  if (stopEvent_) {
+    CloseHandle(static_cast<HANDLE>(stopEvent_));
+    stopEvent_ = nullptr;
+  }
+#else
+  if (inotifyFd_ >= 0) {
+    close(inotifyFd_);
+    inotifyFd_ = -1;
+  }
+  if (wakeFd_ >= 0) {
+    close(wakeFd_);
+    wakeFd_ = -1;
+  }
+#endif
+}
+
+#ifdef _WIN32
+
+// ============================================================================
+// Windows: overlapped ReadDirectoryChangesW
+// ============================================================================
+
+void ConfigWatcher::watchThread() {
+  Logger::instance().registerThread("ConfigWatcher");
+  Tracer::instance().registerThread("ConfigWatcher");
+
+  HANDLE directory = static_cast<HANDLE>(directoryHandle_);
+  HANDLE stopEvent = static_cast<HANDLE>(stopEvent_);
+  const std::wstring fileName =
+      std::filesystem::path(fileName_).wstring();
+
+  alignas(DWORD) uint8_t buffer[16 * 1024];
+  OVERLAPPED overlapped = {};
+  overlapped.hEvent = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+  const HANDLE handles[] = {stopEvent, overlapped.hEvent};
+
+  while (running_.load()) {
+    ResetEvent(overlapped.hEvent);
+    if (!ReadDirectoryChangesW(
+            directory, buffer, sizeof(buffer), FALSE,
+            FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME |
+                FILE_NOTIFY_CHANGE_SIZE,
+            nullptr, &overlapped, nullptr)) {
+      WAM_LOG_ERROR("ReadDirectoryChangesW failed: %lu",
+                    static_cast<unsigned long>(GetLastError()));
+      break;
+    }
+
+    if (WaitForMultipleObjects(2, handles, FALSE, INFINITE) !=
+        WAIT_OBJECT_0 + 1) {
+      CancelIoEx(directory, &overlapped);
+      GetOverlappedResult(directory, &overlapped, nullptr, TRUE);
+      break;
+    }
+
+    DWORD bytes = 0;
+    if (!GetOverlappedResult(directory, &overlapped, &bytes, FALSE)) {
+      continue;
+    }
+
+    // bytes == 0 means the change buffer overflowed: assume we were hit
+    bool matched = bytes == 0;
+    for (DWORD offset = 0; bytes > 0 && !matched;) {
+      const auto *info =
+          reinterpret_cast<const FILE_NOTIFY_INFORMATION *>(buffer + offset);
+      const int length =
+          static_cast<int>(info->FileNameLength / sizeof(WCHAR));
+      if (info->Action != FILE_ACTION_REMOVED &&
+          info->Action != FILE_ACTION_RENAMED_OLD_NAME &&
+          CompareStringOrdinal(info->FileName, length, fileName.c_str(),
+                               static_cast<int>(fileName.size()),
+                               TRUE) == CSTR_EQUAL) {
+        matched = true;
+      }
+      if (info->NextEntryOffset == 0) {
+        break;
+      }
+      offset += info->NextEntryOffset;
+    }
+    if (!matched) {
+      continue;
+    }
+
+    // Let the writer finish; later events in the burst re-trigger a
+    // reload that finds nothing new
+    const uint64_t changeNs = nowNs();
+    if (WaitForSingleObject(stopEvent, SETTLE_MS) == WAIT_OBJECT_0) {
+      break;
+    }
+    callback_(changeNs);
+  }
+
+  CloseHandle(overlapped.hEvent);
+}
+
+#else
+
+// ============================================================================
+// Linux: inotify on the parent directory
+// ============================================================================
+
+void ConfigWatcher::watchThread() {
+  Logger::instance().registerThread("ConfigWatcher");
+  Tracer::instance().registerThread("ConfigWatcher");
+
+  alignas(inotify_event) char buffer[16 * 1024];
+  pollfd descriptors[2] = {{inotifyFd_, POLLIN, 0}, {wakeFd_, POLLIN, 0}};
+
+  // Returns true if any queued event names our file
+  auto drainEvents = [&]() {
+    bool matched = false;
+    while (true) {
+      const ssize_t length = read(inotifyFd_, buffer, sizeof(buffer));
+      if (length <= 0) {
+        return matched;
+      }
+      for (ssize_t offset = 0; offset < length;) {
+        const auto *event =
+            reinterpret_cast<const inotify_event *>(buffer + offset);
+        if ((event->mask & IN_Q_OVERFLOW) ||
+            (event->len > 0 && fileName_ == event->name)) {
+          matched = true;
+        }
+        offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+      }
+    }
+  };
+
+  while (running_.load()) {
+    const int ready = poll(descriptors, 2, -1);
+    if (ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      WAM_LOG_ERROR("Config watcher poll failed: %s", std::strerror(errno));
+      break;
+    }
+    if (descriptors[1].revents != 0 || !drainEvents()) {
+      continue; // Stop request (re-checked above) or another file
+    }
+
+    // Let the writer finish, then swallow the rest of the burst
+    const uint64_t changeNs = nowNs();
+    if (poll(&descriptors[1], 1, SETTLE_MS) != 0) {
+      continue;
+    }
+    drainEvents();
+    callback_(changeNs);
+  }
+}
+
+#endif
+
+} // namespace WindowsAiMic
@@ -0,0 +1,76 @@
+/**
+ * WindowsAiMic - Config File Watcher Header
+ *
+ * Watches the config file's directory (ReadDirectoryChangesW on Windows,
+ * inotify on Linux) and reports changes to the file from a background
+ * thread. Watching the directory rather than the file catches the
+ * write-temp-then-rename pattern used by deployment tools and by
+ * ConfigManager itself.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+
+namespace WindowsAiMic {
+
+/**
+ * Config file watcher
+ */
+class ConfigWatcher {
+public:
+  ConfigWatcher() = default;
+  ~ConfigWatcher();
+
+  // Non-copyable
+  ConfigWatcher(const ConfigWatcher &) = delete;
+  ConfigWatcher &operator=(const ConfigWatcher &) = delete;
+
+  /**
+   * Called on the watcher thread once a burst of changes has settled
+   * @param changeNs steady_clock time of the first change in the burst
+   */
+  using ChangeCallback = std::function<void(uint64_t changeNs)>;
+
+  /**
+   * Start watching
+   * @param path Config file path
+   * @return true if the watch was established
+   */
+  bool start(const std::string &path, ChangeCallback callback);
+
+  /**
+   * Stop watching (joins the thread)
+   */
+  void stop();
+
+  bool isRunning() const { return running_.load(); }
+
+  /** Quiet period that coalesces an editor's or tool's write burst */
+  static constexpr int SETTLE_MS = 50;
+
+private:
+  void watchThread();
+  void closeHandles();
+
+  std::string directory_;
+  std::string fileName_;
+  ChangeCallback callback_;
+
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+
+#ifdef _WIN32
+  void *directoryHandle_ = nullptr; // HANDLE
+  void *stopEvent_ = nullptr;       // HANDLE
+#else
+  int inotifyFd_ = -1;
+  int wakeFd_ = -1; // eventfd used to interrupt poll() on stop
+#endif
+};
+
+} // namespace WindowsAiMic
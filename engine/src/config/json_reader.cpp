@@ -0,0 +1,384 @@
+/**
+ * WindowsAiMic - JSON Reader Implementation
+ */
+
+#include "json_reader.h"
+
+#include <charconv>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+bool JsonReader::parse(std::string_view text, const ValueHandler &handler) {
+  text_ = text;
+  pos_ = 0;
+  handler_ = &handler;
+  path_.clear();
+  error_ = JsonError{};
+
+  // Tolerate a UTF-8 byte order mark (Notepad writes one)
+  if (text_.substr(0, 3) == "\xEF\xBB\xBF") {
+    pos_ = 3;
+  }
+
+  skipWhitespace();
+  if (!parseValue(0)) {
+    return false;
+  }
+  skipWhitespace();
+  if (pos_ != text_.size()) {
+    return fail("unexpected data after document");
+  }
+  return true;
+}
+
+// ============================================================================
+// Values
+// ============================================================================
+
+bool JsonReader::parseValue(int depth) {
+  if (depth > MAX_DEPTH) {
+    return fail("nesting too deep");
+  }
+  if (pos_ >= text_.size()) {
+    return fail("unexpected end of input");
+  }
+
+  JsonValue value;
+  switch (text_[pos_]) {
+  case '{':
+    return parseObject(depth + 1);
+  case '[':
+    return parseArray(depth + 1);
+  case '"':
+    value.type = JsonType::String;
+    if (!parseString(value.string, valueScratch_)) {
+      return false;
+    }
+    break;
+  case 't':
+    value.type = JsonType::Bool;
+    value.boolean = true;
+    if (!parseLiteral("true")) {
+      return false;
+    }
+    break;
+  case 'f':
+    value.type = JsonType::Bool;
+    if (!parseLiteral("false")) {
+      return false;
+    }
+    break;
+  case 'n':
+    if (!parseLiteral("null")) {
+      return false;
+    }
+    break;
+  default:
+    value.type = JsonType::Number;
+    if (!parseNumber(value.number)) {
+      return false;
+    }
+    break;
+  }
+
+  (*handler_)(path_, value);
+  return true;
+}
+
+bool JsonReader::parseObject(int depth) {
+  ++pos_; // '{'
+  skipWhitespace();
+  if (pos_ < text_.size() && text_[pos_] == '}') {
+    ++pos_;
+    return true;
+  }
+
+  const size_t parentLength = path_.size();
+  while (true) {
+    skipWhitespace();
+    if (pos_ >= text_.size() || text_[pos_] != '"') {
+      return fail("expected object key");
+    }
+    std::string_view key;
+    if (!parseString(key, keyScratch_)) {
+      return false;
+    }
+
+    path_.resize(parentLength);
+    if (parentLength > 0) {
+      path_ += '.';
+    }
+    path_ += key;
+
+    skipWhitespace();
+    if (pos_ >= text_.size() || text_[pos_] != ':') {
+      return fail("expected ':' after key");
+    }
+    ++pos_;
+    skipWhitespace();
+    if (!parseValue(depth)) {
+      return false;
+    }
+
+    skipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == ',') {
+      ++pos_;
+      continue;
+    }
+    if (pos_ < text_.size() && text_[pos_] == '}') {
+      ++pos_;
+      path_.resize(parentLength);
+      return true;
+    }
+    return fail("expected ',' or '}'");
+  }
+}
+
+bool JsonReader::parseArray(int depth) {
+  ++pos_; // '['
+  skipWhitespace();
+  if (pos_ < text_.size() && text_[pos_] == ']') {
+    ++pos_;
+    return true;
+  }
+
+  const size_t parentLength = path_.size();
+  for (size_t index = 0;; ++index) {
+    path_.resize(parentLength);
+    if (parentLength > 0) {
+      path_ += '.';
+    }
+    path_ += std::to_string(index);
+
+    skipWhitespace();
+    if (!parseValue(depth)) {
+      return false;
+    }
+
+    skipWhitespace();
+    if (pos_ < text_.size() && text_[pos_] == ',') {
+      ++pos_;
+      continue;
+    }
+    if (pos_ < text_.size() && text_[pos_] == ']') {
+      ++pos_;
+      path_.resize(parentLength);
+      return true;
+    }
+    return fail("expected ',' or ']'");
+  }
+}
+
+// ============================================================================
+// Scalars
+// ============================================================================
+
+bool JsonReader::parseString(std::string_view &out, std::string &scratch) {
+  ++pos_; // opening quote
+  const size_t start = pos_;
+
+  // Fast path: no escapes, hand out a view into the input
+  while (pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\') {
+    if (static_cast<unsigned char>(text_[pos_]) < 0x20) {
+      return fail("control character in string");
+    }
+    ++pos_;
+  }
+  if (pos_ >= text_.size()) {
+    return fail("unterminated string");
+  }
+  if (text_[pos_] == '"') {
+    out = text_.substr(start, pos_ - start);
+    ++pos_;
+    return true;
+  }
+
+  // Slow path: decode escapes into the scratch buffer
+  scratch.assign(text_.substr(start, pos_ - start));
+  while (pos_ < text_.size() && text_[pos_] != '"') {
+    const char c = text_[pos_++];
+    if (static_cast<unsigned char>(c) < 0x20) {
+      return fail("control character in string");
+    }
+    if (c != '\\') {
+      scratch += c;
+      continue;
+    }
+    if (pos_ >= text_.size()) {
+      break;
+    }
+    switch (text_[pos_++]) {
+    case '"':
+      scratch += '"';
+      break;
+    case '\\':
+      scratch += '\\';
+      break;
+    case '/':
+      scratch += '/';
+      break;
+    case 'b':
+      scratch += '\b';
+      break;
+    case 'f':
+      scratch += '\f';
+      break;
+    case 'n':
+      scratch += '\n';
+      break;
+    case 'r':
+      scratch += '\r';
+      break;
+    case 't':
+      scratch += '\t';
+      break;
+    case 'u':
+      if (!appendCodePoint(scratch)) {
+        return false;
+      }
+      break;
+    default:
+      return fail("invalid escape sequence");
+    }
+  }
+  if (pos_ >= text_.size()) {
+    return fail("unterminated string");
+  }
+  ++pos_;
+  out = scratch;
+  return true;
+}
+
+bool JsonReader::appendCodePoint(std::string &out) {
+  auto readHex = [this](uint32_t &unit) {
+    if (pos_ + 4 > text_.size()) {
+      return false;
+    }
+    const char *begin = text_.data() + pos_;
+    const auto result = std::from_chars(begin, begin + 4, unit, 16);
+    if (result.ec != std::errc() || result.ptr != begin + 4) {
+      return false;
+    }
+    pos_ += 4;
+    return true;
+  };
+
+  uint32_t codePoint = 0;
+  if (!readHex(codePoint)) {
+    return fail("invalid \\u escape");
+  }
+
+  // Surrogate pair
+  if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+    uint32_t low = 0;
+    if (text_.substr(pos_, 2) != "\\u") {
+      return fail("unpaired surrogate");
+    }
+    pos_ += 2;
+    if (!readHex(low) || low < 0xDC00 || low > 0xDFFF) {
+      return fail("unpaired surrogate");
+    }
+    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+  } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+    return fail("unpaired surrogate");
+  }
+
+  if (codePoint < 0x80) {
+    out += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    out += static_cast<char>(0xC0 | (codePoint >> 6));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    out += static_cast<char>(0xE0 | (codePoint >> 12));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    out += static_cast<char>(0xF0 | (codePoint >> 18));
+    out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+  return true;
+}
+
+bool JsonReader::parseNumber(double &out) {
+  // Validate the JSON number grammar, then convert the whole token at once
+  const size_t start = pos_;
+  auto digits = [this]() {
+    const size_t first = pos_;
+    while (pos_ < text_.size() && text_[pos_] >= '0' && text_[pos_] <= '9') {
+      ++pos_;
+    }
+    return pos_ > first;
+  };
+
+  if (pos_ < text_.size() && text_[pos_] == '-') {
+    ++pos_;
+  }
+  if (pos_ < text_.size() && text_[pos_] == '0') {
+    ++pos_;
+  } else if (!digits()) {
+    return fail("invalid value");
+  }
+  if (pos_ < text_.size() && text_[pos_] == '.') {
+    ++pos_;
+    if (!digits()) {
+      return fail("invalid number");
+    }
+  }
+  if (pos_ < text_.size() && (text_[pos_] == 'e' || text_[pos_] == 'E')) {
+    ++pos_;
+    if (pos_ < text_.size() && (text_[pos_] == '+' || text_[pos_] == '-')) {
+      ++pos_;
+    }
+    if (!digits()) {
+      return fail("invalid number");
+    }
+  }
+
+  const char *begin = text_.data() + start;
+  const char *end = text_.data() + pos_;
+  const auto result = std::from_chars(begin, end, out);
+  if (result.ec != std::errc() || result.ptr != end) {
+    pos_ = start;
+    return fail("number out of range");
+  }
+  return true;
+}
+
+bool JsonReader::parseLiteral(std::string_view literal) {
+  if (text_.substr(pos_, literal.size()) != literal) {
+    return fail("invalid literal");
+  }
+  pos_ += literal.size();
+  return true;
+}
+
+void JsonReader::skipWhitespace() {
+  while (pos_ < text_.size()) {
+    const char c = text_[pos_];
+    if (c != ' ' && c != '\t' && c != '\n' && c != '\r') {
+      break;
+    }
+    ++pos_;
+  }
+}
+
+bool JsonReader::fail(const char *message) {
+  // Line/column are only computed on the error path
+  error_.line = 1;
+  error_.column = 1;
+  for (size_t i = 0; i < pos_ && i < text_.size(); ++i) {
+    if (text_[i] == '\n') {
+      ++error_.line;
+      error_.column = 1;
+    } else {
+      ++error_.column;
+    }
+  }
+  error_.message = message;
+  return false;
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,83 @@
+/**
+ * WindowsAiMic - JSON Reader Header
+ *
+ * Single-pass, DOM-free JSON parser. Leaf values are reported with their
+ * dotted path ("equalizer.highPass.freq") as they are encountered, so the
+ * caller maps them straight onto its own structures.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace WindowsAiMic {
+
+enum class JsonType { Null, Bool, Number, String };
+
+/**
+ * A leaf value; string views stay valid only for the handler call
+ */
+struct JsonValue {
+  JsonType type = JsonType::Null;
+  bool boolean = false;
+  double number = 0.0;
+  std::string_view string;
+};
+
+/**
+ * Parse failure position (1-based) and reason
+ */
+struct JsonError {
+  size_t line = 0;
+  size_t column = 0;
+  std::string message;
+};
+
+/**
+ * JSON reader
+ *
+ * Strings without escapes are handed out as views into the input and
+ * object keys are appended to one reused path buffer, so a parse
+ * allocates next to nothing. Array elements get their index as the path
+ * component ("list.0").
+ */
+class JsonReader {
+public:
+  using ValueHandler =
+      std::function<void(std::string_view path, const JsonValue &value)>;
+
+  /**
+   * Parse a complete document
+   * @return false on a syntax error (see error())
+   */
+  bool parse(std::string_view text, const ValueHandler &handler);
+
+  const JsonError &error() const { return error_; }
+
+  static constexpr int MAX_DEPTH = 64;
+
+private:
+  bool parseValue(int depth);
+  bool parseObject(int depth);
+  bool parseArray(int depth);
+  bool parseString(std::string_view &out, std::string &scratch);
+  bool parseNumber(double &out);
+  bool parseLiteral(std::string_view literal);
+  bool appendCodePoint(std::string &out);
+  void skipWhitespace();
+  bool fail(const char *message);
+
+  std::string_view text_;
+  size_t pos_ = 0;
+  const ValueHandler *handler_ = nullptr;
+
+  std::string path_;
+  std::string keyScratch_;
+  std::string valueScratch_;
+  JsonError error_;
+};
+
+} // namespace WindowsAiMic
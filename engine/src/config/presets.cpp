@@ -0,0 +1,43 @@
+/**
+ * WindowsAiMic - Presets Implementation
+ */
+
+#include "presets.h"
+
+namespace WindowsAiMic {
+
+bool applyPresetSettings(Config &config, const std::string &presetName) {
+  if (presetName == "podcast") {
+    // Warm, present voice with controlled dynamics
+    config.expander = {true, -45.0f, 2.5f, 5.0f, 100.0f, 3.0f};
+    config.compressor = {true, -16.0f, 3.5f, 6.0f, 10.0f, 100.0f, 6.0f};
+    config.limiter = {true, -1.0f, 50.0f, 5.0f};
+    config.equalizer.highPass = {80.0f, 0.7f};
+    config.equalizer.lowShelf = {200.0f, 1.0f};
+    config.equalizer.presence = {3000.0f, 3.0f, 1.0f};
+    config.equalizer.highShelf = {8000.0f, 2.0f};
+  } else if (presetName == "meeting") {
+    // Natural, less aggressive processing
+    config.expander = {true, -50.0f, 2.0f, 10.0f, 150.0f, 4.0f};
+    config.compressor = {true, -20.0f, 2.5f, 8.0f, 15.0f, 150.0f, 4.0f};
+    config.limiter = {true, -3.0f, 100.0f, 3.0f};
+    config.equalizer.highPass = {100.0f, 0.7f};
+    config.equalizer.lowShelf = {200.0f, 0.0f};
+    config.equalizer.presence = {3000.0f, 1.5f, 1.0f};
+    config.equalizer.highShelf = {10000.0f, 1.0f};
+  } else if (presetName == "streaming") {
+    // Punchy, broadcast-style
+    config.expander = {true, -40.0f, 3.0f, 3.0f, 80.0f, 2.0f};
+    config.compressor = {true, -14.0f, 4.5f, 4.0f, 5.0f, 80.0f, 8.0f};
+    config.limiter = {true, -0.5f, 30.0f, 5.0f};
+    config.equalizer.highPass = {80.0f, 0.8f};
+    config.equalizer.lowShelf = {150.0f, 2.0f};
+    config.equalizer.presence = {4000.0f, 4.0f, 1.2f};
+    config.equalizer.highShelf = {12000.0f, 3.0f};
+  } else {
+    return false;
+  }
+  return true;
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,24 @@
+/**
+ * WindowsAiMic - Presets Header
+ *
+ * The named processing presets offered in the tray menu.
+ */
+
+#pragma once
+
+#include "config_types.h"
+
+#include <string>
+
+namespace WindowsAiMic {
+
+/** Every preset name, in menu order */
+constexpr const char *PRESET_NAMES[] = {"podcast", "meeting", "streaming"};
+
+/**
+ * Overwrite the DSP sections of `config` with a preset's settings
+ * @return false if `presetName` is not a known preset (config unchanged)
+ */
+bool applyPresetSettings(Config &config, const std::string &presetName);
+
+} // namespace WindowsAiMic
@@ -0,0 +1,495 @@
+/**
+ * WindowsAiMic - Auto Tuner Implementation
+ */
+
+#include "auto_tuner.h"
+#include "../config/config_schema.h"
+#include "../config/json_reader.h"
+#include "../diagnostics/logger.h"
+#include "../platform/cpu_features.h"
+#include "../platform/cpu_topology.h"
+#include "../platform/thread_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <thread>
+
+namespace WindowsAiMic {
+
+namespace {
+
+// Bump when the measurement or the decision rule changes, so cached
+// decisions from older builds are measured again
+constexpr int TUNING_CACHE_VERSION = 1;
+
+constexpr size_t MIN_CALIBRATION_BLOCKS = 20;
+constexpr size_t SIGNAL_FRAMES = ProcessingChain::SAMPLE_RATE; // 1 s loop
+
+// Sections whose fields change the work process() does
+constexpr uint32_t PROCESSING_SECTIONS =
+    static_cast<uint32_t>(ConfigSection::AiModel) |
+    static_cast<uint32_t>(ConfigSection::RNNoise) |
+    static_cast<uint32_t>(ConfigSection::DeepFilter) |
+    static_cast<uint32_t>(ConfigSection::Expander) |
+    static_cast<uint32_t>(ConfigSection::Compressor) |
+    static_cast<uint32_t>(ConfigSection::Limiter) |
+    static_cast<uint32_t>(ConfigSection::Equalizer) |
+    static_cast<uint32_t>(ConfigSection::EqHighPass) |
+    static_cast<uint32_t>(ConfigSection::EqLowShelf) |
+    static_cast<uint32_t>(ConfigSection::EqPresence) |
+    static_cast<uint32_t>(ConfigSection::EqHighShelf) |
+    static_cast<uint32_t>(ConfigSection::EqDeEsser);
+
+// ============================================================================
+// Calibration
+// ============================================================================
+
+// Voiced bursts (140 Hz with harmonics, 4 Hz syllables) for 600 ms, then
+// 400 ms of room noise, so the model, gate and compressor all see both
+// speech and pauses
+std::vector<float> makeCalibrationSignal() {
+  std::vector<float> signal(SIGNAL_FRAMES);
+  constexpr float kTwoPi = 6.28318531f;
+  constexpr float kRate = static_cast<float>(ProcessingChain::SAMPLE_RATE);
+  uint32_t noise = 0x2545F491u;
+  for (size_t i = 0; i < signal.size(); ++i) {
+    const float t = static_cast<float>(i) / kRate;
+    noise = noise * 1664525u + 1013904223u;
+    float sample =
+        0.005f * (static_cast<float>(noise >> 8) / 16777216.0f - 0.5f);
+    if (t < 0.6f) {
+      const float syllable = 0.5f - 0.5f * std::cos(kTwoPi * 4.0f * t);
+      float voice = 0.0f;
+      for (int harmonic = 1; harmonic <= 8; ++harmonic) {
+        voice += std::sin(kTwoPi * 140.0f * static_cast<float>(harmonic) *
+                          t) /
+                 static_cast<float>(harmonic);
+      }
+      sample += 0.12f * syllable * voice;
+    }
+    signal[i] = sample;
+  }
+  return signal;
+}
+
+double percentile(std::vector<double> &values, double fraction) {
+  if (values.empty()) {
+    return 0.0;
+  }
+  std::sort(values.begin(), values.end());
+  const size_t rank = static_cast<size_t>(
+      std::ceil(fraction * static_cast<double>(values.size())));
+  return values[std::min(values.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+double elapsedUs(std::chrono::steady_clock::time_point from,
+                 std::chrono::steady_clock::time_point to) {
+  return std::chrono::duration<double, std::micro>(to - from).count();
+}
+
+// Capture keeps writing while the processing thread sits in its slowest
+// block: hold that stall twice over, plus the quantum being read and the
+// one being filled
+size_t inputRingFor(const QuantumTiming &timing) {
+  const size_t stallFrames = static_cast<size_t>(
+      std::ceil(timing.maxUs * ProcessingChain::SAMPLE_RATE / 1e6));
+  const size_t frames = std::max(MIN_INPUT_RING_FRAMES,
+                                 2 * stallFrames + 2 * timing.frames);
+  return (frames + timing.frames - 1) / timing.frames * timing.frames;
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+uint64_t fnv1a(uint64_t hash, std::string_view text) {
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+
+std::string hex(uint64_t value) {
+  char text[17];
+  std::snprintf(text, sizeof(text), "%016llx",
+                static_cast<unsigned long long>(value));
+  return text;
+}
+
+std::string fieldText(const ConfigField &field, const Config &config) {
+  const void *value = field.locate(const_cast<Config &>(config));
+  char text[32];
+  switch (field.type) {
+  case ConfigFieldType::Int:
+    return std::to_string(*static_cast<const int *>(value));
+  case ConfigFieldType::Bool:
+    return *static_cast<const bool *>(value) ? "true" : "false";
+  case ConfigFieldType::Float:
+    std::snprintf(text, sizeof(text), "%.9g",
+                  static_cast<double>(*static_cast<const float *>(value)));
+    return text;
+  case ConfigFieldType::String:
+    return *static_cast<const std::string *>(value);
+  case ConfigFieldType::WideString:
+    break;
+  }
+  return {};
+}
+
+bool validEntry(const TuningDecision &decision) {
+  const size_t quantum = decision.quantumFrames;
+  return std::find(std::begin(TUNING_QUANTA), std::end(TUNING_QUANTA),
+                   quantum) != std::end(TUNING_QUANTA) &&
+         decision.inputRingFrames >= MIN_INPUT_RING_FRAMES &&
+         decision.inputRingFrames % quantum == 0 &&
+         decision.inputRingFrames <= 64 * MIN_INPUT_RING_FRAMES;
+}
+
+std::map<std::string, TuningDecision> readCache(const std::string &path) {
+  std::map<std::string, TuningDecision> entries;
+  std::ifstream file(path, std::ios::binary);
+  if (!file.is_open()) {
+    return entries;
+  }
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  const std::string text = buffer.str();
+
+  int version = 0;
+  constexpr std::string_view kPrefix = "entries.";
+  JsonReader reader;
+  const bool parsed =
+      reader.parse(text, [&](std::string_view path, const JsonValue &value) {
+        if (path == "version" && value.type == JsonType::Number) {
+          version = static_cast<int>(value.number);
+          return;
+        }
+        if (path.substr(0, kPrefix.size()) != kPrefix) {
+          return;
+        }
+        path.remove_prefix(kPrefix.size());
+        const size_t dot = path.rfind('.');
+        if (dot == std::string_view::npos) {
+          return;
+        }
+        TuningDecision &entry = entries[std::string(path.substr(0, dot))];
+        if (entry.timings.empty()) {
+          entry.timings.emplace_back();
+        }
+        QuantumTiming &timing = entry.timings.front();
+        const std::string_view name = path.substr(dot + 1);
+        const double number = value.number;
+        const bool flag = value.type == JsonType::Bool && value.boolean;
+        if (name == "pipelineAi") {
+          entry.pipelineAi = flag;
+        } else if (name == "withinBudget") {
+          entry.withinBudget = flag;
+        } else if (value.type != JsonType::Number || number < 0.0) {
+          return;
+        } else if (name == "quantumFrames") {
+          entry.quantumFrames = static_cast<size_t>(number);
+          timing.frames = entry.quantumFrames;
+        } else if (name == "inputRingFrames") {
+          entry.inputRingFrames = static_cast<size_t>(number);
+        } else if (name == "load") {
+          entry.load = number;
+        } else if (name == "blocks") {
+          timing.blocks = static_cast<size_t>(number);
+        } else if (name == "p50Us") {
+          timing.p50Us = number;
+        } else if (name == "p99Us") {
+          timing.p99Us = number;
+        } else if (name == "maxUs") {
+          timing.maxUs = number;
+        } else if (name == "aiP99Us") {
+          timing.aiP99Us = number;
+        } else if (name == "dspP99Us") {
+          timing.dspP99Us = number;
+        }
+      });
+  if (!parsed || version != TUNING_CACHE_VERSION) {
+    entries.clear();
+  }
+  for (auto it = entries.begin(); it != entries.end();) {
+    it = validEntry(it->second) ? std::next(it) : entries.erase(it);
+  }
+  return entries;
+}
+
+} // namespace
+
+// ============================================================================
+// TuningDecision
+// ============================================================================
+
+std::string TuningDecision::describe() const {
+  char line[256];
+  std::snprintf(line, sizeof(line),
+                "Auto-tune (%s): %zu-frame quantum (%.1f ms), input ring "
+                "%zu frames, AI %s, p99 load %.1f%%%s",
+                cached ? "cached" : "measured", quantumFrames,
+                static_cast<double>(quantumFrames) * 1000.0 /
+                    ProcessingChain::SAMPLE_RATE,
+                inputRingFrames, pipelineAi ? "pipelined" : "inline",
+                load * 100.0, withinBudget ? "" : " (over budget)");
+  std::string text = line;
+  for (const QuantumTiming &timing : timings) {
+    std::snprintf(line, sizeof(line),
+                  "\n  %zu frames: p50 %.0f us, p99 %.0f us, max %.0f us "
+                  "(AI p99 %.0f us, DSP p99 %.0f us), %zu blocks",
+                  timing.frames, timing.p50Us, timing.p99Us, timing.maxUs,
+                  timing.aiP99Us, timing.dspP99Us, timing.blocks);
+    text += line;
+  }
+  return text;
+}
+
+// ============================================================================
+// Calibration and decision
+// ============================================================================
+
+std::vector<QuantumTiming> calibrateChain(ProcessingChain &chain,
+                                          double calibrationMs,
+                                          const std::vector<int> &cpus) {
+  using Clock = std::chrono::steady_clock;
+  const std::vector<float> signal = makeCalibrationSignal();
+  const auto perQuantum = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double, std::milli>(
+          std::max(calibrationMs, 0.0) / std::size(TUNING_QUANTA)));
+
+  std::vector<QuantumTiming> timings;
+  std::thread worker([&]() {
+    // Same scheduling, affinity and FTZ/DAZ as the processing thread;
+    // the engine locks memory itself once it starts
+    RealtimeOptions options;
+    options.cpus = cpus;
+    options.lockMemory = false;
+    RealtimeContext realtime(options);
+
+    std::vector<float> block(MAX_QUANTUM_FRAMES);
+    std::vector<double> total, ai, dsp;
+    size_t offset = 0;
+    for (size_t frames : TUNING_QUANTA) {
+      total.clear();
+      ai.clear();
+      dsp.clear();
+      const Clock::time_point end = Clock::now() + perQuantum;
+      while (Clock::now() < end || total.size() < MIN_CALIBRATION_BLOCKS) {
+        for (size_t i = 0; i < frames; ++i) {
+          block[i] = signal[(offset + i) % signal.size()];
+        }
+        offset = (offset + frames) % signal.size();
+
+        const Clock::time_point start = Clock::now();
+        chain.processAi(block.data(), frames);
+        const Clock::time_point middle = Clock::now();
+        chain.processDsp(block.data(), frames);
+        const Clock::time_point finish = Clock::now();
+        ai.push_back(elapsedUs(start, middle));
+        dsp.push_back(elapsedUs(middle, finish));
+        total.push_back(elapsedUs(start, finish));
+      }
+
+      QuantumTiming timing;
+      timing.frames = frames;
+      timing.blocks = total.size();
+      timing.p50Us = percentile(total, 0.50);
+      timing.p99Us = percentile(total, 0.99);
+      timing.maxUs = total.back(); // Sorted by percentile()
+      timing.aiP99Us = percentile(ai, 0.99);
+      timing.dspP99Us = percentile(dsp, 0.99);
+      timings.push_back(timing);
+    }
+  });
+  worker.join();
+
+  chain.reset();
+  return timings;
+}
+
+TuningDecision chooseTuning(const std::vector<QuantumTiming> &timings,
+                            size_t realtimeCpuCount) {
+  struct Candidate {
+    const QuantumTiming *timing;
+    bool pipelined;
+    double load;
+    size_t delayFrames; // Added by the quantum and the AI hand-off
+  };
+  std::vector<Candidate> candidates;
+  for (const QuantumTiming &timing : timings) {
+    if (timing.frames == 0 || timing.blocks == 0) {
+      continue;
+    }
+    const double period = timing.periodUs();
+    candidates.push_back({&timing, false, timing.p99Us / period,
+                          timing.frames});
+    // With the AI stage on its own core the block costs the slower half
+    if (realtimeCpuCount >= 2) {
+      candidates.push_back(
+          {&timing, true, std::max(timing.aiP99Us, timing.dspP99Us) / period,
+           2 * timing.frames});
+    }
+  }
+
+  TuningDecision decision;
+  decision.timings = timings;
+  decision.inputRingFrames = MIN_INPUT_RING_FRAMES;
+  if (candidates.empty()) {
+    return decision;
+  }
+
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate &a, const Candidate &b) {
+                     if (a.delayFrames != b.delayFrames) {
+                       return a.delayFrames < b.delayFrames;
+                     }
+                     return !a.pipelined && b.pipelined;
+                   });
+  auto chosen = std::find_if(candidates.begin(), candidates.end(),
+                             [](const Candidate &candidate) {
+                               return candidate.load <= TUNING_LOAD_BUDGET;
+                             });
+  decision.withinBudget = chosen != candidates.end();
+  if (!decision.withinBudget) {
+    chosen = std::min_element(candidates.begin(), candidates.end(),
+                              [](const Candidate &a, const Candidate &b) {
+                                return a.load < b.load;
+                              });
+  }
+
+  decision.quantumFrames = chosen->timing->frames;
+  decision.pipelineAi = chosen->pipelined;
+  decision.load = chosen->load;
+  decision.inputRingFrames = inputRingFor(*chosen->timing);
+  return decision;
+}
+
+// ============================================================================
+// Cache
+// ============================================================================
+
+std::string tuningCacheKey(const Config &config) {
+  const CPUFeatures &features = CPUFeatures::get();
+  const CpuTopology &topology = CpuTopology::get();
+  uint64_t machine = fnv1a(FNV_OFFSET, std::to_string(TUNING_CACHE_VERSION));
+  machine = fnv1a(machine, features.vendor());
+  machine = fnv1a(machine, features.brand());
+  machine = fnv1a(machine, topology.describe());
+  for (int cpu : topology.realtimeCpus()) {
+    machine = fnv1a(machine, std::to_string(cpu) + ",");
+  }
+
+  uint64_t processing = FNV_OFFSET;
+  for (const ConfigField &field : configSchema()) {
+    if (static_cast<uint32_t>(field.section) & PROCESSING_SECTIONS) {
+      processing = fnv1a(processing, field.path);
+      processing = fnv1a(processing, "=");
+      processing = fnv1a(processing, fieldText(field, config));
+      processing = fnv1a(processing, ";");
+    }
+  }
+  return hex(machine) + "-" + hex(processing);
+}
+
+bool loadTuningCache(const std::string &path, const std::string &key,
+                     TuningDecision &decision) {
+  std::map<std::string, TuningDecision> entries = readCache(path);
+  const auto it = entries.find(key);
+  if (it == entries.end()) {
+    return false;
+  }
+  decision = it->second;
+  decision.cached = true;
+  return true;
+}
+
+bool saveTuningCache(const std::string &path, const std::string &key,
+                     const TuningDecision &decision) {
+  std::map<std::string, TuningDecision> entries = readCache(path);
+  TuningDecision &entry = entries[key];
+  entry = decision;
+  // Keep only the measurement behind the decision
+  const auto chosen =
+      std::find_if(decision.timings.begin(), decision.timings.end(),
+                   [&](const QuantumTiming &timing) {
+                     return timing.frames == decision.quantumFrames;
+                   });
+  entry.timings.assign(1, chosen != decision.timings.end() ? *chosen
+                                                           : QuantumTiming{});
+
+  std::string text = "{\n  \"version\": " +
+                     std::to_string(TUNING_CACHE_VERSION) +
+                     ",\n  \"entries\": {";
+  const char *separator = "\n";
+  for (const auto &[name, value] : entries) {
+    const QuantumTiming &timing = value.timings.front();
+    char body[512];
+    std::snprintf(
+        body, sizeof(body),
+        "%s    \"%s\": {\"quantumFrames\": %zu, \"inputRingFrames\": %zu, "
+        "\"pipelineAi\": %s, \"withinBudget\": %s, \"load\": %.4f, "
+        "\"blocks\": %zu, \"p50Us\": %.1f, \"p99Us\": %.1f, "
+        "\"maxUs\": %.1f, \"aiP99Us\": %.1f, \"dspP99Us\": %.1f}",
+        separator, name.c_str(), value.quantumFrames, value.inputRingFrames,
+        value.pipelineAi ? "true" : "false",
+        value.withinBudget ? "true" : "false", value.load, timing.blocks,
+        timing.p50Us, timing.p99Us, timing.maxUs, timing.aiP99Us,
+        timing.dspP99Us);
+    text += body;
+    separator = ",\n";
+  }
+  text += "\n  }\n}\n";
+
+  // Temp file and rename, like config.json: a torn write loses the cache,
+  // never leaves a half entry behind
+  const std::string tempPath = path + ".tmp";
+  {
+    std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+      WAM_LOG_WARNING("Could not write tuning cache: %s", tempPath.c_str());
+      return false;
+    }
+    file.write(text.data(), static_cast<std::streamsize>(text.size()));
+    if (!file.good()) {
+      return false;
+    }
+  }
+  std::error_code error;
+  std::filesystem::rename(tempPath, path, error);
+  if (error) {
+    WAM_LOG_WARNING("Could not replace tuning cache %s: %s", path.c_str(),
+                    error.message().c_str());
+    std::filesystem::remove(tempPath, error);
+    return false;
+  }
+  return true;
+}
+
+TuningDecision autoTune(ProcessingChain &chain, const Config &config,
+                        const AutoTuneOptions &options) {
+  const std::string key = tuningCacheKey(config);
+  TuningDecision decision;
+  if (!options.cachePath.empty() &&
+      loadTuningCache(options.cachePath, key, decision)) {
+    return decision;
+  }
+
+  decision = chooseTuning(
+      calibrateChain(chain, options.calibrationMs, options.cpus),
+      options.cpus.size());
+  if (!options.cachePath.empty()) {
+    saveTuningCache(options.cachePath, key, decision);
+  }
+  return decision;
+}
+
+} // namespace WindowsAiMic
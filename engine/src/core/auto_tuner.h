@@ -0,0 +1,124 @@
+/**
+ * WindowsAiMic - Auto Tuner Header
+ *
+ * Start-up calibration of the engine's block size. The configured chain
+ * runs on synthetic speech on the real-time core class for a few hundred
+ * milliseconds; the measured per-block times pick the processing quantum,
+ * the input ring depth and whether the AI stage runs a block ahead on its
+ * own thread. Decisions are cached per machine and processing config.
+ */
+
+#pragma once
+
+#include "../config/config_types.h"
+#include "processing_chain.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Per-block processing times at one quantum, in microseconds
+ */
+struct QuantumTiming {
+  size_t frames = 0;
+  size_t blocks = 0; // Blocks measured
+  double p50Us = 0.0;
+  double p99Us = 0.0;
+  double maxUs = 0.0;
+  double aiP99Us = 0.0;  // Input metering and model
+  double dspP99Us = 0.0; // DSP stages and output metering
+
+  /** Real time one block represents */
+  double periodUs() const {
+    return static_cast<double>(frames) * 1e6 / ProcessingChain::SAMPLE_RATE;
+  }
+};
+
+/**
+ * What the engine runs with
+ */
+struct TuningDecision {
+  size_t quantumFrames = ProcessingChain::FRAME_SIZE;
+  size_t inputRingFrames = 0;
+  bool pipelineAi = false; // AI stage a block ahead on a second core
+  double load = 0.0;       // Critical-path p99 / quantum period
+  bool withinBudget = true;
+  bool cached = false;
+  std::vector<QuantumTiming> timings; // Cached decisions keep the chosen one
+
+  /** Decision then one line per measured quantum, for the log */
+  std::string describe() const;
+};
+
+/**
+ * Quantum candidates: whole RNNoise frames, so none adds AI buffering
+ */
+constexpr size_t TUNING_QUANTA[] = {ProcessingChain::FRAME_SIZE,
+                                    2 * ProcessingChain::FRAME_SIZE,
+                                    3 * ProcessingChain::FRAME_SIZE};
+constexpr size_t MAX_QUANTUM_FRAMES = 3 * ProcessingChain::FRAME_SIZE;
+
+/** Share of the quantum period the p99 block may take */
+constexpr double TUNING_LOAD_BUDGET = 0.5;
+
+/** Smallest input ring: 160 ms, what the engine always had */
+constexpr size_t MIN_INPUT_RING_FRAMES = 16 * ProcessingChain::FRAME_SIZE;
+
+/**
+ * Run `chain` on synthetic speech at each candidate quantum
+ *
+ * Measures on a thread with the real-time set-up of the processing thread
+ * restricted to `cpus`, splitting `calibrationMs` between the quanta. The
+ * chain must be configured; its state is reset afterwards.
+ */
+std::vector<QuantumTiming> calibrateChain(ProcessingChain &chain,
+                                          double calibrationMs,
+                                          const std::vector<int> &cpus);
+
+/**
+ * Pick the lowest-latency setting whose p99 fits TUNING_LOAD_BUDGET
+ *
+ * Candidates are ordered by the delay they add (a pipelined AI stage
+ * costs one quantum); at equal delay the inline chain wins. Pipelining
+ * needs at least two real-time CPUs. When nothing fits, the lightest
+ * setting is returned with withinBudget cleared.
+ */
+TuningDecision chooseTuning(const std::vector<QuantumTiming> &timings,
+                            size_t realtimeCpuCount);
+
+/**
+ * "<machine>-<config>" hash pair: CPU and topology, and every field that
+ * changes what the chain computes (AI model and DSP sections)
+ */
+std::string tuningCacheKey(const Config &config);
+
+/**
+ * Read one cached decision
+ * @return false if the file, the key or a sane entry is missing
+ */
+bool loadTuningCache(const std::string &path, const std::string &key,
+                     TuningDecision &decision);
+
+/**
+ * Add or replace one entry, keeping the others
+ */
+bool saveTuningCache(const std::string &path, const std::string &key,
+                     const TuningDecision &decision);
+
+struct AutoTuneOptions {
+  double calibrationMs = 300.0;
+  std::vector<int> cpus;  // Core class the processing thread runs on
+  std::string cachePath;  // Empty = always measure, never store
+};
+
+/**
+ * Cached decision for this machine and config, or calibrate and store one
+ */
+TuningDecision autoTune(ProcessingChain &chain, const Config &config,
+                        const AutoTuneOptions &options);
+
+} // namespace WindowsAiMic
@@ -0,0 +1,607 @@
+/**
+ * WindowsAiMic - Processing Chain Implementation
+ */
+
+#include "processing_chain.h"
+#include "../ai/rnnoise_processor.h"
+#include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+#include "../dsp/compressor.h"
+#include "../dsp/equalizer.h"
+#include "../dsp/expander.h"
+#include "../dsp/limiter.h"
+#include "../dsp/lookahead_delay.h"
+#include "../dsp/metering.h"
+#include "../dsp/processor_state.h"
+#ifdef USE_DEEPFILTER
+#include "../ai/deepfilter_processor.h"
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr size_t WARM_UP_BLOCKS = 8;
+
+constexpr uint32_t SNAPSHOT_MAGIC = 0x534d4157; // "WAMS"
+constexpr uint32_t SNAPSHOT_VERSION = 2; // 2: shared lookahead line
+
+// Silence counters and the unaligned-block flag
+constexpr size_t CHAIN_STATE_SIZE = 2 * sizeof(uint64_t) + sizeof(uint8_t);
+
+struct SnapshotHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint32_t sampleRate;
+  uint32_t sections;
+  uint64_t sizes[7];
+};
+
+// Quiet 1 kHz tone: real signal for warm-up, far below any threshold
+void fillWarmUpSignal(float *buffer, size_t frames, size_t offset) {
+  constexpr float kStep = 2.0f * 3.14159265f * 1000.0f / 48000.0f;
+  for (size_t i = 0; i < frames; ++i) {
+    buffer[i] = 0.01f * std::sin(kStep * static_cast<float>(offset + i));
+  }
+}
+
+/**
+ * Extend or end a run of silent input with this block
+ * @return true once the run has lasted long enough to skip work
+ */
+bool silentRun(const float *buffer, size_t frames, size_t &silentFrames) {
+  float peak = 0.0f;
+  for (size_t i = 0; i < frames; ++i) {
+    peak = std::max(peak, std::abs(buffer[i]));
+  }
+  if (peak >= ProcessingChain::SILENCE_SKIP_LEVEL) {
+    silentFrames = 0;
+    return false;
+  }
+  silentFrames = std::min(silentFrames + frames,
+                          ProcessingChain::SILENCE_SKIP_FRAMES);
+  return silentFrames >= ProcessingChain::SILENCE_SKIP_FRAMES;
+}
+
+} // namespace
+
+ProcessingChain::ProcessingChain(size_t scratchFrames)
+    : scratch_(arena_.resource()) {
+  // Chain state goes into the arena in the order process() runs it, so
+  // each block walks one contiguous region front to back
+  std::pmr::memory_resource *memory = arena_.resource();
+  inputMetering_ = arena_.make<Metering>(memory);
+  rnnoise_ = arena_.make<RNNoiseProcessor>(memory);
+  // The dynamics stages keep no delay line of their own: they share one
+  expander_ = arena_.make<Expander>(nullptr);
+  equalizer_ = arena_.make<Equalizer>();
+  compressor_ = arena_.make<Compressor>(nullptr);
+  lookahead_ = arena_.make<LookaheadDelay>(memory);
+  limiter_ = arena_.make<Limiter>(nullptr);
+  outputMetering_ = arena_.make<Metering>(memory);
+  scratch_.resize(scratchFrames, 0.0f);
+}
+
+ProcessingChain::~ProcessingChain() = default;
+
+ProcessingChain::AiModel ProcessingChain::parseAiModel(
+    const std::string &name) {
+  if (name == "rnnoise") {
+    return AiModel::RNNoise;
+  }
+  if (name == "deepfilter") {
+    return AiModel::DeepFilter;
+  }
+  return AiModel::None;
+}
+
+bool ProcessingChain::loadModel(const Config &config) {
+  aiModel_.store(parseAiModel(config.aiModel));
+
+  if (!rnnoise_->initialize()) {
+    WAM_LOG_ERROR("Failed to initialize RNNoise");
+    return false;
+  }
+  rnnoise_->setAttenuation(config.aiSettings.rnnoise.attenuation);
+
+#ifdef USE_DEEPFILTER
+  // Alternate model: only loaded when selected (AI model changes take
+  // effect on the next start)
+  if (config.aiModel == "deepfilter") {
+    deepfilter_ = std::make_unique<DeepFilterProcessor>();
+    if (!deepfilter_->initialize(config.aiSettings.deepfilter.modelPath)) {
+      WAM_LOG_WARNING("Failed to initialize DeepFilterNet");
+      deepfilter_.reset();
+    }
+  }
+#endif
+
+  return true;
+}
+
+void ProcessingChain::configure(const Config &config) {
+  aiModel_.store(parseAiModel(config.aiModel));
+  const StagedParams params{config.expander, config.compressor,
+                            config.limiter, config.equalizer};
+  {
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    pending_ = params;
+    pendingDynamics_ = false;
+    pendingEqBands_ = 0;
+    pendingDirty_.store(false, std::memory_order_relaxed);
+  }
+  applyDynamics(params);
+  applyEqualizer(params.equalizer, EQ_ALL_BANDS);
+}
+
+void ProcessingChain::applyChanges(const Config &config,
+                                   const ConfigDiff &changes) {
+  if (changes.has(ConfigSection::AiModel)) {
+    aiModel_.store(parseAiModel(config.aiModel));
+  }
+  if (changes.has(ConfigSection::Expander)) {
+    setExpanderParams(config.expander);
+  }
+  if (changes.has(ConfigSection::Compressor)) {
+    setCompressorParams(config.compressor);
+  }
+  if (changes.has(ConfigSection::Limiter)) {
+    setLimiterParams(config.limiter);
+  }
+
+  // Each band owns its own biquad; recompute only the bands that moved
+  uint32_t eqBands = 0;
+  if (changes.has(ConfigSection::Equalizer)) {
+    eqBands |= EQ_ENABLED;
+  }
+  if (changes.has(ConfigSection::EqHighPass)) {
+    eqBands |= EQ_HIGH_PASS;
+  }
+  if (changes.has(ConfigSection::EqLowShelf)) {
+    eqBands |= EQ_LOW_SHELF;
+  }
+  if (changes.has(ConfigSection::EqPresence)) {
+    eqBands |= EQ_PRESENCE;
+  }
+  if (changes.has(ConfigSection::EqHighShelf)) {
+    eqBands |= EQ_HIGH_SHELF;
+  }
+  if (changes.has(ConfigSection::EqDeEsser)) {
+    eqBands |= EQ_DE_ESSER;
+  }
+  if (eqBands != 0) {
+    stageEqualizer(config.equalizer, eqBands);
+  }
+
+  if (changes.has(ConfigSection::RNNoise)) {
+    rnnoise_->setAttenuation(config.aiSettings.rnnoise.attenuation);
+  }
+}
+
+void ProcessingChain::setExpanderParams(const ExpanderConfig &params) {
+  std::lock_guard<std::mutex> lock(pendingMutex_);
+  pending_.expander = params;
+  pendingDynamics_ = true;
+  pendingDirty_.store(true, std::memory_order_release);
+}
+
+void ProcessingChain::setCompressorParams(const CompressorConfig &params) {
+  std::lock_guard<std::mutex> lock(pendingMutex_);
+  pending_.compressor = params;
+  pendingDynamics_ = true;
+  pendingDirty_.store(true, std::memory_order_release);
+}
+
+void ProcessingChain::setLimiterParams(const LimiterConfig &params) {
+  std::lock_guard<std::mutex> lock(pendingMutex_);
+  pending_.limiter = params;
+  pendingDynamics_ = true;
+  pendingDirty_.store(true, std::memory_order_release);
+}
+
+void ProcessingChain::applyStagedChanges() {
+  if (!pendingDirty_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::unique_lock<std::mutex> lock(pendingMutex_, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    return; // A writer is staging more; take it all next block
+  }
+  const StagedParams params = pending_;
+  const bool dynamics = pendingDynamics_;
+  const uint32_t eqBands = pendingEqBands_;
+  pendingDynamics_ = false;
+  pendingEqBands_ = 0;
+  pendingDirty_.store(false, std::memory_order_relaxed);
+  lock.unlock();
+  if (dynamics) {
+    applyDynamics(params);
+  }
+  applyEqualizer(params.equalizer, eqBands);
+}
+
+void ProcessingChain::applyDynamics(const StagedParams &params) {
+  const ExpanderConfig &expander = params.expander;
+  expander_->setEnabled(expander.enabled);
+  expander_->setThreshold(expander.threshold);
+  expander_->setRatio(expander.ratio);
+  expander_->setAttack(expander.attack);
+  expander_->setRelease(expander.release);
+  expander_->setHysteresis(expander.hysteresis);
+  expander_->setLookahead(expander.lookahead);
+
+  const CompressorConfig &compressor = params.compressor;
+  compressor_->setEnabled(compressor.enabled);
+  compressor_->setThreshold(compressor.threshold);
+  compressor_->setRatio(compressor.ratio);
+  compressor_->setKnee(compressor.knee);
+  compressor_->setAttack(compressor.attack);
+  compressor_->setRelease(compressor.release);
+  compressor_->setMakeupGain(compressor.makeupGain);
+  compressor_->setLookahead(compressor.lookahead);
+
+  const LimiterConfig &limiter = params.limiter;
+  limiter_->setEnabled(limiter.enabled);
+  limiter_->setCeiling(limiter.ceiling);
+  limiter_->setRelease(limiter.release);
+  limiter_->setLookahead(limiter.lookahead);
+  updateLookahead();
+}
+
+void ProcessingChain::updateLookahead() {
+  size_t samples = 0;
+  if (expander_->isEnabled()) {
+    samples = std::max(samples, expander_->getLookahead());
+  }
+  if (compressor_->isEnabled()) {
+    samples = std::max(samples, compressor_->getLookahead());
+  }
+  if (limiter_->isEnabled()) {
+    samples = std::max(samples, limiter_->getLookahead());
+  }
+  lookahead_->setLookahead(samples);
+}
+
+void ProcessingChain::setEqualizerParams(const EqualizerConfig &params) {
+  stageEqualizer(params, EQ_ALL_BANDS);
+}
+
+void ProcessingChain::stageEqualizer(const EqualizerConfig &params,
+                                     uint32_t bands) {
+  std::lock_guard<std::mutex> lock(pendingMutex_);
+  pending_.equalizer = params;
+  pendingEqBands_ |= bands;
+  pendingDirty_.store(true, std::memory_order_release);
+}
+
+void ProcessingChain::applyEqualizer(const EqualizerConfig &params,
+                                     uint32_t bands) {
+  if (bands & EQ_ENABLED) {
+    equalizer_->setEnabled(params.enabled);
+  }
+  if (bands & EQ_HIGH_PASS) {
+    equalizer_->setHighPass(params.highPass.freq, params.highPass.q);
+  }
+  if (bands & EQ_LOW_SHELF) {
+    equalizer_->setLowShelf(params.lowShelf.freq, params.lowShelf.gain);
+  }
+  if (bands & EQ_PRESENCE) {
+    equalizer_->setPresence(params.presence.freq, params.presence.gain,
+                            params.presence.q);
+  }
+  if (bands & EQ_HIGH_SHELF) {
+    equalizer_->setHighShelf(params.highShelf.freq, params.highShelf.gain);
+  }
+  if (bands & EQ_DE_ESSER) {
+    equalizer_->setDeEsser(params.deEsser.freq, params.deEsser.threshold);
+    equalizer_->setDeEsserEnabled(params.deEsserEnabled);
+  }
+}
+
+void ProcessingChain::warmUpModel() {
+  // Local buffer: this runs beside warmUpDsp(), which owns scratch()
+  std::vector<float> warmUp(FRAME_SIZE);
+  for (size_t block = 0; block < WARM_UP_BLOCKS; ++block) {
+    fillWarmUpSignal(warmUp.data(), warmUp.size(), block * FRAME_SIZE);
+    rnnoise_->process(warmUp.data(), warmUp.size());
+  }
+  rnnoise_->reset();
+}
+
+void ProcessingChain::warmUpDsp() {
+  IDSPProcessor *processors[] = {expander_.get(), equalizer_.get(),
+                                 compressor_.get(), limiter_.get()};
+  for (size_t block = 0; block < WARM_UP_BLOCKS; ++block) {
+    fillWarmUpSignal(scratch_.data(), scratch_.size(),
+                     block * scratch_.size());
+    inputMetering_->process(scratch_.data(), scratch_.size());
+    processDsp(scratch_.data(), scratch_.size());
+  }
+  for (IDSPProcessor *processor : processors) {
+    processor->reset();
+  }
+  lookahead_->reset();
+  dspSilentFrames_ = 0;
+  inputMetering_->reset();
+  outputMetering_->reset();
+  std::fill(scratch_.begin(), scratch_.end(), 0.0f);
+}
+
+void ProcessingChain::process(float *buffer, size_t frames) {
+  processAi(buffer, frames);
+  processDsp(buffer, frames);
+}
+
+void ProcessingChain::processAi(float *buffer, size_t frames) {
+  if (frames % FRAME_SIZE != 0) {
+    unalignedBlocks_.store(true, std::memory_order_relaxed);
+  }
+
+  // Update input metering
+  {
+    WAM_TRACE_SCOPE("InputMetering");
+    inputMetering_->process(buffer, frames);
+  }
+
+  // Bypass mode - skip all processing
+  if (bypass_.load()) {
+    return;
+  }
+
+  if (skipSilence_.load(std::memory_order_relaxed) &&
+      silentRun(buffer, frames, aiSilentFrames_)) {
+    std::fill(buffer, buffer + frames, 0.0f);
+    skippedBlocks_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  // AI Enhancement (RNNoise or DeepFilterNet)
+  const AiModel model = aiModel_.load(std::memory_order_relaxed);
+  if (model == AiModel::RNNoise) {
+    WAM_TRACE_SCOPE("RNNoise");
+    rnnoise_->process(buffer, frames);
+  }
+#ifdef USE_DEEPFILTER
+  else if (model == AiModel::DeepFilter && deepfilter_) {
+    WAM_TRACE_SCOPE("DeepFilter");
+    deepfilter_->process(buffer, frames);
+  }
+#endif
+}
+
+void ProcessingChain::processDsp(float *buffer, size_t frames) {
+  applyStagedChanges();
+
+  // Bypass mode - output metering sees the unprocessed audio; past
+  // sustained silence the stages' tails have died away, so skip them
+  const bool bypass = bypass_.load();
+  if (!bypass && skipSilence_.load(std::memory_order_relaxed) &&
+      silentRun(buffer, frames, dspSilentFrames_)) {
+    std::fill(buffer, buffer + frames, 0.0f);
+  } else if (!bypass) {
+    // From the first stage with lookahead on, gains go on at the tap
+    const bool delayed = lookahead_->lookahead() > 0;
+    const bool expanderAtTap = delayed && expander_->isEnabled() &&
+                               expander_->getLookahead() > 0;
+    const bool compressorAtTap =
+        delayed && compressor_->isEnabled() &&
+        (expanderAtTap || compressor_->getLookahead() > 0);
+    const bool limiterAtTap = delayed && limiter_->isEnabled();
+
+    // 1. Expander (noise gate)
+    if (expander_->isEnabled() && !expanderAtTap) {
+      WAM_TRACE_SCOPE("Expander");
+      expander_->process(buffer, frames);
+    }
+
+    // 2. Equalizer (before compression for tonal shaping)
+    if (equalizer_->isEnabled()) {
+      WAM_TRACE_SCOPE("Equalizer");
+      equalizer_->process(buffer, frames);
+    }
+
+    // 3. Compressor
+    if (compressor_->isEnabled() && !compressorAtTap) {
+      WAM_TRACE_SCOPE("Compressor");
+      compressor_->process(buffer, frames);
+    }
+
+    // 4. Limiter
+    if (limiter_->isEnabled() && !limiterAtTap) {
+      WAM_TRACE_SCOPE("Limiter");
+      limiter_->process(buffer, frames);
+    }
+
+    // Lookahead stages, through the shared line
+    if (delayed) {
+      WAM_TRACE_SCOPE("Lookahead");
+      processLookahead(buffer, frames, expanderAtTap, compressorAtTap,
+                       limiterAtTap);
+    }
+  }
+
+  // Update output metering
+  {
+    WAM_TRACE_SCOPE("OutputMetering");
+    outputMetering_->process(buffer, frames);
+  }
+}
+
+void ProcessingChain::processLookahead(float *buffer, size_t frames,
+                                       bool expanderAtTap,
+                                       bool compressorAtTap,
+                                       bool limiterAtTap) {
+  LookaheadDelay &line = *lookahead_;
+  // Gains ahead of the limiter can rise after its window has seen a
+  // sample (a gate opening): the ceiling then holds at the tap
+  const bool holdCeiling = limiterAtTap && (expanderAtTap || compressorAtTap);
+  for (size_t i = 0; i < frames; ++i) {
+    line.push(buffer[i]);
+
+    // Each detector sees the gain the stages before it apply
+    float gain = 1.0f;
+    if (expanderAtTap) {
+      gain *= expander_->tapGain(line, gain);
+    }
+    if (compressorAtTap) {
+      gain *= compressor_->tapGain(line, gain);
+    }
+    if (limiterAtTap) {
+      gain *= limiter_->tapGain(line, gain);
+    }
+    if (holdCeiling) {
+      gain = std::min(gain, limiter_->ceilingGain(std::abs(line.tap())));
+    }
+    buffer[i] = line.tap() * gain;
+  }
+}
+
+void ProcessingChain::reset() {
+  rnnoise_->reset();
+#ifdef USE_DEEPFILTER
+  if (deepfilter_) {
+    deepfilter_->reset();
+  }
+#endif
+  expander_->reset();
+  equalizer_->reset();
+  compressor_->reset();
+  lookahead_->reset();
+  limiter_->reset();
+  inputMetering_->reset();
+  outputMetering_->reset();
+  unalignedBlocks_.store(false, std::memory_order_relaxed);
+  aiSilentFrames_ = 0;
+  dspSilentFrames_ = 0;
+}
+
+void ProcessingChain::snapshotSections(
+    uint64_t (&sizes)[SNAPSHOT_SECTIONS]) const {
+  sizes[0] = CHAIN_STATE_SIZE;
+  sizes[1] = rnnoise_->stateSize();
+  sizes[2] = expander_->stateSize();
+  sizes[3] = equalizer_->stateSize();
+  sizes[4] = compressor_->stateSize();
+  sizes[5] = lookahead_->stateSize();
+  sizes[6] = limiter_->stateSize();
+}
+
+size_t ProcessingChain::snapshotSize() const {
+  uint64_t sizes[SNAPSHOT_SECTIONS];
+  snapshotSections(sizes);
+  size_t total = sizeof(SnapshotHeader);
+  for (const uint64_t size : sizes) {
+    total += static_cast<size_t>(size);
+  }
+  return total;
+}
+
+bool ProcessingChain::saveSnapshot(ChainSnapshot &snapshot) const {
+  SnapshotHeader header{SNAPSHOT_MAGIC, SNAPSHOT_VERSION, SAMPLE_RATE,
+                        SNAPSHOT_SECTIONS, {}};
+  static_assert(std::size(header.sizes) == SNAPSHOT_SECTIONS);
+  snapshotSections(header.sizes);
+
+  const size_t total = snapshotSize();
+  snapshot.bytes_.resize(total); // Within the reserved capacity
+  StateWriter writer(snapshot.bytes_.data(), total);
+  writer.write(header);
+  writer.write(static_cast<uint64_t>(aiSilentFrames_));
+  writer.write(static_cast<uint64_t>(dspSilentFrames_));
+  writer.write(static_cast<uint8_t>(
+      unalignedBlocks_.load(std::memory_order_relaxed) ? 1 : 0));
+  rnnoise_->saveState(writer);
+  expander_->saveState(writer);
+  equalizer_->saveState(writer);
+  compressor_->saveState(writer);
+  lookahead_->saveState(writer);
+  limiter_->saveState(writer);
+
+  if (!writer.ok() || writer.size() != total) {
+    snapshot.clear();
+    return false;
+  }
+  return true;
+}
+
+bool ProcessingChain::restoreSnapshot(const ChainSnapshot &snapshot) {
+  StateReader reader(snapshot.data(), snapshot.size());
+  SnapshotHeader header{};
+  reader.read(header);
+  if (!reader.ok() || header.magic != SNAPSHOT_MAGIC ||
+      header.version != SNAPSHOT_VERSION ||
+      header.sampleRate != static_cast<uint32_t>(SAMPLE_RATE) ||
+      header.sections != SNAPSHOT_SECTIONS) {
+    return false;
+  }
+
+  // Every section must match this chain's layout before anything changes
+  uint64_t sizes[SNAPSHOT_SECTIONS];
+  snapshotSections(sizes);
+  if (!std::equal(std::begin(sizes), std::end(sizes), header.sizes) ||
+      snapshotSize() != snapshot.size()) {
+    return false;
+  }
+
+  uint64_t aiSilentFrames = 0;
+  uint64_t dspSilentFrames = 0;
+  uint8_t unaligned = 0;
+  reader.read(aiSilentFrames);
+  reader.read(dspSilentFrames);
+  reader.read(unaligned);
+  aiSilentFrames_ = static_cast<size_t>(
+      std::min<uint64_t>(aiSilentFrames, SILENCE_SKIP_FRAMES));
+  dspSilentFrames_ = static_cast<size_t>(
+      std::min<uint64_t>(dspSilentFrames, SILENCE_SKIP_FRAMES));
+  unalignedBlocks_.store(unaligned != 0, std::memory_order_relaxed);
+  rnnoise_->loadState(reader);
+  expander_->loadState(reader);
+  equalizer_->loadState(reader);
+  compressor_->loadState(reader);
+  lookahead_->loadState(reader);
+  limiter_->loadState(reader);
+
+  if (!reader.ok() || reader.remaining() != 0) {
+    WAM_LOG_WARNING("Corrupt chain snapshot; state reset");
+    reset();
+    return false;
+  }
+  return true;
+}
+
+size_t ProcessingChain::latencyFrames() const {
+  size_t frames = lookahead_->lookahead();
+  if (aiModel_.load(std::memory_order_relaxed) == AiModel::RNNoise &&
+      unalignedBlocks_.load(std::memory_order_relaxed)) {
+    frames += FRAME_SIZE - 1;
+  }
+  return frames;
+}
+
+size_t ProcessingChain::countSubnormalState() const {
+  size_t count = 0;
+  const IDSPProcessor *processors[] = {expander_.get(), equalizer_.get(),
+                                       compressor_.get(), limiter_.get()};
+  for (const IDSPProcessor *processor : processors) {
+    count += processor->countSubnormalState();
+  }
+  return count + lookahead_->countSubnormalState();
+}
+
+float ProcessingChain::getVADProbability() const {
+  return rnnoise_->getVADProbability();
+}
+
+float ProcessingChain::getCompressorReduction() const {
+  return compressor_->getGainReduction();
+}
+
+float ProcessingChain::getLimiterReduction() const {
+  return limiter_->getGainReduction();
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,298 @@
+/**
+ * WindowsAiMic - Processing Chain Header
+ *
+ * The AI model and DSP processors in the order every block runs through
+ * them, with their state in one AudioArena. Shared by the engine and the
+ * embeddable C API (wam_chain.h); nothing here touches devices or IPC.
+ */
+
+#pragma once
+
+#include "../config/config_schema.h"
+#include "../config/config_types.h"
+#include "../platform/audio_arena.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+class RNNoiseProcessor;
+class Expander;
+class Compressor;
+class Limiter;
+class LookaheadDelay;
+class Equalizer;
+class Metering;
+#ifdef USE_DEEPFILTER
+class DeepFilterProcessor;
+#endif
+
+/**
+ * Serialized running state of a ProcessingChain
+ *
+ * Envelopes, filter memories, the limiter's delay line, the buffered AI
+ * frames and the model's recurrent state; not parameters or meters. Load
+ * it into a chain configured the same way to carry on where the saving
+ * chain stopped. Bytes are for the build that wrote them.
+ */
+class ChainSnapshot {
+public:
+  /** Make room up front so saves don't allocate */
+  void reserve(size_t bytes) { bytes_.reserve(bytes); }
+
+  /** Take bytes saved earlier (e.g. read from a file) */
+  void assign(const uint8_t *data, size_t size) {
+    bytes_.assign(data, data + size);
+  }
+
+  void clear() { bytes_.clear(); }
+  const uint8_t *data() const { return bytes_.data(); }
+  size_t size() const { return bytes_.size(); }
+  size_t capacity() const { return bytes_.capacity(); }
+  bool empty() const { return bytes_.empty(); }
+
+private:
+  friend class ProcessingChain;
+  std::vector<uint8_t> bytes_;
+};
+
+/**
+ * AI enhancement followed by expander, EQ, compressor and limiter
+ *
+ * Dynamics stages with lookahead share one delay line: each detects on
+ * the samples ahead of the line's tap and its gain is applied once at the
+ * tap, as are the gains of every dynamics stage after the first with
+ * lookahead. Stages before that run in place; the EQ always runs ahead
+ * of the line (it is linear, so it commutes with the gains there).
+ *
+ * Mono, 48 kHz, processed in place. Blocks of any size are accepted;
+ * multiples of FRAME_SIZE add no AI buffering delay. Set-up calls
+ * (constructor, loadModel, configure, warm-ups) come before the audio
+ * thread starts; parameter changes may follow from another thread as the
+ * engine has always done. Those changes are staged and taken by the audio
+ * thread at the start of its next block: a lookahead change moves the
+ * shared line's tap, and an EQ band must not be redesigned mid-block.
+ */
+class ProcessingChain {
+public:
+  static constexpr int SAMPLE_RATE = 48000;  // Required for RNNoise
+  static constexpr size_t FRAME_SIZE = 480;  // RNNoise frame, 10 ms
+  static constexpr size_t ARENA_SIZE = 2 * 1024 * 1024; // One huge page
+
+  // Silence skipping: a half skips once its input stayed below the level
+  // for this long; the first louder block is processed in full
+  static constexpr float SILENCE_SKIP_LEVEL = 1e-4f; // -80 dBFS peak
+  static constexpr size_t SILENCE_SKIP_FRAMES = SAMPLE_RATE / 2; // 500 ms
+
+  /**
+   * Allocate every processor in the arena, in processing order
+   * @param scratchFrames Size of scratch() (after the processors)
+   */
+  explicit ProcessingChain(size_t scratchFrames = FRAME_SIZE);
+  ~ProcessingChain();
+
+  // Non-copyable
+  ProcessingChain(const ProcessingChain &) = delete;
+  ProcessingChain &operator=(const ProcessingChain &) = delete;
+
+  /**
+   * Create the AI model state (slow; may run beside configure())
+   * @return false if RNNoise could not be created
+   */
+  bool loadModel(const Config &config);
+
+  /**
+   * Design every DSP filter and set every parameter from `config`
+   */
+  void configure(const Config &config);
+
+  /**
+   * Push the sections in `changes` to their processors
+   * Only processors (and EQ bands) whose fields changed are touched.
+   */
+  void applyChanges(const Config &config, const ConfigDiff &changes);
+
+  // The setters stage their section for the next processDsp()
+  void setExpanderParams(const ExpanderConfig &params);
+  void setCompressorParams(const CompressorConfig &params);
+  void setLimiterParams(const LimiterConfig &params);
+  void setEqualizerParams(const EqualizerConfig &params);
+
+  /**
+   * Take staged changes now rather than at the next block
+   * Only on the thread that runs processDsp(), between blocks.
+   */
+  void applyStagedChanges();
+
+  /**
+   * Run a few quiet blocks through the model so the first real block
+   * doesn't pay for cold caches and first-touch pages, then clear state
+   */
+  void warmUpModel();
+
+  /**
+   * Same for the DSP stages and meters; uses scratch()
+   * reset() keeps the coefficients designed by configure().
+   */
+  void warmUpDsp();
+
+  /**
+   * Run one block through the chain in place
+   */
+  void process(float *buffer, size_t frames);
+
+  /**
+   * The two halves of process(), for running the AI stage a block ahead
+   * on its own thread: input metering and the model, then the DSP stages
+   * and output metering. Each half must stay on one thread.
+   */
+  void processAi(float *buffer, size_t frames);
+  void processDsp(float *buffer, size_t frames);
+
+  /**
+   * Clear all processor state and meters; parameters are kept
+   */
+  void reset();
+
+  /**
+   * Bytes saveSnapshot() writes with the current parameters
+   */
+  size_t snapshotSize() const;
+
+  /**
+   * Save the running state, or restore it, at a block boundary
+   *
+   * Neither allocates once `snapshot` has snapshotSize() reserved, so
+   * both may run on the audio thread between blocks; not while another
+   * thread is inside process(). A restore is checked against this
+   * chain's layout (sample rate, model, limiter lookahead) before any
+   * state is touched and fails without changes on a mismatch; a corrupt
+   * section found part way leaves the chain reset.
+   */
+  bool saveSnapshot(ChainSnapshot &snapshot) const;
+  bool restoreSnapshot(const ChainSnapshot &snapshot);
+
+  void setBypass(bool bypass) { bypass_.store(bypass); }
+  bool isBypassed() const { return bypass_.load(std::memory_order_relaxed); }
+
+  /**
+   * Skip work on sustained silence (power saving)
+   *
+   * After SILENCE_SKIP_FRAMES of input below SILENCE_SKIP_LEVEL, the AI
+   * stage outputs zeros instead of running the model; likewise the DSP
+   * stages on their own input, once any tail has died away. Meters keep
+   * running.
+   */
+  void setSkipSilence(bool skip) { skipSilence_.store(skip); }
+
+  /**
+   * Blocks whose AI stage was skipped as silence
+   */
+  uint64_t getSkippedBlocks() const {
+    return skippedBlocks_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Algorithmic delay in frames: the largest enabled lookahead plus, once
+   * a block that is not a multiple of FRAME_SIZE has been seen, the
+   * partial AI frame being buffered (worst case FRAME_SIZE - 1)
+   */
+  size_t latencyFrames() const;
+
+  /**
+   * Subnormal values left in the DSP stages' state (debug check)
+   */
+  size_t countSubnormalState() const;
+
+  // Meters of the last block
+  float getVADProbability() const;
+  float getCompressorReduction() const;
+  float getLimiterReduction() const;
+  const Metering &inputMetering() const { return *inputMetering_; }
+  const Metering &outputMetering() const { return *outputMetering_; }
+
+  /**
+   * Block-sized buffer in the arena, right after the chain state
+   */
+  float *scratch() { return scratch_.data(); }
+  size_t scratchFrames() const { return scratch_.size(); }
+
+  const AudioArena &arena() const { return arena_; }
+
+private:
+  enum class AiModel { None, RNNoise, DeepFilter };
+  static AiModel parseAiModel(const std::string &name);
+
+  // Snapshot sections: the chain's own counters, then each processor in
+  // processing order
+  static constexpr size_t SNAPSHOT_SECTIONS = 7;
+  void snapshotSections(uint64_t (&sizes)[SNAPSHOT_SECTIONS]) const;
+
+  struct StagedParams {
+    ExpanderConfig expander;
+    CompressorConfig compressor;
+    LimiterConfig limiter;
+    EqualizerConfig equalizer;
+  };
+
+  // EQ bands to redesign, one bit each
+  static constexpr uint32_t EQ_ENABLED = 1u << 0;
+  static constexpr uint32_t EQ_HIGH_PASS = 1u << 1;
+  static constexpr uint32_t EQ_LOW_SHELF = 1u << 2;
+  static constexpr uint32_t EQ_PRESENCE = 1u << 3;
+  static constexpr uint32_t EQ_HIGH_SHELF = 1u << 4;
+  static constexpr uint32_t EQ_DE_ESSER = 1u << 5;
+  static constexpr uint32_t EQ_ALL_BANDS = (1u << 6) - 1;
+
+  void stageEqualizer(const EqualizerConfig &params, uint32_t bands);
+
+  // On the thread that runs processDsp() (or before it starts)
+  void applyDynamics(const StagedParams &params);
+  void applyEqualizer(const EqualizerConfig &params, uint32_t bands);
+
+  // Set the shared line to the largest lookahead of the enabled stages
+  void updateLookahead();
+  void processLookahead(float *buffer, size_t frames, bool expanderAtTap,
+                        bool compressorAtTap, bool limiterAtTap);
+
+  AudioArena arena_{ARENA_SIZE}; // Declared before everything it holds
+
+  ArenaPtr<Metering> inputMetering_;
+  ArenaPtr<RNNoiseProcessor> rnnoise_;
+  ArenaPtr<Expander> expander_;
+  ArenaPtr<Equalizer> equalizer_;
+  ArenaPtr<Compressor> compressor_;
+  ArenaPtr<LookaheadDelay> lookahead_;
+  ArenaPtr<Limiter> limiter_;
+  ArenaPtr<Metering> outputMetering_;
+  std::pmr::vector<float> scratch_;
+#ifdef USE_DEEPFILTER
+  std::unique_ptr<DeepFilterProcessor> deepfilter_;
+#endif
+
+  std::atomic<AiModel> aiModel_{AiModel::RNNoise};
+  std::atomic<bool> bypass_{false};
+  std::atomic<bool> unalignedBlocks_{false};
+  std::atomic<bool> skipSilence_{false};
+  std::atomic<uint64_t> skippedBlocks_{0};
+
+  // Parameters staged by control threads; the audio thread only
+  // try-locks, so a block never waits on a writer
+  std::mutex pendingMutex_;
+  StagedParams pending_;
+  bool pendingDynamics_ = false; // Under pendingMutex_
+  uint32_t pendingEqBands_ = 0;  // Under pendingMutex_
+  std::atomic<bool> pendingDirty_{false};
+
+  // Silent input so far, one count per half (each on its own thread)
+  size_t aiSilentFrames_ = 0;
+  size_t dspSilentFrames_ = 0;
+};
+
+} // namespace WindowsAiMic
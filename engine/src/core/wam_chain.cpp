@@ -0,0 +1,238 @@
+/**
+ * WindowsAiMic - Processing Chain C API Implementation
+ */
+
+#include "wam_chain.h"
+#include "../config/config_schema.h"
+#include "../config/presets.h"
+#include "../dsp/metering.h"
+#include "processing_chain.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace WindowsAiMic;
+
+static_assert(WAM_CHAIN_SAMPLE_RATE == ProcessingChain::SAMPLE_RATE);
+static_assert(WAM_CHAIN_FRAME_SIZE == ProcessingChain::FRAME_SIZE);
+
+struct wam_chain {
+  ProcessingChain chain;
+  Config config;
+  ChainSnapshot snapshot; // Staging for save / restore
+};
+
+namespace {
+
+const ConfigField *numericField(const char *name) {
+  if (!name) {
+    return nullptr;
+  }
+  const ConfigField *field = findConfigField(name);
+  if (!field || (field->type != ConfigFieldType::Float &&
+                 field->type != ConfigFieldType::Int &&
+                 field->type != ConfigFieldType::Bool)) {
+    return nullptr;
+  }
+  return field;
+}
+
+// Push whatever differs between the chain's config and `config`
+void apply(wam_chain *chain, const Config &config) {
+  const ConfigDiff changes = diff(chain->config, config);
+  chain->config = config;
+  if (!changes.empty()) {
+    chain->chain.applyChanges(config, changes);
+    chain->chain.applyStagedChanges(); // The caller's thread runs blocks
+  }
+}
+
+} // namespace
+
+extern "C" {
+
+const char *wam_version(void) { return "1.0.0"; }
+
+wam_chain *wam_chain_create(const char *preset) {
+  wam_chain *chain = new (std::nothrow) wam_chain();
+  if (!chain) {
+    return nullptr;
+  }
+  if (preset && *preset) {
+    if (!applyPresetSettings(chain->config, preset)) {
+      delete chain;
+      return nullptr;
+    }
+    chain->config.activePreset = preset;
+  }
+  if (!chain->chain.loadModel(chain->config)) {
+    delete chain;
+    return nullptr;
+  }
+  chain->chain.configure(chain->config);
+  return chain;
+}
+
+void wam_chain_destroy(wam_chain *chain) { delete chain; }
+
+wam_status wam_chain_process(wam_chain *chain, float *samples,
+                             size_t frames) {
+  if (!chain || (!samples && frames > 0)) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  if (frames > 0) {
+    chain->chain.process(samples, frames);
+  }
+  return WAM_OK;
+}
+
+void wam_chain_reset(wam_chain *chain) {
+  if (chain) {
+    chain->chain.reset();
+  }
+}
+
+wam_status wam_chain_set_param(wam_chain *chain, const char *name,
+                               float value) {
+  if (!chain) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  const ConfigField *field = numericField(name);
+  if (!field) {
+    return WAM_ERROR_UNKNOWN_PARAM;
+  }
+
+  Config config = chain->config;
+  void *target = field->locate(config);
+  if (field->type == ConfigFieldType::Bool) {
+    *static_cast<bool *>(target) = value != 0.0f;
+  } else {
+    const float clamped = std::clamp(value, field->min, field->max);
+    if (field->type == ConfigFieldType::Int) {
+      *static_cast<int *>(target) = static_cast<int>(clamped);
+    } else {
+      *static_cast<float *>(target) = clamped;
+    }
+  }
+  apply(chain, config);
+  return WAM_OK;
+}
+
+wam_status wam_chain_get_param(const wam_chain *chain, const char *name,
+                               float *value) {
+  if (!chain || !value) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  const ConfigField *field = numericField(name);
+  if (!field) {
+    return WAM_ERROR_UNKNOWN_PARAM;
+  }
+
+  const void *source = field->locate(const_cast<Config &>(chain->config));
+  switch (field->type) {
+  case ConfigFieldType::Bool:
+    *value = *static_cast<const bool *>(source) ? 1.0f : 0.0f;
+    break;
+  case ConfigFieldType::Int:
+    *value = static_cast<float>(*static_cast<const int *>(source));
+    break;
+  default:
+    *value = *static_cast<const float *>(source);
+    break;
+  }
+  return WAM_OK;
+}
+
+wam_status wam_chain_apply_preset(wam_chain *chain, const char *preset) {
+  if (!chain || !preset) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  Config config = chain->config;
+  if (!applyPresetSettings(config, preset)) {
+    return WAM_ERROR_UNKNOWN_PRESET;
+  }
+  config.activePreset = preset;
+  apply(chain, config);
+  return WAM_OK;
+}
+
+wam_status wam_chain_load_config(wam_chain *chain, const char *json) {
+  if (!chain || !json) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  Config config = chain->config;
+  if (!parseConfig(json, config).ok) {
+    return WAM_ERROR_INVALID_CONFIG;
+  }
+  apply(chain, config);
+  return WAM_OK;
+}
+
+void wam_chain_set_bypass(wam_chain *chain, int bypass) {
+  if (chain) {
+    chain->chain.setBypass(bypass != 0);
+  }
+}
+
+size_t wam_chain_state_size(const wam_chain *chain) {
+  return chain ? chain->chain.snapshotSize() : 0;
+}
+
+wam_status wam_chain_save_state(wam_chain *chain, void *buffer,
+                                size_t capacity, size_t *written) {
+  if (!chain || !buffer) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  if (capacity < chain->chain.snapshotSize()) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  if (!chain->chain.saveSnapshot(chain->snapshot)) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  std::memcpy(buffer, chain->snapshot.data(), chain->snapshot.size());
+  if (written) {
+    *written = chain->snapshot.size();
+  }
+  return WAM_OK;
+}
+
+wam_status wam_chain_restore_state(wam_chain *chain, const void *buffer,
+                                   size_t size) {
+  if (!chain || (!buffer && size > 0)) {
+    return WAM_ERROR_INVALID_ARGUMENT;
+  }
+  chain->snapshot.assign(static_cast<const uint8_t *>(buffer), size);
+  if (!chain->chain.restoreSnapshot(chain->snapshot)) {
+    return WAM_ERROR_STATE_MISMATCH;
+  }
+  return WAM_OK;
+}
+
+size_t wam_chain_latency_frames(const wam_chain *chain) {
+  return chain ? chain->chain.latencyFrames() : 0;
+}
+
+double wam_chain_latency_ms(const wam_chain *chain) {
+  return static_cast<double>(wam_chain_latency_frames(chain)) * 1000.0 /
+         ProcessingChain::SAMPLE_RATE;
+}
+
+void wam_chain_get_meters(const wam_chain *chain, wam_chain_meters *meters) {
+  if (!chain || !meters) {
+    return;
+  }
+  const ProcessingChain &processing = chain->chain;
+  const Metering &input = processing.inputMetering();
+  const Metering &output = processing.outputMetering();
+  meters->input_peak_db = input.getPeak();
+  meters->input_rms_db = input.getRMS();
+  meters->output_peak_db = output.getPeak();
+  meters->output_rms_db = output.getRMS();
+  meters->output_lufs = output.getLUFSShortTerm();
+  meters->compressor_reduction_db = processing.getCompressorReduction();
+  meters->limiter_reduction_db = processing.getLimiterReduction();
+  meters->vad_probability = processing.getVADProbability();
+}
+
+} // extern "C"
@@ -0,0 +1,148 @@
+/**
+ * WindowsAiMic - Processing Chain C API
+ *
+ * The engine's AI + DSP chain (ProcessingChain) behind a plain C ABI, for
+ * embedding the same processing in other pipelines or benchmarking it in
+ * isolation. Link WindowsAiMicCore statically or load the WindowsAiMicChain
+ * shared library.
+ *
+ * Audio is mono float at 48 kHz, processed in place. Parameters use the
+ * dotted config.json paths ("compressor.threshold", "limiter.enabled").
+ * A chain is not thread-safe: call it from one thread at a time.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#if defined(_WIN32) && defined(WAM_CHAIN_SHARED)
+#if defined(WAM_CHAIN_BUILD)
+#define WAM_API __declspec(dllexport)
+#else
+#define WAM_API __declspec(dllimport)
+#endif
+#elif defined(WAM_CHAIN_BUILD)
+#define WAM_API __attribute__((visibility("default")))
+#else
+#define WAM_API
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define WAM_CHAIN_SAMPLE_RATE 48000
+#define WAM_CHAIN_FRAME_SIZE 480 /* Blocks that are a multiple add no delay */
+
+typedef struct wam_chain wam_chain;
+
+typedef enum wam_status {
+  WAM_OK = 0,
+  WAM_ERROR_INVALID_ARGUMENT = -1,
+  WAM_ERROR_UNKNOWN_PARAM = -2,  /* Not a numeric or boolean config path */
+  WAM_ERROR_UNKNOWN_PRESET = -3,
+  WAM_ERROR_INVALID_CONFIG = -4, /* JSON rejected; settings unchanged */
+  WAM_ERROR_INIT = -5,
+  WAM_ERROR_STATE_MISMATCH = -6  /* Saved by a differently set-up chain */
+} wam_status;
+
+/**
+ * Levels and gain reduction after the last processed block
+ */
+typedef struct wam_chain_meters {
+  float input_peak_db;
+  float input_rms_db;
+  float output_peak_db;
+  float output_rms_db;
+  float output_lufs;
+  float compressor_reduction_db;
+  float limiter_reduction_db;
+  float vad_probability; /* 0..1, RNNoise voice activity */
+} wam_chain_meters;
+
+/**
+ * Library version ("1.0.0")
+ */
+WAM_API const char *wam_version(void);
+
+/**
+ * Create a chain with default settings, or a preset's settings
+ * @param preset "podcast", "meeting", "streaming", or NULL for defaults
+ * @return NULL if the preset is unknown or the model failed to load
+ */
+WAM_API wam_chain *wam_chain_create(const char *preset);
+
+WAM_API void wam_chain_destroy(wam_chain *chain);
+
+/**
+ * Process `frames` samples in place
+ */
+WAM_API wam_status wam_chain_process(wam_chain *chain, float *samples,
+                                     size_t frames);
+
+/**
+ * Clear filter, envelope and model state; settings are kept
+ */
+WAM_API void wam_chain_reset(wam_chain *chain);
+
+/**
+ * Set one numeric or boolean parameter by config path
+ * Values outside the schema range are clamped; booleans are 0 or non-zero.
+ */
+WAM_API wam_status wam_chain_set_param(wam_chain *chain, const char *name,
+                                       float value);
+
+WAM_API wam_status wam_chain_get_param(const wam_chain *chain,
+                                       const char *name, float *value);
+
+/**
+ * Apply a named preset on top of the current settings
+ */
+WAM_API wam_status wam_chain_apply_preset(wam_chain *chain,
+                                          const char *preset);
+
+/**
+ * Apply a config document (the engine's config.json format)
+ * Fields the document leaves out keep their current values.
+ */
+WAM_API wam_status wam_chain_load_config(wam_chain *chain, const char *json);
+
+WAM_API void wam_chain_set_bypass(wam_chain *chain, int bypass);
+
+/**
+ * Bytes wam_chain_save_state() writes with the current settings
+ */
+WAM_API size_t wam_chain_state_size(const wam_chain *chain);
+
+/**
+ * Save the running state: envelopes, filter and delay memories, buffered
+ * frames and the model's state. Restoring it into a chain with the same
+ * settings carries on sample for sample, e.g. to pick up after a restart
+ * or to start each chunk of a file processed in parallel warm.
+ * @param written Bytes used (wam_chain_state_size()); may be NULL
+ * @return WAM_ERROR_INVALID_ARGUMENT if `capacity` is too small
+ */
+WAM_API wam_status wam_chain_save_state(wam_chain *chain, void *buffer,
+                                        size_t capacity, size_t *written);
+
+/**
+ * Load state saved by wam_chain_save_state()
+ * @return WAM_ERROR_STATE_MISMATCH, with the state unchanged, if it came
+ * from another build or settings that change its layout (limiter
+ * lookahead); corrupt contents also reset the chain
+ */
+WAM_API wam_status wam_chain_restore_state(wam_chain *chain,
+                                           const void *buffer, size_t size);
+
+/**
+ * Algorithmic delay of the chain (limiter lookahead, buffered AI frame)
+ */
+WAM_API size_t wam_chain_latency_frames(const wam_chain *chain);
+WAM_API double wam_chain_latency_ms(const wam_chain *chain);
+
+WAM_API void wam_chain_get_meters(const wam_chain *chain,
+                                  wam_chain_meters *meters);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,307 @@
+/**
+ * WindowsAiMic - Flight Recorder Implementation
+ */
+
+#include "flight_recorder.h"
+#include "../audio/wav_file.h"
+#include "../platform/clock.h"
+#include "../platform/thread_utils.h"
+#include "logger.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <ostream>
+
+namespace WindowsAiMic {
+
+namespace {
+
+uint64_t wallClockMs() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::system_clock::now().time_since_epoch())
+          .count());
+}
+
+// JSON has no NaN or Inf, so a non-finite value is written as null. The
+// exponent bits are tested because -ffast-math lets std::isfinite fold
+struct JsonNumber {
+  float value;
+};
+
+std::ostream &operator<<(std::ostream &out, JsonNumber number) {
+  if ((std::bit_cast<uint32_t>(number.value) & 0x7f800000u) == 0x7f800000u) {
+    return out << "null";
+  }
+  return out << number.value;
+}
+
+const char *tapName(size_t tap) {
+  switch (tap) {
+  case 0:
+    return "input";
+  case 1:
+    return "preai";
+  default:
+    return "output";
+  }
+}
+
+} // namespace
+
+FlightRecorder::FlightRecorder(float seconds, int sampleRate, size_t blockSize)
+    : sampleRate_(sampleRate) {
+  const size_t capacity =
+      std::max<size_t>(blockSize, static_cast<size_t>(seconds * sampleRate));
+
+  for (auto &tap : taps_) {
+    tap.samples.assign(capacity, 0.0f);
+  }
+
+  // One record per processing block, plus slack for partial blocks
+  blocks_.resize(capacity / std::max<size_t>(blockSize, 1) + 16);
+}
+
+FlightRecorder::~FlightRecorder() { stop(); }
+
+void FlightRecorder::start(const std::string &dumpDirectory) {
+  if (running_.load()) {
+    return;
+  }
+
+  dumpDirectory_ = dumpDirectory;
+  running_ = true;
+  writerThread_ = std::thread(&FlightRecorder::writerThread, this);
+}
+
+void FlightRecorder::stop() {
+  if (!running_.load()) {
+    return;
+  }
+
+  running_ = false;
+
+  if (writerThread_.joinable()) {
+    writerThread_.join();
+  }
+}
+
+void FlightRecorder::writeAudio(RecorderTap tap, const float *samples,
+                                size_t count) {
+  AudioRing &ring = taps_[static_cast<size_t>(tap)];
+  const size_t capacity = ring.samples.size();
+
+  // Only the most recent `capacity` samples can survive anyway
+  if (count > capacity) {
+    samples += count - capacity;
+    count = capacity;
+  }
+
+  const uint64_t start = ring.counters.claim(count);
+  const size_t pos = static_cast<size_t>(start % capacity);
+  const size_t firstPart = std::min(count, capacity - pos);
+  std::memcpy(&ring.samples[pos], samples, firstPart * sizeof(float));
+  if (firstPart < count) {
+    std::memcpy(&ring.samples[0], samples + firstPart,
+                (count - firstPart) * sizeof(float));
+  }
+
+  ring.counters.publish(start + count);
+}
+
+void FlightRecorder::writeBlock(const BlockRecord &record) {
+  const uint64_t index = blockCounters_.claim(1);
+  blocks_[static_cast<size_t>(index % blocks_.size())] = record;
+  blockCounters_.publish(index + 1);
+}
+
+void FlightRecorder::triggerDump(uint32_t glitchFlags) {
+  if (glitchFlags == 0) {
+    return;
+  }
+
+  const uint64_t now = nowNs();
+
+  // Rate limit automatic dumps so a glitch storm does not flood the disk
+  if ((glitchFlags & GlitchFlag::Manual) == 0) {
+    const uint64_t last = lastDumpNs_.load(std::memory_order_relaxed);
+    if (last != 0 && now - last < MIN_DUMP_INTERVAL_NS) {
+      return;
+    }
+  }
+
+  // The first trigger of a burst sets the reference time
+  const uint32_t previous =
+      pendingFlags_.fetch_or(glitchFlags, std::memory_order_acq_rel);
+  if (previous == 0) {
+    triggerNs_.store(now, std::memory_order_release);
+  }
+}
+
+std::string FlightRecorder::getLastDumpPrefix() const {
+  std::lock_guard<std::mutex> lock(prefixMutex_);
+  return lastDumpPrefix_;
+}
+
+std::string FlightRecorder::describeFlags(uint32_t glitchFlags) {
+  std::string result;
+  auto append = [&result](const char *name) {
+    if (!result.empty()) {
+      result += ",";
+    }
+    result += name;
+  };
+
+  if (glitchFlags & GlitchFlag::Xrun)
+    append("xrun");
+  if (glitchFlags & GlitchFlag::DeadlineMiss)
+    append("deadline_miss");
+  if (glitchFlags & GlitchFlag::Discontinuity)
+    append("discontinuity");
+  if (glitchFlags & GlitchFlag::Clipping)
+    append("clipping");
+  if (glitchFlags & GlitchFlag::Manual)
+    append("manual");
+  if (glitchFlags & GlitchFlag::DcDrift)
+    append("dc_drift");
+
+  return result.empty() ? "none" : result;
+}
+
+void FlightRecorder::writerThread() {
+  Logger::instance().registerThread("FlightRecorder");
+  // Dump writing is background I/O: keep it off the P-cores
+  setThreadCorePreference(CorePreference::Efficiency);
+
+  while (running_.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    if (pendingFlags_.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+
+    // Let the post-trigger context accumulate before taking the snapshot
+    const uint64_t triggerNs = triggerNs_.load(std::memory_order_acquire);
+    if (running_.load() && nowNs() - triggerNs < POST_TRIGGER_NS) {
+      continue;
+    }
+
+    const uint32_t flags = pendingFlags_.exchange(0, std::memory_order_acq_rel);
+    writeDump(flags, triggerNs);
+  }
+
+  // Flush a dump that was requested right before shutdown
+  const uint32_t flags = pendingFlags_.exchange(0, std::memory_order_acq_rel);
+  if (flags != 0) {
+    writeDump(flags, triggerNs_.load(std::memory_order_acquire));
+  }
+}
+
+std::vector<float>
+FlightRecorder::snapshotAudio(const AudioRing &ring) const {
+  const size_t capacity = ring.samples.size();
+  const uint64_t end = ring.counters.end();
+  const uint64_t begin = end > capacity ? end - capacity : 0;
+
+  std::vector<float> out(static_cast<size_t>(end - begin));
+  for (uint64_t i = begin; i < end; ++i) {
+    out[static_cast<size_t>(i - begin)] =
+        ring.samples[static_cast<size_t>(i % capacity)];
+  }
+
+  // Drop whatever the producer may have overwritten while we were copying
+  const size_t stale = ring.counters.stale(begin, out.size(), capacity);
+  out.erase(out.begin(), out.begin() + stale);
+
+  return out;
+}
+
+std::vector<BlockRecord> FlightRecorder::snapshotBlocks() const {
+  const size_t capacity = blocks_.size();
+  const uint64_t end = blockCounters_.end();
+  const uint64_t begin = end > capacity ? end - capacity : 0;
+
+  std::vector<BlockRecord> out(static_cast<size_t>(end - begin));
+  for (uint64_t i = begin; i < end; ++i) {
+    out[static_cast<size_t>(i - begin)] =
+        blocks_[static_cast<size_t>(i % capacity)];
+  }
+
+  const size_t stale = blockCounters_.stale(begin, out.size(), capacity);
+  out.erase(out.begin(), out.begin() + stale);
+
+  return out;
+}
+
+void FlightRecorder::writeDump(uint32_t glitchFlags, uint64_t triggerNs) {
+  namespace fs = std::filesystem;
+
+  std::error_code ec;
+  fs::create_directories(dumpDirectory_, ec);
+  if (ec) {
+    WAM_LOG_ERROR("Flight recorder: cannot create %s: %s",
+                  dumpDirectory_.c_str(), ec.message().c_str());
+    return;
+  }
+
+  const std::string prefix =
+      (fs::path(dumpDirectory_) /
+       ("wam_flight_" + std::to_string(wallClockMs())))
+          .string();
+
+  // Audio taps
+  for (size_t tap = 0; tap < TAP_COUNT; ++tap) {
+    std::vector<float> audio = snapshotAudio(taps_[tap]);
+    const std::string path = prefix + "_" + tapName(tap) + ".wav";
+    if (!writeWavFloat32(path, audio.data(), audio.size(), sampleRate_, 1)) {
+      WAM_LOG_ERROR("Flight recorder: failed to write %s", path.c_str());
+    }
+  }
+
+  // Block metadata
+  std::vector<BlockRecord> blocks = snapshotBlocks();
+  std::ofstream json(prefix + ".json");
+  if (!json.is_open()) {
+    WAM_LOG_ERROR("Flight recorder: failed to write %s.json", prefix.c_str());
+    return;
+  }
+
+  json << "{\n";
+  json << "  \"reason\": \"" << describeFlags(glitchFlags) << "\",\n";
+  json << "  \"triggerTimeNs\": " << triggerNs << ",\n";
+  json << "  \"sampleRate\": " << sampleRate_ << ",\n";
+  json << "  \"blocks\": [\n";
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    const BlockRecord &b = blocks[i];
+    json << "    {\"index\": " << b.blockIndex << ", \"t\": " << b.timestampNs
+         << ", \"processUs\": " << JsonNumber{b.processUs}
+         << ", \"wakeUs\": " << JsonNumber{b.wakeLatencyUs}
+         << ", \"inQueue\": " << b.inputQueueDepth
+         << ", \"outQueue\": " << b.outputQueueDepth
+         << ", \"vad\": " << JsonNumber{b.vad}
+         << ", \"grDb\": " << JsonNumber{b.gainReductionDb}
+         << ", \"inPeak\": " << JsonNumber{b.inputPeak}
+         << ", \"outPeak\": " << JsonNumber{b.outputPeak} << ", \"glitch\": \""
+         << (b.glitchFlags ? describeFlags(b.glitchFlags) : "") << "\"}"
+         << (i + 1 < blocks.size() ? "," : "") << "\n";
+  }
+  json << "  ]\n";
+  json << "}\n";
+
+  lastDumpNs_.store(nowNs(), std::memory_order_relaxed);
+  dumpCount_.fetch_add(1, std::memory_order_relaxed);
+  {
+    std::lock_guard<std::mutex> lock(prefixMutex_);
+    lastDumpPrefix_ = prefix;
+  }
+
+  WAM_LOG_INFO("Flight recorder dump (%s): %s",
+               describeFlags(glitchFlags).c_str(), prefix.c_str());
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,152 @@
+/**
+ * WindowsAiMic - Flight Recorder Header
+ *
+ * Always-on, fixed-size history of recent audio and per-block metadata,
+ * dumped to WAV/JSON files when a glitch is detected or on request.
+ */
+
+#pragma once
+
+#include "glitch_detector.h"
+#include "seqlock_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Audio tap points recorded by the flight recorder
+ */
+enum class RecorderTap {
+  Input, // Capture thread, after downmix/resample (what entered the queue)
+  PreAI, // Processing thread, block as read from the queue
+  Output // Processing thread, after the full chain
+};
+
+/**
+ * Per-block metadata kept alongside the audio history
+ */
+struct BlockRecord {
+  uint64_t blockIndex = 0;
+  uint64_t timestampNs = 0; // steady_clock, end of processing
+  float processUs = 0.0f;   // Time spent in the processing chain
+  float wakeLatencyUs = 0.0f;
+  uint32_t inputQueueDepth = 0; // Samples waiting in the input queue
+  uint32_t outputQueueDepth = 0;
+  float vad = 0.0f;             // Voice probability from the AI stage
+  float gainReductionDb = 0.0f; // Compressor gain reduction
+  float inputPeak = 0.0f;       // Linear block peak before processing
+  float outputPeak = 0.0f;      // Linear block peak after processing
+  uint32_t glitchFlags = 0;
+};
+
+/**
+ * Lock-free flight recorder
+ *
+ * Each tap and the metadata ring have exactly one producer thread.
+ * Producers never block or allocate; the dump itself runs on a
+ * dedicated writer thread.
+ */
+class FlightRecorder {
+public:
+  /**
+   * @param seconds Amount of history to keep
+   * @param sampleRate Sample rate of the recorded taps
+   * @param blockSize Processing block size (for metadata ring sizing)
+   */
+  FlightRecorder(float seconds, int sampleRate, size_t blockSize);
+  ~FlightRecorder();
+
+  // Non-copyable
+  FlightRecorder(const FlightRecorder &) = delete;
+  FlightRecorder &operator=(const FlightRecorder &) = delete;
+
+  /**
+   * Start the background dump writer
+   * @param dumpDirectory Directory for WAV/JSON dumps (created on demand)
+   */
+  void start(const std::string &dumpDirectory);
+
+  /**
+   * Stop the background dump writer (pending dumps are written first)
+   */
+  void stop();
+
+  /**
+   * Append audio to a tap (real-time safe, single producer per tap)
+   */
+  void writeAudio(RecorderTap tap, const float *samples, size_t count);
+
+  /**
+   * Append a block record (real-time safe, single producer)
+   */
+  void writeBlock(const BlockRecord &record);
+
+  /**
+   * Request a dump (real-time safe)
+   *
+   * Automatic triggers are rate limited; GlitchFlag::Manual always queues.
+   * The snapshot is taken shortly after the trigger so that the glitch
+   * itself is inside the dumped window.
+   */
+  void triggerDump(uint32_t glitchFlags);
+
+  /**
+   * Number of dumps written so far
+   */
+  uint32_t getDumpCount() const { return dumpCount_.load(); }
+
+  /**
+   * Path prefix of the most recent dump (empty if none yet)
+   */
+  std::string getLastDumpPrefix() const;
+
+  /**
+   * Human-readable list of glitch flags ("xrun,clipping")
+   */
+  static std::string describeFlags(uint32_t glitchFlags);
+
+private:
+  static constexpr size_t TAP_COUNT = 3;
+
+  struct AudioRing {
+    std::vector<float> samples;
+    SeqlockRing counters;
+  };
+
+  void writerThread();
+  void writeDump(uint32_t glitchFlags, uint64_t triggerNs);
+  std::vector<float> snapshotAudio(const AudioRing &ring) const;
+  std::vector<BlockRecord> snapshotBlocks() const;
+
+  int sampleRate_;
+
+  AudioRing taps_[TAP_COUNT];
+
+  std::vector<BlockRecord> blocks_;
+  SeqlockRing blockCounters_;
+
+  // Trigger state
+  std::atomic<uint32_t> pendingFlags_{0};
+  std::atomic<uint64_t> triggerNs_{0};
+  std::atomic<uint64_t> lastDumpNs_{0};
+  std::atomic<uint32_t> dumpCount_{0};
+
+  // Writer thread
+  std::atomic<bool> running_{false};
+  std::thread writerThread_;
+  std::string dumpDirectory_;
+  std::string lastDumpPrefix_;
+  mutable std::mutex prefixMutex_;
+
+  static constexpr uint64_t POST_TRIGGER_NS = 500'000'000;       // 500 ms
+  static constexpr uint64_t MIN_DUMP_INTERVAL_NS = 30'000'000'000; // 30 s
+};
+
+} // namespace WindowsAiMic
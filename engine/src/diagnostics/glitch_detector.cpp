@@ -0,0 +1,212 @@
+/**
+ * WindowsAiMic - Glitch Detector Implementation
+ */
+
+#include "glitch_detector.h"
+#include "metrics.h"
+#include "../platform/simd_dsp.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace WindowsAiMic {
+
+GlitchDetector::GlitchDetector() {
+  MetricsRegistry &registry = MetricsRegistry::instance();
+  for (size_t i = 0; i < GlitchStats::TYPE_COUNT; ++i) {
+    counts_[i].store(0, std::memory_order_relaxed);
+    lastEventNs_[i].store(0, std::memory_order_relaxed);
+
+    const std::string label =
+        std::string("type=\"") + typeName(static_cast<GlitchType>(i)) + "\"";
+    metrics_[i] = &registry.counter("wam_glitches_total",
+                                    "Glitch events by type", label);
+  }
+}
+
+float GlitchDetector::analyzeInput(const float *block, size_t frames) {
+  const float peak = SIMD::findPeak(block, frames);
+
+  // Sample-level discontinuity: compare the step across the block edge with
+  // the largest step in the few samples on either side of it
+  if (frames >= EDGE_SAMPLES) {
+    if (haveTail_) {
+      float localStep = 0.0f;
+      for (size_t i = 0; i + 1 < EDGE_SAMPLES; ++i) {
+        const float tailStep =
+            std::abs(previousTail_[i + 1] - previousTail_[i]);
+        const float headStep = std::abs(block[i + 1] - block[i]);
+        localStep = std::max(localStep, std::max(tailStep, headStep));
+      }
+
+      const float edgeStep =
+          std::abs(block[0] - previousTail_[EDGE_SAMPLES - 1]);
+      if (edgeStep > EDGE_MIN_JUMP && edgeStep > EDGE_SPIKE_RATIO * localStep) {
+        inputDiscontinuity_ = true;
+      }
+    }
+
+    std::copy(block + frames - EDGE_SAMPLES, block + frames, previousTail_);
+    haveTail_ = true;
+  }
+
+  // Clipping runs (only scanned when the block actually reaches full scale)
+  if (peak >= CLIP_LEVEL && hasClippingRun(block, frames)) {
+    inputClipping_ = true;
+  }
+
+  // DC drift: slow one-pole over block means
+  if (frames > 0) {
+    float sum = 0.0f;
+    for (size_t i = 0; i < frames; ++i) {
+      sum += block[i];
+    }
+    const float mean = sum / static_cast<float>(frames);
+    dcEstimate_ += DC_SMOOTHING * (mean - dcEstimate_);
+  }
+
+  return peak;
+}
+
+uint32_t GlitchDetector::finishBlock(const float *output, size_t frames,
+                                     float processUs, float budgetUs,
+                                     const DeviceCounters &devices,
+                                     uint64_t nowNs) {
+  uint32_t flags = 0;
+
+  if (inputDiscontinuity_) {
+    publish(GlitchType::Discontinuity, nowNs);
+    flags |= GlitchFlag::Discontinuity;
+  }
+
+  outputPeak_ = SIMD::findPeak(output, frames);
+  bool clipping = inputClipping_;
+  if (!clipping && outputPeak_ >= CLIP_LEVEL) {
+    clipping = hasClippingRun(output, frames);
+  }
+  if (clipping) {
+    publish(GlitchType::ClippingRun, nowNs);
+    flags |= GlitchFlag::Clipping;
+  }
+
+  // DC drift is reported once per excursion (with hysteresis)
+  const float dc = std::abs(dcEstimate_);
+  if (!dcDrifting_ && dc > DC_DRIFT_LEVEL) {
+    dcDrifting_ = true;
+    publish(GlitchType::DcDrift, nowNs);
+    flags |= GlitchFlag::DcDrift;
+  } else if (dcDrifting_ && dc < DC_RECOVER_LEVEL) {
+    dcDrifting_ = false;
+  }
+  dcOffset_.store(dcEstimate_, std::memory_order_relaxed);
+
+  if (processUs > budgetUs) {
+    publish(GlitchType::DeadlineMiss, nowNs);
+    flags |= GlitchFlag::DeadlineMiss;
+  }
+
+  // Device and queue counters are maintained by other threads; only their
+  // increments since the previous block become events
+  flags |= countDeviceDelta(devices.captureGaps, lastDevices_.captureGaps,
+                            GlitchType::CaptureGap, nowNs);
+  flags |= countDeviceDelta(devices.renderUnderruns,
+                            lastDevices_.renderUnderruns,
+                            GlitchType::RenderUnderrun, nowNs);
+  flags |= countDeviceDelta(devices.renderOverruns, lastDevices_.renderOverruns,
+                            GlitchType::RenderOverrun, nowNs);
+  flags |= countDeviceDelta(devices.inputOverflows, lastDevices_.inputOverflows,
+                            GlitchType::InputOverflow, nowNs);
+
+  inputDiscontinuity_ = false;
+  inputClipping_ = false;
+
+  return flags;
+}
+
+GlitchStats GlitchDetector::getStats() const {
+  GlitchStats stats;
+  for (size_t i = 0; i < GlitchStats::TYPE_COUNT; ++i) {
+    stats.counts[i] = counts_[i].load(std::memory_order_relaxed);
+    stats.lastEventNs[i] = lastEventNs_[i].load(std::memory_order_relaxed);
+  }
+  stats.lastGlitchNs = lastGlitchNs_.load(std::memory_order_acquire);
+  stats.dcOffset = dcOffset_.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void GlitchDetector::resetStream() {
+  haveTail_ = false;
+  inputDiscontinuity_ = false;
+  inputClipping_ = false;
+  dcEstimate_ = 0.0f;
+  dcDrifting_ = false;
+}
+
+const char *GlitchDetector::typeName(GlitchType type) {
+  switch (type) {
+  case GlitchType::RenderUnderrun:
+    return "render_underrun";
+  case GlitchType::RenderOverrun:
+    return "render_overrun";
+  case GlitchType::CaptureGap:
+    return "capture_gap";
+  case GlitchType::InputOverflow:
+    return "input_overflow";
+  case GlitchType::DeadlineMiss:
+    return "deadline_miss";
+  case GlitchType::Discontinuity:
+    return "discontinuity";
+  case GlitchType::ClippingRun:
+    return "clipping_run";
+  case GlitchType::DcDrift:
+    return "dc_drift";
+  default:
+    return "unknown";
+  }
+}
+
+void GlitchDetector::publish(GlitchType type, uint64_t nowNs) {
+  const size_t index = static_cast<size_t>(type);
+  counts_[index].fetch_add(1, std::memory_order_relaxed);
+  metrics_[index]->add();
+  lastEventNs_[index].store(nowNs, std::memory_order_relaxed);
+  lastGlitchNs_.store(nowNs, std::memory_order_release);
+}
+
+uint32_t GlitchDetector::countDeviceDelta(uint64_t total, uint64_t &lastSeen,
+                                          GlitchType type, uint64_t nowNs) {
+  // A reinitialized device restarts its totals from zero
+  if (total < lastSeen) {
+    lastSeen = total;
+    return 0;
+  }
+  if (total == lastSeen) {
+    return 0;
+  }
+
+  const size_t index = static_cast<size_t>(type);
+  counts_[index].fetch_add(static_cast<uint32_t>(total - lastSeen),
+                           std::memory_order_relaxed);
+  metrics_[index]->add(total - lastSeen);
+  lastEventNs_[index].store(nowNs, std::memory_order_relaxed);
+  lastGlitchNs_.store(nowNs, std::memory_order_release);
+  lastSeen = total;
+
+  return GlitchFlag::Xrun;
+}
+
+bool GlitchDetector::hasClippingRun(const float *block, size_t frames) {
+  size_t run = 0;
+  for (size_t i = 0; i < frames; ++i) {
+    if (std::abs(block[i]) >= CLIP_LEVEL) {
+      if (++run >= CLIP_RUN_SAMPLES) {
+        return true;
+      }
+    } else {
+      run = 0;
+    }
+  }
+  return false;
+}
+
+} // namespace WindowsAiMic
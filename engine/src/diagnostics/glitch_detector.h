@@ -0,0 +1,160 @@
+/**
+ * WindowsAiMic - Glitch Detector Header
+ *
+ * Cheap per-block detectors for xruns, capture gaps, discontinuities,
+ * clipping runs, and DC drift, published through lock-free counters.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+class Counter;
+
+/**
+ * Glitch reasons (bit flags) attached to block records and dump triggers
+ */
+namespace GlitchFlag {
+constexpr uint32_t Xrun = 1u << 0;          // Queue/device overflow/underflow
+constexpr uint32_t DeadlineMiss = 1u << 1;  // Block took longer than realtime
+constexpr uint32_t Discontinuity = 1u << 2; // Sample jump at block edge
+constexpr uint32_t Clipping = 1u << 3;      // Run of full-scale samples
+constexpr uint32_t Manual = 1u << 4;        // Requested over IPC
+constexpr uint32_t DcDrift = 1u << 5;       // Sustained DC offset
+} // namespace GlitchFlag
+
+/**
+ * Individual glitch event types
+ */
+enum class GlitchType {
+  RenderUnderrun, // Render device ran dry after being primed
+  RenderOverrun,  // Render queue full, oldest audio dropped
+  CaptureGap,     // Capture device position skipped ahead
+  InputOverflow,  // Processing fell behind, captured audio dropped
+  DeadlineMiss,   // Block processing exceeded the block duration
+  Discontinuity,  // Derivative spike at a block edge
+  ClippingRun,    // Consecutive full-scale samples
+  DcDrift,        // DC offset crossed the drift threshold
+  Count
+};
+
+/**
+ * Snapshot of glitch counters and the time each type last occurred
+ */
+struct GlitchStats {
+  static constexpr size_t TYPE_COUNT = static_cast<size_t>(GlitchType::Count);
+
+  uint32_t counts[TYPE_COUNT] = {};
+  uint64_t lastEventNs[TYPE_COUNT] = {}; // steady_clock, 0 = never
+  uint64_t lastGlitchNs = 0;             // Most recent event of any type
+  float dcOffset = 0.0f;                 // Smoothed input DC estimate
+
+  uint32_t count(GlitchType type) const {
+    return counts[static_cast<size_t>(type)];
+  }
+  uint64_t lastEvent(GlitchType type) const {
+    return lastEventNs[static_cast<size_t>(type)];
+  }
+};
+
+/**
+ * Running totals maintained by the device and queue layers
+ * The detector turns increments into timestamped events.
+ */
+struct DeviceCounters {
+  uint64_t captureGaps = 0;
+  uint64_t renderUnderruns = 0;
+  uint64_t renderOverruns = 0;
+  uint64_t inputOverflows = 0;
+};
+
+/**
+ * Per-block glitch detector
+ *
+ * analyzeInput() and finishBlock() run on the processing thread and only
+ * touch a handful of samples unless the block is already near full scale.
+ * getStats() may be called from any thread.
+ */
+class GlitchDetector {
+public:
+  GlitchDetector();
+
+  /**
+   * Inspect a block before processing (edges, clipping, DC)
+   * @return Peak of the block (linear)
+   */
+  float analyzeInput(const float *block, size_t frames);
+
+  /**
+   * Inspect the processed block and device counters, publish events
+   * @param output Processed block
+   * @param frames Number of samples
+   * @param processUs Time spent processing the block
+   * @param budgetUs Real-time duration of the block
+   * @param devices Current device/queue totals
+   * @param nowNs steady_clock timestamp for published events
+   * @return GlitchFlag bits raised by this block
+   */
+  uint32_t finishBlock(const float *output, size_t frames, float processUs,
+                       float budgetUs, const DeviceCounters &devices,
+                       uint64_t nowNs);
+
+  /**
+   * Peak of the last processed block (linear)
+   */
+  float getOutputPeak() const { return outputPeak_; }
+
+  /**
+   * Lock-free snapshot of all counters
+   */
+  GlitchStats getStats() const;
+
+  /**
+   * Reset per-stream state (counters are kept)
+   */
+  void resetStream();
+
+  /**
+   * Short snake_case name of a glitch type ("render_underrun")
+   */
+  static const char *typeName(GlitchType type);
+
+private:
+  void publish(GlitchType type, uint64_t nowNs);
+  uint32_t countDeviceDelta(uint64_t total, uint64_t &lastSeen,
+                            GlitchType type, uint64_t nowNs);
+  static bool hasClippingRun(const float *block, size_t frames);
+
+  // Processing-thread state
+  static constexpr size_t EDGE_SAMPLES = 8;
+  float previousTail_[EDGE_SAMPLES] = {};
+  bool haveTail_ = false;
+  bool inputDiscontinuity_ = false;
+  bool inputClipping_ = false;
+  float dcEstimate_ = 0.0f;
+  bool dcDrifting_ = false;
+  float outputPeak_ = 0.0f;
+  DeviceCounters lastDevices_;
+
+  // Published state
+  std::atomic<uint32_t> counts_[GlitchStats::TYPE_COUNT];
+  std::atomic<uint64_t> lastEventNs_[GlitchStats::TYPE_COUNT];
+  std::atomic<uint64_t> lastGlitchNs_{0};
+  std::atomic<float> dcOffset_{0.0f};
+  Counter *metrics_[GlitchStats::TYPE_COUNT] = {}; // wam_glitches_total
+
+  // Thresholds
+  static constexpr float CLIP_LEVEL = 0.999f;       // ~0 dBFS
+  static constexpr size_t CLIP_RUN_SAMPLES = 3;     // Consecutive samples
+  static constexpr float EDGE_MIN_JUMP = 0.1f;      // Ignore tiny steps
+  static constexpr float EDGE_SPIKE_RATIO = 6.0f;   // vs. local derivative
+  static constexpr float DC_SMOOTHING = 0.05f;      // Per-block one-pole
+  static constexpr float DC_DRIFT_LEVEL = 0.05f;    // ~-26 dBFS offset
+  static constexpr float DC_RECOVER_LEVEL = 0.025f; // Hysteresis
+};
+
+} // namespace WindowsAiMic
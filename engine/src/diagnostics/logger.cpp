@@ -0,0 +1,289 @@
+/**
+ * WindowsAiMic - Logger Implementation
+ */
+
+#include "logger.h"
+#include "../platform/clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace WindowsAiMic {
+
+namespace {
+
+const char *levelName(LogLevel level) {
+  switch (level) {
+  case LogLevel::Debug:
+    return "DEBUG";
+  case LogLevel::Info:
+    return "INFO ";
+  case LogLevel::Warning:
+    return "WARN ";
+  case LogLevel::Error:
+    return "ERROR";
+  default:
+    return "     ";
+  }
+}
+
+} // namespace
+
+thread_local Logger::ThreadSlot Logger::slot_;
+
+LogLevel parseLogLevel(const std::string &name) {
+  if (name == "debug")
+    return LogLevel::Debug;
+  if (name == "warning" || name == "warn")
+    return LogLevel::Warning;
+  if (name == "error")
+    return LogLevel::Error;
+  if (name == "off")
+    return LogLevel::Off;
+  return LogLevel::Info;
+}
+
+Logger &Logger::instance() {
+  // Intentionally leaked: threads may still log during static destruction
+  static Logger *logger = new Logger();
+  return *logger;
+}
+
+Logger::Logger() : startNs_(nowNs()) {}
+
+Logger::~Logger() { stop(); }
+
+Logger::ThreadSlot::~ThreadSlot() {
+  if (ring) {
+    ring->inUse.store(false, std::memory_order_release);
+  }
+}
+
+bool Logger::start(const std::string &filePath) {
+  if (running_.load()) {
+    return true;
+  }
+
+  bool ok = true;
+  if (!filePath.empty()) {
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    file_.open(filePath, std::ios::app);
+    ok = file_.is_open();
+  }
+
+  running_ = true;
+  drainThread_ = std::thread(&Logger::drainThread, this);
+
+  if (!ok) {
+    log(LogLevel::Warning, "Could not open log file: %s", filePath.c_str());
+  }
+  return ok;
+}
+
+void Logger::stop() {
+  if (!running_.load()) {
+    return;
+  }
+
+  running_ = false;
+  if (drainThread_.joinable()) {
+    drainThread_.join();
+  }
+
+  std::lock_guard<std::mutex> lock(outputMutex_);
+  if (file_.is_open()) {
+    file_.close();
+  }
+}
+
+void Logger::registerThread(const char *name) {
+  ThreadRing *ring = currentRing();
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+  std::snprintf(ring->name, NAME_SIZE, "%s", name);
+}
+
+void Logger::log(LogLevel level, const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  logv(level, format, args);
+  va_end(args);
+}
+
+void Logger::logv(LogLevel level, const char *format, va_list args) {
+  if (!running_.load(std::memory_order_acquire)) {
+    // Not running: write straight through
+    char text[MESSAGE_SIZE];
+    std::vsnprintf(text, sizeof(text), format, args);
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    writeLine(level, nowNs(), "", text);
+    return;
+  }
+
+  ThreadRing *ring = currentRing();
+  const uint64_t head = ring->head.load(std::memory_order_relaxed);
+  const uint64_t tail = ring->tail.load(std::memory_order_acquire);
+  if (head - tail >= RING_CAPACITY) {
+    ring->dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  Record &record = ring->records[head % RING_CAPACITY];
+  record.timestampNs = nowNs();
+  record.level = level;
+  record.threadIndex = ring->index;
+
+  const int length =
+      std::vsnprintf(record.text, sizeof(record.text), format, args);
+  record.length = static_cast<uint16_t>(
+      std::clamp<int>(length, 0, static_cast<int>(MESSAGE_SIZE) - 1));
+
+  ring->head.store(head + 1, std::memory_order_release);
+}
+
+uint64_t Logger::getDroppedCount() const {
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+  uint64_t total = 0;
+  for (const auto &ring : rings_) {
+    total += ring->dropped.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+Logger::ThreadRing *Logger::currentRing() {
+  if (!slot_.ring) {
+    slot_.ring = acquireRing();
+  }
+  return slot_.ring;
+}
+
+Logger::ThreadRing *Logger::acquireRing() {
+  std::lock_guard<std::mutex> lock(ringsMutex_);
+
+  // Recycle a ring whose thread has exited and whose records were drained
+  for (auto &ring : rings_) {
+    if (!ring->inUse.load(std::memory_order_acquire) &&
+        ring->head.load(std::memory_order_acquire) ==
+            ring->tail.load(std::memory_order_acquire)) {
+      ring->inUse.store(true, std::memory_order_release);
+      std::snprintf(ring->name, NAME_SIZE, "thread-%u", ring->index);
+      return ring.get();
+    }
+  }
+
+  auto ring = std::make_unique<ThreadRing>();
+  ring->index = static_cast<uint32_t>(rings_.size());
+  std::snprintf(ring->name, NAME_SIZE, "thread-%u", ring->index);
+  rings_.push_back(std::move(ring));
+  return rings_.back().get();
+}
+
+void Logger::drainThread() {
+  while (running_.load()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    drainOnce();
+  }
+
+  // Final drain for anything logged right before stop()
+  drainOnce();
+}
+
+void Logger::drainOnce() {
+  std::vector<ThreadRing *> rings;
+  {
+    std::lock_guard<std::mutex> lock(ringsMutex_);
+    rings.reserve(rings_.size());
+    for (auto &ring : rings_) {
+      rings.push_back(ring.get());
+    }
+  }
+
+  drainScratch_.clear();
+  for (ThreadRing *ring : rings) {
+    const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+    const uint64_t head = ring->head.load(std::memory_order_acquire);
+    for (uint64_t i = tail; i < head; ++i) {
+      drainScratch_.push_back(ring->records[i % RING_CAPACITY]);
+    }
+    ring->tail.store(head, std::memory_order_release);
+  }
+
+  // Interleave threads in the order the messages were produced
+  std::stable_sort(drainScratch_.begin(), drainScratch_.end(),
+                   [](const Record &a, const Record &b) {
+                     return a.timestampNs < b.timestampNs;
+                   });
+
+  std::lock_guard<std::mutex> outputLock(outputMutex_);
+  std::lock_guard<std::mutex> ringsLock(ringsMutex_);
+  for (const Record &record : drainScratch_) {
+    const char *thread = record.threadIndex < rings_.size()
+                             ? rings_[record.threadIndex]->name
+                             : "";
+    writeLine(record.level, record.timestampNs, thread, record.text);
+  }
+
+  for (ThreadRing *ring : rings) {
+    const uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+    if (dropped != ring->droppedReported) {
+      char text[64];
+      std::snprintf(text, sizeof(text), "%llu log messages dropped",
+                    static_cast<unsigned long long>(dropped -
+                                                    ring->droppedReported));
+      writeLine(LogLevel::Warning, nowNs(), ring->name, text);
+      ring->droppedReported = dropped;
+    }
+  }
+
+  if (file_.is_open()) {
+    file_.flush();
+  }
+}
+
+void Logger::writeLine(LogLevel level, uint64_t timestampNs,
+                       const char *thread, const char *text) {
+  const double seconds =
+      timestampNs > startNs_ ? (timestampNs - startNs_) / 1e9 : 0.0;
+
+  char prefix[64];
+  if (thread[0] != '\0') {
+    std::snprintf(prefix, sizeof(prefix), "[%10.3f] %s [%s] ", seconds,
+                  levelName(level), thread);
+  } else {
+    std::snprintf(prefix, sizeof(prefix), "[%10.3f] %s ", seconds,
+                  levelName(level));
+  }
+
+  if (console_.load(std::memory_order_relaxed)) {
+    FILE *stream = level >= LogLevel::Warning ? stderr : stdout;
+    std::fputs(prefix, stream);
+    std::fputs(text, stream);
+    std::fputc('\n', stream);
+    std::fflush(stream);
+  }
+
+  if (file_.is_open()) {
+    file_ << prefix << text << '\n';
+  }
+}
+
+bool LogRateLimiter::allow() {
+  const uint64_t now = nowNs();
+  uint64_t last = lastNs_.load(std::memory_order_relaxed);
+
+  if (last != 0 && now - last < intervalNs_) {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  // Only one of several racing threads wins the slot
+  if (!lastNs_.compare_exchange_strong(last, now,
+                                       std::memory_order_relaxed)) {
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  return true;
+}
+
+} // namespace WindowsAiMic
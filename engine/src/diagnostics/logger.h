@@ -0,0 +1,214 @@
+/**
+ * WindowsAiMic - Logger Header
+ *
+ * Real-time safe logging. Each thread formats messages into fixed-size
+ * records in its own lock-free ring; a background thread drains the rings
+ * and writes to the console and/or a log file.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define WAM_PRINTF_FORMAT(fmtIndex, argIndex)                                  \
+  __attribute__((format(printf, fmtIndex, argIndex)))
+#else
+#define WAM_PRINTF_FORMAT(fmtIndex, argIndex)
+#endif
+
+namespace WindowsAiMic {
+
+/**
+ * Log severity
+ */
+enum class LogLevel : uint8_t { Debug, Info, Warning, Error, Off };
+
+/**
+ * Parse "debug", "info", "warning", "error" or "off" (defaults to Info)
+ */
+LogLevel parseLogLevel(const std::string &name);
+
+/**
+ * Process-wide logger
+ *
+ * Before start() and after stop() messages are written synchronously, so
+ * startup and shutdown output is never lost. While running, log() only
+ * formats into the calling thread's ring and never blocks; if the ring is
+ * full the message is dropped and counted.
+ */
+class Logger {
+public:
+  static Logger &instance();
+
+  // Non-copyable
+  Logger(const Logger &) = delete;
+  Logger &operator=(const Logger &) = delete;
+
+  /**
+   * Start the drain thread
+   * @param filePath Optional log file (appended); empty = console only
+   */
+  bool start(const std::string &filePath = "");
+
+  /**
+   * Drain everything still queued and stop the drain thread
+   */
+  void stop();
+
+  /**
+   * Minimum level that is recorded
+   */
+  void setLevel(LogLevel level) { level_.store(level); }
+  LogLevel getLevel() const { return level_.load(); }
+  bool isEnabled(LogLevel level) const {
+    return level >= level_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Enable/disable console output (e.g. after FreeConsole())
+   */
+  void setConsoleOutput(bool enabled) { console_.store(enabled); }
+
+  /**
+   * Allocate the calling thread's ring up front and give it a name
+   * Call at the top of audio threads so the first log() never allocates.
+   */
+  void registerThread(const char *name);
+
+  /**
+   * Format and enqueue a message (real-time safe once registered)
+   */
+  void log(LogLevel level, const char *format, ...) WAM_PRINTF_FORMAT(3, 4);
+  void logv(LogLevel level, const char *format, va_list args);
+
+  /**
+   * Messages dropped because a thread's ring was full
+   */
+  uint64_t getDroppedCount() const;
+
+private:
+  static constexpr size_t MESSAGE_SIZE = 232;
+  static constexpr size_t RING_CAPACITY = 256; // Records per thread
+  static constexpr size_t NAME_SIZE = 24;
+
+  struct Record {
+    uint64_t timestampNs;
+    LogLevel level;
+    uint16_t length;
+    uint32_t threadIndex;
+    char text[MESSAGE_SIZE];
+  };
+
+  struct ThreadRing {
+    Record records[RING_CAPACITY];
+    std::atomic<uint64_t> head{0}; // Producer position
+    std::atomic<uint64_t> tail{0}; // Drain position
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> inUse{true};
+    uint64_t droppedReported = 0; // Drain thread only
+    uint32_t index = 0;
+    char name[NAME_SIZE] = {};
+  };
+
+  // Marks the ring reusable when its thread exits
+  struct ThreadSlot {
+    ThreadRing *ring = nullptr;
+    ~ThreadSlot();
+  };
+
+  Logger();
+  ~Logger();
+
+  ThreadRing *currentRing();
+  ThreadRing *acquireRing();
+  void drainThread();
+  void drainOnce();
+  void writeLine(LogLevel level, uint64_t timestampNs, const char *thread,
+                 const char *text);
+
+  std::atomic<LogLevel> level_{LogLevel::Info};
+  std::atomic<bool> console_{true};
+  std::atomic<bool> running_{false};
+  uint64_t startNs_;
+
+  // Rings are never freed, only recycled, so the drain thread can walk
+  // a copy of the list without holding the lock
+  mutable std::mutex ringsMutex_;
+  std::vector<std::unique_ptr<ThreadRing>> rings_;
+
+  // Output (drain thread, or synchronous callers while stopped)
+  std::mutex outputMutex_;
+  std::ofstream file_;
+  std::vector<Record> drainScratch_;
+
+  std::thread drainThread_;
+
+  static thread_local ThreadSlot slot_;
+};
+
+/**
+ * Per-call-site rate limiter for WAM_LOG_EVERY_MS
+ */
+class LogRateLimiter {
+public:
+  constexpr explicit LogRateLimiter(uint32_t intervalMs)
+      : intervalNs_(static_cast<uint64_t>(intervalMs) * 1'000'000) {}
+
+  /**
+   * True at most once per interval; suppressed calls are counted
+   */
+  bool allow();
+
+  /**
+   * Number of calls suppressed since the last allowed one (resets)
+   */
+  uint32_t takeSuppressed() { return suppressed_.exchange(0); }
+
+private:
+  uint64_t intervalNs_;
+  std::atomic<uint64_t> lastNs_{0};
+  std::atomic<uint32_t> suppressed_{0};
+};
+
+} // namespace WindowsAiMic
+
+#define WAM_LOG(level, ...)                                                    \
+  do {                                                                         \
+    ::WindowsAiMic::Logger &wamLogger_ = ::WindowsAiMic::Logger::instance();   \
+    if (wamLogger_.isEnabled(level)) {                                         \
+      wamLogger_.log(level, __VA_ARGS__);                                      \
+    }                                                                          \
+  } while (0)
+
+#define WAM_LOG_DEBUG(...) WAM_LOG(::WindowsAiMic::LogLevel::Debug, __VA_ARGS__)
+#define WAM_LOG_INFO(...) WAM_LOG(::WindowsAiMic::LogLevel::Info, __VA_ARGS__)
+#define WAM_LOG_WARNING(...)                                                   \
+  WAM_LOG(::WindowsAiMic::LogLevel::Warning, __VA_ARGS__)
+#define WAM_LOG_ERROR(...) WAM_LOG(::WindowsAiMic::LogLevel::Error, __VA_ARGS__)
+
+/**
+ * Log at most once per intervalMs from this call site, then report how many
+ * messages were suppressed in between. Use for anything that can fire every
+ * audio period.
+ */
+#define WAM_LOG_EVERY_MS(level, intervalMs, ...)                               \
+  do {                                                                         \
+    static ::WindowsAiMic::LogRateLimiter wamLimiter_(intervalMs);             \
+    if (wamLimiter_.allow()) {                                                 \
+      const uint32_t wamSuppressed_ = wamLimiter_.takeSuppressed();            \
+      WAM_LOG(level, __VA_ARGS__);                                             \
+      if (wamSuppressed_ > 0) {                                                \
+        WAM_LOG(level, "  (%u similar messages suppressed)", wamSuppressed_);  \
+      }                                                                        \
+    }                                                                          \
+  } while (0)
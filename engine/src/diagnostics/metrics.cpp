@@ -0,0 +1,322 @@
+/**
+ * WindowsAiMic - Metrics Implementation
+ */
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <unistd.h>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+uint32_t highestBit(uint64_t value) {
+  uint32_t bit = 0;
+  while (value >>= 1) {
+    ++bit;
+  }
+  return bit;
+}
+
+void appendLine(std::string &out, const char *format, const char *name,
+                const std::string &labels, uint64_t value) {
+  char line[256];
+  std::snprintf(line, sizeof(line), format, name, labels.c_str(),
+                static_cast<unsigned long long>(value));
+  out += line;
+}
+
+// "a=\"b\"" + "quantile=\"0.5\"" -> "{a=\"b\",quantile=\"0.5\"}"
+std::string labelSet(const std::string &labels, const std::string &extra) {
+  if (labels.empty() && extra.empty()) {
+    return "";
+  }
+  std::string result = "{" + labels;
+  if (!labels.empty() && !extra.empty()) {
+    result += ",";
+  }
+  return result + extra + "}";
+}
+
+} // namespace
+
+// ============================================================================
+// Histogram
+// ============================================================================
+
+Histogram::Histogram()
+    : buckets_(std::make_unique<std::atomic<uint64_t>[]>(BUCKET_COUNT)) {
+  reset();
+}
+
+size_t Histogram::bucketIndex(uint64_t value) {
+  if (value < SUB_BUCKETS) {
+    return static_cast<size_t>(value);
+  }
+
+  const uint64_t maxValue = (uint64_t{1} << (MAX_EXPONENT + 1)) - 1;
+  value = std::min(value, maxValue);
+
+  // [2^e, 2^(e+1)) is split into SUB_BUCKETS equal parts
+  const uint32_t exponent = highestBit(value);
+  const uint32_t shift = exponent - SUB_BUCKET_BITS;
+  const uint64_t sub = (value - (uint64_t{1} << exponent)) >> shift;
+  return SUB_BUCKETS + static_cast<size_t>(shift) * SUB_BUCKETS +
+         static_cast<size_t>(sub);
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index) {
+  if (index < SUB_BUCKETS) {
+    return index;
+  }
+
+  const size_t k = index - SUB_BUCKETS;
+  const uint32_t shift = static_cast<uint32_t>(k / SUB_BUCKETS);
+  const uint64_t sub = k % SUB_BUCKETS;
+  const uint64_t lower =
+      (uint64_t{1} << (shift + SUB_BUCKET_BITS)) + (sub << shift);
+  return lower + (uint64_t{1} << shift) - 1;
+}
+
+void Histogram::record(uint64_t value) {
+  buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+
+  uint64_t previous = max_.load(std::memory_order_relaxed);
+  while (value > previous &&
+         !max_.compare_exchange_weak(previous, value,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+HistogramSummary Histogram::summarize() const {
+  HistogramSummary summary;
+  summary.sum = sum_.load(std::memory_order_relaxed);
+  summary.max = max_.load(std::memory_order_relaxed);
+
+  // Count from the buckets themselves so quantiles are self-consistent
+  std::vector<uint64_t> counts(BUCKET_COUNT);
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    counts[i] = buckets_[i].load(std::memory_order_relaxed);
+    summary.count += counts[i];
+  }
+  if (summary.count == 0) {
+    return summary;
+  }
+
+  auto quantile = [&](double q) {
+    const uint64_t rank = std::max<uint64_t>(
+        1, static_cast<uint64_t>(q * static_cast<double>(summary.count) +
+                                 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+      seen += counts[i];
+      if (seen >= rank) {
+        return std::min(bucketUpperBound(i), summary.max);
+      }
+    }
+    return summary.max;
+  };
+
+  summary.p50 = quantile(0.50);
+  summary.p90 = quantile(0.90);
+  summary.p99 = quantile(0.99);
+  summary.p999 = quantile(0.999);
+  return summary;
+}
+
+void Histogram::reset() {
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    buckets_[i].store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+// ============================================================================
+// MetricsRegistry
+// ============================================================================
+
+MetricsRegistry &MetricsRegistry::instance() {
+  // Intentionally leaked: metrics may be updated during static destruction
+  static MetricsRegistry *registry = new MetricsRegistry();
+  return *registry;
+}
+
+MetricsRegistry::MetricsRegistry() {
+  // Process memory is sampled at scrape time rather than pushed
+  Gauge &resident = gauge("wam_process_resident_bytes",
+                          "Resident memory of the engine process");
+  collectors_.push_back([&resident]() {
+    resident.set(static_cast<double>(processResidentBytes()));
+  });
+}
+
+Counter &MetricsRegistry::counter(const std::string &name,
+                                  const std::string &help,
+                                  const std::string &labels) {
+  return *findOrCreate(Kind::Counter, name, help, labels).counter;
+}
+
+Gauge &MetricsRegistry::gauge(const std::string &name, const std::string &help,
+                              const std::string &labels) {
+  return *findOrCreate(Kind::Gauge, name, help, labels).gauge;
+}
+
+Histogram &MetricsRegistry::histogram(const std::string &name,
+                                      const std::string &help,
+                                      const std::string &labels) {
+  return *findOrCreate(Kind::Histogram, name, help, labels).histogram;
+}
+
+void MetricsRegistry::addCollector(std::function<void()> collector) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  collectors_.push_back(std::move(collector));
+}
+
+MetricsRegistry::Entry &
+MetricsRegistry::findOrCreate(Kind kind, const std::string &name,
+                              const std::string &help,
+                              const std::string &labels) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (auto &entry : entries_) {
+    if (entry->kind == kind && entry->name == name &&
+        entry->labels == labels) {
+      return *entry;
+    }
+  }
+
+  auto entry = std::make_unique<Entry>();
+  entry->kind = kind;
+  entry->name = name;
+  entry->help = help;
+  entry->labels = labels;
+  switch (kind) {
+  case Kind::Counter:
+    entry->counter = std::make_unique<Counter>();
+    break;
+  case Kind::Gauge:
+    entry->gauge = std::make_unique<Gauge>();
+    break;
+  case Kind::Histogram:
+    entry->histogram = std::make_unique<Histogram>();
+    break;
+  }
+
+  entries_.push_back(std::move(entry));
+  return *entries_.back();
+}
+
+std::string MetricsRegistry::renderText(const std::string &prefix) {
+  std::vector<std::function<void()>> collectors;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    collectors = collectors_;
+  }
+  for (auto &collector : collectors) {
+    collector();
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Keep each family together even if its series were registered apart
+  std::vector<const Entry *> sorted;
+  sorted.reserve(entries_.size());
+  for (const auto &entry : entries_) {
+    sorted.push_back(entry.get());
+  }
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Entry *a, const Entry *b) {
+                     return a->name < b->name;
+                   });
+
+  std::string out;
+  std::string lastName;
+  for (const Entry *entry : sorted) {
+    if (entry->name.compare(0, prefix.size(), prefix) != 0) {
+      continue;
+    }
+
+    // HELP/TYPE once per metric family
+    if (entry->name != lastName) {
+      const char *type = entry->kind == Kind::Counter ? "counter"
+                         : entry->kind == Kind::Gauge ? "gauge"
+                                                      : "summary";
+      out += "# HELP " + entry->name + " " + entry->help + "\n";
+      out += "# TYPE " + entry->name + " " + type + "\n";
+      lastName = entry->name;
+    }
+
+    const char *name = entry->name.c_str();
+    switch (entry->kind) {
+    case Kind::Counter:
+      appendLine(out, "%s%s %llu\n", name, labelSet(entry->labels, ""),
+                 entry->counter->get());
+      break;
+    case Kind::Gauge: {
+      char line[256];
+      std::snprintf(line, sizeof(line), "%s%s %.15g\n", name,
+                    labelSet(entry->labels, "").c_str(),
+                    entry->gauge->get());
+      out += line;
+      break;
+    }
+    case Kind::Histogram: {
+      const HistogramSummary s = entry->histogram->summarize();
+      const std::string &l = entry->labels;
+      appendLine(out, "%s%s %llu\n", name, labelSet(l, "quantile=\"0.5\""),
+                 s.p50);
+      appendLine(out, "%s%s %llu\n", name, labelSet(l, "quantile=\"0.9\""),
+                 s.p90);
+      appendLine(out, "%s%s %llu\n", name, labelSet(l, "quantile=\"0.99\""),
+                 s.p99);
+      appendLine(out, "%s%s %llu\n", name,
+                 labelSet(l, "quantile=\"0.999\""), s.p999);
+      appendLine(out, "%s_max%s %llu\n", name, labelSet(l, ""), s.max);
+      appendLine(out, "%s_sum%s %llu\n", name, labelSet(l, ""), s.sum);
+      appendLine(out, "%s_count%s %llu\n", name, labelSet(l, ""), s.count);
+      break;
+    }
+    }
+  }
+
+  return out;
+}
+
+// ============================================================================
+// Process memory
+// ============================================================================
+
+uint64_t processResidentBytes() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS counters = {};
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                           sizeof(counters))) {
+    return static_cast<uint64_t>(counters.WorkingSetSize);
+  }
+  return 0;
+#else
+  std::ifstream statm("/proc/self/statm");
+  uint64_t sizePages = 0;
+  uint64_t residentPages = 0;
+  if (!(statm >> sizePages >> residentPages)) {
+    return 0;
+  }
+  return residentPages * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,168 @@
+/**
+ * WindowsAiMic - Metrics Header
+ *
+ * Process-wide registry of lock-free counters, gauges, and log-linear
+ * (HDR-style) histograms. Subsystems register metrics once at startup and
+ * keep the returned references; updates are a relaxed atomic or two.
+ * Snapshots are rendered as Prometheus-style text for local scrapers.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Monotonic counter
+ */
+class Counter {
+public:
+  void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+  uint64_t get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * Last-value gauge
+ */
+class Gauge {
+public:
+  void set(double value) { value_.store(value, std::memory_order_relaxed); }
+  double get() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+  std::atomic<double> value_{0.0};
+};
+
+/**
+ * Summary of a histogram at snapshot time
+ */
+struct HistogramSummary {
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t max = 0;
+  uint64_t p50 = 0;
+  uint64_t p90 = 0;
+  uint64_t p99 = 0;
+  uint64_t p999 = 0;
+};
+
+/**
+ * Log-linear histogram of non-negative integer values
+ *
+ * Values below SUB_BUCKETS are exact; above that each power of two is split
+ * into SUB_BUCKETS linear buckets, so quantiles are within ~3%.
+ */
+class Histogram {
+public:
+  Histogram();
+
+  /**
+   * Record one value (real-time safe)
+   */
+  void record(uint64_t value);
+
+  /**
+   * Compute count/sum/max and quantiles
+   */
+  HistogramSummary summarize() const;
+
+  /**
+   * Zero all buckets
+   */
+  void reset();
+
+private:
+  static constexpr uint32_t SUB_BUCKET_BITS = 5;
+  static constexpr uint32_t SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  static constexpr uint32_t MAX_EXPONENT = 40; // Values up to ~1e12
+  static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT + 1) * SUB_BUCKETS;
+
+  static size_t bucketIndex(uint64_t value);
+  static uint64_t bucketUpperBound(size_t index);
+
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<uint64_t> sum_{0};
+  std::atomic<uint64_t> max_{0};
+};
+
+/**
+ * Registry of named metrics
+ *
+ * Registering the same name and labels twice returns the same metric, so
+ * several instances of a subsystem share one series. Metrics are never
+ * removed; references stay valid for the life of the process.
+ */
+class MetricsRegistry {
+public:
+  static MetricsRegistry &instance();
+
+  // Non-copyable
+  MetricsRegistry(const MetricsRegistry &) = delete;
+  MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+
+  /**
+   * Register (or look up) a metric
+   * @param name Metric name, e.g. "wam_block_process_us"
+   * @param help One-line description
+   * @param labels Optional label set, e.g. "device=\"capture\""
+   */
+  Counter &counter(const std::string &name, const std::string &help,
+                   const std::string &labels = "");
+  Gauge &gauge(const std::string &name, const std::string &help,
+               const std::string &labels = "");
+  Histogram &histogram(const std::string &name, const std::string &help,
+                       const std::string &labels = "");
+
+  /**
+   * Run a callback before every snapshot (for values that are cheaper to
+   * sample than to push, such as process memory)
+   */
+  void addCollector(std::function<void()> collector);
+
+  /**
+   * Render all metrics as Prometheus text exposition
+   * @param prefix Only include metrics whose name starts with this
+   */
+  std::string renderText(const std::string &prefix = "");
+
+private:
+  enum class Kind { Counter, Gauge, Histogram };
+
+  struct Entry {
+    Kind kind;
+    std::string name;
+    std::string help;
+    std::string labels;
+    std::unique_ptr<Counter> counter;
+    std::unique_ptr<Gauge> gauge;
+    std::unique_ptr<Histogram> histogram;
+  };
+
+  MetricsRegistry();
+
+  Entry &findOrCreate(Kind kind, const std::string &name,
+                      const std::string &help, const std::string &labels);
+
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<Entry>> entries_;
+  std::vector<std::function<void()>> collectors_;
+};
+
+/**
+ * Resident memory of this process in bytes (0 if unavailable)
+ */
+uint64_t processResidentBytes();
+
+} // namespace WindowsAiMic
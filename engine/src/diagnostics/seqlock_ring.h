@@ -0,0 +1,74 @@
+/**
+ * WindowsAiMic - Seqlock Ring Counters
+ *
+ * Position counters for a single-producer ring that readers copy without
+ * locking. The producer advances `claimed` before it overwrites slots and
+ * `written` after; a reader copies up to `written` and then drops the
+ * front of its copy that `claimed` says may have been overwritten
+ * meanwhile. The slots stay with the owner, so the counters work the
+ * same in process memory and in a shared-memory region.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+struct SeqlockRing {
+  std::atomic<uint64_t> claimed{0}; // Advanced before slots are written
+  std::atomic<uint64_t> written{0}; // Advanced after slots are written
+
+  /**
+   * Producer: announce the next `count` slots before writing them
+   * @return Index of the first slot
+   */
+  uint64_t claim(uint64_t count) {
+    const uint64_t index = written.load(std::memory_order_relaxed);
+    claimed.store(index + count, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    return index;
+  }
+
+  /**
+   * Producer: make slots before `end` visible to readers
+   */
+  void publish(uint64_t end) {
+    written.store(end, std::memory_order_release);
+  }
+
+  /**
+   * Reader: index after the last published slot
+   */
+  uint64_t end() const { return written.load(std::memory_order_acquire); }
+
+  /**
+   * Reader: after copying `count` slots from `begin`, how many at the
+   * front of the copy the producer may have overwritten
+   */
+  size_t stale(uint64_t begin, size_t count, uint64_t capacity) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t claimedEnd = claimed.load(std::memory_order_relaxed);
+    if (claimedEnd <= capacity || claimedEnd - capacity <= begin) {
+      return 0;
+    }
+    return static_cast<size_t>(
+        std::min<uint64_t>(claimedEnd - capacity - begin, count));
+  }
+
+  /**
+   * Start over from index 0 (no readers or producer running)
+   */
+  void reset() {
+    claimed.store(0, std::memory_order_relaxed);
+    written.store(0, std::memory_order_relaxed);
+  }
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "SeqlockRing needs address-free 64-bit atomics");
+
+} // namespace WindowsAiMic
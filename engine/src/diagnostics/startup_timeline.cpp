@@ -0,0 +1,143 @@
+/**
+ * WindowsAiMic - Startup Timeline Implementation
+ */
+
+#include "startup_timeline.h"
+#include "../platform/clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr int BAR_WIDTH = 40;
+
+double toMs(uint64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+} // namespace
+
+StartupTimeline::Scope::Scope(StartupTimeline &timeline, const char *name)
+    : timeline_(timeline), name_(name), startNs_(nowNs()) {}
+
+StartupTimeline::Scope::~Scope() {
+  timeline_.add(name_, startNs_, nowNs(), ok_);
+}
+
+void StartupTimeline::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  spans_.clear();
+  lanes_.clear();
+  firstAudioNs_.store(0, std::memory_order_relaxed);
+  originNs_.store(nowNs(), std::memory_order_release);
+}
+
+void StartupTimeline::add(const char *name, uint64_t startNs, uint64_t endNs,
+                          bool ok) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::thread::id thread = std::this_thread::get_id();
+  auto lane = std::find(lanes_.begin(), lanes_.end(), thread);
+  if (lane == lanes_.end()) {
+    lane = lanes_.insert(lanes_.end(), thread);
+  }
+  Span span;
+  span.name = name;
+  span.lane = static_cast<uint32_t>(lane - lanes_.begin());
+  span.startNs = startNs;
+  span.endNs = std::max(startNs, endNs);
+  span.ok = ok;
+  spans_.push_back(span);
+}
+
+void StartupTimeline::markFirstAudio() {
+  if (firstAudioNs_.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+  uint64_t expected = 0;
+  firstAudioNs_.compare_exchange_strong(expected, nowNs(),
+                                        std::memory_order_relaxed);
+}
+
+double StartupTimeline::firstAudioMs() const {
+  const uint64_t origin = originNs_.load(std::memory_order_acquire);
+  const uint64_t firstAudio = firstAudioNs_.load(std::memory_order_relaxed);
+  if (origin == 0 || firstAudio < origin) {
+    return -1.0;
+  }
+  return toMs(firstAudio - origin);
+}
+
+std::vector<StartupTimeline::Span> StartupTimeline::spans() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<Span> sorted = spans_;
+  std::stable_sort(sorted.begin(), sorted.end(),
+                   [](const Span &a, const Span &b) {
+                     return a.startNs < b.startNs;
+                   });
+  return sorted;
+}
+
+std::string StartupTimeline::describe() const {
+  const uint64_t origin = originNs_.load(std::memory_order_acquire);
+  const std::vector<Span> sorted = spans();
+  uint64_t endNs = origin;
+  for (const Span &span : sorted) {
+    endNs = std::max(endNs, span.endNs);
+  }
+  const double firstAudio = firstAudioMs();
+  const double totalMs = std::max({toMs(endNs - origin), firstAudio, 1e-3});
+
+  std::string text = "Startup timeline (ms since initialize):\n";
+  char line[160];
+  for (const Span &span : sorted) {
+    const double startMs = toMs(span.startNs - origin);
+    const double durationMs = toMs(span.endNs - span.startNs);
+    const int from = static_cast<int>(startMs / totalMs * BAR_WIDTH);
+    const int width = std::max(
+        1, static_cast<int>(durationMs / totalMs * BAR_WIDTH + 0.5));
+    std::string bar(static_cast<size_t>(std::min(from, BAR_WIDTH)), ' ');
+    bar.append(static_cast<size_t>(width), span.ok ? '#' : 'x');
+    std::snprintf(line, sizeof(line), "  %-18s %2u %8.2f %+8.2f  |%s\n",
+                  span.name, span.lane, startMs, durationMs, bar.c_str());
+    text += line;
+  }
+  if (firstAudio >= 0.0) {
+    std::snprintf(line, sizeof(line), "  %-18s    %8.2f\n", "first-audio",
+                  firstAudio);
+    text += line;
+  }
+  return text;
+}
+
+std::string StartupTimeline::toJson() const {
+  const uint64_t origin = originNs_.load(std::memory_order_acquire);
+  const std::vector<Span> sorted = spans();
+  std::string json = "{\"firstAudioMs\":";
+  char number[64];
+  std::snprintf(number, sizeof(number), "%.3f", firstAudioMs());
+  json += number;
+  json += ",\"spans\":[";
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    const Span &span = sorted[i];
+    if (i > 0) {
+      json += ',';
+    }
+    json += "{\"name\":\"";
+    json += span.name;
+    std::snprintf(number, sizeof(number), "\",\"lane\":%u", span.lane);
+    json += number;
+    std::snprintf(number, sizeof(number), ",\"startMs\":%.3f",
+                  toMs(span.startNs - origin));
+    json += number;
+    std::snprintf(number, sizeof(number), ",\"durationMs\":%.3f",
+                  toMs(span.endNs - span.startNs));
+    json += number;
+    json += span.ok ? ",\"ok\":true}" : ",\"ok\":false}";
+  }
+  json += "]}";
+  return json;
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,95 @@
+/**
+ * WindowsAiMic - Startup Timeline Header
+ *
+ * Wall-clock spans of engine start-up (device open, model load, filter
+ * design, IPC) recorded from the initialization threads, plus the moment
+ * audio first reached the render device.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Start-up timeline of one engine
+ *
+ * Span names must be string literals (only the pointer is stored).
+ * Spans may be added from any thread; markFirstAudio() is real-time safe.
+ */
+class StartupTimeline {
+public:
+  struct Span {
+    const char *name = "";
+    uint32_t lane = 0; // Distinct threads in order of first use
+    uint64_t startNs = 0;
+    uint64_t endNs = 0;
+    bool ok = true;
+  };
+
+  /**
+   * Times one span from construction to destruction
+   */
+  class Scope {
+  public:
+    Scope(StartupTimeline &timeline, const char *name);
+    ~Scope();
+
+    // Non-copyable
+    Scope(const Scope &) = delete;
+    Scope &operator=(const Scope &) = delete;
+
+    void fail() { ok_ = false; }
+
+  private:
+    StartupTimeline &timeline_;
+    const char *name_;
+    uint64_t startNs_;
+    bool ok_ = true;
+  };
+
+  /**
+   * Forget all spans and start the clock again
+   */
+  void reset();
+
+  void add(const char *name, uint64_t startNs, uint64_t endNs, bool ok);
+
+  /**
+   * Record the first processed block handed to the render device
+   * Only the first call after reset() counts.
+   */
+  void markFirstAudio();
+
+  /**
+   * Milliseconds from reset() to first audio, or a negative value
+   */
+  double firstAudioMs() const;
+
+  std::vector<Span> spans() const;
+
+  /**
+   * One line per span with its offset, duration and a bar
+   */
+  std::string describe() const;
+
+  /**
+   * {"firstAudioMs": .., "spans": [{"name", "lane", "startMs", ...}]}
+   */
+  std::string toJson() const;
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<Span> spans_;
+  std::vector<std::thread::id> lanes_;
+  std::atomic<uint64_t> originNs_{0};
+  std::atomic<uint64_t> firstAudioNs_{0};
+};
+
+} // namespace WindowsAiMic
@@ -0,0 +1,229 @@
+/**
+ * WindowsAiMic - Tracer Implementation
+ */
+
+#include "tracer.h"
+#include "../platform/clock.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+namespace WindowsAiMic {
+
+namespace {
+
+// Event names are literals from our own code, but keep the JSON valid anyway
+void writeJsonString(std::ofstream &out, const char *text) {
+  out << '"';
+  for (const char *c = text; *c; ++c) {
+    if (*c == '"' || *c == '\\') {
+      out << '\\';
+    }
+    out << *c;
+  }
+  out << '"';
+}
+
+} // namespace
+
+thread_local Tracer::ThreadSlot Tracer::slot_;
+
+Tracer &Tracer::instance() {
+  // Intentionally leaked: threads may still trace during static destruction
+  static Tracer *tracer = new Tracer();
+  return *tracer;
+}
+
+Tracer::Tracer() : startNs_(nowNs()) {}
+
+Tracer::ThreadSlot::~ThreadSlot() {
+  if (trace) {
+    trace->inUse.store(false, std::memory_order_release);
+  }
+}
+
+void Tracer::setEnabled(bool enabled) {
+  if (enabled) {
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    for (auto &trace : threads_) {
+      allocate(*trace);
+    }
+  }
+  enabled_.store(enabled, std::memory_order_release);
+}
+
+void Tracer::registerThread(const char *name) {
+  if (!slot_.trace) {
+    slot_.trace = acquireThread(name);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(threadsMutex_);
+  std::snprintf(slot_.trace->name, NAME_SIZE, "%s", name);
+}
+
+void Tracer::record(const char *name, char phase) {
+  ThreadTrace *trace = currentThread();
+  Event *buffer = trace->buffer.load(std::memory_order_acquire);
+  if (!buffer) {
+    // Thread started tracing before it was registered
+    std::lock_guard<std::mutex> lock(threadsMutex_);
+    allocate(*trace);
+    buffer = trace->buffer.load(std::memory_order_relaxed);
+  }
+
+  const uint64_t index = trace->counters.claim(1);
+  Event &event = buffer[index % RING_CAPACITY];
+  event.timestampNs = nowNs();
+  event.name = name;
+  event.phase = phase;
+
+  trace->counters.publish(index + 1);
+}
+
+Tracer::ThreadTrace *Tracer::currentThread() {
+  if (!slot_.trace) {
+    slot_.trace = acquireThread(nullptr);
+  }
+  return slot_.trace;
+}
+
+Tracer::ThreadTrace *Tracer::acquireThread(const char *name) {
+  std::lock_guard<std::mutex> lock(threadsMutex_);
+
+  // A restarted thread (e.g. capture after a device change) keeps its track
+  if (name) {
+    for (auto &trace : threads_) {
+      if (!trace->inUse.load(std::memory_order_acquire) &&
+          std::strncmp(trace->name, name, NAME_SIZE) == 0) {
+        trace->inUse.store(true, std::memory_order_release);
+        if (enabled_.load(std::memory_order_relaxed)) {
+          allocate(*trace);
+        }
+        return trace.get();
+      }
+    }
+  }
+
+  auto trace = std::make_unique<ThreadTrace>();
+  trace->tid = static_cast<uint32_t>(threads_.size() + 1);
+  if (name) {
+    std::snprintf(trace->name, NAME_SIZE, "%s", name);
+  } else {
+    std::snprintf(trace->name, NAME_SIZE, "thread-%u", trace->tid);
+  }
+  if (enabled_.load(std::memory_order_relaxed)) {
+    allocate(*trace);
+  }
+
+  threads_.push_back(std::move(trace));
+  return threads_.back().get();
+}
+
+void Tracer::allocate(ThreadTrace &trace) {
+  if (trace.events) {
+    return;
+  }
+  trace.events = std::make_unique<Event[]>(RING_CAPACITY);
+  trace.buffer.store(trace.events.get(), std::memory_order_release);
+}
+
+void Tracer::clear() {
+  std::lock_guard<std::mutex> lock(threadsMutex_);
+  for (auto &trace : threads_) {
+    // Only the snapshot window moves; producers keep writing
+    trace->clearedAt.store(trace->counters.end(), std::memory_order_relaxed);
+  }
+}
+
+std::vector<Tracer::Event> Tracer::snapshot(const ThreadTrace &trace) const {
+  const Event *buffer = trace.buffer.load(std::memory_order_acquire);
+  if (!buffer) {
+    return {};
+  }
+
+  const uint64_t end = trace.counters.end();
+  const uint64_t begin =
+      std::max(end > RING_CAPACITY ? end - RING_CAPACITY : 0,
+               std::min(end, trace.clearedAt.load(std::memory_order_relaxed)));
+
+  std::vector<Event> out(static_cast<size_t>(end - begin));
+  for (uint64_t i = begin; i < end; ++i) {
+    out[static_cast<size_t>(i - begin)] = buffer[i % RING_CAPACITY];
+  }
+
+  // Drop whatever the producer may have overwritten while we were copying
+  const size_t stale = trace.counters.stale(begin, out.size(), RING_CAPACITY);
+  out.erase(out.begin(), out.begin() + stale);
+
+  return out;
+}
+
+bool Tracer::exportChromeTrace(const std::string &path) const {
+  std::ofstream out(path);
+  if (!out.is_open()) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(threadsMutex_);
+
+  out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+  bool first = true;
+  auto separator = [&]() {
+    if (!first) {
+      out << ",\n";
+    }
+    first = false;
+  };
+
+  char ts[32];
+  for (const auto &trace : threads_) {
+    std::vector<Event> events = snapshot(*trace);
+    if (events.empty()) {
+      continue;
+    }
+
+    separator();
+    out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+        << trace->tid << ",\"args\":{\"name\":";
+    writeJsonString(out, trace->name);
+    out << "}}";
+
+    // The ring may start in the middle of a scope; skip unmatched ends
+    int depth = 0;
+    for (const Event &event : events) {
+      if (event.phase == 'E') {
+        if (depth == 0) {
+          continue;
+        }
+        --depth;
+      } else if (event.phase == 'B') {
+        ++depth;
+      }
+
+      const double us =
+          event.timestampNs > startNs_
+              ? static_cast<double>(event.timestampNs - startNs_) / 1000.0
+              : 0.0;
+      std::snprintf(ts, sizeof(ts), "%.3f", us);
+
+      separator();
+      out << "{\"name\":";
+      writeJsonString(out, event.name);
+      out << ",\"ph\":\"" << event.phase << "\",\"ts\":" << ts
+          << ",\"pid\":1,\"tid\":" << trace->tid;
+      if (event.phase == 'i') {
+        out << ",\"s\":\"t\"";
+      }
+      out << "}";
+    }
+  }
+
+  out << "\n]}\n";
+  return out.good();
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,148 @@
+/**
+ * WindowsAiMic - Tracer Header
+ *
+ * Opt-in begin/end event tracing for the audio pipeline. Events go into
+ * per-thread lock-free rings (newest events win) and are exported on demand
+ * as Chrome Trace Event JSON, viewable in chrome://tracing or Perfetto.
+ */
+
+#pragma once
+
+#include "seqlock_ring.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Process-wide trace recorder
+ *
+ * Event names must be string literals (only the pointer is stored).
+ * Recording an event costs a clock read and a few stores.
+ */
+class Tracer {
+public:
+  static Tracer &instance();
+
+  // Non-copyable
+  Tracer(const Tracer &) = delete;
+  Tracer &operator=(const Tracer &) = delete;
+
+  /**
+   * Enable/disable recording
+   * Enabling allocates rings for every registered thread up front.
+   */
+  void setEnabled(bool enabled);
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /**
+   * Name the calling thread's track (and reuse its ring across restarts)
+   */
+  void registerThread(const char *name);
+
+  /**
+   * Record events on the calling thread
+   */
+  void begin(const char *name) { record(name, 'B'); }
+  void end(const char *name) { record(name, 'E'); }
+  void instant(const char *name) { record(name, 'i'); }
+
+  /**
+   * Write everything currently buffered as Chrome Trace Event JSON
+   */
+  bool exportChromeTrace(const std::string &path) const;
+
+  /**
+   * Drop all buffered events
+   */
+  void clear();
+
+private:
+  static constexpr size_t RING_CAPACITY = 32768; // Events per thread
+  static constexpr size_t NAME_SIZE = 24;
+
+  struct Event {
+    uint64_t timestampNs;
+    const char *name;
+    char phase; // 'B', 'E' or 'i'
+  };
+
+  struct ThreadTrace {
+    std::unique_ptr<Event[]> events;
+    std::atomic<Event *> buffer{nullptr};
+    SeqlockRing counters;
+    std::atomic<uint64_t> clearedAt{0}; // Export starts here after clear()
+    std::atomic<bool> inUse{true};
+    uint32_t tid = 0;
+    char name[NAME_SIZE] = {};
+  };
+
+  // Marks the ring reusable when its thread exits
+  struct ThreadSlot {
+    ThreadTrace *trace = nullptr;
+    ~ThreadSlot();
+  };
+
+  Tracer();
+
+  void record(const char *name, char phase);
+  ThreadTrace *currentThread();
+  ThreadTrace *acquireThread(const char *name);
+  void allocate(ThreadTrace &trace);
+  std::vector<Event> snapshot(const ThreadTrace &trace) const;
+
+  std::atomic<bool> enabled_{false};
+  uint64_t startNs_;
+
+  // Rings are recycled, never freed
+  mutable std::mutex threadsMutex_;
+  std::vector<std::unique_ptr<ThreadTrace>> threads_;
+
+  static thread_local ThreadSlot slot_;
+};
+
+/**
+ * RAII begin/end pair (no-op while tracing is disabled)
+ */
+class TraceScope {
+public:
+  explicit TraceScope(const char *name)
+      : name_(Tracer::instance().isEnabled() ? name : nullptr) {
+    if (name_) {
+      Tracer::instance().begin(name_);
+    }
+  }
+  ~TraceScope() {
+    if (name_) {
+      Tracer::instance().end(name_);
+    }
+  }
+
+  TraceScope(const TraceScope &) = delete;
+  TraceScope &operator=(const TraceScope &) = delete;
+
+private:
+  const char *name_;
+};
+
+} // namespace WindowsAiMic
+
+#define WAM_TRACE_CONCAT_INNER(a, b) a##b
+#define WAM_TRACE_CONCAT(a, b) WAM_TRACE_CONCAT_INNER(a, b)
+
+#define WAM_TRACE_SCOPE(name)                                                  \
+  ::WindowsAiMic::TraceScope WAM_TRACE_CONCAT(wamTraceScope_, __LINE__)(name)
+
+#define WAM_TRACE_INSTANT(name)                                                \
+  do {                                                                         \
+    ::WindowsAiMic::Tracer &wamTracer_ = ::WindowsAiMic::Tracer::instance();   \
+    if (wamTracer_.isEnabled()) {                                              \
+      wamTracer_.instant(name);                                                \
+    }                                                                          \
+  } while (0)
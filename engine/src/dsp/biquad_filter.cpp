@@ -3,6 +3,8 @@
  */
 
 #include "biquad_filter.h"
+#include "denormal.h"
+#include "processor_state.h"
 #include <cmath>
 
 namespace WindowsAiMic {
@@ -151,4 +153,18 @@ void BiquadFilter::reset() {
   z2_ = 0.0f;
 }
 
+size_t BiquadFilter::countSubnormalState() const {
+  return countSubnormals({z1_, z2_});
+}
+
+void BiquadFilter::saveState(StateWriter &writer) const {
+  writer.write(z1_);
+  writer.write(z2_);
+}
+
+void BiquadFilter::loadState(StateReader &reader) {
+  reader.read(z1_);
+  reader.read(z2_);
+}
+
 } // namespace WindowsAiMic
@@ -10,6 +10,9 @@
 
 namespace WindowsAiMic {
 
+class StateReader;
+class StateWriter;
+
 /**
  * Biquad filter types
  */
@@ -94,6 +97,18 @@ public:
    */
   void reset();
 
+  /**
+   * Count subnormal values in the filter memory
+   */
+  size_t countSubnormalState() const;
+
+  /**
+   * Filter memory (z1, z2) for snapshots; coefficients are parameters
+   */
+  static constexpr size_t STATE_SIZE = 2 * sizeof(float);
+  void saveState(StateWriter &writer) const;
+  void loadState(StateReader &reader);
+
 private:
   // Coefficients
   float b0_ = 1.0f, b1_ = 0.0f, b2_ = 0.0f;
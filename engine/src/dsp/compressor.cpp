@@ -3,12 +3,14 @@
  */
 
 #include "compressor.h"
+#include "denormal.h"
+#include "processor_state.h"
 #include <algorithm>
 #include <cmath>
 
 namespace WindowsAiMic {
 
-Compressor::Compressor() {
+Compressor::Compressor(std::pmr::memory_resource *memory) : delay_(memory) {
   setThreshold(-18.0f);
   setRatio(4.0f);
   setKnee(6.0f);
@@ -41,12 +43,42 @@ void Compressor::setMakeupGain(float db) {
   makeupGain_ = std::pow(10.0f, std::clamp(db, 0.0f, 24.0f) / 20.0f);
 }
 
+void Compressor::setLookahead(float ms) {
+  float lookaheadMs = std::clamp(ms, 0.0f, LookaheadDelay::MAX_LOOKAHEAD_MS);
+  lookaheadSamples_ = static_cast<size_t>(lookaheadMs * sampleRate_ / 1000.0f);
+  delay_.setLookahead(lookaheadSamples_);
+}
+
 void Compressor::reset() {
+  delay_.reset();
   envelope_ = 0.0f;
   gainReductionDb_ = 0.0f;
   smoothedGain_ = 1.0f;
 }
 
+size_t Compressor::countSubnormalState() const {
+  return countSubnormals({envelope_, smoothedGain_}) +
+         delay_.countSubnormalState();
+}
+
+size_t Compressor::stateSize() const {
+  return 3 * sizeof(float) + delay_.stateSize();
+}
+
+void Compressor::saveState(StateWriter &writer) const {
+  writer.write(envelope_);
+  writer.write(gainReductionDb_);
+  writer.write(smoothedGain_);
+  delay_.saveState(writer);
+}
+
+void Compressor::loadState(StateReader &reader) {
+  reader.read(envelope_);
+  reader.read(gainReductionDb_);
+  reader.read(smoothedGain_);
+  delay_.loadState(reader);
+}
+
 float Compressor::computeGainDb(float inputDb) {
   // Soft knee implementation
   float kneeStart = thresholdDb_ - kneeDb_ / 2.0f;
@@ -72,41 +104,55 @@ float Compressor::computeGainDb(float inputDb) {
   return outputDb - inputDb; // Return gain reduction in dB
 }
 
-void Compressor::process(float *buffer, size_t frames) {
-  if (!enabled_) {
+void Compressor::updateGain(float level) {
+  // Avoid log of zero
+  if (level < 1e-10f) {
     return;
   }
 
-  for (size_t i = 0; i < frames; ++i) {
-    float input = buffer[i];
-    float level = std::abs(input);
+  // Envelope follower (peak detector with attack/release)
+  float coeff;
+  if (level > envelope_) {
+    coeff = attackCoeff_;
+  } else {
+    coeff = releaseCoeff_;
+  }
+  envelope_ = coeff * envelope_ + (1.0f - coeff) * level;
 
-    // Avoid log of zero
-    if (level < 1e-10f) {
-      buffer[i] = input * smoothedGain_ * makeupGain_;
-      continue;
-    }
+  // Compute gain reduction
+  float envelopeDb = 20.0f * std::log10(envelope_);
+  float gainDb = computeGainDb(envelopeDb);
+  gainReductionDb_ = -gainDb; // Store as positive value
 
-    // Envelope follower (peak detector with attack/release)
-    float coeff;
-    if (level > envelope_) {
-      coeff = attackCoeff_;
-    } else {
-      coeff = releaseCoeff_;
-    }
-    envelope_ = coeff * envelope_ + (1.0f - coeff) * level;
+  // Convert to linear gain
+  float gain = std::pow(10.0f, gainDb / 20.0f);
 
-    // Compute gain reduction
-    float envelopeDb = 20.0f * std::log10(envelope_);
-    float gainDb = computeGainDb(envelopeDb);
-    gainReductionDb_ = -gainDb; // Store as positive value
+  // Smooth gain changes to avoid zipper noise
+  float smoothCoeff = 0.99f;
+  smoothedGain_ = smoothCoeff * smoothedGain_ + (1.0f - smoothCoeff) * gain;
+}
 
-    // Convert to linear gain
-    float gain = std::pow(10.0f, gainDb / 20.0f);
+float Compressor::tapGain(const LookaheadDelay &line, float upstream) {
+  updateGain(std::abs(line.ahead(lookaheadSamples_)) * upstream);
+  return smoothedGain_ * makeupGain_;
+}
 
-    // Smooth gain changes to avoid zipper noise
-    float smoothCoeff = 0.99f;
-    smoothedGain_ = smoothCoeff * smoothedGain_ + (1.0f - smoothCoeff) * gain;
+void Compressor::process(float *buffer, size_t frames) {
+  if (!enabled_) {
+    return;
+  }
+
+  if (delay_.lookahead() > 0) {
+    for (size_t i = 0; i < frames; ++i) {
+      delay_.push(buffer[i]);
+      buffer[i] = delay_.tap() * tapGain(delay_, 1.0f);
+    }
+    return;
+  }
+
+  for (size_t i = 0; i < frames; ++i) {
+    float input = buffer[i];
+    updateGain(std::abs(input));
 
     // Apply compression and makeup gain
     buffer[i] = input * smoothedGain_ * makeupGain_;
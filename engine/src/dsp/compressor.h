@@ -7,7 +7,9 @@
 #pragma once
 
 #include "dsp_processor_interface.h"
+#include "lookahead_delay.h"
 #include <cstddef>
+#include <memory_resource>
 
 namespace WindowsAiMic {
 
@@ -19,13 +21,22 @@ namespace WindowsAiMic {
  */
 class Compressor : public IDSPProcessor {
 public:
-  Compressor();
+  /**
+   * @param memory Where process()'s lookahead line lives; nullptr for
+   *               a compressor that only runs at a chain's shared line
+   */
+  explicit Compressor(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
   // IDSPProcessor interface
   void process(float *buffer, size_t frames) override;
   void reset() override;
   void setEnabled(bool enabled) override { enabled_ = enabled; }
   bool isEnabled() const override { return enabled_; }
+  size_t countSubnormalState() const override;
+  size_t stateSize() const override;
+  void saveState(StateWriter &writer) const override;
+  void loadState(StateReader &reader) override;
 
   /**
    * Set compression threshold
@@ -68,8 +79,24 @@ public:
    */
   float getGainReduction() const { return gainReductionDb_; }
 
+  /**
+   * Set lookahead time (so attacks are caught before they pass)
+   * @param ms Lookahead in milliseconds (0 to 10)
+   * Note: Adds latency equal to lookahead time
+   */
+  void setLookahead(float ms);
+  size_t getLookahead() const { return lookaheadSamples_; }
+
+  /**
+   * Gain for the sample at `line`'s tap, detected getLookahead() samples
+   * after it scaled by `upstream` (the gain earlier stages apply). One
+   * call per pushed sample.
+   */
+  float tapGain(const LookaheadDelay &line, float upstream);
+
 private:
   float computeGainDb(float inputDb);
+  void updateGain(float level);
 
   bool enabled_ = true;
 
@@ -86,6 +113,10 @@ private:
   float gainReductionDb_ = 0.0f;
   float smoothedGain_ = 1.0f;
 
+  // Lookahead, and process()'s own line when not in a chain
+  size_t lookaheadSamples_ = 0;
+  LookaheadDelay delay_;
+
   // Sample rate
   float sampleRate_ = 48000.0f;
 };
@@ -0,0 +1,37 @@
+/**
+ * WindowsAiMic - Denormal Helpers
+ *
+ * Subnormal checks for the debug state sampler. The test works on the bit
+ * pattern: with DAZ set, a comparison reads a subnormal operand as zero.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+namespace WindowsAiMic {
+
+/**
+ * True for a nonzero value with a zero exponent
+ */
+inline bool isSubnormal(float value) {
+  uint32_t bits = 0;
+  std::memcpy(&bits, &value, sizeof(bits));
+  return (bits & 0x7F800000u) == 0 && (bits & 0x007FFFFFu) != 0;
+}
+
+/**
+ * Number of subnormal values in a list of state variables
+ */
+inline size_t countSubnormals(std::initializer_list<float> values) {
+  size_t count = 0;
+  for (const float value : values) {
+    count += isSubnormal(value) ? 1 : 0;
+  }
+  return count;
+}
+
+} // namespace WindowsAiMic
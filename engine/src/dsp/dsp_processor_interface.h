@@ -10,6 +10,9 @@
 
 namespace WindowsAiMic {
 
+class StateReader;
+class StateWriter;
+
 /**
  * Abstract interface for DSP processors
  */
@@ -38,6 +41,22 @@ public:
    * Check if processor is enabled
    */
   virtual bool isEnabled() const = 0;
+
+  /**
+   * Count subnormal values in the processor's state (debug check)
+   * Envelopes and filter memories decay toward zero in silence; without
+   * FTZ/DAZ they end up subnormal and every operation on them stalls.
+   */
+  virtual size_t countSubnormalState() const { return 0; }
+
+  /**
+   * Running state (not parameters) for snapshots: stateSize() bytes,
+   * which may change with parameters such as a delay length. loadState()
+   * expects what saveState() wrote with the same parameters.
+   */
+  virtual size_t stateSize() const { return 0; }
+  virtual void saveState(StateWriter &) const {}
+  virtual void loadState(StateReader &) {}
 };
 
 } // namespace WindowsAiMic
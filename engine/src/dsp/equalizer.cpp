@@ -3,6 +3,8 @@
  */
 
 #include "equalizer.h"
+#include "denormal.h"
+#include "processor_state.h"
 #include <algorithm>
 #include <cmath>
 
@@ -60,6 +62,35 @@ void Equalizer::reset() {
   deEsserEnvelope_ = 0.0f;
 }
 
+size_t Equalizer::countSubnormalState() const {
+  return highPass_.countSubnormalState() + lowShelf_.countSubnormalState() +
+         presence_.countSubnormalState() + highShelf_.countSubnormalState() +
+         deEsserDetect_.countSubnormalState() +
+         countSubnormals({deEsserEnvelope_});
+}
+
+size_t Equalizer::stateSize() const {
+  return 5 * BiquadFilter::STATE_SIZE + sizeof(float);
+}
+
+void Equalizer::saveState(StateWriter &writer) const {
+  highPass_.saveState(writer);
+  lowShelf_.saveState(writer);
+  presence_.saveState(writer);
+  highShelf_.saveState(writer);
+  deEsserDetect_.saveState(writer);
+  writer.write(deEsserEnvelope_);
+}
+
+void Equalizer::loadState(StateReader &reader) {
+  highPass_.loadState(reader);
+  lowShelf_.loadState(reader);
+  presence_.loadState(reader);
+  highShelf_.loadState(reader);
+  deEsserDetect_.loadState(reader);
+  reader.read(deEsserEnvelope_);
+}
+
 void Equalizer::process(float *buffer, size_t frames) {
   if (!enabled_) {
     return;
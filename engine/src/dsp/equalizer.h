@@ -27,6 +27,10 @@ public:
   void reset() override;
   void setEnabled(bool enabled) override { enabled_ = enabled; }
   bool isEnabled() const override { return enabled_; }
+  size_t countSubnormalState() const override;
+  size_t stateSize() const override;
+  void saveState(StateWriter &writer) const override;
+  void loadState(StateReader &reader) override;
 
   /**
    * Set high-pass filter (rumble removal)
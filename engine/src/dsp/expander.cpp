@@ -3,12 +3,14 @@
  */
 
 #include "expander.h"
+#include "denormal.h"
+#include "processor_state.h"
 #include <algorithm>
 #include <cmath>
 
 namespace WindowsAiMic {
 
-Expander::Expander() {
+Expander::Expander(std::pmr::memory_resource *memory) : delay_(memory) {
   setThreshold(-40.0f);
   setRatio(2.0f);
   setAttack(5.0f);
@@ -40,12 +42,41 @@ void Expander::setHysteresis(float db) {
   hysteresis_ = std::pow(10.0f, std::clamp(db, 0.0f, 10.0f) / 20.0f);
 }
 
+void Expander::setLookahead(float ms) {
+  float lookaheadMs = std::clamp(ms, 0.0f, LookaheadDelay::MAX_LOOKAHEAD_MS);
+  lookaheadSamples_ = static_cast<size_t>(lookaheadMs * sampleRate_ / 1000.0f);
+  delay_.setLookahead(lookaheadSamples_);
+}
+
 void Expander::reset() {
+  delay_.reset();
   envelope_ = 0.0f;
   gainReductionDb_ = 0.0f;
   gateOpen_ = false;
 }
 
+size_t Expander::countSubnormalState() const {
+  return countSubnormals({envelope_}) + delay_.countSubnormalState();
+}
+
+size_t Expander::stateSize() const {
+  return 2 * sizeof(float) + sizeof(bool) + delay_.stateSize();
+}
+
+void Expander::saveState(StateWriter &writer) const {
+  writer.write(envelope_);
+  writer.write(gainReductionDb_);
+  writer.write(gateOpen_);
+  delay_.saveState(writer);
+}
+
+void Expander::loadState(StateReader &reader) {
+  reader.read(envelope_);
+  reader.read(gainReductionDb_);
+  reader.read(gateOpen_);
+  delay_.loadState(reader);
+}
+
 float Expander::computeGain(float envelope) {
   // Compute gain reduction based on envelope level relative to threshold
   if (envelope < 1e-10f) {
@@ -71,43 +102,56 @@ float Expander::computeGain(float envelope) {
   return 1.0f;
 }
 
+float Expander::nextGain(float level) {
+  // Envelope follower with attack/release
+  float coeff;
+  if (level > envelope_) {
+    coeff = attackCoeff_; // Fast attack
+  } else {
+    coeff = releaseCoeff_; // Slow release
+  }
+  envelope_ = coeff * envelope_ + (1.0f - coeff) * level;
+
+  // Hysteresis logic
+  float effectiveThreshold;
+  if (gateOpen_) {
+    // Once open, use lower threshold to close (hysteresis)
+    effectiveThreshold = threshold_ / hysteresis_;
+  } else {
+    effectiveThreshold = threshold_;
+  }
+
+  // Update gate state
+  if (envelope_ > threshold_) {
+    gateOpen_ = true;
+  } else if (envelope_ < effectiveThreshold) {
+    gateOpen_ = false;
+  }
+
+  return computeGain(envelope_);
+}
+
+float Expander::tapGain(const LookaheadDelay &line, float upstream) {
+  return nextGain(std::abs(line.ahead(lookaheadSamples_)) * upstream);
+}
+
 void Expander::process(float *buffer, size_t frames) {
   if (!enabled_) {
     return;
   }
 
-  for (size_t i = 0; i < frames; ++i) {
-    float input = buffer[i];
-    float level = std::abs(input);
-
-    // Envelope follower with attack/release
-    float coeff;
-    if (level > envelope_) {
-      coeff = attackCoeff_; // Fast attack
-    } else {
-      coeff = releaseCoeff_; // Slow release
-    }
-    envelope_ = coeff * envelope_ + (1.0f - coeff) * level;
-
-    // Hysteresis logic
-    float effectiveThreshold;
-    if (gateOpen_) {
-      // Once open, use lower threshold to close (hysteresis)
-      effectiveThreshold = threshold_ / hysteresis_;
-    } else {
-      effectiveThreshold = threshold_;
-    }
-
-    // Update gate state
-    if (envelope_ > threshold_) {
-      gateOpen_ = true;
-    } else if (envelope_ < effectiveThreshold) {
-      gateOpen_ = false;
+  if (delay_.lookahead() > 0) {
+    // Gate opens ahead of the delayed sample
+    for (size_t i = 0; i < frames; ++i) {
+      delay_.push(buffer[i]);
+      buffer[i] = delay_.tap() * tapGain(delay_, 1.0f);
     }
+    return;
+  }
 
-    // Compute and apply gain
-    float gain = computeGain(envelope_);
-    buffer[i] = input * gain;
+  for (size_t i = 0; i < frames; ++i) {
+    float input = buffer[i];
+    buffer[i] = input * nextGain(std::abs(input));
   }
 }
 
@@ -7,7 +7,9 @@
 #pragma once
 
 #include "dsp_processor_interface.h"
+#include "lookahead_delay.h"
 #include <cstddef>
+#include <memory_resource>
 
 namespace WindowsAiMic {
 
@@ -20,13 +22,22 @@ namespace WindowsAiMic {
  */
 class Expander : public IDSPProcessor {
 public:
-  Expander();
+  /**
+   * @param memory Where process()'s lookahead line lives; nullptr for
+   *               an expander that only runs at a chain's shared line
+   */
+  explicit Expander(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
   // IDSPProcessor interface
   void process(float *buffer, size_t frames) override;
   void reset() override;
   void setEnabled(bool enabled) override { enabled_ = enabled; }
   bool isEnabled() const override { return enabled_; }
+  size_t countSubnormalState() const override;
+  size_t stateSize() const override;
+  void saveState(StateWriter &writer) const override;
+  void loadState(StateReader &reader) override;
 
   /**
    * Set threshold for expansion
@@ -63,8 +74,24 @@ public:
    */
   float getGainReduction() const { return gainReductionDb_; }
 
+  /**
+   * Set lookahead time (so word onsets open the gate)
+   * @param ms Lookahead in milliseconds (0 to 10)
+   * Note: Adds latency equal to lookahead time
+   */
+  void setLookahead(float ms);
+  size_t getLookahead() const { return lookaheadSamples_; }
+
+  /**
+   * Gain for the sample at `line`'s tap, detected getLookahead() samples
+   * after it scaled by `upstream` (the gain earlier stages apply). One
+   * call per pushed sample.
+   */
+  float tapGain(const LookaheadDelay &line, float upstream);
+
 private:
   float computeGain(float envelope);
+  float nextGain(float level);
 
   bool enabled_ = true;
 
@@ -80,6 +107,10 @@ private:
   float gainReductionDb_ = 0.0f;
   bool gateOpen_ = false;
 
+  // Lookahead, and process()'s own line when not in a chain
+  size_t lookaheadSamples_ = 0;
+  LookaheadDelay delay_;
+
   // Sample rate (set during first process or via initialize)
   float sampleRate_ = 48000.0f;
 };
@@ -3,12 +3,14 @@
  */
 
 #include "limiter.h"
+#include "denormal.h"
+#include "processor_state.h"
 #include <algorithm>
 #include <cmath>
 
 namespace WindowsAiMic {
 
-Limiter::Limiter() {
+Limiter::Limiter(std::pmr::memory_resource *memory) : delay_(memory) {
   setCeiling(-1.0f);
   setRelease(50.0f);
   setLookahead(5.0f);
@@ -24,93 +26,88 @@ void Limiter::setRelease(float ms) {
 }
 
 void Limiter::setLookahead(float ms) {
-  float lookaheadMs = std::clamp(ms, 0.0f, 10.0f);
-  size_t newLookahead =
-      static_cast<size_t>(lookaheadMs * sampleRate_ / 1000.0f);
-
-  if (newLookahead != lookaheadSamples_) {
-    lookaheadSamples_ = newLookahead;
-    lookaheadBuffer_.resize(lookaheadSamples_ + 1);
-    std::fill(lookaheadBuffer_.begin(), lookaheadBuffer_.end(), 0.0f);
-    bufferPos_ = 0;
+  float lookaheadMs = std::clamp(ms, 0.0f, LookaheadDelay::MAX_LOOKAHEAD_MS);
+  lookaheadSamples_ = static_cast<size_t>(lookaheadMs * sampleRate_ / 1000.0f);
+  if (lookaheadSamples_ > 0) {
+    attackCoeff_ = std::exp(-1.0f / static_cast<float>(lookaheadSamples_));
   }
+  delay_.setLookahead(lookaheadSamples_);
 }
 
 void Limiter::reset() {
-  std::fill(lookaheadBuffer_.begin(), lookaheadBuffer_.end(), 0.0f);
-  bufferPos_ = 0;
+  delay_.reset();
   gainReductionDb_ = 0.0f;
   smoothedGain_ = 1.0f;
 }
 
+size_t Limiter::countSubnormalState() const {
+  return countSubnormals({smoothedGain_}) + delay_.countSubnormalState();
+}
+
+size_t Limiter::stateSize() const {
+  return delay_.stateSize() + 2 * sizeof(float);
+}
+
+void Limiter::saveState(StateWriter &writer) const {
+  delay_.saveState(writer);
+  writer.write(gainReductionDb_);
+  writer.write(smoothedGain_);
+}
+
+void Limiter::loadState(StateReader &reader) {
+  delay_.loadState(reader);
+  reader.read(gainReductionDb_);
+  reader.read(smoothedGain_);
+}
+
+float Limiter::nextGain(float level, bool instantAttack) {
+  // Calculate required gain
+  float targetGain = 1.0f;
+  if (level > ceiling_) {
+    targetGain = ceiling_ / level;
+  }
+
+  // Smooth gain: instant attack, or over the lookahead; slow release
+  if (targetGain < smoothedGain_) {
+    if (instantAttack) {
+      smoothedGain_ = targetGain;
+    } else {
+      smoothedGain_ =
+          attackCoeff_ * smoothedGain_ + (1.0f - attackCoeff_) * targetGain;
+    }
+  } else {
+    smoothedGain_ =
+        releaseCoeff_ * smoothedGain_ + (1.0f - releaseCoeff_) * targetGain;
+  }
+
+  gainReductionDb_ = -20.0f * std::log10(std::max(smoothedGain_, 0.0001f));
+  return smoothedGain_;
+}
+
+float Limiter::tapGain(const LookaheadDelay &line, float upstream) {
+  if (lookaheadSamples_ == 0) {
+    return nextGain(std::abs(line.tap()) * upstream, true);
+  }
+  // Peak in the lookahead window
+  return nextGain(line.peakAhead(1, lookaheadSamples_ + 1) * upstream, false);
+}
+
 void Limiter::process(float *buffer, size_t frames) {
   if (!enabled_) {
     return;
   }
 
-  if (lookaheadSamples_ == 0) {
+  if (delay_.lookahead() == 0) {
     // No lookahead - simple instantaneous limiting
     for (size_t i = 0; i < frames; ++i) {
       float input = buffer[i];
-      float absInput = std::abs(input);
-
-      // Calculate required gain reduction
-      float targetGain = 1.0f;
-      if (absInput > ceiling_) {
-        targetGain = ceiling_ / absInput;
-      }
-
-      // Smooth gain changes (instant attack, slow release)
-      if (targetGain < smoothedGain_) {
-        smoothedGain_ = targetGain; // Instant attack
-      } else {
-        smoothedGain_ =
-            releaseCoeff_ * smoothedGain_ + (1.0f - releaseCoeff_) * targetGain;
-      }
-
-      gainReductionDb_ = -20.0f * std::log10(std::max(smoothedGain_, 0.0001f));
-
-      buffer[i] = input * smoothedGain_;
+      buffer[i] = input * nextGain(std::abs(input), true);
     }
   } else {
-    // Lookahead limiting
+    // Lookahead limiting: delayed sample out with the gain applied
     for (size_t i = 0; i < frames; ++i) {
-      float input = buffer[i];
-
-      // Store input in lookahead buffer
-      float delayedSample = lookaheadBuffer_[bufferPos_];
-      lookaheadBuffer_[bufferPos_] = input;
-
-      // Find peak in lookahead window
-      float peakLevel = 0.0f;
-      for (size_t j = 0; j < lookaheadBuffer_.size(); ++j) {
-        peakLevel = std::max(peakLevel, std::abs(lookaheadBuffer_[j]));
-      }
-
-      // Calculate required gain
-      float targetGain = 1.0f;
-      if (peakLevel > ceiling_) {
-        targetGain = ceiling_ / peakLevel;
-      }
-
-      // Smooth gain (fast attack via lookahead, slow release)
-      if (targetGain < smoothedGain_) {
-        // Use lookahead attack time
-        float attackCoeff =
-            std::exp(-1.0f / static_cast<float>(lookaheadSamples_));
-        smoothedGain_ =
-            attackCoeff * smoothedGain_ + (1.0f - attackCoeff) * targetGain;
-      } else {
-        smoothedGain_ =
-            releaseCoeff_ * smoothedGain_ + (1.0f - releaseCoeff_) * targetGain;
-      }
-
-      gainReductionDb_ = -20.0f * std::log10(std::max(smoothedGain_, 0.0001f));
-
-      // Output delayed sample with gain applied
-      buffer[i] = delayedSample * smoothedGain_;
-
-      bufferPos_ = (bufferPos_ + 1) % lookaheadBuffer_.size();
+      delay_.push(buffer[i]);
+      buffer[i] = delay_.tap() * tapGain(delay_, 1.0f);
     }
   }
 }
@@ -7,8 +7,9 @@
 #pragma once
 
 #include "dsp_processor_interface.h"
+#include "lookahead_delay.h"
 #include <cstddef>
-#include <vector>
+#include <memory_resource>
 
 namespace WindowsAiMic {
 
@@ -20,13 +21,22 @@ namespace WindowsAiMic {
  */
 class Limiter : public IDSPProcessor {
 public:
-  Limiter();
+  /**
+   * @param memory Where process()'s lookahead line lives; nullptr for a
+   *               limiter that only runs at a chain's shared line
+   */
+  explicit Limiter(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
   // IDSPProcessor interface
   void process(float *buffer, size_t frames) override;
   void reset() override;
   void setEnabled(bool enabled) override { enabled_ = enabled; }
   bool isEnabled() const override { return enabled_; }
+  size_t countSubnormalState() const override;
+  size_t stateSize() const override;
+  void saveState(StateWriter &writer) const override;
+  void loadState(StateReader &reader) override;
 
   /**
    * Set output ceiling
@@ -47,6 +57,18 @@ public:
    */
   void setLookahead(float ms);
 
+  /**
+   * Gain for the sample at `line`'s tap, from the peak of the lookahead
+   * samples after it scaled by `upstream` (the gain earlier stages apply
+   * to that sample). One call per pushed sample.
+   */
+  float tapGain(const LookaheadDelay &line, float upstream);
+
+  /** Largest gain that keeps a sample of magnitude `level` at the ceiling */
+  float ceilingGain(float level) const {
+    return level > ceiling_ ? ceiling_ / level : 1.0f;
+  }
+
   /**
    * Get current gain reduction in dB
    */
@@ -56,18 +78,21 @@ public:
    * Get latency in samples (due to lookahead)
    */
   size_t getLatency() const { return lookaheadSamples_; }
+  size_t getLookahead() const { return lookaheadSamples_; }
 
 private:
+  float nextGain(float level, bool instantAttack);
+
   bool enabled_ = true;
 
   // Parameters
   float ceiling_ = 0.891f; // -1 dBFS
   float releaseCoeff_ = 0.0f;
+  float attackCoeff_ = 0.0f; // Over the lookahead
   size_t lookaheadSamples_ = 0;
 
-  // Lookahead buffer
-  std::vector<float> lookaheadBuffer_;
-  size_t bufferPos_ = 0;
+  // process()'s own line when not in a chain
+  LookaheadDelay delay_;
 
   // State
   float gainReductionDb_ = 0.0f;
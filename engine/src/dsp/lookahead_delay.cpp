@@ -0,0 +1,94 @@
+/**
+ * WindowsAiMic - Lookahead Delay Implementation
+ */
+
+#include "lookahead_delay.h"
+#include "denormal.h"
+#include "processor_state.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+LookaheadDelay::LookaheadDelay(std::pmr::memory_resource *memory)
+    : buffer_(memory ? memory : std::pmr::null_memory_resource()) {
+  if (memory) {
+    buffer_.resize(MAX_LOOKAHEAD + 2, 0.0f);
+    length_ = 1;
+  }
+}
+
+void LookaheadDelay::setLookahead(size_t samples) {
+  if (buffer_.empty()) {
+    return; // No storage
+  }
+  const size_t lookahead = std::min(samples, MAX_LOOKAHEAD);
+  if (lookahead != lookahead_) {
+    lookahead_ = lookahead;
+    length_ = lookahead_ > 0 ? lookahead_ + 2 : 1;
+    reset();
+  }
+}
+
+void LookaheadDelay::reset() {
+  std::fill(buffer_.begin(), buffer_.end(), 0.0f);
+  position_ = 0;
+}
+
+float LookaheadDelay::peakAhead(size_t first, size_t last) const {
+  // At most two contiguous runs, so the scans vectorise
+  const size_t size = length_;
+  size_t begin = position_ + first;
+  begin = begin < size ? begin : begin - size;
+  const size_t count = last - first + 1;
+  const size_t run = std::min(count, size - begin);
+
+  float peak = 0.0f;
+  const float *samples = buffer_.data();
+  for (size_t i = begin; i < begin + run; ++i) {
+    peak = std::max(peak, std::abs(samples[i]));
+  }
+  for (size_t i = 0; i < count - run; ++i) {
+    peak = std::max(peak, std::abs(samples[i]));
+  }
+  return peak;
+}
+
+size_t LookaheadDelay::countSubnormalState() const {
+  size_t count = 0;
+  for (size_t i = 0; i < length_; ++i) {
+    count += isSubnormal(buffer_[i]) ? 1 : 0;
+  }
+  return count;
+}
+
+size_t LookaheadDelay::stateSize() const {
+  return 2 * sizeof(uint64_t) + length_ * sizeof(float);
+}
+
+void LookaheadDelay::saveState(StateWriter &writer) const {
+  writer.write(static_cast<uint64_t>(length_));
+  writer.writeFloats(buffer_.data(), length_);
+  writer.write(static_cast<uint64_t>(position_));
+}
+
+void LookaheadDelay::loadState(StateReader &reader) {
+  // The samples only carry over to the same lookahead
+  uint64_t length = 0;
+  reader.read(length);
+  if (length != length_) {
+    reader.fail();
+    return;
+  }
+  reader.readFloats(buffer_.data(), length_);
+  uint64_t position = 0;
+  reader.read(position);
+  if (position >= std::max<uint64_t>(length, 1)) {
+    reader.fail();
+    return;
+  }
+  position_ = static_cast<size_t>(position);
+}
+
+} // namespace WindowsAiMic
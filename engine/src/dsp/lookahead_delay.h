@@ -0,0 +1,77 @@
+/**
+ * WindowsAiMic - Lookahead Delay Header
+ *
+ * Delay line that lookahead dynamics stages share: their detectors read
+ * the samples ahead of the tap, and their gains are applied once to the
+ * sample leaving at the tap. Latency is the largest lookahead, not the
+ * sum, and each sample is stored once however many stages look ahead.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace WindowsAiMic {
+
+class StateReader;
+class StateWriter;
+
+class LookaheadDelay {
+public:
+  static constexpr float MAX_LOOKAHEAD_MS = 10.0f;
+  static constexpr size_t MAX_LOOKAHEAD = 480; // 10 ms at 48 kHz
+
+  /**
+   * @param memory Where the line lives; sized for MAX_LOOKAHEAD once, so
+   *               a lookahead change never reallocates. nullptr gives a
+   *               line with no storage, whose lookahead stays 0 (for
+   *               stages that only run in a chain's shared line).
+   */
+  explicit LookaheadDelay(std::pmr::memory_resource *memory);
+
+  /**
+   * Set the lookahead in samples (clamped to MAX_LOOKAHEAD)
+   * A change clears the line; call it from the thread that pushes.
+   */
+  void setLookahead(size_t samples);
+  size_t lookahead() const { return lookahead_; }
+
+  void reset();
+
+  /**
+   * Add the newest sample; the one lookahead() + 1 samples older is then
+   * at the tap (with no lookahead, the newest itself). The extra sample
+   * is the limiter's original layout, kept so its output is unchanged.
+   */
+  void push(float sample) {
+    buffer_[position_] = sample;
+    position_ = position_ + 1 >= length_ ? 0 : position_ + 1;
+  }
+
+  /** Sample leaving the line */
+  float tap() const { return buffer_[position_]; }
+
+  /** Sample `offset` after the tap; offset <= lookahead() + 1 */
+  float ahead(size_t offset) const {
+    const size_t index = position_ + offset;
+    return buffer_[index < length_ ? index : index - length_];
+  }
+
+  /** Largest magnitude from ahead(first) to ahead(last) inclusive */
+  float peakAhead(size_t first, size_t last) const;
+
+  size_t countSubnormalState() const;
+  size_t stateSize() const;
+  void saveState(StateWriter &writer) const;
+  void loadState(StateReader &reader);
+
+private:
+  std::pmr::vector<float> buffer_; // MAX_LOOKAHEAD + 2, or empty
+  size_t length_ = 0;               // In use: lookahead + 2, or 1
+  size_t position_ = 0;             // Tap; the next push overwrites it
+  size_t lookahead_ = 0;
+};
+
+} // namespace WindowsAiMic
@@ -9,7 +9,8 @@
 
 namespace WindowsAiMic {
 
-Metering::Metering() : lufsBuffer_(LUFS_WINDOW_SAMPLES, 0.0f) {
+Metering::Metering(std::pmr::memory_resource *memory)
+    : lufsBuffer_(LUFS_WINDOW_SAMPLES, 0.0f, memory) {
   setPeakDecay(1500.0f); // 1.5 second decay
 }
 
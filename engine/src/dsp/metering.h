@@ -7,6 +7,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory_resource>
 #include <vector>
 
 namespace WindowsAiMic {
@@ -19,7 +20,11 @@ namespace WindowsAiMic {
  */
 class Metering {
 public:
-  Metering();
+  /**
+   * @param memory Where the LUFS window lives
+   */
+  explicit Metering(
+      std::pmr::memory_resource *memory = std::pmr::get_default_resource());
 
   /**
    * Process audio buffer and update measurements
@@ -86,7 +91,7 @@ private:
 
   // LUFS meter (simplified - uses 3 second window)
   float lufs_ = -70.0f;
-  std::vector<float> lufsBuffer_;
+  std::pmr::vector<float> lufsBuffer_;
   size_t lufsPos_ = 0;
   static constexpr size_t LUFS_WINDOW_SAMPLES = 48000 * 3; // 3 seconds
 };
@@ -0,0 +1,101 @@
+/**
+ * WindowsAiMic - Processor State Serialization
+ *
+ * Bounded byte writer and reader the processors save their running state
+ * (envelopes, filter memories, delay lines, model state) through. Both
+ * work on caller-owned memory, so saving and restoring never allocate.
+ * Values are native-endian: a snapshot is for the build that made it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace WindowsAiMic {
+
+/**
+ * Appends state to a fixed buffer; an append that doesn't fit fails the
+ * writer and writes nothing
+ */
+class StateWriter {
+public:
+  StateWriter(uint8_t *data, size_t capacity)
+      : data_(data), capacity_(capacity) {}
+
+  void writeBytes(const void *bytes, size_t size) {
+    if (!ok_ || size > capacity_ - size_) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(data_ + size_, bytes, size);
+    size_ += size;
+  }
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    writeBytes(&value, sizeof(T));
+  }
+
+  void writeFloats(const float *values, size_t count) {
+    writeBytes(values, count * sizeof(float));
+  }
+
+  bool ok() const { return ok_; }
+  size_t size() const { return size_; }
+
+private:
+  uint8_t *data_;
+  size_t capacity_;
+  size_t size_ = 0;
+  bool ok_ = true;
+};
+
+/**
+ * Reads state back in the order it was written; a read past the end, or
+ * a value the processor rejects (fail()), fails the reader
+ */
+class StateReader {
+public:
+  StateReader(const uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+  void readBytes(void *bytes, size_t size) {
+    if (!ok_ || size > size_ - position_) {
+      ok_ = false;
+      return;
+    }
+    std::memcpy(bytes, data_ + position_, size);
+    position_ += size;
+  }
+
+  template <typename T> void read(T &value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    readBytes(&value, sizeof(T));
+  }
+
+  void readFloats(float *values, size_t count) {
+    readBytes(values, count * sizeof(float));
+  }
+
+  void skip(size_t size) {
+    if (!ok_ || size > size_ - position_) {
+      ok_ = false;
+      return;
+    }
+    position_ += size;
+  }
+
+  void fail() { ok_ = false; }
+  bool ok() const { return ok_; }
+  size_t remaining() const { return size_ - position_; }
+
+private:
+  const uint8_t *data_;
+  size_t size_;
+  size_t position_ = 0;
+  bool ok_ = true;
+};
+
+} // namespace WindowsAiMic
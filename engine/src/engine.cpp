@@ -7,79 +7,215 @@
 
 #include "engine.h"
 #include "ai/openvino_processor.h"
-#include "ai/rnnoise_processor.h"
 #include "audio/resampler.h"
 #include "audio/wasapi_capture.h"
 #include "audio/wasapi_render.h"
-#include "dsp/compressor.h"
-#include "dsp/equalizer.h"
-#include "dsp/expander.h"
-#include "dsp/limiter.h"
+#include "config/config_watcher.h"
+#include "config/presets.h"
+#include "core/auto_tuner.h"
+#include "core/processing_chain.h"
+#include "diagnostics/flight_recorder.h"
+#include "diagnostics/logger.h"
+#include "diagnostics/metrics.h"
+#include "diagnostics/tracer.h"
 #include "dsp/metering.h"
+#include "ipc/audio_export.h"
 #include "ipc/pipe_server.h"
+#include "ipc/telemetry.h"
+#include "platform/clock.h"
 #include "platform/cpu_features.h"
+#include "platform/cpu_topology.h"
+#include "platform/power.h"
 #include "platform/simd_dsp.h"
 #include "platform/thread_utils.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <future>
 #include <iostream>
+#include <iterator>
 
 namespace WindowsAiMic {
 
-Engine::Engine(ConfigManager &configManager)
-    : configManager_(configManager), inputBuffer_(BUFFER_SIZE),
-      outputBuffer_(BUFFER_SIZE), processingBuffer_(PROCESSING_BLOCK_SIZE) {}
+namespace {
 
-Engine::~Engine() { stop(); }
+// Efficiency mode: the capture thread wakes once per (largest) quantum
+constexpr float EFFICIENCY_QUANTUM_US =
+    MAX_QUANTUM_FRAMES * 1e6f / ProcessingChain::SAMPLE_RATE;
+
+std::vector<std::string> splitLines(const std::string &text) {
+  std::vector<std::string> lines;
+  size_t begin = 0;
+  while (begin < text.size()) {
+    size_t end = text.find('\n', begin);
+    if (end == std::string::npos) {
+      end = text.size();
+    }
+    lines.push_back(text.substr(begin, end - begin));
+    begin = end + 1;
+  }
+  return lines;
+}
+} // namespace
+
+Engine::Engine(ConfigManager &configManager, AudioBackend backend)
+    : configManager_(configManager), backend_(std::move(backend)),
+      outputBuffer_(BUFFER_SIZE) {
+  input_.ring = std::make_unique<LockFreeRingBuffer>(BUFFER_SIZE);
+  nextInput_.ring = std::make_unique<LockFreeRingBuffer>(BUFFER_SIZE);
+  activeInputRing_.store(input_.ring.get());
+
+  MetricsRegistry &metrics = MetricsRegistry::instance();
+  blockTimeMetric_ = &metrics.histogram(
+      "wam_block_process_us", "Processing time per 10 ms block");
+  wakeLatencyMetric_ =
+      &metrics.histogram("wam_wake_latency_us",
+                         "Capture callback to processing thread wake-up");
+  inputQueueMetric_ = &metrics.gauge("wam_input_queue_frames",
+                                     "Frames waiting in the input ring");
+  outputQueueMetric_ = &metrics.gauge(
+      "wam_output_queue_frames", "Frames queued for the render device");
+  firstAudioMetric_ = &metrics.gauge(
+      "wam_time_to_first_audio_ms",
+      "initialize() to the first block handed to the render device");
+  quantumMetric_ = &metrics.gauge(
+      "wam_quantum_frames", "Frames per processing block (auto-tuned)");
+  // Same series the devices count their wake-ups in
+  captureWakeMetric_ = &metrics.counter(
+      "wam_audio_wakeups_total", "Audio thread wake-ups", "thread=\"capture\"");
+  renderWakeMetric_ = &metrics.counter(
+      "wam_audio_wakeups_total", "Audio thread wake-ups", "thread=\"render\"");
+  processingWakeMetric_ =
+      &metrics.counter("wam_audio_wakeups_total", "Audio thread wake-ups",
+                       "thread=\"processing\"");
+  wakeupRateMetric_ = &metrics.gauge(
+      "wam_wakeups_per_second", "Audio thread wake-ups per second (last 1 s)");
+  cpuPerAudioMetric_ = &metrics.gauge(
+      "wam_cpu_ms_per_audio_second",
+      "Process CPU time per second of audio processed (last 1 s)");
+  reloadLatencyMetric_ =
+      &metrics.histogram("wam_config_reload_us",
+                         "Config file change to new parameters applied");
+  reloadRejectedMetric_ = &metrics.counter(
+      "wam_config_reload_rejected_total", "Config reloads rejected as invalid");
+  denormalBlocksMetric_ = &metrics.counter(
+      "wam_denormal_blocks_total", "Blocks that left subnormal DSP state");
+  denormalValuesMetric_ = &metrics.counter(
+      "wam_denormal_values_total", "Subnormal DSP state values seen");
+}
+
+Engine::~Engine() {
+  stop();
+  // initialize() may have failed or start() never ran
+  if (ipcTask_.valid()) {
+    ipcTask_.wait();
+  }
+}
 
 bool Engine::initialize() {
-  std::cout << "Initializing audio engine..." << std::endl;
+  WAM_LOG_INFO("Initializing audio engine...");
+  startup_.reset();
+  ipcReady_.store(false, std::memory_order_release);
+
+  // Decided once: the devices open in the matching mode
+  const std::string powerMode = configManager_.getConfig().tuning.powerMode;
+  efficiencyMode_ = powerMode == "efficiency" ||
+                    (powerMode == "auto" && onBatteryPower());
+  WAM_LOG_INFO("Power mode: %s%s", powerModeName(),
+               powerMode == "auto" ? " (auto)" : "");
+
+  // Opening each device, the model and IPC are independent and mostly
+  // waiting on the OS, so they overlap. WASAPI calls on the worker threads
+  // use the process MTA that main() entered.
+  auto captureTask = std::async(std::launch::async, [this]() {
+    StartupTimeline::Scope span(startup_, "capture-open");
+    const bool ok = initializeCapture();
+    if (!ok) {
+      span.fail();
+    }
+    return ok;
+  });
+  auto renderTask = std::async(std::launch::async, [this]() {
+    StartupTimeline::Scope span(startup_, "render-open");
+    const bool ok = initializeRender();
+    if (!ok) {
+      span.fail();
+    }
+    return ok;
+  });
 
-  // Detect CPU capabilities (Intel Core Ultra optimizations)
-  CPUFeatures::initialize();
-  const auto &cpu = CPUFeatures::get();
+  // UI communication is optional; start() waits for it after audio runs
+  ipcTask_ = std::async(std::launch::async, [this]() {
+    StartupTimeline::Scope span(startup_, "ipc");
+    const bool ok = initializeIPC();
+    if (!ok) {
+      span.fail();
+      WAM_LOG_WARNING("Failed to initialize IPC server");
+    }
+    ipcReady_.store(true, std::memory_order_release);
+    return ok;
+  });
 
-  std::cout << "CPU Optimizations:" << std::endl;
-  std::cout << "  - AVX2: " << (cpu.hasAVX2() ? "Yes" : "No") << std::endl;
-  std::cout << "  - AVX-512: " << (cpu.hasAVX512() ? "Yes" : "No") << std::endl;
-  std::cout << "  - NPU: " << (cpu.hasNPU() ? "Yes (Intel AI Boost)" : "No")
-            << std::endl;
-  if (cpu.isHybrid()) {
-    std::cout << "  - Hybrid CPU: " << cpu.performanceCores() << " P-cores, "
-              << cpu.efficiencyCores() << " E-cores" << std::endl;
+  logCpuFeatures();
+  const bool processorsOk = initializeProcessors();
+  const bool captureOk = captureTask.get();
+  const bool renderOk = renderTask.get();
+
+  for (const std::string &line : splitLines(startup_.describe())) {
+    WAM_LOG_INFO("%s", line.c_str());
   }
 
-  // Initialize audio capture
-  if (!initializeCapture()) {
-    std::cerr << "Failed to initialize audio capture" << std::endl;
+  if (!captureOk) {
+    WAM_LOG_ERROR("Failed to initialize audio capture");
     return false;
   }
-
-  // Initialize audio render
-  if (!initializeRender()) {
-    std::cerr << "Failed to initialize audio render" << std::endl;
+  if (!renderOk) {
+    WAM_LOG_ERROR("Failed to initialize audio render");
     return false;
   }
-
-  // Initialize processors
-  if (!initializeProcessors()) {
-    std::cerr << "Failed to initialize audio processors" << std::endl;
+  if (!processorsOk) {
+    WAM_LOG_ERROR("Failed to initialize audio processors");
     return false;
   }
 
-  // Initialize IPC for UI communication
-  if (!initializeIPC()) {
-    std::cerr << "Warning: Failed to initialize IPC server" << std::endl;
-    // Continue anyway - UI communication is optional
+  return true;
+}
+
+void Engine::logCpuFeatures() {
+  StartupTimeline::Scope span(startup_, "cpu-detect");
+
+  // Detect CPU capabilities (Intel Core Ultra optimizations)
+  CPUFeatures::initialize();
+  const auto &cpu = CPUFeatures::get();
+
+  WAM_LOG_INFO("CPU Optimizations:");
+  WAM_LOG_INFO("  - AVX2: %s", cpu.hasAVX2() ? "Yes" : "No");
+  WAM_LOG_INFO("  - AVX-512: %s", cpu.hasAVX512() ? "Yes" : "No");
+  WAM_LOG_INFO("  - NPU: %s", cpu.hasNPU() ? "Yes (Intel AI Boost)" : "No");
+  if (cpu.isHybrid()) {
+    WAM_LOG_INFO("  - Hybrid CPU: %d P-cores, %d E-cores",
+                 cpu.performanceCores(), cpu.efficiencyCores());
+  }
+}
+
+std::unique_ptr<CaptureDevice> Engine::createCapture() const {
+  if (backend_.createCapture) {
+    return backend_.createCapture();
   }
+  return std::make_unique<WasapiCapture>();
+}
 
-  return true;
+std::unique_ptr<RenderDevice> Engine::createRender() const {
+  if (backend_.createRender) {
+    return backend_.createRender();
+  }
+  return std::make_unique<WasapiRender>();
 }
 
 bool Engine::initializeCapture() {
-  capture_ = std::make_unique<WasapiCapture>();
-
   const auto &config = configManager_.getConfig();
   std::wstring inputDevice = config.devices.inputDevice;
 
@@ -88,84 +224,118 @@ bool Engine::initializeCapture() {
     inputDevice = L""; // Empty string means default device in WASAPI
   }
 
-  if (!capture_->initialize(inputDevice)) {
-    return false;
+  return openInput(inputDevice, input_);
+}
+
+bool Engine::openInput(const std::wstring &deviceId, InputRoute &route) {
+  route.device = createCapture();
+  route.resampler.reset();
+
+  // Efficiency mode: one wake-up per quantum, not per device period
+  if (efficiencyMode_ &&
+      !route.device->setWakeInterval(EFFICIENCY_QUANTUM_US)) {
+    WAM_LOG_INFO("Capture device is event-driven only");
   }
 
-  // Set up callback for captured audio
-  capture_->setCallback(
-      [this](float *buffer, size_t frames, int sampleRate, int channels) {
-        onAudioCaptured(buffer, frames, sampleRate, channels);
-      });
+  if (!route.device->initialize(deviceId)) {
+    route.device.reset();
+    return false;
+  }
 
   // Set up resampler if needed
-  int captureSampleRate = capture_->getSampleRate();
+  int captureSampleRate = route.device->getSampleRate();
   if (captureSampleRate != INTERNAL_SAMPLE_RATE) {
-    inputResampler_ = std::make_unique<Resampler>();
-    if (!inputResampler_->initialize(captureSampleRate, INTERNAL_SAMPLE_RATE,
+    route.resampler = std::make_unique<Resampler>();
+    if (!route.resampler->initialize(captureSampleRate, INTERNAL_SAMPLE_RATE,
                                      INTERNAL_CHANNELS)) {
-      std::cerr << "Failed to initialize input resampler" << std::endl;
+      WAM_LOG_ERROR("Failed to initialize input resampler");
+      route.device.reset();
+      route.resampler.reset();
       return false;
     }
-    std::cout << "Input resampler: " << captureSampleRate << " Hz -> "
-              << INTERNAL_SAMPLE_RATE << " Hz" << std::endl;
+    WAM_LOG_INFO("Input resampler: %d Hz -> %d Hz", captureSampleRate,
+                 INTERNAL_SAMPLE_RATE);
   }
 
+  // Set up callback for captured audio; each device writes only its own
+  // ring, which keeps every ring single-producer across a switch
+  LockFreeRingBuffer *ring = route.ring.get();
+  Resampler *resampler = route.resampler.get();
+  route.device->setCallback([this, ring, resampler](float *buffer,
+                                                     size_t frames, int,
+                                                     int channels) {
+    onAudioCaptured(*ring, resampler, buffer, frames, channels);
+  });
+
   return true;
 }
 
 bool Engine::initializeRender() {
-  render_ = std::make_unique<WasapiRender>();
-
   const auto &config = configManager_.getConfig();
   std::wstring outputDevice = config.devices.outputDevice;
 
   // Auto-detect VB-Cable if no output device specified
   if (outputDevice.empty()) {
-    std::cout << "Looking for virtual audio device..." << std::endl;
-    auto devices = getOutputDevices();
+    WAM_LOG_INFO("Looking for virtual audio device...");
+    auto devices = createRender()->enumerateDevices();
 
     for (const auto &device : devices) {
       // Look for VB-Cable (CABLE Input is what we write to)
       if (device.first.find("CABLE Input") != std::string::npos ||
           device.first.find("VB-Audio") != std::string::npos) {
         outputDevice = device.second;
-        std::cout << "  Found VB-Cable: " << device.first << std::endl;
+        WAM_LOG_INFO("  Found VB-Cable: %s", device.first.c_str());
         break;
       }
       // Also check for our custom driver
       if (device.first.find("Virtual Speaker") != std::string::npos ||
           device.first.find("WindowsAiMic") != std::string::npos) {
         outputDevice = device.second;
-        std::cout << "  Found WindowsAiMic driver: " << device.first
-                  << std::endl;
+        WAM_LOG_INFO("  Found WindowsAiMic driver: %s",
+                     device.first.c_str());
         break;
       }
     }
 
     if (outputDevice.empty()) {
-      std::cerr << "No virtual audio device found!" << std::endl;
-      std::cerr << "Please install VB-Cable from: https://vb-audio.com/Cable/"
-                << std::endl;
+      WAM_LOG_ERROR("No virtual audio device found!");
+      WAM_LOG_ERROR("Please install VB-Cable from: "
+                    "https://vb-audio.com/Cable/");
       return false;
     }
   }
 
-  if (!render_->initialize(outputDevice)) {
+  return openOutput(outputDevice, output_);
+}
+
+bool Engine::openOutput(const std::wstring &deviceId, OutputRoute &route) {
+  route.device = createRender();
+  route.resampler.reset();
+
+  // Efficiency mode: written from the processing path, no render thread
+  if (efficiencyMode_ &&
+      !route.device->setFillOnWrite(EFFICIENCY_QUANTUM_US)) {
+    WAM_LOG_INFO("Render device keeps its own thread");
+  }
+
+  if (!route.device->initialize(deviceId)) {
+    route.device.reset();
     return false;
   }
 
   // Set up output resampler if needed
-  int renderSampleRate = render_->getSampleRate();
+  int renderSampleRate = route.device->getSampleRate();
   if (renderSampleRate != INTERNAL_SAMPLE_RATE) {
-    outputResampler_ = std::make_unique<Resampler>();
-    if (!outputResampler_->initialize(INTERNAL_SAMPLE_RATE, renderSampleRate,
-                                      INTERNAL_CHANNELS)) {
-      std::cerr << "Failed to initialize output resampler" << std::endl;
+    route.resampler = std::make_unique<Resampler>();
+    if (!route.resampler->initialize(INTERNAL_SAMPLE_RATE, renderSampleRate,
+                                     INTERNAL_CHANNELS)) {
+      WAM_LOG_ERROR("Failed to initialize output resampler");
+      route.device.reset();
+      route.resampler.reset();
       return false;
     }
-    std::cout << "Output resampler: " << INTERNAL_SAMPLE_RATE << " Hz -> "
-              << renderSampleRate << " Hz" << std::endl;
+    WAM_LOG_INFO("Output resampler: %d Hz -> %d Hz", INTERNAL_SAMPLE_RATE,
+                 renderSampleRate);
   }
 
   return true;
@@ -174,83 +344,231 @@ bool Engine::initializeRender() {
 bool Engine::initializeProcessors() {
   const auto &config = configManager_.getConfig();
 
-  // Initialize RNNoise
-  rnnoise_ = std::make_unique<RNNoiseProcessor>();
-  if (!rnnoise_->initialize()) {
-    std::cerr << "Failed to initialize RNNoise" << std::endl;
+  {
+    StartupTimeline::Scope span(startup_, "arena");
+    // Room for the largest quantum the tuner may pick, twice over: the
+    // second half is the AI thread's block when that stage is pipelined
+    chain_ = std::make_unique<ProcessingChain>(2 * MAX_QUANTUM_FRAMES);
+    processingBuffer_ = chain_->scratch();
+    aiBlock_ = chain_->scratch() + MAX_QUANTUM_FRAMES;
+    const AudioArena &arena = chain_->arena();
+    if (arena.overflowBytes() > 0) {
+      WAM_LOG_WARNING("Processing arena too small: %zu bytes on the heap",
+                      arena.overflowBytes());
+    }
+    WAM_LOG_INFO("Processing arena: %s", arena.describe().c_str());
+  }
+
+  // The model loads while the DSP filters are designed on this thread
+  auto modelTask = std::async(std::launch::async, [this, &config]() {
+    StartupTimeline::Scope span(startup_, "model-load");
+    if (!chain_->loadModel(config)) {
+      span.fail();
+      return false;
+    }
+    chain_->warmUpModel();
+    return true;
+  });
+
+  {
+    StartupTimeline::Scope span(startup_, "filter-design");
+    chain_->configure(config);
+    chain_->warmUpDsp();
+  }
+  WAM_LOG_INFO("DSP chain initialized");
+
+  // Pipeline tracing is opt-in (can also be toggled over IPC)
+  Tracer::instance().setEnabled(config.diagnostics.tracing);
+  denormalCheck_ = config.diagnostics.denormalCheck;
+
+  if (!modelTask.get()) {
+    WAM_LOG_ERROR("Failed to initialize RNNoise");
     return false;
   }
-  rnnoise_->setAttenuation(config.aiSettings.rnnoise.attenuation);
-  std::cout << "RNNoise initialized" << std::endl;
-
-#ifdef USE_DEEPFILTER
-  // Initialize DeepFilterNet if enabled
-  deepfilter_ = std::make_unique<DeepFilterProcessor>();
-  if (!deepfilter_->initialize(config.aiSettings.deepfilter.modelPath)) {
-    std::cerr << "Warning: Failed to initialize DeepFilterNet" << std::endl;
-    deepfilter_.reset();
-  }
-#endif
-
-  // Initialize DSP chain
-  expander_ = std::make_unique<Expander>();
-  expander_->setEnabled(config.expander.enabled);
-  expander_->setThreshold(config.expander.threshold);
-  expander_->setRatio(config.expander.ratio);
-  expander_->setAttack(config.expander.attack);
-  expander_->setRelease(config.expander.release);
-  expander_->setHysteresis(config.expander.hysteresis);
-  std::cout << "Expander initialized" << std::endl;
-
-  compressor_ = std::make_unique<Compressor>();
-  compressor_->setEnabled(config.compressor.enabled);
-  compressor_->setThreshold(config.compressor.threshold);
-  compressor_->setRatio(config.compressor.ratio);
-  compressor_->setKnee(config.compressor.knee);
-  compressor_->setAttack(config.compressor.attack);
-  compressor_->setRelease(config.compressor.release);
-  compressor_->setMakeupGain(config.compressor.makeupGain);
-  std::cout << "Compressor initialized" << std::endl;
-
-  limiter_ = std::make_unique<Limiter>();
-  limiter_->setEnabled(config.limiter.enabled);
-  limiter_->setCeiling(config.limiter.ceiling);
-  limiter_->setRelease(config.limiter.release);
-  limiter_->setLookahead(config.limiter.lookahead);
-  std::cout << "Limiter initialized" << std::endl;
-
-  equalizer_ = std::make_unique<Equalizer>();
-  equalizer_->setEnabled(config.equalizer.enabled);
-  equalizer_->setHighPass(config.equalizer.highPass.freq,
-                          config.equalizer.highPass.q);
-  equalizer_->setLowShelf(config.equalizer.lowShelf.freq,
-                          config.equalizer.lowShelf.gain);
-  equalizer_->setPresence(config.equalizer.presence.freq,
-                          config.equalizer.presence.gain,
-                          config.equalizer.presence.q);
-  equalizer_->setHighShelf(config.equalizer.highShelf.freq,
-                           config.equalizer.highShelf.gain);
-  std::cout << "Equalizer initialized" << std::endl;
-
-  // Initialize metering
-  inputMetering_ = std::make_unique<Metering>();
-  outputMetering_ = std::make_unique<Metering>();
-  std::cout << "Metering initialized" << std::endl;
+  WAM_LOG_INFO("RNNoise initialized");
+
+  // Needs the whole chain; the devices are still opening meanwhile
+  tuneProcessing(config);
+
+  // Carry on from where the last run stopped (calibration cleared state)
+  restoreChainState();
+
+  // Flight recorder (always-on glitch history)
+  if (config.diagnostics.flightRecorder) {
+    StartupTimeline::Scope span(startup_, "flight-recorder");
+    flightRecorder_ = std::make_unique<FlightRecorder>(
+        config.diagnostics.recorderSeconds, INTERNAL_SAMPLE_RATE,
+        blockFrames_);
+    WAM_LOG_INFO("Flight recorder initialized (%.1f s)",
+                 config.diagnostics.recorderSeconds);
+  }
 
   return true;
 }
 
+void Engine::tuneProcessing(const Config &config) {
+  TuningDecision decision;
+  decision.inputRingFrames = BUFFER_SIZE;
+
+  if (efficiencyMode_) {
+    // Fewest wake-ups rather than least delay; nothing to calibrate
+    decision.quantumFrames = MAX_QUANTUM_FRAMES;
+    chain_->setSkipSilence(true);
+    WAM_LOG_INFO("Efficiency mode: %zu-frame quantum on the capture thread, "
+                 "silence skipped",
+                 decision.quantumFrames);
+  } else if (config.tuning.autoTune) {
+    StartupTimeline::Scope span(startup_, "auto-tune");
+    AutoTuneOptions options;
+    options.calibrationMs = config.tuning.calibrationMs;
+    options.cpus = CpuTopology::get().realtimeCpus();
+    const std::string configPath = configManager_.getConfigPath();
+    if (!configPath.empty()) {
+      options.cachePath =
+          (std::filesystem::path(configPath).parent_path() / TUNING_CACHE_FILE)
+              .string();
+    }
+
+    decision = autoTune(*chain_, config, options);
+    for (const std::string &line : splitLines(decision.describe())) {
+      WAM_LOG_INFO("%s", line.c_str());
+    }
+    if (!decision.withinBudget) {
+      WAM_LOG_WARNING("No block size keeps the chain's p99 within %.0f%% of "
+                      "real time; expect deadline misses",
+                      TUNING_LOAD_BUDGET * 100.0);
+    }
+  } else {
+    WAM_LOG_INFO("Auto-tune disabled: %zu-frame quantum",
+                 decision.quantumFrames);
+  }
+
+  blockFrames_ = decision.quantumFrames;
+  blockDurationUs_ =
+      static_cast<float>(blockFrames_) * 1e6f / INTERNAL_SAMPLE_RATE;
+  pipelineAi_ = decision.pipelineAi;
+  input_.ring->resize(decision.inputRingFrames);
+  nextInput_.ring->resize(decision.inputRingFrames);
+  fadeBlock_.assign(blockFrames_, 0.0f);
+  quantumMetric_->set(static_cast<double>(blockFrames_));
+}
+
 bool Engine::initializeIPC() {
+  // Meters go through shared memory; the pipe only carries commands
+  telemetry_ = std::make_unique<TelemetryWriter>();
+  if (!telemetry_->open()) {
+    WAM_LOG_WARNING("Failed to create telemetry shared memory");
+  }
+
+  // Processed stream for local consumers (recorders, transcription, QA)
+  const auto &exportConfig = configManager_.getConfig().audioExport;
+  if (exportConfig.enabled) {
+    audioExport_ = std::make_unique<AudioExportWriter>();
+    const size_t capacity = static_cast<size_t>(
+        std::max(exportConfig.bufferSeconds, 0.1f) * INTERNAL_SAMPLE_RATE);
+    if (!audioExport_->open(AudioExportWriter::REGION_NAME,
+                            INTERNAL_SAMPLE_RATE, INTERNAL_CHANNELS,
+                            capacity)) {
+      WAM_LOG_WARNING("Failed to create audio export shared memory");
+      audioExport_.reset();
+    }
+  }
+
   pipeServer_ = std::make_unique<PipeServer>();
 
-  // Set up config update callback
-  pipeServer_->setConfigUpdateCallback([this](const Config &newConfig) {
-    configManager_.applyConfig(newConfig);
-    // Re-apply all settings
-    applyPreset(newConfig.activePreset);
+  // Preset switches from the tray edit the live config
+  pipeServer_->setPresetCallback(
+      [this](const std::string &presetName) { applyPreset(presetName); });
+
+  // Batched parameter updates (also BYPASS and CONFIG text commands)
+  pipeServer_->setParameterCallback(
+      [this](const std::vector<ParamUpdate> &updates) {
+        return applyParameters(updates);
+      });
+
+  // Prometheus-style metrics scrape (optional data = name prefix)
+  pipeServer_->registerCommand("METRICS", [](const std::string &data) {
+    return MetricsRegistry::instance().renderText(data);
+  });
+
+  // On-demand flight recorder dump
+  pipeServer_->registerCommand("DUMP_RECORDER", [this](const std::string &) {
+    if (!flightRecorder_) {
+      return std::string("DUMP:DISABLED");
+    }
+    flightRecorder_->triggerDump(GlitchFlag::Manual);
+    return std::string("DUMP:QUEUED");
+  });
+
+  // Pipeline tracing: TRACE:START, TRACE:STOP, TRACE:DUMP
+  pipeServer_->registerCommand("TRACE", [this](const std::string &data) {
+    Tracer &tracer = Tracer::instance();
+    if (data == "START") {
+      tracer.clear();
+      tracer.setEnabled(true);
+      return std::string("TRACE:STARTED");
+    }
+    if (data == "STOP") {
+      tracer.setEnabled(false);
+      return std::string("TRACE:STOPPED");
+    }
+    if (data == "DUMP") {
+      return "TRACE:" + exportTrace();
+    }
+    return std::string("TRACE:UNKNOWN");
   });
 
-  return pipeServer_->start();
+  // Start-up timeline and time to first audio (JSON)
+  pipeServer_->registerCommand("STARTUP", [this](const std::string &) {
+    return "STARTUP:" + startup_.toJson();
+  });
+
+  // The pipe itself starts once audio is running (see start())
+  return true;
+}
+
+std::string Engine::chainStatePath() const {
+  const std::string configPath = configManager_.getConfigPath();
+  if (configPath.empty()) {
+    return {};
+  }
+  return (std::filesystem::path(configPath).parent_path() / CHAIN_STATE_FILE)
+      .string();
+}
+
+void Engine::saveChainState() {
+  const std::string path = chainStatePath();
+  if (path.empty() || !chain_) {
+    return;
+  }
+  ChainSnapshot snapshot;
+  snapshot.reserve(chain_->snapshotSize());
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  if (!chain_->saveSnapshot(snapshot) || !file ||
+      !file.write(reinterpret_cast<const char *>(snapshot.data()),
+                  static_cast<std::streamsize>(snapshot.size()))) {
+    WAM_LOG_WARNING("Failed to save chain state to %s", path.c_str());
+  }
+}
+
+void Engine::restoreChainState() {
+  const std::string path = chainStatePath();
+  std::ifstream file(path, std::ios::binary);
+  if (path.empty() || !file) {
+    return;
+  }
+  const std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+  ChainSnapshot snapshot;
+  snapshot.assign(reinterpret_cast<const uint8_t *>(bytes.data()),
+                  bytes.size());
+  if (chain_->restoreSnapshot(snapshot)) {
+    WAM_LOG_INFO("Resumed processing state from %s", path.c_str());
+  } else {
+    // Settings changed the layout (or the build did): start from reset
+    WAM_LOG_INFO("Chain state in %s does not match; starting fresh",
+                 path.c_str());
+  }
 }
 
 void Engine::start() {
@@ -259,19 +577,64 @@ void Engine::start() {
   }
 
   running_ = true;
+  glitchDetector_.resetStream();
+
+  // Start flight recorder dump writer
+  if (flightRecorder_) {
+    flightRecorder_->start(
+        configManager_.getConfig().diagnostics.dumpDirectory);
+  }
 
-  // Start processing thread
-  processingThread_ = std::thread(&Engine::processingThread, this);
+  {
+    StartupTimeline::Scope span(startup_, "start");
+
+    startNs_ = nowNs();
+    startCpuNs_ = processCpuTimeNs();
+    startWakeups_ = captureWakeMetric_->get() + renderWakeMetric_->get() +
+                    processingWakeMetric_->get();
+    startSkippedBlocks_ = chain_->getSkippedBlocks();
+    processedBlocks_ = 0;
+    processedFrames_ = 0;
+    powerSampleNs_ = startNs_;
+    powerSample_ = PowerUsage{};
+
+    // Start the AI stage thread first; the processing thread feeds it
+    aiInFlight_ = false;
+    aiQuit_ = false;
+    if (pipelineAi_) {
+      aiThread_ = std::thread(&Engine::aiThread, this);
+    }
 
-  // Start audio capture
-  capture_->start();
+    // Start processing thread (efficiency mode runs on the capture thread)
+    if (!efficiencyMode_) {
+      processingThread_ = std::thread(&Engine::processingThread, this);
+    }
 
-  // Start audio render
-  render_->start();
+    // Start audio capture
+    input_.device->start();
 
-  // Start IPC server
-  if (pipeServer_) {
-    pipeServer_->start();
+    // Start audio render
+    output_.device->start();
+  }
+
+  // Start IPC server; audio is already flowing
+  if (ipcTask_.valid() && ipcTask_.get() && pipeServer_) {
+    StartupTimeline::Scope span(startup_, "ipc-listen");
+    if (!pipeServer_->start()) {
+      span.fail();
+      WAM_LOG_WARNING("Failed to start IPC server");
+    }
+  }
+
+  // Pick up config deployed while we run
+  const std::string configPath = configManager_.getConfigPath();
+  if (!configPath.empty()) {
+    configWatcher_ = std::make_unique<ConfigWatcher>();
+    if (!configWatcher_->start(configPath, [this](uint64_t changeNs) {
+          reloadConfig(changeNs);
+        })) {
+      configWatcher_.reset();
+    }
   }
 
   std::lock_guard<std::mutex> lock(statusMutex_);
@@ -289,23 +652,52 @@ void Engine::stop() {
   // Signal processing thread to wake up
   processingCv_.notify_all();
 
-  // Stop audio I/O
-  if (capture_) {
-    capture_->stop();
-  }
-  if (render_) {
-    render_->stop();
+  // Stop audio I/O, once a device switch in progress has settled
+  {
+    std::lock_guard<std::mutex> lock(switchMutex_);
+    if (input_.device) {
+      input_.device->stop();
+    }
+    if (output_.device) {
+      output_.device->stop();
+    }
   }
 
-  // Stop IPC
+  // Stop IPC and config reloads
+  if (ipcTask_.valid()) {
+    ipcTask_.wait();
+  }
   if (pipeServer_) {
     pipeServer_->stop();
   }
+  if (configWatcher_) {
+    configWatcher_->stop();
+    configWatcher_.reset();
+  }
 
-  // Wait for processing thread
+  // Wait for processing thread; on its way out it releases the AI thread
   if (processingThread_.joinable()) {
     processingThread_.join();
   }
+  if (aiThread_.joinable()) {
+    aiThread_.join();
+  }
+
+  // Flush any pending recorder dump
+  if (flightRecorder_) {
+    flightRecorder_->stop();
+  }
+
+  // The chain is idle now; the next run resumes from here
+  saveChainState();
+
+  const PowerUsage usage = getPowerUsage();
+  if (usage.blocks > 0) {
+    WAM_LOG_INFO("Power (%s mode): %.1f wake-ups/s, %.2f ms CPU per audio "
+                 "second, %.1f%% of blocks skipped as silence",
+                 powerModeName(), usage.wakeupsPerSecond(),
+                 usage.cpuMsPerAudioSecond(), usage.skippedPercent());
+  }
 
   std::lock_guard<std::mutex> lock(statusMutex_);
   status_.capturing = false;
@@ -328,17 +720,18 @@ void Engine::listAudioDevices() {
 }
 
 std::vector<std::pair<std::string, std::wstring>> Engine::getInputDevices() {
-  WasapiCapture temp;
-  return temp.enumerateDevices();
+  return createCapture()->enumerateDevices();
 }
 
 std::vector<std::pair<std::string, std::wstring>> Engine::getOutputDevices() {
-  WasapiRender temp;
-  return temp.enumerateDevices();
+  return createRender()->enumerateDevices();
 }
 
-void Engine::onAudioCaptured(float *buffer, size_t frames, int sampleRate,
+void Engine::onAudioCaptured(LockFreeRingBuffer &ring, Resampler *resampler,
+                             const float *buffer, size_t frames,
                              int channels) {
+  WAM_TRACE_SCOPE("CaptureCallback");
+
   // Convert to mono if stereo
   std::vector<float> monoBuffer(frames);
   if (channels == 2) {
@@ -354,282 +747,929 @@ void Engine::onAudioCaptured(float *buffer, size_t frames, int sampleRate,
   float *audioData = monoBuffer.data();
   size_t audioFrames = frames;
 
-  if (inputResampler_) {
-    resampledBuffer = inputResampler_->process(monoBuffer.data(), frames);
+  if (resampler) {
+    resampledBuffer = resampler->process(monoBuffer.data(), frames);
     audioData = resampledBuffer.data();
     audioFrames = resampledBuffer.size();
   }
 
-  // Push to ring buffer
-  inputBuffer_.write(audioData, audioFrames);
+  // The tap has one producer: while a switch runs, two devices deliver
+  if (flightRecorder_ &&
+      inputSwitch_.load(std::memory_order_acquire) == SwitchState::Idle) {
+    flightRecorder_->writeAudio(RecorderTap::Input, audioData, audioFrames);
+  }
+
+  // Push to ring buffer (a short write to the ring being processed means
+  // the processing thread fell behind and captured audio was dropped)
+  {
+    WAM_TRACE_SCOPE("RingWrite");
+    if (ring.write(audioData, audioFrames) < audioFrames &&
+        &ring == activeInputRing_.load(std::memory_order_acquire)) {
+      inputOverflows_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  lastCaptureNs_.store(nowNs(), std::memory_order_release);
+
+  if (efficiencyMode_) {
+    processCoalesced();
+    return;
+  }
 
   // Signal processing thread
   processingCv_.notify_one();
 }
 
+void Engine::processCoalesced() {
+  // During a device switch both capture threads get here; one processes
+  // and the other leaves its audio for the next wake-up
+  if (coalescedBusy_.test_and_set(std::memory_order_acquire)) {
+    return;
+  }
+
+  thread_local bool threadSetUp = false;
+  if (!threadSetUp) {
+    // The device thread already flushes denormals; steer it to E-cores
+    threadSetUp = true;
+    const bool preferred = setThreadCorePreference(CorePreference::Efficiency);
+    WAM_LOG_INFO("Processing on the capture thread%s",
+                 preferred ? ", E-cores preferred" : "");
+  }
+  processPendingBlocks(0.0f);
+  coalescedBusy_.clear(std::memory_order_release);
+}
+
 void Engine::processingThread() {
-  std::cout << "Processing thread started" << std::endl;
+  WAM_LOG_INFO("Processing thread started");
 
   // Set thread name for debugging
   setThreadName("AudioProcessing");
-
-  // Intel Core Ultra optimization: Run on P-cores for consistent performance
-  const auto &cpu = CPUFeatures::get();
-  if (cpu.isHybrid()) {
-    setThreadCorePreference(CorePreference::Performance);
-    std::cout << "  Using P-core scheduling for audio processing" << std::endl;
-  }
-
-  // Set up multimedia thread mode (WASAPI MMCSS integration)
-  MultimediaThreadScope mmcss("Pro Audio");
-  if (mmcss.isActive()) {
-    std::cout << "  MMCSS Pro Audio mode active" << std::endl;
-  }
+  Logger::instance().registerThread("AudioProcessing");
+  Tracer::instance().registerThread("AudioProcessing");
+
+  // MMCSS Pro Audio on Windows, SCHED_FIFO on Linux; plus locked memory,
+  // a prefaulted stack and FTZ/DAZ for the DSP chain. The CPU set is the
+  // first hardware thread of each P-core (each core when not hybrid), so
+  // the DSP never shares a core with another audio thread's SMT sibling.
+  RealtimeOptions realtimeOptions;
+  realtimeOptions.cpus = CpuTopology::get().realtimeCpus();
+  RealtimeContext realtime(realtimeOptions);
+  WAM_LOG_INFO("  Real-time context: %s", realtime.summary().c_str());
 
   while (running_.load()) {
     // Wait for data
     {
       std::unique_lock<std::mutex> lock(processingMutex_);
       processingCv_.wait_for(lock, std::chrono::milliseconds(10), [this]() {
-        return inputBuffer_.availableRead() >= PROCESSING_BLOCK_SIZE ||
-               !running_.load();
+        return input_.ring->availableRead() >= blockFrames_ ||
+               inputSwitchReady() || !running_.load();
       });
     }
 
     if (!running_.load()) {
       break;
     }
+    WAM_TRACE_INSTANT("ProcessingWake");
+    processingWakeMetric_->add();
+
+    // Time from the last capture callback to this wake-up
+    const uint64_t wakeNs = nowNs();
+    const uint64_t captureNs = lastCaptureNs_.load(std::memory_order_acquire);
+    float wakeLatencyUs =
+        captureNs != 0 && wakeNs > captureNs
+            ? static_cast<float>(wakeNs - captureNs) / 1000.0f
+            : 0.0f;
+
+    processPendingBlocks(wakeLatencyUs);
+  }
+
+  // Take back the block in flight, then let the AI thread exit
+  if (pipelineAi_) {
+    if (aiInFlight_) {
+      aiDone_.acquire();
+      aiInFlight_ = false;
+    }
+    aiQuit_ = true;
+    aiWork_.release();
+  }
 
-    // Process available blocks
-    while (inputBuffer_.availableRead() >= PROCESSING_BLOCK_SIZE) {
-      // Read a block
-      inputBuffer_.read(processingBuffer_.data(), PROCESSING_BLOCK_SIZE);
+  WAM_LOG_INFO("Processing thread stopped");
+}
 
-      // Process the block
-      processAudioBlock(processingBuffer_.data(), PROCESSING_BLOCK_SIZE);
+void Engine::processPendingBlocks(float wakeLatencyUs) {
+  // Read a block at a time; a pending input switch fades in on one
+  while (readInputBlock()) {
+    WAM_TRACE_SCOPE("Block");
+    const uint64_t blockStartNs = nowNs();
 
-      // Write to output buffer
-      outputBuffer_.write(processingBuffer_.data(), PROCESSING_BLOCK_SIZE);
+    if (flightRecorder_) {
+      flightRecorder_->writeAudio(RecorderTap::PreAI, processingBuffer_,
+                                  blockFrames_);
+    }
+    const float inputPeak =
+        glitchDetector_.analyzeInput(processingBuffer_, blockFrames_);
 
-      // Feed to render
-      if (render_ && render_->isReady()) {
-        std::vector<float> renderBuffer;
+    // Pipelined: the rest of this block works on the previous block,
+    // back from the AI thread (the first block has nothing to show yet)
+    if (pipelineAi_ && !exchangeAiBlock()) {
+      continue;
+    }
+
+    // Process the block
+    processAudioBlock(processingBuffer_, blockFrames_);
+    if (denormalCheck_) {
+      checkDenormals();
+    }
+
+    // Glitch checks
+    const uint64_t blockEndNs = nowNs();
+    const float processUs =
+        static_cast<float>(blockEndNs - blockStartNs) / 1000.0f;
+    const uint32_t glitchFlags = glitchDetector_.finishBlock(
+        processingBuffer_, blockFrames_, processUs, blockDurationUs_,
+        collectDeviceCounters(), blockEndNs);
+
+    blockTimeMetric_->record(static_cast<uint64_t>(processUs));
+    if (wakeLatencyUs > 0.0f) {
+      wakeLatencyMetric_->record(static_cast<uint64_t>(wakeLatencyUs));
+    }
+    inputQueueMetric_->set(static_cast<double>(input_.ring->availableRead()));
+    outputQueueMetric_->set(static_cast<double>(renderQueueDepth()));
+    processedBlocks_.fetch_add(1, std::memory_order_relaxed);
+    processedFrames_.fetch_add(blockFrames_, std::memory_order_relaxed);
+    updatePowerMetrics(blockEndNs);
+
+    if (flightRecorder_) {
+      recordBlock(blockEndNs, processUs, wakeLatencyUs, inputPeak,
+                  glitchFlags);
+    }
+    // Shared memory is set up by the IPC task, which may still be running
+    const bool ipcReady = ipcReady_.load(std::memory_order_acquire);
+    if (ipcReady) {
+      publishTelemetry(blockEndNs, glitchFlags);
+    }
+    ++blockIndex_;
 
-        // Resample for output if needed
-        if (outputResampler_) {
-          renderBuffer = outputResampler_->process(processingBuffer_.data(),
-                                                   PROCESSING_BLOCK_SIZE);
-          render_->write(renderBuffer.data(), renderBuffer.size());
-        } else {
-          render_->write(processingBuffer_.data(), PROCESSING_BLOCK_SIZE);
-        }
+    if (ipcReady && audioExport_) {
+      audioExport_->write(processingBuffer_, blockFrames_, blockEndNs);
+    }
+    wakeLatencyUs = 0.0f; // Only the first block follows the wake-up
+
+    // Write to output buffer
+    outputBuffer_.write(processingBuffer_, blockFrames_);
+
+    // Feed to render, fading over to a new device if one is waiting
+    SwitchState pending = SwitchState::Pending;
+    bool rendered = false;
+    if (outputSwitch_.load(std::memory_order_acquire) == pending &&
+        outputSwitch_.compare_exchange_strong(pending, SwitchState::Switching,
+                                              std::memory_order_acq_rel)) {
+      crossfadeOutput();
+      rendered = true;
+    } else {
+      rendered = writeRender(output_, processingBuffer_);
+    }
+    if (rendered) {
+      if (startup_.firstAudioMs() < 0.0) {
+        startup_.markFirstAudio();
+        firstAudioMetric_->set(startup_.firstAudioMs());
+        WAM_LOG_INFO("First audio after %.1f ms", startup_.firstAudioMs());
       }
     }
   }
+}
 
-  std::cout << "Processing thread stopped" << std::endl;
+bool Engine::inputSwitchReady() const {
+  if (inputSwitch_.load(std::memory_order_acquire) != SwitchState::Pending) {
+    return false;
+  }
+  // Fade once both devices have a block; a second block queued on the
+  // new device means the old one has stopped delivering
+  const size_t nextFrames = nextInput_.ring->availableRead();
+  return nextFrames >= blockFrames_ &&
+         (input_.ring->availableRead() >= blockFrames_ ||
+          nextFrames >= 2 * blockFrames_);
 }
 
-void Engine::processAudioBlock(float *buffer, size_t frames) {
-  // Update input metering
-  if (inputMetering_) {
-    inputMetering_->process(buffer, frames);
+bool Engine::readInputBlock() {
+  SwitchState pending = SwitchState::Pending;
+  if (inputSwitchReady() &&
+      inputSwitch_.compare_exchange_strong(pending, SwitchState::Switching,
+                                           std::memory_order_acq_rel)) {
+    crossfadeInput(input_.ring->availableRead() >= blockFrames_);
+    return true;
+  }
+  if (input_.ring->availableRead() < blockFrames_) {
+    return false;
+  }
+  input_.ring->read(processingBuffer_, blockFrames_);
+  return true;
+}
+
+void Engine::crossfadeInput(bool oldReady) {
+  LockFreeRingBuffer &next = *nextInput_.ring;
+
+  // Keep the old device's delay: what the new one queued beyond the old
+  // ring's backlog would only add latency
+  const size_t backlog =
+      oldReady ? input_.ring->availableRead() - blockFrames_ : 0;
+  while (next.availableRead() > blockFrames_ + backlog) {
+    next.read(fadeBlock_.data(),
+              std::min(next.availableRead() - blockFrames_ - backlog,
+                       blockFrames_));
+  }
+  next.read(fadeBlock_.data(), blockFrames_);
+  if (oldReady) {
+    input_.ring->read(processingBuffer_, blockFrames_);
+  } else {
+    std::fill_n(processingBuffer_, blockFrames_, 0.0f);
+  }
+
+  // Linear over one block: both microphones pick up the same voice
+  const float step = 1.0f / static_cast<float>(blockFrames_);
+  for (size_t i = 0; i < blockFrames_; ++i) {
+    const float fade = (static_cast<float>(i) + 0.5f) * step;
+    processingBuffer_[i] += fade * (fadeBlock_[i] - processingBuffer_[i]);
+  }
+
+  // The chain, its meters and the glitch detector carry straight on
+  std::swap(input_, nextInput_);
+  activeInputRing_.store(input_.ring.get(), std::memory_order_release);
+  inputSwitch_.store(SwitchState::Done, std::memory_order_release);
+}
+
+bool Engine::writeRender(OutputRoute &route, const float *block) {
+  if (!route.device || !route.device->isReady()) {
+    return false;
+  }
+  WAM_TRACE_SCOPE("RenderWrite");
+
+  // Resample for output if needed
+  if (route.resampler) {
+    std::vector<float> renderBuffer =
+        route.resampler->process(block, blockFrames_);
+    route.device->write(renderBuffer.data(), renderBuffer.size());
+  } else {
+    route.device->write(block, blockFrames_);
+  }
+  return true;
+}
+
+void Engine::crossfadeOutput() {
+  // Line the fade up with what the old device still has to play, less
+  // what the new one has queued already. Only up to one block of it: a
+  // deeper old queue is latency that built up on the old device, and
+  // carrying it over would keep it on the new one for good.
+  RenderDevice &next = *nextOutput_.device;
+  const uint64_t oldRate = static_cast<uint64_t>(
+      std::max(output_.device->getSampleRate(), 1));
+  const uint64_t nextRate = static_cast<uint64_t>(
+      std::max(next.getSampleRate(), 1));
+  const size_t oldQueued = static_cast<size_t>(
+      output_.device->getQueuedFrames() *
+      static_cast<uint64_t>(INTERNAL_SAMPLE_RATE) / oldRate);
+  const size_t lineUp = std::min(oldQueued, blockFrames_);
+  const size_t nextQueued = static_cast<size_t>(
+      next.getQueuedFrames() * static_cast<uint64_t>(INTERNAL_SAMPLE_RATE) /
+      nextRate);
+  size_t preroll =
+      lineUp > nextQueued
+          ? (lineUp - nextQueued) * static_cast<size_t>(nextRate) /
+                INTERNAL_SAMPLE_RATE
+          : 0;
+  std::fill(fadeBlock_.begin(), fadeBlock_.end(), 0.0f);
+  while (preroll > 0 && next.isReady()) {
+    const size_t frames = std::min(preroll, fadeBlock_.size());
+    next.write(fadeBlock_.data(), frames);
+    preroll -= frames;
+  }
+
+  // The old device plays this block out fading down while the new one
+  // fades up
+  const float step = 1.0f / static_cast<float>(blockFrames_);
+  for (size_t i = 0; i < blockFrames_; ++i) {
+    const float fade = (static_cast<float>(i) + 0.5f) * step;
+    fadeBlock_[i] = processingBuffer_[i] * (1.0f - fade);
+  }
+  writeRender(output_, fadeBlock_.data());
+  for (size_t i = 0; i < blockFrames_; ++i) {
+    const float fade = (static_cast<float>(i) + 0.5f) * step;
+    fadeBlock_[i] = processingBuffer_[i] * fade;
+  }
+  writeRender(nextOutput_, fadeBlock_.data());
+
+  std::swap(output_, nextOutput_);
+
+  // Trim what neither device lines up with: the old device drops the
+  // head of its deeper queue so its fade-out still meets the fade-in, and
+  // the new one drops whatever it held beyond the line-up
+  if (oldQueued > lineUp) {
+    nextOutput_.device->discardQueued(static_cast<size_t>(
+        (oldQueued - lineUp) * oldRate / INTERNAL_SAMPLE_RATE));
+  }
+  if (nextQueued > lineUp) {
+    output_.device->discardQueued(static_cast<size_t>(
+        (nextQueued - lineUp) * nextRate / INTERNAL_SAMPLE_RATE));
   }
+  outputSwitch_.store(SwitchState::Done, std::memory_order_release);
+}
 
-  // Bypass mode - skip all processing
-  if (bypass_.load()) {
-    // Update output metering with unprocessed audio
-    if (outputMetering_) {
-      outputMetering_->process(buffer, frames);
+bool Engine::exchangeAiBlock() {
+  const bool hadBlock = aiInFlight_;
+  if (aiInFlight_) {
+    WAM_TRACE_SCOPE("AiWait");
+    aiDone_.acquire();
+  }
+  std::swap(processingBuffer_, aiBlock_);
+  aiInFlight_ = true;
+  aiWork_.release();
+  return hadBlock;
+}
+
+void Engine::aiThread() {
+  setThreadName("AudioAI");
+  Logger::instance().registerThread("AudioAI");
+  Tracer::instance().registerThread("AudioAI");
+
+  // Same core class as the processing thread, which it runs beside
+  RealtimeOptions realtimeOptions;
+  realtimeOptions.cpus = CpuTopology::get().realtimeCpus();
+  RealtimeContext realtime(realtimeOptions);
+  WAM_LOG_INFO("AI stage thread started: %s", realtime.summary().c_str());
+
+  while (true) {
+    aiWork_.acquire();
+    if (aiQuit_) {
+      break;
     }
-    return;
+    {
+      WAM_TRACE_SCOPE("AiStage");
+      chain_->processAi(aiBlock_, blockFrames_);
+    }
+    aiDone_.release();
   }
 
-  // AI Enhancement (RNNoise or DeepFilterNet)
-  const auto &config = configManager_.getConfig();
+  WAM_LOG_INFO("AI stage thread stopped");
+}
 
-  if (config.aiModel == "rnnoise" && rnnoise_) {
-    rnnoise_->process(buffer, frames);
+void Engine::updatePowerMetrics(uint64_t nowNs) {
+  if (nowNs - powerSampleNs_ < POWER_METRICS_INTERVAL_NS) {
+    return;
   }
-#ifdef USE_DEEPFILTER
-  else if (config.aiModel == "deepfilter" && deepfilter_) {
-    deepfilter_->process(buffer, frames);
+  powerSampleNs_ = nowNs;
+  const PowerUsage usage = getPowerUsage();
+  const PowerUsage window = usage.since(powerSample_);
+  powerSample_ = usage;
+  wakeupRateMetric_->set(window.wakeupsPerSecond());
+  cpuPerAudioMetric_->set(window.cpuMsPerAudioSecond());
+}
+
+void Engine::recordBlock(uint64_t timestampNs, float processUs,
+                         float wakeLatencyUs, float inputPeak,
+                         uint32_t glitchFlags) {
+  BlockRecord record;
+  record.blockIndex = blockIndex_;
+  record.timestampNs = timestampNs;
+  record.processUs = processUs;
+  record.wakeLatencyUs = wakeLatencyUs;
+  record.inputQueueDepth =
+      static_cast<uint32_t>(input_.ring->availableRead());
+  record.outputQueueDepth = static_cast<uint32_t>(renderQueueDepth());
+  record.vad = chain_->getVADProbability();
+  record.gainReductionDb = chain_->getCompressorReduction();
+  record.inputPeak = inputPeak;
+  record.outputPeak = glitchDetector_.getOutputPeak();
+  record.glitchFlags = glitchFlags;
+
+  flightRecorder_->writeAudio(RecorderTap::Output, processingBuffer_,
+                              blockFrames_);
+  flightRecorder_->writeBlock(record);
+
+  // A slow DC drift is worth counting but not worth a dump
+  flightRecorder_->triggerDump(glitchFlags & ~GlitchFlag::DcDrift);
+}
+
+void Engine::checkDenormals() {
+  // FTZ/DAZ should make this impossible; a hit means a thread is missing
+  // its guard or a processor keeps state in double precision
+  const size_t count = chain_->countSubnormalState();
+  if (count == 0) {
+    return;
   }
-#endif
 
-  // DSP Chain
+  if (denormalBlocksMetric_->get() == 0) {
+    WAM_LOG_WARNING("Subnormal DSP state after block %llu (%zu values)",
+                    static_cast<unsigned long long>(blockIndex_), count);
+  }
+  denormalBlocksMetric_->add();
+  denormalValuesMetric_->add(count);
+}
 
-  // 1. Expander (noise gate)
-  if (expander_ && expander_->isEnabled()) {
-    expander_->process(buffer, frames);
+void Engine::publishTelemetry(uint64_t timestampNs, uint32_t glitchFlags) {
+  if (!telemetry_ || !telemetry_->isOpen()) {
+    return;
   }
 
-  // 2. Equalizer (before compression for tonal shaping)
-  if (equalizer_ && equalizer_->isEnabled()) {
-    equalizer_->process(buffer, frames);
+  TelemetryFrame frame;
+  frame.timestampNs = timestampNs;
+  frame.blockIndex = blockIndex_;
+  const Metering &input = chain_->inputMetering();
+  const Metering &output = chain_->outputMetering();
+  frame.inputPeakDb = input.getPeak();
+  frame.inputRmsDb = input.getRMS();
+  frame.outputPeakDb = output.getPeak();
+  frame.outputRmsDb = output.getRMS();
+  frame.outputLufs = output.getLUFSShortTerm();
+  frame.compressorReductionDb = chain_->getCompressorReduction();
+  frame.limiterReductionDb = chain_->getLimiterReduction();
+  frame.vadProbability = chain_->getVADProbability();
+
+  const GlitchStats glitches = glitchDetector_.getStats();
+  for (uint32_t count : glitches.counts) {
+    frame.glitchCount += count;
+  }
+  if (glitchFlags != 0) {
+    frame.flags |= TelemetryFlag::Glitch;
   }
+  if (chain_->isBypassed()) {
+    frame.flags |= TelemetryFlag::Bypass;
+  }
+
+  telemetry_->publish(frame);
+}
 
-  // 3. Compressor
-  if (compressor_ && compressor_->isEnabled()) {
-    compressor_->process(buffer, frames);
+std::string Engine::exportTrace() const {
+  namespace fs = std::filesystem;
+
+  const std::string &directory =
+      configManager_.getConfig().diagnostics.dumpDirectory;
+  std::error_code ec;
+  fs::create_directories(directory, ec);
+
+  const auto wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+  const std::string path =
+      (fs::path(directory) / ("wam_trace_" + std::to_string(wallMs) + ".json"))
+          .string();
+
+  if (!Tracer::instance().exportChromeTrace(path)) {
+    WAM_LOG_ERROR("Failed to write trace: %s", path.c_str());
+    return "FAILED";
   }
+  WAM_LOG_INFO("Trace written: %s", path.c_str());
+  return path;
+}
+
+size_t Engine::renderQueueDepth() const {
+  return output_.device ? output_.device->getQueuedFrames() : 0;
+}
 
-  // 4. Limiter
-  if (limiter_ && limiter_->isEnabled()) {
-    limiter_->process(buffer, frames);
+DeviceCounters Engine::collectDeviceCounters() const {
+  DeviceCounters counters;
+  if (input_.device) {
+    counters.captureGaps = input_.device->getGapCount();
+  }
+  if (output_.device) {
+    counters.renderUnderruns = output_.device->getUnderrunCount();
+    counters.renderOverruns = output_.device->getOverrunCount();
   }
+  counters.inputOverflows = inputOverflows_.load(std::memory_order_relaxed);
+  return counters;
+}
 
-  // Update output metering
-  if (outputMetering_) {
-    outputMetering_->process(buffer, frames);
+void Engine::processAudioBlock(float *buffer, size_t frames) {
+  if (pipelineAi_) {
+    chain_->processDsp(buffer, frames); // AI already ran on aiThread_
+  } else {
+    chain_->process(buffer, frames);
   }
 
   // Send meter updates if callback is set
   {
     std::lock_guard<std::mutex> lock(meterMutex_);
     if (meterCallback_) {
-      float gainReduction =
-          compressor_ ? compressor_->getGainReduction() : 0.0f;
-      meterCallback_(outputMetering_->getPeak(), outputMetering_->getRMS(),
-                     gainReduction);
+      const Metering &output = chain_->outputMetering();
+      meterCallback_(output.getPeak(), output.getRMS(),
+                     chain_->getCompressorReduction());
     }
   }
 
   // Update status
   {
     std::lock_guard<std::mutex> lock(statusMutex_);
-    status_.inputLevel = inputMetering_ ? inputMetering_->getRMS() : 0.0f;
-    status_.outputLevel = outputMetering_ ? outputMetering_->getRMS() : 0.0f;
-    status_.gainReduction =
-        compressor_ ? compressor_->getGainReduction() : 0.0f;
+    status_.inputLevel = chain_->inputMetering().getRMS();
+    status_.outputLevel = chain_->outputMetering().getRMS();
+    status_.gainReduction = chain_->getCompressorReduction();
   }
 }
 
-void Engine::setInputDevice(const std::wstring &deviceId) {
-  if (running_.load()) {
-    capture_->stop();
+bool Engine::setInputDevice(const std::wstring &deviceId) {
+  std::lock_guard<std::mutex> lock(switchMutex_);
+  nextInput_.ring->clear();
+  if (!openInput(deviceId, nextInput_)) {
+    WAM_LOG_ERROR("Failed to open input device; keeping the current one");
+    return false;
   }
 
-  capture_->initialize(deviceId);
+  if (!running_.load()) {
+    std::swap(input_, nextInput_);
+    activeInputRing_.store(input_.ring.get(), std::memory_order_release);
+    nextInput_.device.reset();
+    nextInput_.resampler.reset();
+    return true;
+  }
 
-  if (running_.load()) {
-    capture_->start();
+  // The new device fills the spare ring while the old one keeps feeding
+  // the chain; the processing side takes it from there
+  CaptureDevice *device = nextInput_.device.get();
+  inputSwitch_.store(SwitchState::Pending, std::memory_order_release);
+  device->start();
+  const bool switched = finishSwitch(inputSwitch_);
+
+  // The old device, or the new one if it never delivered
+  nextInput_.device->stop();
+  nextInput_.device.reset();
+  nextInput_.resampler.reset();
+  inputSwitch_.store(SwitchState::Idle, std::memory_order_release);
+
+  if (!switched) {
+    WAM_LOG_ERROR("New input device delivered no audio; keeping the "
+                  "current one");
+    return false;
   }
+  WAM_LOG_INFO("Input device switched (%d Hz)",
+               input_.device->getSampleRate());
+  return true;
 }
 
-void Engine::setOutputDevice(const std::wstring &deviceId) {
-  if (running_.load()) {
-    render_->stop();
+bool Engine::setOutputDevice(const std::wstring &deviceId) {
+  std::lock_guard<std::mutex> lock(switchMutex_);
+  if (!openOutput(deviceId, nextOutput_)) {
+    WAM_LOG_ERROR("Failed to open output device; keeping the current one");
+    return false;
   }
 
-  render_->initialize(deviceId);
+  if (!running_.load()) {
+    std::swap(output_, nextOutput_);
+    nextOutput_.device.reset();
+    nextOutput_.resampler.reset();
+    return true;
+  }
 
-  if (running_.load()) {
-    render_->start();
+  // Plays silence until the processing side fades over to it
+  nextOutput_.device->start();
+  outputSwitch_.store(SwitchState::Pending, std::memory_order_release);
+  const bool switched = finishSwitch(outputSwitch_);
+
+  nextOutput_.device->stop();
+  nextOutput_.device.reset();
+  nextOutput_.resampler.reset();
+  outputSwitch_.store(SwitchState::Idle, std::memory_order_release);
+
+  if (!switched) {
+    WAM_LOG_ERROR("No audio was processed to switch output devices; "
+                  "keeping the current one");
+    return false;
+  }
+  WAM_LOG_INFO("Output device switched (%d Hz)",
+               output_.device->getSampleRate());
+  return true;
+}
+
+bool Engine::finishSwitch(std::atomic<SwitchState> &state) {
+  const auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(SWITCH_TIMEOUT_MS);
+  while (state.load(std::memory_order_acquire) == SwitchState::Pending &&
+         running_.load() && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  // Withdraw the switch unless the processing side has claimed it
+  SwitchState pending = SwitchState::Pending;
+  if (state.compare_exchange_strong(pending, SwitchState::Switching,
+                                    std::memory_order_acq_rel)) {
+    return false;
+  }
+  // Claimed: the fade finishes within the block being processed
+  while (state.load(std::memory_order_acquire) != SwitchState::Done) {
+    std::this_thread::yield();
   }
+  return true;
 }
 
 void Engine::setAIModel(const std::string &modelName) {
-  auto config = configManager_.getConfig();
-  config.aiModel = modelName;
-  configManager_.applyConfig(config);
+  updateConfig([&modelName](Config &config) { config.aiModel = modelName; });
 }
 
 void Engine::applyPreset(const std::string &presetName) {
-  auto config = configManager_.getConfig();
-
-  if (presetName == "podcast") {
-    // Warm, present voice with controlled dynamics
-    config.expander = {true, -45.0f, 2.5f, 5.0f, 100.0f, 3.0f};
-    config.compressor = {true, -16.0f, 3.5f, 6.0f, 10.0f, 100.0f, 6.0f};
-    config.limiter = {true, -1.0f, 50.0f, 5.0f};
-    config.equalizer.highPass = {80.0f, 0.7f};
-    config.equalizer.lowShelf = {200.0f, 1.0f};
-    config.equalizer.presence = {3000.0f, 3.0f, 1.0f};
-    config.equalizer.highShelf = {8000.0f, 2.0f};
-  } else if (presetName == "meeting") {
-    // Natural, less aggressive processing
-    config.expander = {true, -50.0f, 2.0f, 10.0f, 150.0f, 4.0f};
-    config.compressor = {true, -20.0f, 2.5f, 8.0f, 15.0f, 150.0f, 4.0f};
-    config.limiter = {true, -3.0f, 100.0f, 3.0f};
-    config.equalizer.highPass = {100.0f, 0.7f};
-    config.equalizer.lowShelf = {200.0f, 0.0f};
-    config.equalizer.presence = {3000.0f, 1.5f, 1.0f};
-    config.equalizer.highShelf = {10000.0f, 1.0f};
-  } else if (presetName == "streaming") {
-    // Punchy, broadcast-style
-    config.expander = {true, -40.0f, 3.0f, 3.0f, 80.0f, 2.0f};
-    config.compressor = {true, -14.0f, 4.5f, 4.0f, 5.0f, 80.0f, 8.0f};
-    config.limiter = {true, -0.5f, 30.0f, 5.0f};
-    config.equalizer.highPass = {80.0f, 0.8f};
-    config.equalizer.lowShelf = {150.0f, 2.0f};
-    config.equalizer.presence = {4000.0f, 4.0f, 1.2f};
-    config.equalizer.highShelf = {12000.0f, 3.0f};
-  }
-
-  config.activePreset = presetName;
+  updateConfig([&presetName](Config &config) {
+    applyPresetSettings(config, presetName);
+    config.activePreset = presetName;
+  });
+}
+
+void Engine::applyConfig(const Config &config) {
+  std::lock_guard<std::mutex> lock(applyMutex_);
+  applyConfigLocked(config);
+}
+
+void Engine::updateConfig(const std::function<void(Config &)> &update) {
+  std::lock_guard<std::mutex> lock(applyMutex_);
+  Config config = configManager_.getConfig();
+  update(config);
+  applyConfigLocked(config);
+}
+
+void Engine::applyConfigLocked(const Config &config) {
+  const ConfigDiff changes = diff(configManager_.getConfig(), config);
+  if (changes.empty()) {
+    return;
+  }
+
   configManager_.applyConfig(config);
+  applyConfigChanges(config, changes);
+}
+
+void Engine::applyConfigChanges(const Config &config,
+                                const ConfigDiff &changes) {
+  if (chain_) {
+    chain_->applyChanges(config, changes);
+  }
+
+  WAM_LOG_DEBUG("Config applied: %zu field(s) changed", changes.fields.size());
+}
+
+void Engine::reloadConfig(uint64_t changeNs) {
+  WAM_TRACE_SCOPE("ConfigReload");
+  std::lock_guard<std::mutex> lock(applyMutex_);
 
-  // Apply to processors
-  setExpanderParams(config.expander);
-  setCompressorParams(config.compressor);
-  setLimiterParams(config.limiter);
-  setEqualizerParams(config.equalizer);
+  // Invalid files are rejected before anything reaches the processors
+  ConfigDiff changes;
+  if (!configManager_.reload(changes)) {
+    reloadRejectedMetric_->add();
+    WAM_LOG_WARNING("Config reload rejected; keeping current settings");
+    return;
+  }
+  if (changes.empty()) {
+    return;
+  }
+
+  applyConfigChanges(configManager_.getConfig(), changes);
+
+  const uint64_t latencyUs = (nowNs() - changeNs) / 1000;
+  reloadLatencyMetric_->record(latencyUs);
+  WAM_LOG_INFO("Config reloaded: %zu field(s) changed, applied %.1f ms "
+               "after the file changed",
+               changes.fields.size(), static_cast<double>(latencyUs) / 1000.0);
+
+  const uint32_t restartOnly =
+      static_cast<uint32_t>(ConfigSection::Devices) |
+      static_cast<uint32_t>(ConfigSection::AiModel) |
+      static_cast<uint32_t>(ConfigSection::DeepFilter) |
+      static_cast<uint32_t>(ConfigSection::Diagnostics) |
+      static_cast<uint32_t>(ConfigSection::AudioExport) |
+      static_cast<uint32_t>(ConfigSection::Tuning);
+  for (const ConfigField *field : changes.fields) {
+    if (static_cast<uint32_t>(field->section) & restartOnly) {
+      WAM_LOG_INFO("  %s takes effect after restart", field->path);
+    } else {
+      WAM_LOG_DEBUG("  %s", field->path);
+    }
+  }
 }
 
-void Engine::setBypass(bool bypass) { bypass_ = bypass; }
+void Engine::setBypass(bool bypass) {
+  if (chain_) {
+    chain_->setBypass(bypass);
+  }
+}
 
 void Engine::setExpanderParams(const ExpanderConfig &params) {
-  if (expander_) {
-    expander_->setEnabled(params.enabled);
-    expander_->setThreshold(params.threshold);
-    expander_->setRatio(params.ratio);
-    expander_->setAttack(params.attack);
-    expander_->setRelease(params.release);
-    expander_->setHysteresis(params.hysteresis);
+  if (chain_) {
+    chain_->setExpanderParams(params);
   }
 }
 
 void Engine::setCompressorParams(const CompressorConfig &params) {
-  if (compressor_) {
-    compressor_->setEnabled(params.enabled);
-    compressor_->setThreshold(params.threshold);
-    compressor_->setRatio(params.ratio);
-    compressor_->setKnee(params.knee);
-    compressor_->setAttack(params.attack);
-    compressor_->setRelease(params.release);
-    compressor_->setMakeupGain(params.makeupGain);
+  if (chain_) {
+    chain_->setCompressorParams(params);
   }
 }
 
 void Engine::setLimiterParams(const LimiterConfig &params) {
-  if (limiter_) {
-    limiter_->setEnabled(params.enabled);
-    limiter_->setCeiling(params.ceiling);
-    limiter_->setRelease(params.release);
-    limiter_->setLookahead(params.lookahead);
+  if (chain_) {
+    chain_->setLimiterParams(params);
   }
 }
 
 void Engine::setEqualizerParams(const EqualizerConfig &params) {
-  if (equalizer_) {
-    equalizer_->setEnabled(params.enabled);
-    equalizer_->setHighPass(params.highPass.freq, params.highPass.q);
-    equalizer_->setLowShelf(params.lowShelf.freq, params.lowShelf.gain);
-    equalizer_->setPresence(params.presence.freq, params.presence.gain,
-                            params.presence.q);
-    equalizer_->setHighShelf(params.highShelf.freq, params.highShelf.gain);
+  if (chain_) {
+    chain_->setEqualizerParams(params);
   }
 }
 
+size_t Engine::applyParameters(const std::vector<ParamUpdate> &updates) {
+  // The check PipeServer makes, for callers that bypass it: a NaN or
+  // out-of-range value must reach neither the processors nor the file
+  for (const ParamUpdate &update : updates) {
+    if (!isValidParameter(update)) {
+      WAM_LOG_WARNING("Parameter batch rejected: invalid %s",
+                      paramName(update.id));
+      return 0;
+    }
+  }
+
+  size_t applied = 0;
+
+  // One config change per batch, however many parameters it carried
+  updateConfig([&](Config &config) {
+    for (const ParamUpdate &update : updates) {
+      const float v = update.value;
+      const bool on = v != 0.0f;
+      auto &eq = config.equalizer;
+
+      switch (update.id) {
+      case ParamId::Bypass:
+        setBypass(on);
+        break;
+      case ParamId::RNNoiseAttenuation:
+        config.aiSettings.rnnoise.attenuation = v;
+        break;
+
+      case ParamId::ExpanderEnabled:
+        config.expander.enabled = on;
+        break;
+      case ParamId::ExpanderThreshold:
+        config.expander.threshold = v;
+        break;
+      case ParamId::ExpanderRatio:
+        config.expander.ratio = v;
+        break;
+      case ParamId::ExpanderAttack:
+        config.expander.attack = v;
+        break;
+      case ParamId::ExpanderRelease:
+        config.expander.release = v;
+        break;
+      case ParamId::ExpanderHysteresis:
+        config.expander.hysteresis = v;
+        break;
+      case ParamId::ExpanderLookahead:
+        config.expander.lookahead = v;
+        break;
+
+      case ParamId::CompressorEnabled:
+        config.compressor.enabled = on;
+        break;
+      case ParamId::CompressorThreshold:
+        config.compressor.threshold = v;
+        break;
+      case ParamId::CompressorRatio:
+        config.compressor.ratio = v;
+        break;
+      case ParamId::CompressorKnee:
+        config.compressor.knee = v;
+        break;
+      case ParamId::CompressorAttack:
+        config.compressor.attack = v;
+        break;
+      case ParamId::CompressorRelease:
+        config.compressor.release = v;
+        break;
+      case ParamId::CompressorMakeupGain:
+        config.compressor.makeupGain = v;
+        break;
+      case ParamId::CompressorLookahead:
+        config.compressor.lookahead = v;
+        break;
+
+      case ParamId::LimiterEnabled:
+        config.limiter.enabled = on;
+        break;
+      case ParamId::LimiterCeiling:
+        config.limiter.ceiling = v;
+        break;
+      case ParamId::LimiterRelease:
+        config.limiter.release = v;
+        break;
+      case ParamId::LimiterLookahead:
+        config.limiter.lookahead = v;
+        break;
+
+      case ParamId::EqualizerEnabled:
+        eq.enabled = on;
+        break;
+      case ParamId::EqHighPassFreq:
+        eq.highPass.freq = v;
+        break;
+      case ParamId::EqHighPassQ:
+        eq.highPass.q = v;
+        break;
+      case ParamId::EqLowShelfFreq:
+        eq.lowShelf.freq = v;
+        break;
+      case ParamId::EqLowShelfGain:
+        eq.lowShelf.gain = v;
+        break;
+      case ParamId::EqPresenceFreq:
+        eq.presence.freq = v;
+        break;
+      case ParamId::EqPresenceGain:
+        eq.presence.gain = v;
+        break;
+      case ParamId::EqPresenceQ:
+        eq.presence.q = v;
+        break;
+      case ParamId::EqHighShelfFreq:
+        eq.highShelf.freq = v;
+        break;
+      case ParamId::EqHighShelfGain:
+        eq.highShelf.gain = v;
+        break;
+      case ParamId::EqDeEsserEnabled:
+        eq.deEsserEnabled = on;
+        break;
+      case ParamId::EqDeEsserFreq:
+        eq.deEsser.freq = v;
+        break;
+      case ParamId::EqDeEsserThreshold:
+        eq.deEsser.threshold = v;
+        break;
+
+      default:
+        continue; // Unknown ID (newer client)
+      }
+      ++applied;
+    }
+  });
+  return applied;
+}
+
 void Engine::setMeterCallback(MeterCallback callback) {
   std::lock_guard<std::mutex> lock(meterMutex_);
   meterCallback_ = std::move(callback);
 }
 
 Engine::Status Engine::getStatus() const {
-  std::lock_guard<std::mutex> lock(statusMutex_);
-  return status_;
+  Status status;
+  {
+    std::lock_guard<std::mutex> lock(statusMutex_);
+    status = status_;
+  }
+
+  // Glitch counters are published lock-free by the processing thread
+  status.glitches = glitchDetector_.getStats();
+  status.bufferUnderruns =
+      status.glitches.count(GlitchType::RenderUnderrun);
+  return status;
+}
+
+Engine::PowerUsage Engine::getPowerUsage() const {
+  PowerUsage usage;
+  const uint64_t now = nowNs();
+  usage.elapsedNs = startNs_ != 0 && now > startNs_ ? now - startNs_ : 0;
+  usage.wakeups = captureWakeMetric_->get() + renderWakeMetric_->get() +
+                  processingWakeMetric_->get() - startWakeups_;
+  usage.cpuNs = processCpuTimeNs() - startCpuNs_;
+  usage.blocks = processedBlocks_.load(std::memory_order_relaxed);
+  usage.audioFrames = processedFrames_.load(std::memory_order_relaxed);
+  if (chain_) {
+    usage.skippedBlocks = chain_->getSkippedBlocks() - startSkippedBlocks_;
+  }
+  return usage;
+}
+
+Engine::PowerUsage
+Engine::PowerUsage::since(const PowerUsage &earlier) const {
+  PowerUsage window;
+  window.elapsedNs = elapsedNs - earlier.elapsedNs;
+  window.wakeups = wakeups - earlier.wakeups;
+  window.cpuNs = cpuNs - earlier.cpuNs;
+  window.blocks = blocks - earlier.blocks;
+  window.audioFrames = audioFrames - earlier.audioFrames;
+  window.skippedBlocks = skippedBlocks - earlier.skippedBlocks;
+  return window;
+}
+
+double Engine::PowerUsage::wakeupsPerSecond() const {
+  return elapsedNs > 0 ? static_cast<double>(wakeups) * 1e9 /
+                             static_cast<double>(elapsedNs)
+                       : 0.0;
+}
+
+double Engine::PowerUsage::cpuMsPerAudioSecond() const {
+  if (audioFrames == 0) {
+    return 0.0;
+  }
+  const double audioSeconds =
+      static_cast<double>(audioFrames) / ProcessingChain::SAMPLE_RATE;
+  return static_cast<double>(cpuNs) / 1e6 / audioSeconds;
+}
+
+double Engine::PowerUsage::skippedPercent() const {
+  return blocks > 0 ? 100.0 * static_cast<double>(skippedBlocks) /
+                          static_cast<double>(blocks)
+                    : 0.0;
 }
 
 } // namespace WindowsAiMic
@@ -10,27 +10,34 @@
 #include <atomic>
 #include <condition_variable>
 #include <functional>
+#include <future>
 #include <memory>
 #include <mutex>
+#include <semaphore>
 #include <string>
 #include <thread>
 #include <vector>
 
 #include "audio/audio_buffer.h"
+#include "audio/audio_device.h"
 #include "config/config_manager.h"
+#include "config/config_schema.h"
+#include "diagnostics/glitch_detector.h"
+#include "diagnostics/startup_timeline.h"
+#include "ipc/protocol.h"
 
 // Forward declarations
 namespace WindowsAiMic {
-class WasapiCapture;
-class WasapiRender;
 class Resampler;
-class RNNoiseProcessor;
-class Expander;
-class Compressor;
-class Limiter;
-class Equalizer;
-class Metering;
+class ProcessingChain;
 class PipeServer;
+class TelemetryWriter;
+class AudioExportWriter;
+class FlightRecorder;
+class ConfigWatcher;
+class Histogram;
+class Gauge;
+class Counter;
 } // namespace WindowsAiMic
 
 namespace WindowsAiMic {
@@ -40,7 +47,10 @@ namespace WindowsAiMic {
  */
 class Engine {
 public:
-  explicit Engine(ConfigManager &configManager);
+  /**
+   * @param backend Device factories; the default opens WASAPI devices
+   */
+  explicit Engine(ConfigManager &configManager, AudioBackend backend = {});
   ~Engine();
 
   // Lifecycle
@@ -54,19 +64,50 @@ public:
   std::vector<std::pair<std::string, std::wstring>> getInputDevices();
   std::vector<std::pair<std::string, std::wstring>> getOutputDevices();
 
+  /**
+   * Switch devices without interrupting processing
+   *
+   * The new device opens beside the running one, with its resampler for
+   * the device's rate. While running, the processing side crossfades from
+   * the old device to the new one over one block and carries on with the
+   * same DSP and AI state; the old device is then closed.
+   * @return false if the new device could not be opened or delivered no
+   *         audio in time; the current device stays in use
+   */
+  bool setInputDevice(const std::wstring &deviceId);
+  bool setOutputDevice(const std::wstring &deviceId);
+
   // Configuration
-  void setInputDevice(const std::wstring &deviceId);
-  void setOutputDevice(const std::wstring &deviceId);
   void setAIModel(const std::string &modelName);
   void applyPreset(const std::string &presetName);
   void setBypass(bool bypass);
 
+  /**
+   * Store a new config and push it to the processors
+   * Only processors (and EQ bands) whose fields changed are touched.
+   */
+  void applyConfig(const Config &config);
+
+  /**
+   * Edit the current config and apply the result as one change
+   * `update` runs under the same lock as hot reloads, so a reload can't
+   * land between reading the config and applying the edited copy.
+   */
+  void updateConfig(const std::function<void(Config &)> &update);
+
   // DSP parameter setters
   void setExpanderParams(const ExpanderConfig &params);
   void setCompressorParams(const CompressorConfig &params);
   void setLimiterParams(const LimiterConfig &params);
   void setEqualizerParams(const EqualizerConfig &params);
 
+  /**
+   * Apply a batch of IPC parameter updates as one config change
+   * A batch with an invalid value (isValidParameter) is not applied.
+   * @return Number of updates applied (unknown IDs are skipped)
+   */
+  size_t applyParameters(const std::vector<ParamUpdate> &updates);
+
   // Metering callbacks
   using MeterCallback =
       std::function<void(float peak, float rms, float gainReduction)>;
@@ -81,56 +122,195 @@ public:
     float gainReduction = 0.0f;
     float cpuUsage = 0.0f;
     uint32_t bufferUnderruns = 0;
+    GlitchStats glitches;
   };
   Status getStatus() const;
 
+  /**
+   * What the audio path has cost since start(); diff two samples with
+   * since() to measure a window
+   */
+  struct PowerUsage {
+    uint64_t elapsedNs = 0;
+    uint64_t wakeups = 0;     // Capture, render and processing threads
+    uint64_t cpuNs = 0;       // Whole process, user plus kernel
+    uint64_t blocks = 0;      // Processed blocks
+    uint64_t audioFrames = 0; // In those blocks, at the internal rate
+    uint64_t skippedBlocks = 0; // AI stage skipped as silence
+
+    PowerUsage since(const PowerUsage &earlier) const;
+    double wakeupsPerSecond() const;
+    double cpuMsPerAudioSecond() const;
+    double skippedPercent() const;
+  };
+  PowerUsage getPowerUsage() const;
+
+  /**
+   * "efficiency" or "latency": tuning.powerMode as resolved by initialize()
+   */
+  const char *powerModeName() const {
+    return efficiencyMode_ ? "efficiency" : "latency";
+  }
+
+  /**
+   * Spans of the last initialize()/start() and the time to first audio
+   */
+  const StartupTimeline &getStartupTimeline() const { return startup_; }
+
 private:
+  // One capture device and the ring only it writes
+  struct InputRoute {
+    std::unique_ptr<CaptureDevice> device;
+    std::unique_ptr<Resampler> resampler; // Device rate to internal
+    std::unique_ptr<LockFreeRingBuffer> ring;
+  };
+
+  struct OutputRoute {
+    std::unique_ptr<RenderDevice> device;
+    std::unique_ptr<Resampler> resampler; // Internal rate to device
+  };
+
+  // Pending: next* is open and streaming. The processing side claims it
+  // (Switching), fades over and swaps (Done); the control thread claims
+  // it instead if nothing did in SWITCH_TIMEOUT_MS.
+  enum class SwitchState { Idle, Pending, Switching, Done };
+
   // Processing thread
   void processingThread();
+  void processPendingBlocks(float wakeLatencyUs);
+  void processCoalesced();
+  bool inputSwitchReady() const;
+  bool readInputBlock();
+  void crossfadeInput(bool oldReady);
+  void crossfadeOutput();
+  void updatePowerMetrics(uint64_t nowNs);
+  void aiThread();
+  bool exchangeAiBlock();
   void processAudioBlock(float *buffer, size_t frames);
+  void recordBlock(uint64_t timestampNs, float processUs, float wakeLatencyUs,
+                   float inputPeak, uint32_t glitchFlags);
+  void publishTelemetry(uint64_t timestampNs, uint32_t glitchFlags);
+  void checkDenormals();
+  bool writeRender(OutputRoute &route, const float *block);
+  DeviceCounters collectDeviceCounters() const;
+  size_t renderQueueDepth() const;
+  std::string exportTrace() const;
 
   // Initialization helpers
+  std::unique_ptr<CaptureDevice> createCapture() const;
+  std::unique_ptr<RenderDevice> createRender() const;
   bool initializeCapture();
   bool initializeRender();
+  bool openInput(const std::wstring &deviceId, InputRoute &route);
+  bool openOutput(const std::wstring &deviceId, OutputRoute &route);
+  bool finishSwitch(std::atomic<SwitchState> &state);
   bool initializeProcessors();
+  void tuneProcessing(const Config &config);
+  std::string chainStatePath() const;
+  void saveChainState();
+  void restoreChainState();
   bool initializeIPC();
+  void logCpuFeatures();
+  void applyConfigLocked(const Config &config); // Holds applyMutex_
+  void applyConfigChanges(const Config &config, const ConfigDiff &changes);
+  void reloadConfig(uint64_t changeNs); // Config watcher thread
 
-  // Audio callback from WASAPI capture
-  void onAudioCaptured(float *buffer, size_t frames, int sampleRate,
-                       int channels);
+  // Audio callback from a capture device, bound to its own route
+  void onAudioCaptured(LockFreeRingBuffer &ring, Resampler *resampler,
+                       const float *buffer, size_t frames, int channels);
 
   // Configuration
   ConfigManager &configManager_;
+  std::unique_ptr<ConfigWatcher> configWatcher_; // Hot reload
+  std::mutex applyMutex_; // Serialises IPC, preset and reload changes
 
-  // Audio I/O
-  std::unique_ptr<WasapiCapture> capture_;
-  std::unique_ptr<WasapiRender> render_;
-  std::unique_ptr<Resampler> inputResampler_;
-  std::unique_ptr<Resampler> outputResampler_;
-
-  // Processing chain
-  std::unique_ptr<RNNoiseProcessor> rnnoise_;
-#ifdef USE_DEEPFILTER
-  std::unique_ptr<DeepFilterProcessor> deepfilter_;
-#endif
-  std::unique_ptr<Expander> expander_;
-  std::unique_ptr<Compressor> compressor_;
-  std::unique_ptr<Limiter> limiter_;
-  std::unique_ptr<Equalizer> equalizer_;
-  std::unique_ptr<Metering> inputMetering_;
-  std::unique_ptr<Metering> outputMetering_;
+  // Audio I/O. A device switch opens the new device as nextInput_ or
+  // nextOutput_ beside the running one; the processing side fades over
+  // at a block boundary and swaps the routes, then the control thread
+  // closes whichever device is left in next*.
+  AudioBackend backend_;
+  InputRoute input_;
+  InputRoute nextInput_;
+  OutputRoute output_;
+  OutputRoute nextOutput_;
+  std::atomic<SwitchState> inputSwitch_{SwitchState::Idle};
+  std::atomic<SwitchState> outputSwitch_{SwitchState::Idle};
+  std::atomic<LockFreeRingBuffer *> activeInputRing_{nullptr};
+  std::mutex switchMutex_;       // One switch at a time; stop() waits
+  std::vector<float> fadeBlock_; // Processing side: the faded block
+
+  // Processing chain; its arena also holds processingBuffer_
+  std::unique_ptr<ProcessingChain> chain_;
 
   // IPC
   std::unique_ptr<PipeServer> pipeServer_;
+  std::unique_ptr<TelemetryWriter> telemetry_;     // Shared-memory meters
+  std::unique_ptr<AudioExportWriter> audioExport_; // Shared-memory audio
+  std::future<bool> ipcTask_;        // initializeIPC() off the audio path
+  std::atomic<bool> ipcReady_{false}; // telemetry_/audioExport_ are set
+
+  // Diagnostics
+  std::unique_ptr<FlightRecorder> flightRecorder_;
+  GlitchDetector glitchDetector_;
+  StartupTimeline startup_;
+  std::atomic<uint64_t> inputOverflows_{0}; // Short writes to input_.ring
+  std::atomic<uint64_t> lastCaptureNs_{0};
+  uint64_t blockIndex_ = 0;    // Processing thread only
+  bool denormalCheck_ = false; // Sample DSP state for subnormals
+
+  // Metrics (owned by MetricsRegistry)
+  Histogram *blockTimeMetric_ = nullptr;
+  Histogram *wakeLatencyMetric_ = nullptr;
+  Gauge *inputQueueMetric_ = nullptr;
+  Gauge *outputQueueMetric_ = nullptr;
+  Gauge *firstAudioMetric_ = nullptr;
+  Gauge *quantumMetric_ = nullptr;
+  Counter *captureWakeMetric_ = nullptr;
+  Counter *renderWakeMetric_ = nullptr;
+  Counter *processingWakeMetric_ = nullptr;
+  Gauge *wakeupRateMetric_ = nullptr;
+  Gauge *cpuPerAudioMetric_ = nullptr;
+  Histogram *reloadLatencyMetric_ = nullptr;
+  Counter *reloadRejectedMetric_ = nullptr;
+  Counter *denormalBlocksMetric_ = nullptr;
+  Counter *denormalValuesMetric_ = nullptr;
 
   // Buffers
-  LockFreeRingBuffer inputBuffer_;
   LockFreeRingBuffer outputBuffer_;
-  std::vector<float> processingBuffer_;
+  float *processingBuffer_ = nullptr; // In chain_->scratch()
+
+  // Block size chosen by the start-up auto-tuner
+  size_t blockFrames_ = PROCESSING_BLOCK_SIZE;
+  float blockDurationUs_ = BLOCK_DURATION_US;
+
+  // AI stage a block ahead on its own thread (auto-tuner decision).
+  // aiWork_ hands aiBlock_ to aiThread_, aiDone_ hands it back.
+  bool pipelineAi_ = false;
+  std::thread aiThread_;
+  std::counting_semaphore<> aiWork_{0};
+  std::counting_semaphore<> aiDone_{0};
+  float *aiBlock_ = nullptr; // In chain_->scratch()
+  bool aiInFlight_ = false;  // Processing thread only
+  bool aiQuit_ = false;      // Set before the last aiWork_ release
+
+  // Efficiency mode (tuning.powerMode): the largest quantum, the capture
+  // thread waking once per quantum and running the chain inline, render
+  // filled from write(), E-core preference and silence skipping
+  bool efficiencyMode_ = false;
+  std::atomic_flag coalescedBusy_; // Held by the capture thread processing
+
+  // Power accounting since start()
+  uint64_t startNs_ = 0;
+  uint64_t startCpuNs_ = 0;
+  uint64_t startWakeups_ = 0;
+  uint64_t startSkippedBlocks_ = 0;
+  std::atomic<uint64_t> processedBlocks_{0};
+  std::atomic<uint64_t> processedFrames_{0};
+  uint64_t powerSampleNs_ = 0; // Last gauge update, processing side only
+  PowerUsage powerSample_;
 
   // State
   std::atomic<bool> running_{false};
-  std::atomic<bool> bypass_{false};
   std::thread processingThread_;
 
   // Synchronization
@@ -150,6 +330,12 @@ private:
   static constexpr int INTERNAL_CHANNELS = 1;          // Mono processing
   static constexpr size_t PROCESSING_BLOCK_SIZE = 480; // 10ms at 48kHz
   static constexpr size_t BUFFER_SIZE = PROCESSING_BLOCK_SIZE * 16;
+  static constexpr const char *TUNING_CACHE_FILE = "tuning_cache.json";
+  static constexpr const char *CHAIN_STATE_FILE = "chain_state.bin";
+  static constexpr uint64_t POWER_METRICS_INTERVAL_NS = 1000000000ull;
+  static constexpr int SWITCH_TIMEOUT_MS = 1000;
+  static constexpr float BLOCK_DURATION_US =
+      PROCESSING_BLOCK_SIZE * 1e6f / INTERNAL_SAMPLE_RATE;
 };
 
 } // namespace WindowsAiMic
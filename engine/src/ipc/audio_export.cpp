@@ -0,0 +1,210 @@
+/**
+ * WindowsAiMic - Audio Export Implementation
+ */
+
+#include "audio_export.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr size_t PAGE_SIZE_BYTES = 4096;
+
+size_t roundUpPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+} // namespace
+
+// ============================================================================
+// AudioExportWriter
+// ============================================================================
+
+bool AudioExportWriter::open(const char *name, int sampleRate, int channels,
+                             size_t capacityFrames) {
+  close();
+
+  if (sampleRate <= 0 || channels <= 0 || capacityFrames == 0) {
+    return false;
+  }
+
+  static_assert(sizeof(AudioExportHeader) <= PAGE_SIZE_BYTES);
+  const size_t capacity = roundUpPowerOfTwo(capacityFrames);
+  const size_t bytes = PAGE_SIZE_BYTES + capacity *
+                                             static_cast<size_t>(channels) *
+                                             sizeof(float);
+  if (!region_.create(name, bytes)) {
+    return false;
+  }
+
+  // Fresh header over the mapping; readers ignore it until magic is set
+  auto *base = static_cast<char *>(region_.data());
+  header_ = new (base) AudioExportHeader();
+  header_->version = AudioExportHeader::VERSION;
+  header_->sampleRate = static_cast<uint32_t>(sampleRate);
+  header_->channels = static_cast<uint32_t>(channels);
+  header_->capacityFrames = static_cast<uint32_t>(capacity);
+  header_->samplesOffset = static_cast<uint32_t>(PAGE_SIZE_BYTES);
+  header_->active.store(1, std::memory_order_relaxed);
+  header_->ring.reset();
+  header_->writeTimeNs.store(0, std::memory_order_relaxed);
+  samples_ = reinterpret_cast<float *>(base + PAGE_SIZE_BYTES);
+  header_->magic.store(AudioExportHeader::MAGIC, std::memory_order_release);
+  return true;
+}
+
+void AudioExportWriter::close() {
+  if (!header_) {
+    return;
+  }
+  header_->active.store(0, std::memory_order_release);
+  header_ = nullptr;
+  samples_ = nullptr;
+  region_.close();
+}
+
+void AudioExportWriter::write(const float *samples, size_t frames,
+                              uint64_t timestampNs) {
+  if (!header_ || frames == 0) {
+    return;
+  }
+
+  const size_t capacity = header_->capacityFrames;
+  const size_t channels = header_->channels;
+  const uint64_t index = header_->ring.claim(frames);
+  const uint64_t end = index + frames;
+
+  // Only the newest capacity frames of an oversized block can survive
+  if (frames > capacity) {
+    samples += (frames - capacity) * channels;
+    frames = capacity;
+  }
+
+  const size_t start = static_cast<size_t>((end - frames) & (capacity - 1));
+  const size_t first = std::min(frames, capacity - start);
+  std::memcpy(samples_ + start * channels, samples,
+              first * channels * sizeof(float));
+  if (first < frames) {
+    std::memcpy(samples_, samples + first * channels,
+                (frames - first) * channels * sizeof(float));
+  }
+
+  header_->writeTimeNs.store(timestampNs, std::memory_order_relaxed);
+  header_->ring.publish(end);
+}
+
+// ============================================================================
+// AudioExportReader
+// ============================================================================
+
+bool AudioExportReader::open(const char *name) {
+  close();
+
+  // Map the header alone first to learn the ring size
+  if (!region_.open(name, sizeof(AudioExportHeader))) {
+    return false;
+  }
+  const auto *probe = static_cast<const AudioExportHeader *>(region_.data());
+  if (probe->magic.load(std::memory_order_acquire) !=
+          AudioExportHeader::MAGIC ||
+      probe->version != AudioExportHeader::VERSION) {
+    region_.close();
+    return false;
+  }
+  const size_t bytes = probe->samplesOffset +
+                       static_cast<size_t>(probe->capacityFrames) *
+                           probe->channels * sizeof(float);
+
+  if (!region_.open(name, bytes)) {
+    return false;
+  }
+
+  const auto *base = static_cast<const char *>(region_.data());
+  header_ = reinterpret_cast<const AudioExportHeader *>(base);
+  samples_ = reinterpret_cast<const float *>(base + header_->samplesOffset);
+  cursor_ = header_->ring.end();
+  dropped_ = 0;
+  return true;
+}
+
+void AudioExportReader::close() {
+  header_ = nullptr;
+  samples_ = nullptr;
+  region_.close();
+}
+
+bool AudioExportReader::isWriterActive() const {
+  return header_ && header_->active.load(std::memory_order_acquire) != 0;
+}
+
+int AudioExportReader::getSampleRate() const {
+  return header_ ? static_cast<int>(header_->sampleRate) : 0;
+}
+
+int AudioExportReader::getChannels() const {
+  return header_ ? static_cast<int>(header_->channels) : 0;
+}
+
+size_t AudioExportReader::available() const {
+  if (!header_) {
+    return 0;
+  }
+  const uint64_t end = header_->ring.end();
+  return static_cast<size_t>(
+      std::min<uint64_t>(end > cursor_ ? end - cursor_ : 0,
+                         header_->capacityFrames));
+}
+
+uint64_t AudioExportReader::latestTimestampNs() const {
+  return header_ ? header_->writeTimeNs.load(std::memory_order_acquire) : 0;
+}
+
+size_t AudioExportReader::read(float *out, size_t maxFrames) {
+  if (!header_ || maxFrames == 0) {
+    return 0;
+  }
+
+  const uint64_t capacity = header_->capacityFrames;
+  const size_t channels = header_->channels;
+  const uint64_t end = header_->ring.end();
+  if (end < cursor_) {
+    cursor_ = end; // Writer recreated the region under us
+  }
+
+  uint64_t begin = std::max(cursor_, end > capacity ? end - capacity : 0);
+  dropped_ += begin - cursor_;
+
+  size_t count =
+      static_cast<size_t>(std::min<uint64_t>(end - begin, maxFrames));
+  const size_t start = static_cast<size_t>(begin & (capacity - 1));
+  const size_t first = std::min<size_t>(count, capacity - start);
+  std::memcpy(out, samples_ + start * channels,
+              first * channels * sizeof(float));
+  if (first < count) {
+    std::memcpy(out + first * channels, samples_,
+                (count - first) * channels * sizeof(float));
+  }
+
+  // Drop whatever the writer may have overwritten while we were copying
+  const size_t stale = header_->ring.stale(begin, count, capacity);
+  if (stale > 0) {
+    std::memmove(out, out + stale * channels,
+                 (count - stale) * channels * sizeof(float));
+    count -= stale;
+    dropped_ += stale;
+    begin += stale;
+  }
+
+  cursor_ = begin + count;
+  return count;
+}
+
+} // namespace WindowsAiMic
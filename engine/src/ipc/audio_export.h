@@ -0,0 +1,134 @@
+/**
+ * WindowsAiMic - Audio Export Header
+ *
+ * Broadcast ring of processed audio in shared memory for local consumers
+ * (recorders, transcription, QA tools). The engine writes without locks or
+ * syscalls; readers attach and detach at any time, each with its own
+ * cursor, and are never waited for: a reader that falls more than the ring
+ * behind skips ahead and counts the frames it lost.
+ */
+
+#pragma once
+
+#include "../diagnostics/seqlock_ring.h"
+#include "../platform/shared_memory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+/**
+ * Header at the start of the region; interleaved float samples follow at
+ * samplesOffset (page aligned)
+ */
+struct AudioExportHeader {
+  static constexpr uint32_t MAGIC = 0x50584541; // "AEXP"
+  static constexpr uint32_t VERSION = 1;
+
+  std::atomic<uint32_t> magic; // Written last by the creator
+  uint32_t version;
+  uint32_t sampleRate;
+  uint32_t channels;
+  uint32_t capacityFrames; // Power of two
+  uint32_t samplesOffset;  // Bytes from the start of the region
+  std::atomic<uint32_t> active; // Cleared when the engine shuts down
+
+  // Frame counters since the region was created
+  alignas(64) SeqlockRing ring;
+  std::atomic<uint64_t> writeTimeNs; // steady_clock of the newest block
+};
+
+/**
+ * Engine side: creates the region and appends audio
+ */
+class AudioExportWriter {
+public:
+  static constexpr const char *REGION_NAME = "WindowsAiMicAudio";
+
+  AudioExportWriter() = default;
+  ~AudioExportWriter() { close(); }
+
+  // Non-copyable
+  AudioExportWriter(const AudioExportWriter &) = delete;
+  AudioExportWriter &operator=(const AudioExportWriter &) = delete;
+
+  /**
+   * Create the shared region
+   * @param capacityFrames Ring length (rounded up to a power of two)
+   */
+  bool open(const char *name, int sampleRate, int channels,
+            size_t capacityFrames);
+  void close();
+  bool isOpen() const { return header_ != nullptr; }
+
+  /**
+   * Append interleaved frames (wait-free, single producer)
+   * @param timestampNs steady_clock time the block was produced
+   */
+  void write(const float *samples, size_t frames, uint64_t timestampNs);
+
+private:
+  SharedMemoryRegion region_;
+  AudioExportHeader *header_ = nullptr;
+  float *samples_ = nullptr;
+};
+
+/**
+ * Client side: maps the region read-only and follows the stream
+ */
+class AudioExportReader {
+public:
+  AudioExportReader() = default;
+
+  // Non-copyable
+  AudioExportReader(const AudioExportReader &) = delete;
+  AudioExportReader &operator=(const AudioExportReader &) = delete;
+
+  /**
+   * Attach to a running engine; reading starts at the live edge
+   * @return false if the region does not exist (retry later)
+   */
+  bool open(const char *name = AudioExportWriter::REGION_NAME);
+  void close();
+  bool isOpen() const { return header_ != nullptr; }
+
+  /**
+   * False once the engine has shut down; reopen to follow a restart
+   */
+  bool isWriterActive() const;
+
+  int getSampleRate() const;
+  int getChannels() const;
+
+  /**
+   * Copy up to maxFrames interleaved frames published since the last read
+   * @return Frames copied
+   */
+  size_t read(float *out, size_t maxFrames);
+
+  /**
+   * Frames ready to read (capped at the ring size)
+   */
+  size_t available() const;
+
+  /**
+   * steady_clock time of the newest published block (0 = none yet)
+   */
+  uint64_t latestTimestampNs() const;
+
+  /**
+   * Frames lost because this reader fell behind
+   */
+  uint64_t getDroppedFrames() const { return dropped_; }
+
+private:
+  SharedMemoryRegion region_;
+  const AudioExportHeader *header_ = nullptr;
+  const float *samples_ = nullptr;
+  uint64_t cursor_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+} // namespace WindowsAiMic
@@ -0,0 +1,228 @@
+/**
+ * WindowsAiMic - IPC Client Implementation
+ */
+
+#include "ipc_client.h"
+
+#include <chrono>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+int remainingMs(Clock::time_point deadline) {
+  const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+      deadline - Clock::now());
+  return left.count() > 0 ? static_cast<int>(left.count()) : 0;
+}
+
+} // namespace
+
+bool IpcClient::connect(const std::string &name, int timeoutMs) {
+  disconnect();
+  const std::string path = ipcEndpointPath(name);
+
+#ifdef _WIN32
+  HANDLE pipe = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0,
+                            nullptr, OPEN_EXISTING, 0, nullptr);
+  if (pipe == INVALID_HANDLE_VALUE && GetLastError() == ERROR_PIPE_BUSY &&
+      WaitNamedPipeA(path.c_str(), static_cast<DWORD>(timeoutMs))) {
+    pipe = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+                       OPEN_EXISTING, 0, nullptr);
+  }
+  if (pipe == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  pipe_ = pipe;
+#else
+  (void)timeoutMs;
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) {
+    return false;
+  }
+  std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+
+  fd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0) {
+    return false;
+  }
+  if (::connect(fd_, reinterpret_cast<sockaddr *>(&address),
+                sizeof(address)) != 0) {
+    disconnect();
+    return false;
+  }
+#endif
+
+  decoder_ = FrameDecoder();
+  return true;
+}
+
+void IpcClient::disconnect() {
+#ifdef _WIN32
+  if (pipe_) {
+    CloseHandle(static_cast<HANDLE>(pipe_));
+    pipe_ = nullptr;
+  }
+#else
+  if (fd_ >= 0) {
+    close(fd_);
+    fd_ = -1;
+  }
+#endif
+}
+
+bool IpcClient::isConnected() const {
+#ifdef _WIN32
+  return pipe_ != nullptr;
+#else
+  return fd_ >= 0;
+#endif
+}
+
+uint32_t IpcClient::nextRequestId() {
+  const uint32_t id = nextRequestId_++;
+  if (nextRequestId_ == 0) {
+    nextRequestId_ = 1; // 0 means "failed"
+  }
+  return id;
+}
+
+uint32_t IpcClient::sendCommand(const std::string &command) {
+  const uint32_t id = nextRequestId();
+  sendBuffer_.clear();
+  Protocol::appendCommand(sendBuffer_, id, command);
+  return writeAll(sendBuffer_) ? id : 0;
+}
+
+uint32_t IpcClient::sendParameters(const ParamUpdate *updates, size_t count) {
+  const uint32_t id = nextRequestId();
+  sendBuffer_.clear();
+  Protocol::appendParamBatch(sendBuffer_, id, updates, count);
+  return writeAll(sendBuffer_) ? id : 0;
+}
+
+bool IpcClient::waitAck(uint32_t requestId, Ack &ack, int timeoutMs) {
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+  Frame frame;
+  while (isConnected()) {
+    while (decoder_.next(frame)) {
+      if (Protocol::decodeAck(frame, ack) && ack.requestId == requestId) {
+        return true;
+      }
+    }
+    if (decoder_.failed() || !readSome(remainingMs(deadline))) {
+      return false;
+    }
+  }
+  return false;
+}
+
+bool IpcClient::request(const std::string &command, std::string &response,
+                        int timeoutMs) {
+  const uint32_t id = sendCommand(command);
+  Ack ack;
+  if (id == 0 || !waitAck(id, ack, timeoutMs)) {
+    return false;
+  }
+  response = std::move(ack.text);
+  return ack.status == AckStatus::Ok;
+}
+
+bool IpcClient::writeAll(const std::vector<uint8_t> &data) {
+  if (!isConnected()) {
+    return false;
+  }
+
+#ifdef _WIN32
+  DWORD written = 0;
+  if (!WriteFile(static_cast<HANDLE>(pipe_), data.data(),
+                 static_cast<DWORD>(data.size()), &written, nullptr) ||
+      written != data.size()) {
+    disconnect();
+    return false;
+  }
+#else
+  size_t sent = 0;
+  while (sent < data.size()) {
+    const ssize_t n =
+        send(fd_, data.data() + sent, data.size() - sent, MSG_NOSIGNAL);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n <= 0) {
+      disconnect();
+      return false;
+    }
+    sent += static_cast<size_t>(n);
+  }
+#endif
+  return true;
+}
+
+bool IpcClient::readSome(int timeoutMs) {
+  uint8_t buffer[16 * 1024];
+
+#ifdef _WIN32
+  // Synchronous pipe handle: poll for data so the timeout holds
+  HANDLE pipe = static_cast<HANDLE>(pipe_);
+  const auto deadline = Clock::now() + std::chrono::milliseconds(timeoutMs);
+  DWORD available = 0;
+  while (true) {
+    if (!PeekNamedPipe(pipe, nullptr, 0, nullptr, &available, nullptr)) {
+      disconnect();
+      return false;
+    }
+    if (available > 0) {
+      break;
+    }
+    if (remainingMs(deadline) == 0) {
+      return false;
+    }
+    Sleep(1);
+  }
+
+  DWORD received = 0;
+  const DWORD toRead = available < sizeof(buffer)
+                           ? available
+                           : static_cast<DWORD>(sizeof(buffer));
+  if (!ReadFile(pipe, buffer, toRead, &received, nullptr) || received == 0) {
+    disconnect();
+    return false;
+  }
+  decoder_.feed(buffer, received);
+  return true;
+#else
+  pollfd descriptor = {fd_, POLLIN, 0};
+  int ready;
+  do {
+    ready = poll(&descriptor, 1, timeoutMs);
+  } while (ready < 0 && errno == EINTR);
+  if (ready <= 0) {
+    return false;
+  }
+
+  const ssize_t received = recv(fd_, buffer, sizeof(buffer), 0);
+  if (received <= 0) {
+    disconnect();
+    return false;
+  }
+  decoder_.feed(buffer, static_cast<size_t>(received));
+  return true;
+#endif
+}
+
+} // namespace WindowsAiMic
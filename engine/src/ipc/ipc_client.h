@@ -0,0 +1,84 @@
+/**
+ * WindowsAiMic - IPC Client Header
+ *
+ * Blocking client for the engine's control protocol. Requests can be
+ * pipelined: send several, then collect their acknowledgements, which
+ * arrive in request order.
+ */
+
+#pragma once
+
+#include "protocol.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Connection to the engine's IPC server (not thread-safe)
+ */
+class IpcClient {
+public:
+  IpcClient() = default;
+  ~IpcClient() { disconnect(); }
+
+  // Non-copyable
+  IpcClient(const IpcClient &) = delete;
+  IpcClient &operator=(const IpcClient &) = delete;
+
+  /**
+   * Connect to the server
+   * @param timeoutMs How long to wait for a free pipe instance (Windows)
+   */
+  bool connect(const std::string &name = IPC_ENDPOINT_NAME,
+               int timeoutMs = 2000);
+  void disconnect();
+  bool isConnected() const;
+
+  /**
+   * Send a text command ("PRESET:podcast")
+   * @return Request ID, or 0 if the write failed
+   */
+  uint32_t sendCommand(const std::string &command);
+
+  /**
+   * Send a batch of parameter updates in one frame
+   * @return Request ID, or 0 if the write failed
+   */
+  uint32_t sendParameters(const ParamUpdate *updates, size_t count);
+  uint32_t sendParameters(const std::vector<ParamUpdate> &updates) {
+    return sendParameters(updates.data(), updates.size());
+  }
+
+  /**
+   * Wait for the acknowledgement of a request (earlier ones are skipped)
+   * @return false on timeout or disconnect
+   */
+  bool waitAck(uint32_t requestId, Ack &ack, int timeoutMs = 1000);
+
+  /**
+   * Send a command and wait for its response text
+   */
+  bool request(const std::string &command, std::string &response,
+               int timeoutMs = 1000);
+
+private:
+  bool writeAll(const std::vector<uint8_t> &data);
+  bool readSome(int timeoutMs); // Feeds decoder_
+
+  uint32_t nextRequestId();
+
+#ifdef _WIN32
+  void *pipe_ = nullptr; // HANDLE
+#else
+  int fd_ = -1;
+#endif
+
+  uint32_t nextRequestId_ = 1;
+  FrameDecoder decoder_;
+  std::vector<uint8_t> sendBuffer_;
+};
+
+} // namespace WindowsAiMic
@@ -1,133 +1,130 @@
 /**
- * WindowsAiMic - Named Pipe Server Implementation
+ * WindowsAiMic - IPC Server Implementation
  */
 
 #include "pipe_server.h"
-#include <iostream>
-#include <sstream>
+#include "../config/config_schema.h"
+#include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+#include "transport.h"
 
-#ifdef _WIN32
-#include <Windows.h>
-#endif
+#include <bit>
+#include <cstdint>
+#include <cstdlib>
 
 namespace WindowsAiMic {
 
-PipeServer::PipeServer() = default;
-
-PipeServer::~PipeServer() { stop(); }
+namespace {
 
-bool PipeServer::start() {
-  if (running_.load()) {
-    return true;
-  }
-
-#ifdef _WIN32
-  // Create named pipe
-  pipe_ =
-      CreateNamedPipeA(PIPE_NAME, PIPE_ACCESS_DUPLEX,
-                       PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT,
-                       1,      // Max instances
-                       4096,   // Output buffer size
-                       4096,   // Input buffer size
-                       0,      // Default timeout
-                       nullptr // Default security
-      );
-
-  if (pipe_ == INVALID_HANDLE_VALUE || pipe_ == nullptr) {
-    std::cerr << "Failed to create named pipe: " << GetLastError() << std::endl;
-    pipe_ = nullptr;
-    return false;
+// Wire names are the config keys, except for the AI settings' prefix
+const ConfigField *paramField(ParamId id) {
+  if (id == ParamId::RNNoiseAttenuation) {
+    return findConfigField("aiSettings.rnnoise.attenuation");
   }
+  const char *name = paramName(id);
+  return name ? findConfigField(name) : nullptr;
+}
 
-  running_ = true;
-  serverThread_ = std::thread(&PipeServer::serverThread, this);
-
-  std::cout << "IPC pipe server started: " << PIPE_NAME << std::endl;
-  return true;
-#else
-  std::cout << "Named pipes not supported on this platform" << std::endl;
-  return false;
-#endif
+bool parseBool(const std::string &text) {
+  return text == "1" || text == "true" || text == "on";
 }
 
-void PipeServer::stop() {
-  if (!running_.load()) {
-    return;
+// Booleans may be spelled out; everything else is a number
+float parseValue(const std::string &text) {
+  if (text == "true" || text == "on") {
+    return 1.0f;
+  }
+  if (text == "false" || text == "off") {
+    return 0.0f;
   }
+  return std::strtof(text.c_str(), nullptr);
+}
 
-  running_ = false;
+} // namespace
 
-#ifdef _WIN32
-  // Close pipe to unblock WaitForSingleObject/ConnectNamedPipe
-  if (pipe_ != nullptr) {
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    DisconnectNamedPipe(hPipe);
-    CloseHandle(hPipe);
-    pipe_ = nullptr;
+bool isValidParameter(const ParamUpdate &update) {
+  // Exponent bits, not std::isfinite: -ffast-math lets the compiler
+  // assume every float is finite
+  if ((std::bit_cast<uint32_t>(update.value) & 0x7f800000u) == 0x7f800000u) {
+    return false;
   }
-#endif
-
-  if (serverThread_.joinable()) {
-    serverThread_.join();
+  const ConfigField *field = paramField(update.id);
+  if (!field || field->type != ConfigFieldType::Float) {
+    return true; // Bypass and switches take any number; unknown IDs skip
   }
-
-  std::cout << "IPC pipe server stopped" << std::endl;
+  return update.value >= field->min && update.value <= field->max;
 }
 
-void PipeServer::serverThread() {
-#ifdef _WIN32
-  HANDLE hPipe = static_cast<HANDLE>(pipe_);
-  while (running_.load()) {
-    // Wait for client connection
-    BOOL connected = ConnectNamedPipe(hPipe, nullptr);
+PipeServer::PipeServer() = default;
 
-    if (!running_.load()) {
-      break;
-    }
+PipeServer::~PipeServer() { stop(); }
 
-    if (connected || GetLastError() == ERROR_PIPE_CONNECTED) {
-      clientConnected_ = true;
-      std::cout << "Client connected to pipe" << std::endl;
+bool PipeServer::start(const std::string &name) {
+  if (transport_) {
+    return true;
+  }
 
-      handleClient();
+  transport_ = IpcTransport::create(name);
+  const bool started = transport_->start(
+      [this](uint32_t, const Frame &frame, std::vector<uint8_t> &reply) {
+        handleFrame(frame, reply);
+      });
+  if (!started) {
+    transport_.reset();
+    return false;
+  }
 
-      clientConnected_ = false;
-      std::cout << "Client disconnected" << std::endl;
+  WAM_LOG_INFO("IPC server started: %s", ipcEndpointPath(name).c_str());
+  return true;
+}
 
-      DisconnectNamedPipe(hPipe);
-    }
+void PipeServer::stop() {
+  if (!transport_) {
+    return;
   }
-#endif
-}
 
-void PipeServer::handleClient() {
-#ifdef _WIN32
-  char buffer[4096];
-  DWORD bytesRead;
+  transport_->stop();
+  transport_.reset();
 
-  while (running_.load() && clientConnected_.load()) {
-    // Read message from client
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    BOOL success =
-        ReadFile(hPipe, buffer, sizeof(buffer) - 1, &bytesRead, nullptr);
+  WAM_LOG_INFO("IPC server stopped");
+}
 
-    if (!success || bytesRead == 0) {
-      if (GetLastError() == ERROR_BROKEN_PIPE) {
-        break; // Client disconnected
-      }
-      continue;
-    }
+size_t PipeServer::clientCount() const {
+  return transport_ ? transport_->clientCount() : 0;
+}
 
-    buffer[bytesRead] = '\0';
-    processMessage(std::string(buffer, bytesRead));
+void PipeServer::handleFrame(const Frame &frame, std::vector<uint8_t> &reply) {
+  WAM_TRACE_SCOPE("IpcMessage");
+
+  std::string response;
+  uint32_t applied = 0;
+  AckStatus status;
+
+  switch (frame.type) {
+  case MessageType::Command:
+    status = processCommand(
+        std::string(frame.payload.begin(), frame.payload.end()), response,
+        applied);
+    break;
+  case MessageType::ParamBatch: {
+    std::vector<ParamUpdate> updates;
+    status = Protocol::decodeParamBatch(frame, updates)
+                 ? applyParameters(updates, applied)
+                 : AckStatus::Malformed;
+    break;
+  }
+  default:
+    status = AckStatus::UnknownCommand;
+    break;
   }
-#endif
+
+  Protocol::appendAck(reply, frame.requestId, status, applied, response);
 }
 
-void PipeServer::processMessage(const std::string &message) {
-  // Simple command parsing
+AckStatus PipeServer::processCommand(const std::string &message,
+                                     std::string &response,
+                                     uint32_t &applied) {
   // Format: "COMMAND:DATA"
-
   size_t colonPos = message.find(':');
   std::string command =
       colonPos != std::string::npos ? message.substr(0, colonPos) : message;
@@ -136,60 +133,84 @@ void PipeServer::processMessage(const std::string &message) {
 
   if (command == "PING") {
     // Health check
-#ifdef _WIN32
-    const char *response = "PONG";
-    DWORD bytesWritten;
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    WriteFile(hPipe, response, 4, &bytesWritten, nullptr);
-#endif
-  } else if (command == "GET_STATUS") {
-    // Return current status
-#ifdef _WIN32
-    std::string response = "STATUS:OK";
-    DWORD bytesWritten;
-    HANDLE hPipe = static_cast<HANDLE>(pipe_);
-    WriteFile(hPipe, response.c_str(), static_cast<DWORD>(response.size()),
-              &bytesWritten, nullptr);
-#endif
-  } else if (command == "CONFIG") {
-    // Config update - would parse JSON and call callback
-    // For now, just acknowledge
-    if (configCallback_) {
-      // In production, parse JSON from data
-      // configCallback_(parsedConfig);
+    response = "PONG";
+    return AckStatus::Ok;
+  }
+  if (command == "GET_STATUS") {
+    response = "STATUS:OK";
+    return AckStatus::Ok;
+  }
+  if (command == "CONFIG") {
+    // "compressor.threshold=-18,limiter.enabled=1"
+    std::vector<ParamUpdate> updates;
+    size_t start = 0;
+    while (start < data.size()) {
+      size_t end = data.find(',', start);
+      if (end == std::string::npos) {
+        end = data.size();
+      }
+      const std::string pair = data.substr(start, end - start);
+      const size_t equals = pair.find('=');
+      ParamUpdate update;
+      if (equals == std::string::npos ||
+          !parseParamName(pair.substr(0, equals), update.id)) {
+        response = "Unknown parameter: " + pair;
+        return AckStatus::InvalidParameter;
+      }
+      update.value = parseValue(pair.substr(equals + 1));
+      updates.push_back(update);
+      start = end + 1;
     }
-  } else if (command == "PRESET") {
-    // Apply preset
-    if (configCallback_) {
-      Config config;
-      config.activePreset = data;
-      configCallback_(config);
+    return applyParameters(updates, applied);
+  }
+  if (command == "PRESET") {
+    if (!presetCallback_) {
+      return AckStatus::Failed;
     }
-  } else if (command == "BYPASS") {
-    // Toggle bypass
-    // Would be handled by engine
+    presetCallback_(data);
+    return AckStatus::Ok;
+  }
+  if (command == "BYPASS") {
+    const ParamUpdate update{ParamId::Bypass, parseBool(data) ? 1.0f : 0.0f};
+    return applyParameters({update}, applied);
+  }
+
+  auto it = commandHandlers_.find(command);
+  if (it == commandHandlers_.end()) {
+    return AckStatus::UnknownCommand;
   }
+  response = it->second(data);
+  return AckStatus::Ok;
 }
 
-void PipeServer::sendMeterUpdate(float peak, float rms, float gainReduction) {
-  if (!clientConnected_.load()) {
-    return;
+AckStatus PipeServer::applyParameters(const std::vector<ParamUpdate> &updates,
+                                      uint32_t &applied) {
+  if (!parameterCallback_) {
+    return AckStatus::Failed;
+  }
+  // All or nothing: one bad value refuses the whole batch
+  for (const ParamUpdate &update : updates) {
+    if (!isValidParameter(update)) {
+      applied = 0;
+      return AckStatus::InvalidParameter;
+    }
   }
+  applied = static_cast<uint32_t>(parameterCallback_(updates));
+  return applied == updates.size() ? AckStatus::Ok
+                                   : AckStatus::InvalidParameter;
+}
 
-#ifdef _WIN32
-  std::ostringstream ss;
-  ss << "METERS:" << peak << "," << rms << "," << gainReduction;
-  std::string message = ss.str();
+void PipeServer::setPresetCallback(PresetCallback callback) {
+  presetCallback_ = std::move(callback);
+}
 
-  DWORD bytesWritten;
-  HANDLE hPipe = static_cast<HANDLE>(pipe_);
-  WriteFile(hPipe, message.c_str(), static_cast<DWORD>(message.size()),
-            &bytesWritten, nullptr);
-#endif
+void PipeServer::setParameterCallback(ParameterCallback callback) {
+  parameterCallback_ = std::move(callback);
 }
 
-void PipeServer::setConfigUpdateCallback(ConfigUpdateCallback callback) {
-  configCallback_ = std::move(callback);
+void PipeServer::registerCommand(const std::string &command,
+                                 CommandHandler handler) {
+  commandHandlers_[command] = std::move(handler);
 }
 
 } // namespace WindowsAiMic
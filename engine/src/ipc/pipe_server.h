@@ -1,24 +1,37 @@
 /**
- * WindowsAiMic - Named Pipe Server Header
+ * WindowsAiMic - IPC Server Header
  *
- * IPC server for communication with the UI application.
+ * Control-plane server for the UI and other local clients.
  */
 
 #pragma once
 
-#include "../config/config_types.h"
-#include <atomic>
+#include "protocol.h"
 #include <functional>
+#include <memory>
 #include <string>
-#include <thread>
+#include <unordered_map>
+#include <vector>
 
 namespace WindowsAiMic {
 
+class IpcTransport;
+
 /**
- * Named pipe server for UI communication
+ * Check an update's value against the config schema's limits
+ * @return false for a NaN or infinity, or a value outside the field's
+ *         range; unknown IDs pass (they are skipped when applied)
+ */
+bool isValidParameter(const ParamUpdate &update);
+
+/**
+ * IPC server for UI communication
  *
- * Allows the tray application to retrieve/update configuration
- * and receive real-time meter updates.
+ * Serves any number of clients at once over the platform transport
+ * (named pipe on Windows, Unix socket elsewhere) using the binary protocol
+ * in protocol.h. Real-time meters are published separately through shared
+ * memory (see telemetry.h) so the audio path never blocks on a client.
+ * Handlers run on the transport thread.
  */
 class PipeServer {
 public:
@@ -26,48 +39,59 @@ public:
   ~PipeServer();
 
   /**
-   * Start the pipe server
+   * Start the server
+   * @param name Endpoint name (tests and benches use their own)
    * @return true on success
    */
-  bool start();
+  bool start(const std::string &name = IPC_ENDPOINT_NAME);
 
   /**
-   * Stop the pipe server
+   * Stop the server
    */
   void stop();
 
   /**
-   * Send meter update to connected client
+   * Set callback for "PRESET:name": apply the named preset on top of the
+   * current config
    */
-  void sendMeterUpdate(float peak, float rms, float gainReduction);
+  using PresetCallback = std::function<void(const std::string &presetName)>;
+  void setPresetCallback(PresetCallback callback);
 
   /**
-   * Set callback for config update requests
+   * Set callback that applies a batch of parameter updates
+   * Batches with an invalid value (isValidParameter) are refused with
+   * InvalidParameter before it is called.
+   * @return Number of updates applied (unknown IDs are skipped)
    */
-  using ConfigUpdateCallback = std::function<void(const Config &)>;
-  void setConfigUpdateCallback(ConfigUpdateCallback callback);
+  using ParameterCallback =
+      std::function<size_t(const std::vector<ParamUpdate> &updates)>;
+  void setParameterCallback(ParameterCallback callback);
 
   /**
-   * Check if client is connected
+   * Register a handler for an additional "COMMAND:DATA" message
+   * The returned string is sent back in the acknowledgement.
    */
-  bool isClientConnected() const { return clientConnected_.load(); }
+  using CommandHandler = std::function<std::string(const std::string &data)>;
+  void registerCommand(const std::string &command, CommandHandler handler);
 
-private:
-  void serverThread();
-  void handleClient();
-  void processMessage(const std::string &message);
-
-  static constexpr const char *PIPE_NAME = "\\\\.\\pipe\\WindowsAiMicPipe";
+  /**
+   * Check if any client is connected
+   */
+  bool isClientConnected() const { return clientCount() > 0; }
+  size_t clientCount() const;
 
-#ifdef _WIN32
-  void *pipe_ = nullptr; // HANDLE
-#endif
+private:
+  void handleFrame(const Frame &frame, std::vector<uint8_t> &reply);
+  AckStatus processCommand(const std::string &message, std::string &response,
+                           uint32_t &applied);
+  AckStatus applyParameters(const std::vector<ParamUpdate> &updates,
+                            uint32_t &applied);
 
-  std::atomic<bool> running_{false};
-  std::atomic<bool> clientConnected_{false};
-  std::thread serverThread_;
+  std::unique_ptr<IpcTransport> transport_;
 
-  ConfigUpdateCallback configCallback_;
+  PresetCallback presetCallback_;
+  ParameterCallback parameterCallback_;
+  std::unordered_map<std::string, CommandHandler> commandHandlers_;
 };
 
 } // namespace WindowsAiMic
@@ -0,0 +1,252 @@
+/**
+ * WindowsAiMic - IPC Protocol Implementation
+ */
+
+#include "protocol.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace WindowsAiMic {
+
+namespace {
+
+struct ParamEntry {
+  ParamId id;
+  const char *name;
+};
+
+// Names follow the config file keys
+constexpr ParamEntry PARAMS[] = {
+    {ParamId::Bypass, "bypass"},
+    {ParamId::RNNoiseAttenuation, "rnnoise.attenuation"},
+    {ParamId::ExpanderEnabled, "expander.enabled"},
+    {ParamId::ExpanderThreshold, "expander.threshold"},
+    {ParamId::ExpanderRatio, "expander.ratio"},
+    {ParamId::ExpanderAttack, "expander.attack"},
+    {ParamId::ExpanderRelease, "expander.release"},
+    {ParamId::ExpanderHysteresis, "expander.hysteresis"},
+    {ParamId::ExpanderLookahead, "expander.lookahead"},
+    {ParamId::CompressorEnabled, "compressor.enabled"},
+    {ParamId::CompressorThreshold, "compressor.threshold"},
+    {ParamId::CompressorRatio, "compressor.ratio"},
+    {ParamId::CompressorKnee, "compressor.knee"},
+    {ParamId::CompressorAttack, "compressor.attack"},
+    {ParamId::CompressorRelease, "compressor.release"},
+    {ParamId::CompressorMakeupGain, "compressor.makeupGain"},
+    {ParamId::CompressorLookahead, "compressor.lookahead"},
+    {ParamId::LimiterEnabled, "limiter.enabled"},
+    {ParamId::LimiterCeiling, "limiter.ceiling"},
+    {ParamId::LimiterRelease, "limiter.release"},
+    {ParamId::LimiterLookahead, "limiter.lookahead"},
+    {ParamId::EqualizerEnabled, "equalizer.enabled"},
+    {ParamId::EqHighPassFreq, "equalizer.highPass.freq"},
+    {ParamId::EqHighPassQ, "equalizer.highPass.q"},
+    {ParamId::EqLowShelfFreq, "equalizer.lowShelf.freq"},
+    {ParamId::EqLowShelfGain, "equalizer.lowShelf.gain"},
+    {ParamId::EqPresenceFreq, "equalizer.presence.freq"},
+    {ParamId::EqPresenceGain, "equalizer.presence.gain"},
+    {ParamId::EqPresenceQ, "equalizer.presence.q"},
+    {ParamId::EqHighShelfFreq, "equalizer.highShelf.freq"},
+    {ParamId::EqHighShelfGain, "equalizer.highShelf.gain"},
+    {ParamId::EqDeEsserEnabled, "equalizer.deEsserEnabled"},
+    {ParamId::EqDeEsserFreq, "equalizer.deEsser.freq"},
+    {ParamId::EqDeEsserThreshold, "equalizer.deEsser.threshold"},
+};
+
+void putU16(std::vector<uint8_t> &out, uint16_t value) {
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void putU32(std::vector<uint8_t> &out, uint32_t value) {
+  for (int shift = 0; shift < 32; shift += 8) {
+    out.push_back(static_cast<uint8_t>(value >> shift));
+  }
+}
+
+uint16_t getU16(const uint8_t *data) {
+  return static_cast<uint16_t>(data[0] | (data[1] << 8));
+}
+
+uint32_t getU32(const uint8_t *data) {
+  return static_cast<uint32_t>(data[0]) |
+         (static_cast<uint32_t>(data[1]) << 8) |
+         (static_cast<uint32_t>(data[2]) << 16) |
+         (static_cast<uint32_t>(data[3]) << 24);
+}
+
+// Patch the length field once the payload has been appended
+void beginFrame(std::vector<uint8_t> &out, MessageType type,
+                uint32_t requestId) {
+  putU32(out, 0);
+  putU16(out, static_cast<uint16_t>(type));
+  putU16(out, 0); // flags
+  putU32(out, requestId);
+}
+
+void endFrame(std::vector<uint8_t> &out, size_t frameStart) {
+  const uint32_t length =
+      static_cast<uint32_t>(out.size() - frameStart - Protocol::HEADER_SIZE);
+  for (int i = 0; i < 4; ++i) {
+    out[frameStart + i] = static_cast<uint8_t>(length >> (8 * i));
+  }
+}
+
+} // namespace
+
+std::string ipcEndpointPath(const std::string &name) {
+#ifdef _WIN32
+  return "\\\\.\\pipe\\" + name;
+#else
+  const char *runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+  const std::string directory =
+      runtimeDir && *runtimeDir ? runtimeDir : "/tmp";
+  return directory + "/" + name + ".sock";
+#endif
+}
+
+const char *paramName(ParamId id) {
+  for (const ParamEntry &entry : PARAMS) {
+    if (entry.id == id) {
+      return entry.name;
+    }
+  }
+  return nullptr;
+}
+
+bool parseParamName(const std::string &name, ParamId &id) {
+  for (const ParamEntry &entry : PARAMS) {
+    if (name == entry.name) {
+      id = entry.id;
+      return true;
+    }
+  }
+  return false;
+}
+
+// ============================================================================
+// Encoding
+// ============================================================================
+
+namespace Protocol {
+
+void appendFrame(std::vector<uint8_t> &out, MessageType type,
+                 uint32_t requestId, const uint8_t *payload, size_t size) {
+  const size_t start = out.size();
+  beginFrame(out, type, requestId);
+  out.insert(out.end(), payload, payload + size);
+  endFrame(out, start);
+}
+
+void appendCommand(std::vector<uint8_t> &out, uint32_t requestId,
+                   const std::string &command) {
+  appendFrame(out, MessageType::Command, requestId,
+              reinterpret_cast<const uint8_t *>(command.data()),
+              command.size());
+}
+
+void appendParamBatch(std::vector<uint8_t> &out, uint32_t requestId,
+                      const ParamUpdate *updates, size_t count) {
+  count = std::min(count, MAX_BATCH);
+  const size_t start = out.size();
+  beginFrame(out, MessageType::ParamBatch, requestId);
+  putU16(out, static_cast<uint16_t>(count));
+  for (size_t i = 0; i < count; ++i) {
+    uint32_t bits;
+    std::memcpy(&bits, &updates[i].value, sizeof(bits));
+    putU16(out, static_cast<uint16_t>(updates[i].id));
+    putU32(out, bits);
+  }
+  endFrame(out, start);
+}
+
+void appendAck(std::vector<uint8_t> &out, uint32_t requestId,
+               AckStatus status, uint32_t applied, const std::string &text) {
+  const size_t start = out.size();
+  beginFrame(out, MessageType::Ack, requestId);
+  putU32(out, static_cast<uint32_t>(status));
+  putU32(out, applied);
+  out.insert(out.end(), text.begin(), text.end());
+  endFrame(out, start);
+}
+
+bool decodeParamBatch(const Frame &frame, std::vector<ParamUpdate> &updates) {
+  const std::vector<uint8_t> &p = frame.payload;
+  if (frame.type != MessageType::ParamBatch || p.size() < 2) {
+    return false;
+  }
+
+  const size_t count = getU16(p.data());
+  if (count > MAX_BATCH || p.size() != 2 + count * 6) {
+    return false;
+  }
+
+  updates.resize(count);
+  for (size_t i = 0; i < count; ++i) {
+    const uint8_t *entry = p.data() + 2 + i * 6;
+    const uint32_t bits = getU32(entry + 2);
+    updates[i].id = static_cast<ParamId>(getU16(entry));
+    std::memcpy(&updates[i].value, &bits, sizeof(bits));
+  }
+  return true;
+}
+
+bool decodeAck(const Frame &frame, Ack &ack) {
+  const std::vector<uint8_t> &p = frame.payload;
+  if (frame.type != MessageType::Ack || p.size() < 8) {
+    return false;
+  }
+
+  ack.requestId = frame.requestId;
+  ack.status = static_cast<AckStatus>(getU32(p.data()));
+  ack.applied = getU32(p.data() + 4);
+  ack.text.assign(reinterpret_cast<const char *>(p.data()) + 8, p.size() - 8);
+  return true;
+}
+
+} // namespace Protocol
+
+// ============================================================================
+// FrameDecoder
+// ============================================================================
+
+void FrameDecoder::feed(const uint8_t *data, size_t size) {
+  // Reclaim consumed bytes before growing
+  if (readPos_ > 0 && readPos_ == buffer_.size()) {
+    buffer_.clear();
+    readPos_ = 0;
+  } else if (readPos_ > 64 * 1024) {
+    buffer_.erase(buffer_.begin(), buffer_.begin() + readPos_);
+    readPos_ = 0;
+  }
+  buffer_.insert(buffer_.end(), data, data + size);
+}
+
+bool FrameDecoder::next(Frame &frame) {
+  if (failed_ || buffer_.size() - readPos_ < Protocol::HEADER_SIZE) {
+    return false;
+  }
+
+  const uint8_t *header = buffer_.data() + readPos_;
+  const uint32_t length = getU32(header);
+  if (length > Protocol::MAX_PAYLOAD) {
+    failed_ = true;
+    return false;
+  }
+  if (buffer_.size() - readPos_ < Protocol::HEADER_SIZE + length) {
+    return false;
+  }
+
+  frame.type = static_cast<MessageType>(getU16(header + 4));
+  frame.flags = getU16(header + 6);
+  frame.requestId = getU32(header + 8);
+  const uint8_t *payload = header + Protocol::HEADER_SIZE;
+  frame.payload.assign(payload, payload + length);
+
+  readPos_ += Protocol::HEADER_SIZE + length;
+  return true;
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,192 @@
+/**
+ * WindowsAiMic - IPC Protocol Header
+ *
+ * Length-prefixed binary control protocol shared by the engine's IPC
+ * server and its clients. Every frame carries a request ID that the
+ * server echoes in its acknowledgement, so clients can pipeline requests.
+ * A single ParamBatch frame updates many parameters at once.
+ *
+ * Frame layout (little-endian):
+ *   uint32 payloadLength | uint16 type | uint16 flags | uint32 requestId
+ *   payload[payloadLength]
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Endpoint name shared by server and clients
+ * Windows: \\.\pipe\<name>; elsewhere: a Unix socket in $XDG_RUNTIME_DIR
+ * (or /tmp) named <name>.sock
+ */
+constexpr const char *IPC_ENDPOINT_NAME = "WindowsAiMicPipe";
+
+/**
+ * Platform path for an endpoint name
+ */
+std::string ipcEndpointPath(const std::string &name);
+
+enum class MessageType : uint16_t {
+  Command = 1,    // UTF-8 "COMMAND:DATA" (the original text commands)
+  ParamBatch = 2, // uint16 count, then count x (uint16 id, float32 value)
+  Ack = 3,        // uint32 status, uint32 applied, then UTF-8 response text
+};
+
+enum class AckStatus : uint32_t {
+  Ok = 0,
+  UnknownCommand = 1,
+  InvalidParameter = 2, // Some updates in a batch were rejected
+  Malformed = 3,
+  Failed = 4,
+};
+
+/**
+ * Parameter IDs carried in ParamBatch frames
+ * Values are stable on the wire: append new IDs, never renumber.
+ */
+enum class ParamId : uint16_t {
+  Bypass = 1,
+  RNNoiseAttenuation = 2,
+
+  ExpanderEnabled = 10,
+  ExpanderThreshold = 11,
+  ExpanderRatio = 12,
+  ExpanderAttack = 13,
+  ExpanderRelease = 14,
+  ExpanderHysteresis = 15,
+  ExpanderLookahead = 16,
+
+  CompressorEnabled = 20,
+  CompressorThreshold = 21,
+  CompressorRatio = 22,
+  CompressorKnee = 23,
+  CompressorAttack = 24,
+  CompressorRelease = 25,
+  CompressorMakeupGain = 26,
+  CompressorLookahead = 27,
+
+  LimiterEnabled = 30,
+  LimiterCeiling = 31,
+  LimiterRelease = 32,
+  LimiterLookahead = 33,
+
+  EqualizerEnabled = 40,
+  EqHighPassFreq = 41,
+  EqHighPassQ = 42,
+  EqLowShelfFreq = 43,
+  EqLowShelfGain = 44,
+  EqPresenceFreq = 45,
+  EqPresenceGain = 46,
+  EqPresenceQ = 47,
+  EqHighShelfFreq = 48,
+  EqHighShelfGain = 49,
+  EqDeEsserEnabled = 50,
+  EqDeEsserFreq = 51,
+  EqDeEsserThreshold = 52,
+};
+
+struct ParamUpdate {
+  ParamId id;
+  float value; // Booleans: 0 = off, anything else = on
+};
+
+/**
+ * Config-style name of a parameter ("compressor.threshold"), or nullptr
+ */
+const char *paramName(ParamId id);
+
+/**
+ * Look up a parameter by its config-style name
+ * @return false if the name is unknown
+ */
+bool parseParamName(const std::string &name, ParamId &id);
+
+/**
+ * One decoded frame
+ */
+struct Frame {
+  MessageType type = MessageType::Command;
+  uint16_t flags = 0;
+  uint32_t requestId = 0;
+  std::vector<uint8_t> payload;
+};
+
+/**
+ * Decoded acknowledgement
+ */
+struct Ack {
+  uint32_t requestId = 0;
+  AckStatus status = AckStatus::Ok;
+  uint32_t applied = 0; // Parameters applied (ParamBatch)
+  std::string text;     // Command response, if any
+};
+
+namespace Protocol {
+
+constexpr size_t HEADER_SIZE = 12;
+constexpr uint32_t MAX_PAYLOAD = 1u << 20;
+constexpr size_t MAX_BATCH = 4096; // Updates per ParamBatch
+
+/**
+ * Encode a frame and append it to out (clients batch several per write)
+ */
+void appendFrame(std::vector<uint8_t> &out, MessageType type,
+                 uint32_t requestId, const uint8_t *payload, size_t size);
+
+void appendCommand(std::vector<uint8_t> &out, uint32_t requestId,
+                   const std::string &command);
+// Batches longer than MAX_BATCH are truncated; split them across frames
+void appendParamBatch(std::vector<uint8_t> &out, uint32_t requestId,
+                      const ParamUpdate *updates, size_t count);
+void appendAck(std::vector<uint8_t> &out, uint32_t requestId,
+               AckStatus status, uint32_t applied, const std::string &text);
+
+/**
+ * Decode payloads
+ * @return false if the payload is malformed
+ */
+bool decodeParamBatch(const Frame &frame, std::vector<ParamUpdate> &updates);
+bool decodeAck(const Frame &frame, Ack &ack);
+
+} // namespace Protocol
+
+/**
+ * Reassembles frames from a byte stream (reads may split or merge frames)
+ */
+class FrameDecoder {
+public:
+  /**
+   * Append received bytes
+   */
+  void feed(const uint8_t *data, size_t size);
+
+  /**
+   * Pop the next complete frame
+   * @return false if none is complete yet (or the stream is corrupt)
+   */
+  bool next(Frame &frame);
+
+  /**
+   * True once an oversized or invalid header was seen; the connection
+   * should be dropped
+   */
+  bool failed() const { return failed_; }
+
+  /**
+   * Bytes received and not yet popped as frames
+   */
+  size_t buffered() const { return buffer_.size() - readPos_; }
+
+private:
+  std::vector<uint8_t> buffer_;
+  size_t readPos_ = 0;
+  bool failed_ = false;
+};
+
+} // namespace WindowsAiMic
@@ -0,0 +1,163 @@
+/**
+ * WindowsAiMic - Telemetry Implementation
+ */
+
+#include "telemetry.h"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr int READ_ATTEMPTS = 4;
+
+} // namespace
+
+// ============================================================================
+// TelemetryWriter
+// ============================================================================
+
+bool TelemetryWriter::open(const char *name) {
+  close();
+
+  if (!region_.create(name, sizeof(TelemetryLayout))) {
+    return false;
+  }
+
+  // Fresh objects over the mapping; readers ignore it until magic is set
+  layout_ = new (region_.data()) TelemetryLayout();
+  layout_->version = TelemetryLayout::VERSION;
+  layout_->frameSize = sizeof(TelemetryFrame);
+  layout_->active.store(1, std::memory_order_relaxed);
+  layout_->sequence.store(0, std::memory_order_relaxed);
+  layout_->historyRing.reset();
+  layout_->magic.store(TelemetryLayout::MAGIC, std::memory_order_release);
+  return true;
+}
+
+void TelemetryWriter::close() {
+  if (!layout_) {
+    return;
+  }
+  layout_->active.store(0, std::memory_order_release);
+  layout_ = nullptr;
+  region_.close();
+}
+
+void TelemetryWriter::publish(const TelemetryFrame &frame) {
+  if (!layout_) {
+    return;
+  }
+
+  // Current frame: odd sequence while the copy is in flight
+  const uint64_t sequence = layout_->sequence.load(std::memory_order_relaxed);
+  layout_->sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  std::memcpy(&layout_->current, &frame, sizeof(frame));
+  layout_->sequence.store(sequence + 2, std::memory_order_release);
+
+  // History ring
+  const uint64_t index = layout_->historyRing.claim(1);
+  std::memcpy(&layout_->history[index % TelemetryLayout::HISTORY_CAPACITY],
+              &frame, sizeof(frame));
+  layout_->historyRing.publish(index + 1);
+}
+
+// ============================================================================
+// TelemetryReader
+// ============================================================================
+
+bool TelemetryReader::open(const char *name) {
+  close();
+
+  if (!region_.open(name, sizeof(TelemetryLayout))) {
+    return false;
+  }
+
+  const auto *layout = static_cast<const TelemetryLayout *>(region_.data());
+  if (layout->magic.load(std::memory_order_acquire) !=
+          TelemetryLayout::MAGIC ||
+      layout->version != TelemetryLayout::VERSION ||
+      layout->frameSize != sizeof(TelemetryFrame)) {
+    region_.close();
+    return false;
+  }
+
+  layout_ = layout;
+  // Start from what is already buffered
+  const uint64_t written = layout_->historyRing.end();
+  cursor_ = written > TelemetryLayout::HISTORY_CAPACITY
+                ? written - TelemetryLayout::HISTORY_CAPACITY
+                : 0;
+  dropped_ = 0;
+  return true;
+}
+
+void TelemetryReader::close() {
+  layout_ = nullptr;
+  region_.close();
+}
+
+bool TelemetryReader::isWriterActive() const {
+  return layout_ && layout_->active.load(std::memory_order_acquire) != 0;
+}
+
+bool TelemetryReader::readCurrent(TelemetryFrame &frame) const {
+  if (!layout_) {
+    return false;
+  }
+
+  for (int attempt = 0; attempt < READ_ATTEMPTS; ++attempt) {
+    const uint64_t before = layout_->sequence.load(std::memory_order_acquire);
+    if (before & 1) {
+      continue;
+    }
+
+    std::memcpy(&frame, &layout_->current, sizeof(frame));
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (layout_->sequence.load(std::memory_order_relaxed) == before) {
+      return before != 0; // 0 = nothing published yet
+    }
+  }
+  return false;
+}
+
+size_t TelemetryReader::readHistory(TelemetryFrame *out, size_t maxFrames) {
+  if (!layout_ || maxFrames == 0) {
+    return 0;
+  }
+
+  constexpr uint64_t capacity = TelemetryLayout::HISTORY_CAPACITY;
+  const uint64_t end = layout_->historyRing.end();
+  if (end < cursor_) {
+    cursor_ = 0; // Writer recreated the region under us
+  }
+
+  uint64_t begin = std::max(cursor_, end > capacity ? end - capacity : 0);
+  dropped_ += begin - cursor_;
+
+  size_t count =
+      static_cast<size_t>(std::min<uint64_t>(end - begin, maxFrames));
+  for (size_t i = 0; i < count; ++i) {
+    std::memcpy(&out[i], &layout_->history[(begin + i) % capacity],
+                sizeof(TelemetryFrame));
+  }
+
+  // Drop whatever the writer may have overwritten while we were copying
+  const size_t stale = layout_->historyRing.stale(begin, count, capacity);
+  if (stale > 0) {
+    std::memmove(out, out + stale, (count - stale) * sizeof(TelemetryFrame));
+    count -= stale;
+    dropped_ += stale;
+    begin += stale;
+  }
+
+  cursor_ = begin + count;
+  return count;
+}
+
+} // namespace WindowsAiMic
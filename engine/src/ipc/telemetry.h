@@ -0,0 +1,156 @@
+/**
+ * WindowsAiMic - Telemetry Header
+ *
+ * Shared-memory meter channel. The engine publishes one frame per audio
+ * block without locks or syscalls; any number of UI or monitoring processes
+ * map the region read-only and poll it at their own frame rate.
+ */
+
+#pragma once
+
+#include "../diagnostics/seqlock_ring.h"
+#include "../platform/shared_memory.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+/**
+ * Telemetry frame flags
+ */
+namespace TelemetryFlag {
+constexpr uint32_t Bypass = 1u << 0;
+constexpr uint32_t Glitch = 1u << 1; // Glitch detected in this block
+} // namespace TelemetryFlag
+
+/**
+ * Meter snapshot for one processed block (POD, shared across processes)
+ */
+struct TelemetryFrame {
+  uint64_t timestampNs = 0; // Engine steady_clock
+  uint64_t blockIndex = 0;  // Blocks since engine start
+  float inputPeakDb = -100.0f;
+  float inputRmsDb = -100.0f;
+  float outputPeakDb = -100.0f;
+  float outputRmsDb = -100.0f;
+  float outputLufs = -100.0f;        // Short-term loudness
+  float compressorReductionDb = 0.0f;
+  float limiterReductionDb = 0.0f;
+  float vadProbability = 0.0f; // RNNoise voice activity, 0-1
+  uint32_t glitchCount = 0;    // Total since engine start
+  uint32_t flags = 0;          // TelemetryFlag bits
+};
+
+/**
+ * Layout of the shared region
+ *
+ * "current" is guarded by a seqlock (odd sequence = write in progress).
+ * "history" is a ring of every frame; readers follow it with a cursor and
+ * drop entries the writer lapped while they were copying.
+ */
+struct TelemetryLayout {
+  static constexpr uint32_t MAGIC = 0x4D4C4554; // "TELM"
+  static constexpr uint32_t VERSION = 1;
+  static constexpr size_t HISTORY_CAPACITY = 1024; // ~10 s at 10 ms blocks
+
+  std::atomic<uint32_t> magic;  // Written last by the creator
+  uint32_t version;
+  uint32_t frameSize;           // sizeof(TelemetryFrame), layout check
+  std::atomic<uint32_t> active; // Cleared when the engine shuts down
+
+  std::atomic<uint64_t> sequence;
+  TelemetryFrame current;
+
+  SeqlockRing historyRing;
+  TelemetryFrame history[HISTORY_CAPACITY];
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Telemetry needs address-free 64-bit atomics");
+
+/**
+ * Engine side: creates the region and publishes frames
+ */
+class TelemetryWriter {
+public:
+  static constexpr const char *REGION_NAME = "WindowsAiMicTelemetry";
+
+  TelemetryWriter() = default;
+  ~TelemetryWriter() { close(); }
+
+  // Non-copyable
+  TelemetryWriter(const TelemetryWriter &) = delete;
+  TelemetryWriter &operator=(const TelemetryWriter &) = delete;
+
+  /**
+   * Create the shared region
+   * @param name Region name (tests use a unique one)
+   */
+  bool open(const char *name = REGION_NAME);
+  void close();
+  bool isOpen() const { return layout_ != nullptr; }
+
+  /**
+   * Publish a frame (wait-free, single producer)
+   */
+  void publish(const TelemetryFrame &frame);
+
+private:
+  SharedMemoryRegion region_;
+  TelemetryLayout *layout_ = nullptr;
+};
+
+/**
+ * Client side: maps the region read-only
+ */
+class TelemetryReader {
+public:
+  TelemetryReader() = default;
+
+  // Non-copyable
+  TelemetryReader(const TelemetryReader &) = delete;
+  TelemetryReader &operator=(const TelemetryReader &) = delete;
+
+  /**
+   * Attach to the engine's region
+   * @return false if the engine is not running (retry later)
+   */
+  bool open(const char *name = TelemetryWriter::REGION_NAME);
+  void close();
+  bool isOpen() const { return layout_ != nullptr; }
+
+  /**
+   * False once the engine that created the region has shut down;
+   * close() and open() again to follow a restarted engine
+   */
+  bool isWriterActive() const;
+
+  /**
+   * Copy the most recent frame
+   * @return false if no consistent copy could be taken (writer mid-update)
+   */
+  bool readCurrent(TelemetryFrame &frame) const;
+
+  /**
+   * Copy frames published since the last call
+   * @param out Destination buffer
+   * @param maxFrames Capacity of out
+   * @return Number of frames copied (oldest first)
+   */
+  size_t readHistory(TelemetryFrame *out, size_t maxFrames);
+
+  /**
+   * Frames lost because the reader fell more than the ring behind
+   */
+  uint64_t getDroppedFrames() const { return dropped_; }
+
+private:
+  SharedMemoryRegion region_;
+  const TelemetryLayout *layout_ = nullptr;
+  uint64_t cursor_ = 0;
+  uint64_t dropped_ = 0;
+};
+
+} // namespace WindowsAiMic
@@ -0,0 +1,569 @@
+/**
+ * WindowsAiMic - IPC Transport Implementation
+ */
+
+#include "transport.h"
+#include "../diagnostics/logger.h"
+#include "../diagnostics/tracer.h"
+
+#include <atomic>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <unordered_map>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr size_t READ_CHUNK = 64 * 1024;
+constexpr int READ_CHUNKS_PER_WAKE = 16; // Then other clients get a turn
+
+// Run the handler over every complete frame in the decoder
+void dispatchFrames(FrameDecoder &decoder, uint32_t clientId,
+                    const IpcTransport::FrameHandler &handler,
+                    std::vector<uint8_t> &output) {
+  Frame frame;
+  while (decoder.next(frame)) {
+    handler(clientId, frame, output);
+  }
+}
+
+#ifdef _WIN32
+
+// ============================================================================
+// Overlapped named pipes (Windows)
+// ============================================================================
+
+class NamedPipeTransport : public IpcTransport {
+public:
+  explicit NamedPipeTransport(std::string path) : path_(std::move(path)) {}
+  ~NamedPipeTransport() override { stop(); }
+
+  bool start(FrameHandler handler) override;
+  void stop() override;
+  size_t clientCount() const override { return clients_.load(); }
+
+private:
+  enum class State { Connecting, Reading, Writing };
+
+  // One pipe instance per potential client
+  struct Instance {
+    HANDLE pipe = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped = {};
+    State state = State::Connecting;
+    bool pending = false; // Overlapped operation outstanding
+    bool connected = false;
+    uint32_t clientId = 0;
+    FrameDecoder decoder;
+    std::vector<uint8_t> readBuffer;
+    std::vector<uint8_t> output;
+  };
+
+  void serverThread();
+  bool listen(Instance &instance);
+  void resume(Instance &instance);
+  void disconnect(Instance &instance);
+
+  std::string path_;
+  FrameHandler handler_;
+  Instance instances_[MAX_CLIENTS];
+  HANDLE stopEvent_ = nullptr;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<size_t> clients_{0};
+  uint32_t nextClientId_ = 1;
+};
+
+bool NamedPipeTransport::start(FrameHandler handler) {
+  if (running_.load()) {
+    return true;
+  }
+  handler_ = std::move(handler);
+
+  stopEvent_ = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+  for (Instance &instance : instances_) {
+    instance.pipe = CreateNamedPipeA(
+        path_.c_str(), PIPE_ACCESS_DUPLEX | FILE_FLAG_OVERLAPPED,
+        PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
+        static_cast<DWORD>(MAX_CLIENTS), static_cast<DWORD>(READ_CHUNK),
+        static_cast<DWORD>(READ_CHUNK), 0, nullptr);
+    if (instance.pipe == INVALID_HANDLE_VALUE) {
+      WAM_LOG_ERROR("Failed to create named pipe: %lu",
+                    static_cast<unsigned long>(GetLastError()));
+      stop();
+      return false;
+    }
+    instance.overlapped.hEvent = CreateEventA(nullptr, TRUE, TRUE, nullptr);
+    instance.readBuffer.resize(READ_CHUNK);
+    if (!listen(instance)) {
+      stop();
+      return false;
+    }
+  }
+
+  running_ = true;
+  thread_ = std::thread(&NamedPipeTransport::serverThread, this);
+  return true;
+}
+
+void NamedPipeTransport::stop() {
+  if (running_.exchange(false)) {
+    SetEvent(stopEvent_);
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  for (Instance &instance : instances_) {
+    if (instance.pipe != INVALID_HANDLE_VALUE) {
+      CancelIoEx(instance.pipe, nullptr);
+      DisconnectNamedPipe(instance.pipe);
+      CloseHandle(instance.pipe);
+      instance.pipe = INVALID_HANDLE_VALUE;
+    }
+    if (instance.overlapped.hEvent) {
+      CloseHandle(instance.overlapped.hEvent);
+      instance.overlapped.hEvent = nullptr;
+    }
+    instance.connected = false;
+  }
+  if (stopEvent_) {
+    CloseHandle(stopEvent_);
+    stopEvent_ = nullptr;
+  }
+  clients_ = 0;
+}
+
+bool NamedPipeTransport::listen(Instance &instance) {
+  instance.state = State::Connecting;
+  instance.decoder = FrameDecoder();
+  instance.output.clear();
+
+  // An overlapped ConnectNamedPipe always returns FALSE
+  ConnectNamedPipe(instance.pipe, &instance.overlapped);
+  switch (GetLastError()) {
+  case ERROR_IO_PENDING:
+    instance.pending = true;
+    return true;
+  case ERROR_PIPE_CONNECTED:
+    // Client slipped in between create and connect
+    instance.pending = false;
+    SetEvent(instance.overlapped.hEvent);
+    return true;
+  default:
+    WAM_LOG_ERROR("ConnectNamedPipe failed: %lu",
+                  static_cast<unsigned long>(GetLastError()));
+    return false;
+  }
+}
+
+void NamedPipeTransport::disconnect(Instance &instance) {
+  if (instance.connected) {
+    instance.connected = false;
+    --clients_;
+  }
+  DisconnectNamedPipe(instance.pipe);
+  listen(instance);
+}
+
+// Issue the next write (if output is queued) or read
+void NamedPipeTransport::resume(Instance &instance) {
+  BOOL issued;
+  if (!instance.output.empty()) {
+    instance.state = State::Writing;
+    issued = WriteFile(instance.pipe, instance.output.data(),
+                       static_cast<DWORD>(instance.output.size()), nullptr,
+                       &instance.overlapped);
+  } else {
+    instance.state = State::Reading;
+    issued = ReadFile(instance.pipe, instance.readBuffer.data(),
+                      static_cast<DWORD>(instance.readBuffer.size()), nullptr,
+                      &instance.overlapped);
+  }
+
+  // Synchronous completion still signals the event
+  if (!issued && GetLastError() != ERROR_IO_PENDING) {
+    disconnect(instance);
+    return;
+  }
+  instance.pending = true;
+}
+
+void NamedPipeTransport::serverThread() {
+  Logger::instance().registerThread("IpcServer");
+  Tracer::instance().registerThread("IpcServer");
+
+  HANDLE events[MAX_CLIENTS + 1];
+  for (size_t i = 0; i < MAX_CLIENTS; ++i) {
+    events[i] = instances_[i].overlapped.hEvent;
+  }
+  events[MAX_CLIENTS] = stopEvent_;
+
+  while (running_.load()) {
+    const DWORD result = WaitForMultipleObjects(
+        static_cast<DWORD>(MAX_CLIENTS + 1), events, FALSE, INFINITE);
+    if (result >= WAIT_OBJECT_0 + MAX_CLIENTS) {
+      break; // Stop requested (or the wait itself failed)
+    }
+
+    Instance &instance = instances_[result - WAIT_OBJECT_0];
+    DWORD transferred = 0;
+    BOOL ok = TRUE;
+    if (instance.pending) {
+      ok = GetOverlappedResult(instance.pipe, &instance.overlapped,
+                               &transferred, FALSE);
+      instance.pending = false;
+    }
+
+    switch (instance.state) {
+    case State::Connecting:
+      if (!ok) {
+        DisconnectNamedPipe(instance.pipe);
+        listen(instance);
+        break;
+      }
+      instance.connected = true;
+      instance.clientId = nextClientId_++;
+      ++clients_;
+      resume(instance);
+      break;
+
+    case State::Reading:
+      if (!ok || transferred == 0) {
+        disconnect(instance);
+        break;
+      }
+      instance.decoder.feed(instance.readBuffer.data(), transferred);
+      dispatchFrames(instance.decoder, instance.clientId, handler_,
+                     instance.output);
+      if (instance.decoder.failed() ||
+          instance.decoder.buffered() > MAX_PENDING_INPUT ||
+          instance.output.size() > MAX_PENDING_OUTPUT) {
+        disconnect(instance);
+        break;
+      }
+      resume(instance);
+      break;
+
+    case State::Writing:
+      if (!ok) {
+        disconnect(instance);
+        break;
+      }
+      instance.output.erase(instance.output.begin(),
+                            instance.output.begin() + transferred);
+      resume(instance);
+      break;
+    }
+  }
+}
+
+#else
+
+// ============================================================================
+// epoll + Unix domain socket (Linux)
+// ============================================================================
+
+class UnixSocketTransport : public IpcTransport {
+public:
+  explicit UnixSocketTransport(std::string path) : path_(std::move(path)) {}
+  ~UnixSocketTransport() override { stop(); }
+
+  bool start(FrameHandler handler) override;
+  void stop() override;
+  size_t clientCount() const override { return clients_.load(); }
+
+private:
+  struct Client {
+    uint32_t id = 0;
+    FrameDecoder decoder;
+    std::vector<uint8_t> output;
+    bool wantsWrite = false;
+  };
+
+  void serverThread();
+  void acceptClients();
+  void readClient(int fd, Client &client);
+  bool flushClient(int fd, Client &client);
+  void closeClient(int fd);
+
+  std::string path_;
+  FrameHandler handler_;
+  int listenFd_ = -1;
+  int epollFd_ = -1;
+  int wakeFd_ = -1;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<size_t> clients_{0};
+  std::unordered_map<int, Client> clientMap_; // Transport thread only
+  uint32_t nextClientId_ = 1;
+};
+
+bool UnixSocketTransport::start(FrameHandler handler) {
+  if (running_.load()) {
+    return true;
+  }
+  handler_ = std::move(handler);
+
+  sockaddr_un address = {};
+  address.sun_family = AF_UNIX;
+  if (path_.size() >= sizeof(address.sun_path)) {
+    WAM_LOG_ERROR("IPC socket path too long: %s", path_.c_str());
+    return false;
+  }
+  std::memcpy(address.sun_path, path_.c_str(), path_.size() + 1);
+
+  listenFd_ = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+  if (listenFd_ < 0) {
+    WAM_LOG_ERROR("Failed to create IPC socket: %s", std::strerror(errno));
+    return false;
+  }
+
+  // A stale socket file from a crashed engine would make bind fail. The
+  // socket file is created owner-only: a chmod after bind would leave it
+  // open to other local users until then.
+  unlink(path_.c_str());
+  const mode_t previousMask = umask(0177);
+  const bool bound = bind(listenFd_, reinterpret_cast<sockaddr *>(&address),
+                          sizeof(address)) == 0;
+  const int bindError = errno;
+  umask(previousMask);
+  if (!bound || listen(listenFd_, static_cast<int>(MAX_CLIENTS)) != 0) {
+    WAM_LOG_ERROR("Failed to listen on %s: %s", path_.c_str(),
+                  std::strerror(bound ? errno : bindError));
+    stop();
+    return false;
+  }
+
+  epollFd_ = epoll_create1(EPOLL_CLOEXEC);
+  wakeFd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (epollFd_ < 0 || wakeFd_ < 0) {
+    WAM_LOG_ERROR("Failed to set up epoll: %s", std::strerror(errno));
+    stop();
+    return false;
+  }
+
+  epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = listenFd_;
+  epoll_ctl(epollFd_, EPOLL_CTL_ADD, listenFd_, &event);
+  event.data.fd = wakeFd_;
+  epoll_ctl(epollFd_, EPOLL_CTL_ADD, wakeFd_, &event);
+
+  running_ = true;
+  thread_ = std::thread(&UnixSocketTransport::serverThread, this);
+  return true;
+}
+
+void UnixSocketTransport::stop() {
+  if (running_.exchange(false)) {
+    const uint64_t one = 1;
+    [[maybe_unused]] ssize_t written = write(wakeFd_, &one, sizeof(one));
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  for (auto &entry : clientMap_) {
+    close(entry.first);
+  }
+  clientMap_.clear();
+  clients_ = 0;
+
+  if (listenFd_ >= 0) {
+    close(listenFd_);
+    listenFd_ = -1;
+    unlink(path_.c_str());
+  }
+  if (epollFd_ >= 0) {
+    close(epollFd_);
+    epollFd_ = -1;
+  }
+  if (wakeFd_ >= 0) {
+    close(wakeFd_);
+    wakeFd_ = -1;
+  }
+}
+
+void UnixSocketTransport::serverThread() {
+  Logger::instance().registerThread("IpcServer");
+  Tracer::instance().registerThread("IpcServer");
+
+  epoll_event events[64];
+  while (running_.load()) {
+    const int count = epoll_wait(epollFd_, events, 64, -1);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      WAM_LOG_ERROR("epoll_wait failed: %s", std::strerror(errno));
+      break;
+    }
+
+    for (int i = 0; i < count; ++i) {
+      const int fd = events[i].data.fd;
+      if (fd == wakeFd_) {
+        continue; // running_ is re-checked by the loop
+      }
+      if (fd == listenFd_) {
+        acceptClients();
+        continue;
+      }
+
+      auto it = clientMap_.find(fd);
+      if (it == clientMap_.end()) {
+        continue;
+      }
+      if (events[i].events & EPOLLERR) {
+        closeClient(fd);
+        continue;
+      }
+      // A client that sent its last frames and hung up still gets them
+      // handled: readable data is read first, and the read that reaches
+      // the end of the stream closes the client
+      if (events[i].events & EPOLLIN) {
+        readClient(fd, it->second);
+        if (clientMap_.find(fd) == clientMap_.end()) {
+          continue;
+        }
+      } else if (events[i].events & EPOLLHUP) {
+        closeClient(fd);
+        continue;
+      }
+      if (events[i].events & EPOLLOUT) {
+        if (!flushClient(fd, it->second)) {
+          closeClient(fd);
+        }
+      }
+    }
+  }
+}
+
+void UnixSocketTransport::acceptClients() {
+  while (true) {
+    const int fd = accept4(listenFd_, nullptr, nullptr,
+                           SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (fd < 0) {
+      return; // EAGAIN: accepted everything pending
+    }
+    if (clientMap_.size() >= MAX_CLIENTS) {
+      WAM_LOG_WARNING("IPC client rejected: %zu clients connected",
+                      clientMap_.size());
+      close(fd);
+      continue;
+    }
+
+    epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(epollFd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+      close(fd);
+      continue;
+    }
+
+    Client &client = clientMap_[fd];
+    client.id = nextClientId_++;
+    ++clients_;
+  }
+}
+
+void UnixSocketTransport::readClient(int fd, Client &client) {
+  // Frames are handled chunk by chunk, and a client that keeps writing
+  // gives up the thread after a few chunks (epoll reports it again)
+  uint8_t buffer[READ_CHUNK];
+  bool hungUp = false;
+  for (int chunk = 0; chunk < READ_CHUNKS_PER_WAKE;) {
+    const ssize_t received = recv(fd, buffer, sizeof(buffer), 0);
+    if (received < 0 && errno == EINTR) {
+      continue;
+    }
+    if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    if (received <= 0) {
+      hungUp = true;
+      break;
+    }
+
+    client.decoder.feed(buffer, static_cast<size_t>(received));
+    dispatchFrames(client.decoder, client.id, handler_, client.output);
+    if (client.decoder.failed() ||
+        client.decoder.buffered() > MAX_PENDING_INPUT ||
+        client.output.size() > MAX_PENDING_OUTPUT) {
+      closeClient(fd);
+      return;
+    }
+    ++chunk;
+  }
+
+  // Replies to the last frames still go out before a hang-up closes
+  if (!flushClient(fd, client) || hungUp) {
+    closeClient(fd);
+  }
+}
+
+bool UnixSocketTransport::flushClient(int fd, Client &client) {
+  size_t sent = 0;
+  while (sent < client.output.size()) {
+    const ssize_t n = send(fd, client.output.data() + sent,
+                           client.output.size() - sent, MSG_NOSIGNAL);
+    if (n > 0) {
+      sent += static_cast<size_t>(n);
+      continue;
+    }
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    }
+    return false;
+  }
+  client.output.erase(client.output.begin(), client.output.begin() + sent);
+
+  // Only ask for EPOLLOUT while something is queued
+  const bool wantsWrite = !client.output.empty();
+  if (wantsWrite != client.wantsWrite) {
+    epoll_event event = {};
+    event.events = EPOLLIN | (wantsWrite ? EPOLLOUT : 0u);
+    event.data.fd = fd;
+    epoll_ctl(epollFd_, EPOLL_CTL_MOD, fd, &event);
+    client.wantsWrite = wantsWrite;
+  }
+  return true;
+}
+
+void UnixSocketTransport::closeClient(int fd) {
+  epoll_ctl(epollFd_, EPOLL_CTL_DEL, fd, nullptr);
+  close(fd);
+  if (clientMap_.erase(fd) > 0) {
+    --clients_;
+  }
+}
+
+#endif
+
+} // namespace
+
+std::unique_ptr<IpcTransport> IpcTransport::create(const std::string &name) {
+#ifdef _WIN32
+  return std::make_unique<NamedPipeTransport>(ipcEndpointPath(name));
+#else
+  return std::make_unique<UnixSocketTransport>(ipcEndpointPath(name));
+#endif
+}
+
+} // namespace WindowsAiMic
@@ -0,0 +1,66 @@
+/**
+ * WindowsAiMic - IPC Transport Header
+ *
+ * Byte-stream server transports for the control protocol. One event-loop
+ * thread serves every client without blocking on any of them: overlapped
+ * named pipes on Windows, epoll on a Unix domain socket elsewhere.
+ */
+
+#pragma once
+
+#include "protocol.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Multi-client frame server
+ */
+class IpcTransport {
+public:
+  /**
+   * Called on the transport thread for each complete frame
+   * @param clientId Stable for the life of the connection
+   * @param reply Encoded frames to send back (append, may stay empty)
+   */
+  using FrameHandler = std::function<void(
+      uint32_t clientId, const Frame &frame, std::vector<uint8_t> &reply)>;
+
+  virtual ~IpcTransport() = default;
+
+  /**
+   * Start listening and serving
+   * @return true on success
+   */
+  virtual bool start(FrameHandler handler) = 0;
+
+  /**
+   * Disconnect all clients and stop the thread
+   */
+  virtual void stop() = 0;
+
+  /**
+   * Currently connected clients
+   */
+  virtual size_t clientCount() const = 0;
+
+  /**
+   * Transport for this platform
+   * @param name Endpoint name (see ipcEndpointPath)
+   */
+  static std::unique_ptr<IpcTransport> create(const std::string &name);
+
+  static constexpr size_t MAX_CLIENTS = 16;
+  static constexpr size_t MAX_PENDING_OUTPUT = 4 * 1024 * 1024; // Per client
+  // Undecoded input per client: room for one largest frame plus the
+  // start of the next; a client past it is writing garbage or flooding
+  static constexpr size_t MAX_PENDING_INPUT = 2 * 1024 * 1024;
+};
+
+} // namespace WindowsAiMic
@@ -19,19 +19,18 @@
 
 #include "engine.h"
 #include "config/config_manager.h"
+#include "diagnostics/logger.h"
 
 namespace {
+    // The only thing the signal handler touches; the main loop does the rest
     std::atomic<bool> g_running{true};
-    WindowsAiMic::Engine* g_engine = nullptr;
+    static_assert(std::atomic<bool>::is_always_lock_free,
+                  "g_running must be async-signal-safe");
 }
 
 void signalHandler(int signal) {
     if (signal == SIGINT || signal == SIGTERM) {
-        std::cout << "\nShutdown signal received..." << std::endl;
-        g_running = false;
-        if (g_engine) {
-            g_engine->stop();
-        }
+        g_running.store(false);
     }
 }
 
@@ -51,12 +50,15 @@ void printUsage(const char* programName) {
               << "  --help, -h          Show this help message\n"
               << "  --background, -b    Run in background mode (no console)\n"
               << "  --config <path>     Path to configuration file\n"
+              << "  --log-file <path>   Also write the log to a file\n"
+              << "  --verbose           Enable debug logging\n"
               << "  --list-devices      List available audio devices\n"
               << "  --version, -v       Show version information\n"
               << std::endl;
 }
 
-bool parseArguments(int argc, char* argv[], std::string& configPath, bool& background, bool& listDevices) {
+bool parseArguments(int argc, char* argv[], std::string& configPath, bool& background, bool& listDevices,
+                    std::string& logFile, bool& verbose) {
     for (int i = 1; i < argc; ++i) {
         std::string arg = argv[i];
         
@@ -77,6 +79,12 @@ bool parseArguments(int argc, char* argv[], std::string& configPath, bool& backg
         else if (arg == "--config" && i + 1 < argc) {
             configPath = argv[++i];
         }
+        else if (arg == "--log-file" && i + 1 < argc) {
+            logFile = argv[++i];
+        }
+        else if (arg == "--verbose") {
+            verbose = true;
+        }
         else {
             std::cerr << "Unknown argument: " << arg << std::endl;
             printUsage(argv[0]);
@@ -91,8 +99,10 @@ int main(int argc, char* argv[]) {
     std::string configPath = "config.json";
     bool background = false;
     bool listDevices = false;
+    std::string logFile;
+    bool verbose = false;
     
-    if (!parseArguments(argc, argv, configPath, background, listDevices)) {
+    if (!parseArguments(argc, argv, configPath, background, listDevices, logFile, verbose)) {
         return 0;
     }
     
@@ -109,13 +119,14 @@ int main(int argc, char* argv[]) {
     // Initialize COM for WASAPI
     HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
     if (FAILED(hr)) {
-        std::cerr << "Failed to initialize COM: 0x" << std::hex << hr << std::endl;
+        WAM_LOG_ERROR("Failed to initialize COM: 0x%08lx", static_cast<unsigned long>(hr));
         return 1;
     }
     
     // If running in background mode on Windows, hide console
     if (background) {
         FreeConsole();
+        WindowsAiMic::Logger::instance().setConsoleOutput(false);
     }
 #endif
     
@@ -123,18 +134,26 @@ int main(int argc, char* argv[]) {
         // Load configuration
         WindowsAiMic::ConfigManager configManager;
         if (!configManager.load(configPath)) {
-            std::cerr << "Failed to load configuration from: " << configPath << std::endl;
-            std::cout << "Using default configuration..." << std::endl;
+            WAM_LOG_ERROR("Failed to load configuration from: %s", configPath.c_str());
+            WAM_LOG_INFO("Using default configuration...");
             configManager.loadDefaults();
         }
         
+        // Start the background log writer; audio threads only ever enqueue
+        const auto& diagnostics = configManager.getConfig().diagnostics;
+        auto& logger = WindowsAiMic::Logger::instance();
+        logger.setLevel(verbose ? WindowsAiMic::LogLevel::Debug
+                                : WindowsAiMic::parseLogLevel(diagnostics.logLevel));
+        logger.start(logFile.empty() ? diagnostics.logFile : logFile);
+        logger.registerThread("Main");
+        
         // Create and initialize engine
         WindowsAiMic::Engine engine(configManager);
-        g_engine = &engine;
         
         // List devices if requested
         if (listDevices) {
             engine.listAudioDevices();
+            logger.stop();
 #ifdef _WIN32
             CoUninitialize();
 #endif
@@ -143,15 +162,16 @@ int main(int argc, char* argv[]) {
         
         // Initialize engine
         if (!engine.initialize()) {
-            std::cerr << "Failed to initialize audio engine" << std::endl;
+            WAM_LOG_ERROR("Failed to initialize audio engine");
+            logger.stop();
 #ifdef _WIN32
             CoUninitialize();
 #endif
             return 1;
         }
         
-        std::cout << "Audio engine initialized successfully" << std::endl;
-        std::cout << "Processing audio... Press Ctrl+C to stop." << std::endl;
+        WAM_LOG_INFO("Audio engine initialized successfully");
+        WAM_LOG_INFO("Processing audio... Press Ctrl+C to stop.");
         
         // Start processing
         engine.start();
@@ -160,15 +180,22 @@ int main(int argc, char* argv[]) {
         while (g_running && engine.isRunning()) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
+        if (!g_running) {
+            WAM_LOG_INFO("Shutdown signal received...");
+        }
         
         // Cleanup
-        std::cout << "Stopping audio engine..." << std::endl;
+        WAM_LOG_INFO("Stopping audio engine...");
         engine.stop();
         
-        g_engine = nullptr;
+        // Write out any settings change still inside the debounce window
+        configManager.flush();
+        
+        logger.stop();
         
     } catch (const std::exception& e) {
-        std::cerr << "Fatal error: " << e.what() << std::endl;
+        WindowsAiMic::Logger::instance().stop();
+        WAM_LOG_ERROR("Fatal error: %s", e.what());
 #ifdef _WIN32
         CoUninitialize();
 #endif
@@ -179,6 +206,6 @@ int main(int argc, char* argv[]) {
     CoUninitialize();
 #endif
     
-    std::cout << "WindowsAiMic shut down cleanly." << std::endl;
+    WAM_LOG_INFO("WindowsAiMic shut down cleanly.");
     return 0;
 }
@@ -0,0 +1,175 @@
+/**
+ * WindowsAiMic - Audio Arena Implementation
+ */
+
+#include "audio_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+size_t roundUp(size_t value, size_t multiple) {
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+} // namespace
+
+AudioArena::AudioArena(size_t capacity)
+    : capacity_(roundUp(std::max<size_t>(capacity, CACHE_LINE_SIZE),
+                        CACHE_LINE_SIZE)),
+      block_(allocateBlock()), monotonic_(block_, capacity_, &overflow_),
+      aligned_(&monotonic_) {}
+
+AudioArena::~AudioArena() {
+  monotonic_.release();
+  freeBlock();
+}
+
+bool AudioArena::contains(const void *pointer) const {
+  const auto *byte = static_cast<const uint8_t *>(pointer);
+  const auto *start = static_cast<const uint8_t *>(block_);
+  return byte >= start && byte < start + capacity_;
+}
+
+std::string AudioArena::describe() const {
+  char text[160];
+  std::snprintf(text, sizeof(text), "%zu of %zu KiB used%s%s%s",
+                used() / 1024, capacity_ / 1024, locked_ ? ", locked" : "",
+                hugePages_ ? ", huge pages" : "",
+                overflowBytes() > 0 ? ", OVERFLOWED to heap" : "");
+  return text;
+}
+
+// ============================================================================
+// Block allocation
+// ============================================================================
+
+void *AudioArena::allocateBlock() {
+  void *block = nullptr;
+
+#ifdef _WIN32
+  // Large pages need SeLockMemoryPrivilege; they are locked by nature
+  const SIZE_T largePage = GetLargePageMinimum();
+  if (largePage > 0) {
+    const size_t size = roundUp(capacity_, largePage);
+    block = VirtualAlloc(nullptr, size,
+                         MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+                         PAGE_READWRITE);
+    if (block) {
+      mappedSize_ = size;
+      hugePages_ = true;
+      locked_ = true;
+    }
+  }
+  if (!block) {
+    block = VirtualAlloc(nullptr, capacity_, MEM_RESERVE | MEM_COMMIT,
+                         PAGE_READWRITE);
+    if (block) {
+      mappedSize_ = capacity_;
+    }
+  }
+#else
+  // Map one huge page more than needed and trim to a 2 MiB boundary so
+  // transparent huge pages can back the whole block
+  const size_t size = roundUp(capacity_, HUGE_PAGE_SIZE);
+  void *raw = mmap(nullptr, size + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw != MAP_FAILED) {
+    const auto address = reinterpret_cast<uintptr_t>(raw);
+    const uintptr_t start = roundUp(address, HUGE_PAGE_SIZE);
+    const size_t head = start - address;
+    if (head > 0) {
+      munmap(raw, head);
+    }
+    munmap(reinterpret_cast<void *>(start + size), HUGE_PAGE_SIZE - head);
+    block = reinterpret_cast<void *>(start);
+    mappedSize_ = size;
+#ifdef MADV_HUGEPAGE
+    hugePages_ = madvise(block, size, MADV_HUGEPAGE) == 0;
+#endif
+  }
+#endif
+
+  if (!block) {
+    block = ::operator new(capacity_, std::align_val_t{CACHE_LINE_SIZE});
+  }
+
+  // Prefault every page, then pin them
+  std::memset(block, 0, mappedSize_ > 0 ? mappedSize_ : capacity_);
+  if (!locked_) {
+#ifdef _WIN32
+    // VirtualLock is bounded by the minimum working set
+    SIZE_T minimum = 0;
+    SIZE_T maximum = 0;
+    if (GetProcessWorkingSetSize(GetCurrentProcess(), &minimum, &maximum)) {
+      SetProcessWorkingSetSize(GetCurrentProcess(), minimum + capacity_,
+                               maximum + capacity_);
+    }
+    locked_ = VirtualLock(block, capacity_) != 0;
+#else
+    locked_ = mlock(block, capacity_) == 0;
+#endif
+  }
+  return block;
+}
+
+void AudioArena::freeBlock() {
+  if (!block_) {
+    return;
+  }
+  if (mappedSize_ == 0) {
+    ::operator delete(block_, std::align_val_t{CACHE_LINE_SIZE});
+  } else {
+#ifdef _WIN32
+    VirtualFree(block_, 0, MEM_RELEASE);
+#else
+    munmap(block_, mappedSize_);
+#endif
+  }
+  block_ = nullptr;
+}
+
+// ============================================================================
+// Resources
+// ============================================================================
+
+void *AudioArena::OverflowResource::do_allocate(size_t bytes,
+                                                size_t alignment) {
+  bytes_ += bytes;
+  return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void AudioArena::OverflowResource::do_deallocate(void *pointer, size_t bytes,
+                                                 size_t alignment) {
+  std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+}
+
+void *AudioArena::AlignedResource::do_allocate(size_t bytes,
+                                               size_t alignment) {
+  const size_t rounded = roundUp(std::max<size_t>(bytes, 1), CACHE_LINE_SIZE);
+  used_ += rounded;
+  return upstream_->allocate(rounded, std::max(alignment, CACHE_LINE_SIZE));
+}
+
+void AudioArena::AlignedResource::do_deallocate(void *pointer, size_t bytes,
+                                                size_t alignment) {
+  upstream_->deallocate(pointer,
+                        roundUp(std::max<size_t>(bytes, 1), CACHE_LINE_SIZE),
+                        std::max(alignment, CACHE_LINE_SIZE));
+}
+
+} // namespace WindowsAiMic
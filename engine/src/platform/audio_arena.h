@@ -0,0 +1,127 @@
+/**
+ * WindowsAiMic - Audio Arena Header
+ *
+ * One contiguous block for the processing chain's state and scratch
+ * buffers. The block is locked, prefaulted and huge-page eligible, and a
+ * std::pmr monotonic resource hands it out in allocation order with
+ * cache-line alignment, so one block's work walks memory front to back.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <utility>
+
+namespace WindowsAiMic {
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * Deleter for objects placed in an AudioArena
+ * Runs the destructor only; the memory goes back with the arena.
+ */
+template <typename T> struct ArenaDeleter {
+  void operator()(T *object) const { object->~T(); }
+};
+
+template <typename T> using ArenaPtr = std::unique_ptr<T, ArenaDeleter<T>>;
+
+/**
+ * Monotonic arena over a locked, prefaulted block
+ *
+ * Allocations past the end fall back to the heap (counted in
+ * overflowBytes()); size the arena so that never happens. Not
+ * thread-safe: allocate during setup, before the audio threads start.
+ * Objects made with make() must be destroyed before the arena.
+ */
+class AudioArena {
+public:
+  explicit AudioArena(size_t capacity);
+  ~AudioArena();
+
+  // Non-copyable
+  AudioArena(const AudioArena &) = delete;
+  AudioArena &operator=(const AudioArena &) = delete;
+
+  /**
+   * Resource for std::pmr containers; every allocation is rounded up to
+   * whole cache lines
+   */
+  std::pmr::memory_resource *resource() { return &aligned_; }
+
+  /**
+   * Construct an object in the arena
+   */
+  template <typename T, typename... Args> ArenaPtr<T> make(Args &&...args) {
+    void *memory = aligned_.allocate(sizeof(T), alignof(T));
+    return ArenaPtr<T>(new (memory) T(std::forward<Args>(args)...));
+  }
+
+  /** True if `pointer` lies inside the block */
+  bool contains(const void *pointer) const;
+
+  size_t capacity() const { return capacity_; }
+  size_t used() const { return aligned_.used(); }
+  size_t overflowBytes() const { return overflow_.bytes(); }
+  bool isLocked() const { return locked_; }
+  bool hasHugePages() const { return hugePages_; }
+
+  /** One-line summary for the log */
+  std::string describe() const;
+
+private:
+  // Heap fallback that counts what it hands out
+  class OverflowResource : public std::pmr::memory_resource {
+  public:
+    size_t bytes() const { return bytes_; }
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes,
+                       size_t alignment) override;
+    bool do_is_equal(const memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+
+    size_t bytes_ = 0;
+  };
+
+  // Rounds sizes and alignment up to the cache line
+  class AlignedResource : public std::pmr::memory_resource {
+  public:
+    explicit AlignedResource(std::pmr::memory_resource *upstream)
+        : upstream_(upstream) {}
+    size_t used() const { return used_; }
+
+  private:
+    void *do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void *pointer, size_t bytes,
+                       size_t alignment) override;
+    bool do_is_equal(const memory_resource &other) const noexcept override {
+      return this == &other;
+    }
+
+    std::pmr::memory_resource *upstream_;
+    size_t used_ = 0;
+  };
+
+  void *allocateBlock();
+  void freeBlock();
+
+  // allocateBlock() sets these, so they precede block_
+  size_t capacity_;
+  size_t mappedSize_ = 0; // What freeBlock() releases; 0 = heap block
+  bool locked_ = false;
+  bool hugePages_ = false;
+  void *block_ = nullptr;
+
+  OverflowResource overflow_;
+  std::pmr::monotonic_buffer_resource monotonic_;
+  AlignedResource aligned_;
+};
+
+} // namespace WindowsAiMic
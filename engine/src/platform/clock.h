@@ -0,0 +1,30 @@
+/**
+ * WindowsAiMic - Clock
+ *
+ * Steady-clock timestamps in nanoseconds, the time base shared by the
+ * engine, its diagnostics and the shared-memory channels.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+/**
+ * Nanoseconds since the steady clock's epoch
+ */
+inline uint64_t toNs(std::chrono::steady_clock::time_point time) {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          time.time_since_epoch())
+          .count());
+}
+
+/**
+ * Current steady-clock time in nanoseconds
+ */
+inline uint64_t nowNs() { return toNs(std::chrono::steady_clock::now()); }
+
+} // namespace WindowsAiMic
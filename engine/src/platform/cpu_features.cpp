@@ -3,10 +3,11 @@
  */
 
 #include "cpu_features.h"
+#include "cpu_topology.h"
+#include "../diagnostics/logger.h"
+
 #include <cstring>
-#include <iostream>
-#include <thread>
-#include <vector>
+#include <algorithm>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -106,127 +107,43 @@ void CPUFeatures::detect() {
     brand_ = brandStr;
   }
 
-  // Get core counts
-  logicalCores_ = std::thread::hardware_concurrency();
-
-#ifdef _WIN32
-  DWORD length = 0;
-  GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
-
-  if (length > 0) {
-    std::vector<char> buffer(length);
-    if (GetLogicalProcessorInformationEx(
-            RelationProcessorCore,
-            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
-                buffer.data()),
-            &length)) {
-
-      physicalCores_ = 0;
-      char *ptr = buffer.data();
-      while (ptr < buffer.data() + length) {
-        auto *info =
-            reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(ptr);
-        if (info->Relationship == RelationProcessorCore) {
-          physicalCores_++;
-        }
-        ptr += info->Size;
-      }
-    }
-  }
-#else
-  physicalCores_ = logicalCores_ / 2; // Approximate
-#endif
-
-  // Detect Intel hybrid architecture
-  if (isIntel_) {
-    detectIntelHybrid();
-  }
+  // Core counts and hybrid layout
+  detectTopology();
 
   // Detect NPU
   detectNPU();
 
   // Log detected features
-  std::cout << "CPU: " << brand_ << std::endl;
-  std::cout << "  Cores: " << physicalCores_ << " physical, " << logicalCores_
-            << " logical" << std::endl;
-  if (isHybrid_) {
-    std::cout << "  Hybrid: " << pCores_ << " P-cores, " << eCores_
-              << " E-cores" << std::endl;
-  }
-  std::cout << "  SIMD: ";
+  WAM_LOG_INFO("CPU: %s", brand_.c_str());
+  WAM_LOG_INFO("  Topology: %s", CpuTopology::get().describe().c_str());
+  std::string simd;
   if (avx512_)
-    std::cout << "AVX-512 ";
+    simd += "AVX-512 ";
   else if (avx2_)
-    std::cout << "AVX2 ";
+    simd += "AVX2 ";
   else if (avx_)
-    std::cout << "AVX ";
+    simd += "AVX ";
   else if (sse42_)
-    std::cout << "SSE4.2 ";
+    simd += "SSE4.2 ";
   if (fma_)
-    std::cout << "FMA ";
-  std::cout << std::endl;
+    simd += "FMA ";
+  WAM_LOG_INFO("  SIMD: %s", simd.c_str());
 
   if (hasNPU_) {
-    std::cout << "  NPU: Intel Neural Processing Unit detected" << std::endl;
+    WAM_LOG_INFO("  NPU: Intel Neural Processing Unit detected");
   }
 }
 
-void CPUFeatures::detectIntelHybrid() {
-  // Intel Core Ultra processors (Meteor Lake) have hybrid architecture
-  // Check for hybrid architecture support
-
-  int cpuInfo[4] = {0};
-
-#ifdef _WIN32
-  // Check if CPU supports hybrid info leaf
-  __cpuid(cpuInfo, 0);
-  int maxId = cpuInfo[0];
-
-  if (maxId >= 0x1A) {
-    __cpuidex(cpuInfo, 0x1A, 0);
-
-    // Core type is in bits 31:24
-    // If we can query this, it's a hybrid CPU
-    int coreType = (cpuInfo[0] >> 24) & 0xFF;
-
-    if (coreType != 0) {
-      isHybrid_ = true;
-
-      // Count P-cores and E-cores
-      // This requires iterating through all processors
-      DWORD length = 0;
-      GetLogicalProcessorInformationEx(RelationProcessorCore, nullptr, &length);
-
-      if (length > 0) {
-        std::vector<char> buffer(length);
-        if (GetLogicalProcessorInformationEx(
-                RelationProcessorCore,
-                reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
-                    buffer.data()),
-                &length)) {
-
-          // For now, estimate based on typical Intel Core Ultra 7 config
-          // The 165U has: 2 P-cores + 8 E-cores + 2 LP E-cores
-          // We'll use thread counts as approximation
-          pCores_ = 2;
-          eCores_ = 8;
-        }
-      }
-    }
-  }
-#endif
-
-  // Fallback: Check brand string for "Core Ultra" which indicates Meteor Lake
-  if (!isHybrid_ && brand_.find("Core") != std::string::npos &&
-      brand_.find("Ultra") != std::string::npos) {
-    isHybrid_ = true;
-
-    // Intel Core Ultra 7 165U: 2P + 8E + 2LP-E = 12 cores, 14 threads
-    if (brand_.find("165U") != std::string::npos) {
-      pCores_ = 2;
-      eCores_ = 10; // 8E + 2LP-E
-    }
-  }
+void CPUFeatures::detectTopology() {
+  // Per-CPU core types come from CPUID leaf 0x1A and the OS (CPU sets on
+  // Windows, sysfs on Linux); low-power E-cores count as E-cores here
+  const CpuTopology &topology = CpuTopology::get();
+  logicalCores_ = topology.logicalCores();
+  physicalCores_ = topology.physicalCores();
+  isHybrid_ = topology.isHybrid();
+  pCores_ = topology.coreCount(CoreType::Performance);
+  eCores_ = topology.coreCount(CoreType::Efficiency) +
+            topology.coreCount(CoreType::LowPowerEfficiency);
 }
 
 void CPUFeatures::detectNPU() {
@@ -245,21 +162,6 @@ void CPUFeatures::detectNPU() {
 #endif
 }
 
-int CPUFeatures::recommendedBufferSize() const {
-  // Smaller buffer = lower latency, but needs faster CPU
-  // Intel Core Ultra 7 can handle very small buffers
-
-  if (hasNPU_ || (isHybrid_ && pCores_ >= 2)) {
-    return 128; // ~2.7ms at 48kHz - very low latency
-  } else if (avx2_) {
-    return 256; // ~5.3ms at 48kHz
-  } else if (avx_) {
-    return 480; // 10ms - RNNoise native
-  } else {
-    return 512; // ~10.7ms - safe default
-  }
-}
-
 int CPUFeatures::recommendedThreadCount() const {
   if (isHybrid_) {
     // Use P-cores for audio processing
@@ -54,7 +54,6 @@ public:
   std::string brand() const { return brand_; }
 
   // Recommended settings based on detected CPU
-  int recommendedBufferSize() const;
   int recommendedThreadCount() const;
   bool shouldUseNPU() const;
   bool shouldUseAVX512() const;
@@ -62,7 +61,7 @@ public:
 private:
   CPUFeatures() = default;
   void detect();
-  void detectIntelHybrid();
+  void detectTopology();
   void detectNPU();
 
   static CPUFeatures instance_;
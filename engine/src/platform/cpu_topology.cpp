@@ -0,0 +1,452 @@
+/**
+ * WindowsAiMic - CPU Topology Implementation
+ */
+
+#include "cpu_topology.h"
+#include "thread_utils.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <thread>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#include <filesystem>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+constexpr uint32_t CPUID_HYBRID_BIT = 1u << 15; // Leaf 7.0 EDX
+constexpr uint32_t CORE_TYPE_ATOM = 0x20;       // Leaf 0x1A EAX[31:24]
+constexpr uint32_t CORE_TYPE_CORE = 0x40;
+
+void cpuid(uint32_t leaf, uint32_t subleaf, uint32_t regs[4]) {
+#ifdef _WIN32
+  int info[4] = {0};
+  __cpuidex(info, static_cast<int>(leaf), static_cast<int>(subleaf));
+  for (int i = 0; i < 4; ++i) {
+    regs[i] = static_cast<uint32_t>(info[i]);
+  }
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// True if CPUID reports a hybrid part with the native model ID leaf
+bool cpuidHybrid() {
+  uint32_t regs[4] = {0};
+  cpuid(0, 0, regs);
+  const uint32_t maxLeaf = regs[0];
+  if (maxLeaf < 0x1A) {
+    return false;
+  }
+  cpuid(7, 0, regs);
+  return (regs[3] & CPUID_HYBRID_BIT) != 0;
+}
+
+#ifdef __linux__
+
+std::string readLine(const std::string &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int readInt(const std::string &path, int fallback) {
+  int value = fallback;
+  std::sscanf(readLine(path).c_str(), "%d", &value);
+  return value;
+}
+
+#endif
+
+} // namespace
+
+const char *coreTypeName(CoreType type) {
+  switch (type) {
+  case CoreType::Performance:
+    return "P";
+  case CoreType::Efficiency:
+    return "E";
+  case CoreType::LowPowerEfficiency:
+    return "LP-E";
+  default:
+    return "?";
+  }
+}
+
+std::vector<int> parseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    int first = -1;
+    int last = -1;
+    const int fields = std::sscanf(range.c_str(), "%d-%d", &first, &last);
+    if (fields < 1 || first < 0) {
+      continue;
+    }
+    if (fields == 1) {
+      last = first;
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// ============================================================================
+// Detection
+// ============================================================================
+
+const CpuTopology &CpuTopology::get() {
+  static const CpuTopology topology;
+  return topology;
+}
+
+CpuTopology::CpuTopology() {
+  detectOs();
+  if (cpus_.empty()) {
+    // Unknown OS or no information: one core per logical CPU
+    const int count =
+        std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int id = 0; id < count; ++id) {
+      LogicalCpu cpu;
+      cpu.id = id;
+      cpu.core = id;
+      cpus_.push_back(cpu);
+    }
+  }
+  detectCoreTypes();
+  finish();
+}
+
+#ifdef _WIN32
+
+void CpuTopology::detectOs() {
+  // CPU sets: IDs, core index and efficiency class per logical CPU
+  ULONG length = 0;
+  GetSystemCpuSetInformation(nullptr, 0, &length, GetCurrentProcess(), 0);
+  if (length == 0) {
+    return;
+  }
+  std::vector<uint8_t> buffer(length);
+  if (!GetSystemCpuSetInformation(
+          reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data()),
+          length, &length, GetCurrentProcess(), 0)) {
+    return;
+  }
+
+  int minClass = 255;
+  int maxClass = 0;
+  for (ULONG offset = 0; offset < length;) {
+    const auto *info =
+        reinterpret_cast<const SYSTEM_CPU_SET_INFORMATION *>(buffer.data() +
+                                                             offset);
+    if (info->Type == CpuSetInformation) {
+      LogicalCpu cpu;
+      cpu.id = info->CpuSet.Group * 64 + info->CpuSet.LogicalProcessorIndex;
+      cpu.core = info->CpuSet.Group * 64 + info->CpuSet.CoreIndex;
+      cpu.efficiencyClass = info->CpuSet.EfficiencyClass;
+      cpu.cpuSetId = info->CpuSet.Id;
+      minClass = std::min(minClass, cpu.efficiencyClass);
+      maxClass = std::max(maxClass, cpu.efficiencyClass);
+      cpus_.push_back(cpu);
+    }
+    offset += info->Size;
+  }
+
+  // Distinct efficiency classes: the highest is the P-core class
+  if (maxClass > minClass) {
+    for (LogicalCpu &cpu : cpus_) {
+      cpu.type = cpu.efficiencyClass == maxClass ? CoreType::Performance
+                                                 : CoreType::Efficiency;
+    }
+  }
+
+  // Packages and L2/L3 sharing
+  length = 0;
+  GetLogicalProcessorInformationEx(RelationAll, nullptr, &length);
+  std::vector<uint8_t> relations(length);
+  if (length == 0 ||
+      !GetLogicalProcessorInformationEx(
+          RelationAll,
+          reinterpret_cast<PSYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX>(
+              relations.data()),
+          &length)) {
+    return;
+  }
+
+  auto forEachCpu = [&](const GROUP_AFFINITY &mask, auto &&apply) {
+    for (LogicalCpu &cpu : cpus_) {
+      const int group = cpu.id / 64;
+      const int bit = cpu.id % 64;
+      if (group == mask.Group && (mask.Mask & (KAFFINITY{1} << bit))) {
+        apply(cpu);
+      }
+    }
+  };
+
+  int package = 0;
+  int cacheDomain = 0;
+  for (DWORD offset = 0; offset < length;) {
+    const auto *info =
+        reinterpret_cast<const SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *>(
+            relations.data() + offset);
+    if (info->Relationship == RelationProcessorPackage) {
+      for (WORD i = 0; i < info->Processor.GroupCount; ++i) {
+        forEachCpu(info->Processor.GroupMask[i],
+                   [&](LogicalCpu &cpu) { cpu.package = package; });
+      }
+      ++package;
+    } else if (info->Relationship == RelationCache &&
+               info->Cache.Type != CacheInstruction &&
+               (info->Cache.Level == 2 || info->Cache.Level == 3)) {
+      const int level = info->Cache.Level;
+      forEachCpu(info->Cache.GroupMask, [&](LogicalCpu &cpu) {
+        (level == 2 ? cpu.l2Domain : cpu.l3Domain) = cacheDomain;
+      });
+      ++cacheDomain;
+    }
+    offset += info->Size;
+  }
+}
+
+#elif defined(__linux__)
+
+void CpuTopology::detectOs() {
+  const std::string root = "/sys/devices/system/cpu/";
+  const std::vector<int> pCpus =
+      parseCpuList(readLine("/sys/devices/cpu_core/cpus"));
+  const std::vector<int> eCpus =
+      parseCpuList(readLine("/sys/devices/cpu_atom/cpus"));
+  auto contains = [](const std::vector<int> &list, int cpu) {
+    return std::find(list.begin(), list.end(), cpu) != list.end();
+  };
+
+  for (const int id : parseCpuList(readLine(root + "online"))) {
+    const std::string base = root + "cpu" + std::to_string(id) + "/";
+    LogicalCpu cpu;
+    cpu.id = id;
+    cpu.package = readInt(base + "topology/physical_package_id", 0);
+
+    // core_id is only unique per package; the lowest sibling is not
+    const std::vector<int> siblings =
+        parseCpuList(readLine(base + "topology/thread_siblings_list"));
+    cpu.core = siblings.empty() ? id : siblings.front();
+
+    for (int index = 0;; ++index) {
+      const std::string cache = base + "cache/index" + std::to_string(index);
+      if (!std::filesystem::exists(cache)) {
+        break;
+      }
+      const int level = readInt(cache + "/level", 0);
+      if ((level != 2 && level != 3) ||
+          readLine(cache + "/type") == "Instruction") {
+        continue;
+      }
+      const std::vector<int> shared =
+          parseCpuList(readLine(cache + "/shared_cpu_list"));
+      (level == 2 ? cpu.l2Domain : cpu.l3Domain) =
+          shared.empty() ? id : shared.front();
+    }
+
+    // Hybrid parts expose one perf PMU per core type
+    if (contains(pCpus, id)) {
+      cpu.type = CoreType::Performance;
+    } else if (contains(eCpus, id)) {
+      cpu.type = CoreType::Efficiency;
+    }
+    cpus_.push_back(cpu);
+  }
+}
+
+#else
+
+void CpuTopology::detectOs() {}
+
+#endif
+
+void CpuTopology::detectCoreTypes() {
+  // Leaf 0x1A describes the CPU it runs on, so visit each one from a
+  // helper thread rather than moving the caller around
+  if (!cpuidHybrid()) {
+    return;
+  }
+
+  std::thread probe([this]() {
+    for (LogicalCpu &cpu : cpus_) {
+      if (!setThreadAffinity({cpu.id})) {
+        continue; // Keep what the OS reported
+      }
+      uint32_t regs[4] = {0};
+      cpuid(0x1A, 0, regs);
+      const uint32_t coreType = regs[0] >> 24;
+      if (coreType == CORE_TYPE_CORE) {
+        cpu.type = CoreType::Performance;
+      } else if (coreType == CORE_TYPE_ATOM) {
+        cpu.type = CoreType::Efficiency;
+      }
+    }
+  });
+  probe.join();
+}
+
+void CpuTopology::finish() {
+  std::sort(cpus_.begin(), cpus_.end(),
+            [](const LogicalCpu &a, const LogicalCpu &b) {
+              return a.id < b.id;
+            });
+
+  // Dense core indices in CPU order; SMT index within each core
+  std::map<int, int> coreIndex;
+  std::map<int, int> threadsSeen;
+  for (LogicalCpu &cpu : cpus_) {
+    const auto inserted =
+        coreIndex.emplace(cpu.core, static_cast<int>(coreIndex.size()));
+    cpu.core = inserted.first->second;
+    cpu.smtIndex = threadsSeen[cpu.core]++;
+  }
+  physicalCores_ = static_cast<int>(coreIndex.size());
+
+  // E-cores outside the shared L3 are the low-power island
+  const bool anyL3 =
+      std::any_of(cpus_.begin(), cpus_.end(),
+                  [](const LogicalCpu &cpu) { return cpu.l3Domain >= 0; });
+  bool performance = false;
+  bool efficiency = false;
+  for (LogicalCpu &cpu : cpus_) {
+    if (cpu.type == CoreType::Efficiency && anyL3 && cpu.l3Domain < 0) {
+      cpu.type = CoreType::LowPowerEfficiency;
+    }
+    performance |= cpu.type == CoreType::Performance;
+    efficiency |= cpu.type == CoreType::Efficiency ||
+                  cpu.type == CoreType::LowPowerEfficiency;
+  }
+
+  hybrid_ = performance && efficiency;
+  if (!hybrid_) {
+    for (LogicalCpu &cpu : cpus_) {
+      cpu.type = CoreType::Unknown;
+    }
+  }
+}
+
+// ============================================================================
+// Queries
+// ============================================================================
+
+const LogicalCpu *CpuTopology::cpu(int id) const {
+  for (const LogicalCpu &cpu : cpus_) {
+    if (cpu.id == id) {
+      return &cpu;
+    }
+  }
+  return nullptr;
+}
+
+int CpuTopology::coreCount(CoreType type) const {
+  return static_cast<int>(
+      std::count_if(cpus_.begin(), cpus_.end(), [&](const LogicalCpu &cpu) {
+        return cpu.smtIndex == 0 && cpu.type == type;
+      }));
+}
+
+std::vector<int> CpuTopology::cpusOfType(CoreType type,
+                                         bool primaryOnly) const {
+  std::vector<int> ids;
+  for (const LogicalCpu &cpu : cpus_) {
+    if (cpu.type == type && (!primaryOnly || cpu.smtIndex == 0)) {
+      ids.push_back(cpu.id);
+    }
+  }
+  return ids;
+}
+
+std::vector<int> CpuTopology::smtSiblings(int id) const {
+  std::vector<int> ids;
+  const LogicalCpu *self = cpu(id);
+  if (self == nullptr) {
+    return ids;
+  }
+  for (const LogicalCpu &cpu : cpus_) {
+    if (cpu.core == self->core && cpu.id != id) {
+      ids.push_back(cpu.id);
+    }
+  }
+  return ids;
+}
+
+std::vector<int> CpuTopology::realtimeCpus() const {
+  std::vector<int> ids = cpusOfType(
+      hybrid_ ? CoreType::Performance : CoreType::Unknown, true);
+  if (ids.size() > 1 && ids.front() == 0) {
+    ids.erase(ids.begin());
+  }
+  return ids;
+}
+
+std::vector<int> CpuTopology::workerCpus() const {
+  std::vector<int> ids;
+  for (const LogicalCpu &cpu : cpus_) {
+    if (!hybrid_ || cpu.type == CoreType::Efficiency ||
+        cpu.type == CoreType::LowPowerEfficiency) {
+      ids.push_back(cpu.id);
+    }
+  }
+  return ids;
+}
+
+std::vector<uint32_t>
+CpuTopology::cpuSetIds(const std::vector<int> &ids) const {
+  std::vector<uint32_t> setIds;
+  for (const int id : ids) {
+    const LogicalCpu *entry = cpu(id);
+    if (entry != nullptr && entry->cpuSetId != 0) {
+      setIds.push_back(entry->cpuSetId);
+    }
+  }
+  return setIds;
+}
+
+std::string CpuTopology::describe() const {
+  std::set<int> l3Domains;
+  for (const LogicalCpu &cpu : cpus_) {
+    if (cpu.l3Domain >= 0) {
+      l3Domains.insert(cpu.l3Domain);
+    }
+  }
+
+  std::string text = std::to_string(physicalCores_) + " cores, " +
+                     std::to_string(cpus_.size()) + " threads";
+  if (hybrid_) {
+    for (const CoreType type :
+         {CoreType::Performance, CoreType::Efficiency,
+          CoreType::LowPowerEfficiency}) {
+      const int cores = coreCount(type);
+      if (cores == 0) {
+        continue;
+      }
+      const size_t threads = cpusOfType(type).size();
+      text += " | " + std::to_string(cores) + " " + coreTypeName(type);
+      if (threads != static_cast<size_t>(cores)) {
+        text += " (" + std::to_string(threads) + " threads)";
+      }
+    }
+  }
+  text += " | " + std::to_string(l3Domains.size()) + " L3";
+  return text;
+}
+
+} // namespace WindowsAiMic
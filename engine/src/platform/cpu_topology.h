@@ -0,0 +1,107 @@
+/**
+ * WindowsAiMic - CPU Topology Header
+ *
+ * Per-logical-CPU topology: core type (CPUID leaf 0x1A), physical core and
+ * SMT siblings, L2/L3 sharing, and on Windows the CPU set IDs. Used to
+ * pin real-time threads to P-cores away from each other's SMT siblings
+ * and to keep background work on E-cores.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace WindowsAiMic {
+
+/**
+ * Core type of a logical CPU
+ */
+enum class CoreType : uint8_t {
+  Unknown,            // Not hybrid, or not reported
+  Performance,        // P-core ("Core")
+  Efficiency,         // E-core ("Atom") sharing the L3
+  LowPowerEfficiency, // E-core without L3 (Meteor Lake SoC tile)
+};
+
+const char *coreTypeName(CoreType type);
+
+/**
+ * One logical CPU as the OS numbers it
+ */
+struct LogicalCpu {
+  int id = 0;           // OS logical CPU number (affinity bit)
+  int core = 0;         // Physical core index; SMT siblings share it
+  int package = 0;
+  int smtIndex = 0;     // 0 for the first hardware thread of a core
+  int l2Domain = -1;    // CPUs with the same value share an L2
+  int l3Domain = -1;    // -1 = no L3
+  CoreType type = CoreType::Unknown;
+  int efficiencyClass = 0; // Windows: higher = faster core
+  uint32_t cpuSetId = 0;   // Windows CPU set ID (0 elsewhere)
+};
+
+/**
+ * Parse a kernel CPU list such as "0-3,8,10-11"
+ */
+std::vector<int> parseCpuList(const std::string &list);
+
+/**
+ * Detected CPU topology (process-wide, detected once)
+ */
+class CpuTopology {
+public:
+  static const CpuTopology &get();
+
+  const std::vector<LogicalCpu> &cpus() const { return cpus_; }
+  const LogicalCpu *cpu(int id) const;
+
+  int logicalCores() const { return static_cast<int>(cpus_.size()); }
+  int physicalCores() const { return physicalCores_; }
+  int coreCount(CoreType type) const; // Physical cores of one type
+  bool isHybrid() const { return hybrid_; }
+
+  /**
+   * Logical CPUs of one core type
+   * @param primaryOnly Only the first hardware thread of each core
+   */
+  std::vector<int> cpusOfType(CoreType type, bool primaryOnly = false) const;
+
+  /**
+   * Logical CPUs sharing a physical core with `cpu` (excluding it)
+   */
+  std::vector<int> smtSiblings(int cpu) const;
+
+  /**
+   * CPUs for real-time threads: the first hardware thread of each P-core
+   * (every core when not hybrid), so no two audio threads share a core.
+   * CPU 0 is left out when there is a choice, as it takes most IRQs.
+   */
+  std::vector<int> realtimeCpus() const;
+
+  /**
+   * CPUs for background work: E-cores when hybrid, otherwise all CPUs
+   */
+  std::vector<int> workerCpus() const;
+
+  /**
+   * Windows CPU set IDs for a list of logical CPUs
+   */
+  std::vector<uint32_t> cpuSetIds(const std::vector<int> &cpus) const;
+
+  /** One-line summary for the log */
+  std::string describe() const;
+
+private:
+  CpuTopology();
+  void detectOs();
+  void detectCoreTypes();
+  void finish();
+
+  std::vector<LogicalCpu> cpus_;
+  int physicalCores_ = 0;
+  bool hybrid_ = false;
+};
+
+} // namespace WindowsAiMic
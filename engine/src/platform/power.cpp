@@ -0,0 +1,88 @@
+/**
+ * WindowsAiMic - Power Implementation
+ */
+
+#include "power.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <sys/resource.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+#ifndef _WIN32
+
+std::string readLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+#endif
+
+} // namespace
+
+bool onBatteryPower() {
+#ifdef _WIN32
+  SYSTEM_POWER_STATUS status;
+  if (!GetSystemPowerStatus(&status)) {
+    return false;
+  }
+  return status.ACLineStatus == 0; // 1 = online, 255 = unknown
+#else
+  // /sys/class/power_supply: any online adapter means mains, otherwise a
+  // discharging battery means battery power
+  namespace fs = std::filesystem;
+  std::error_code ec;
+  bool discharging = false;
+  for (const fs::directory_entry &supply :
+       fs::directory_iterator("/sys/class/power_supply", ec)) {
+    const std::string type = readLine(supply.path() / "type");
+    if (type == "Mains" || type == "USB") {
+      if (readLine(supply.path() / "online") == "1") {
+        return false;
+      }
+    } else if (type == "Battery") {
+      discharging = discharging ||
+                    readLine(supply.path() / "status") == "Discharging";
+    }
+  }
+  return discharging;
+#endif
+}
+
+uint64_t processCpuTimeNs() {
+#ifdef _WIN32
+  FILETIME creation, exit, kernel, user;
+  if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel,
+                       &user)) {
+    return 0;
+  }
+  auto ticks = [](const FILETIME &time) {
+    return (static_cast<uint64_t>(time.dwHighDateTime) << 32) |
+           time.dwLowDateTime;
+  };
+  return (ticks(kernel) + ticks(user)) * 100; // 100 ns units
+#else
+  rusage usage{};
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return 0;
+  }
+  auto ns = [](const timeval &time) {
+    return static_cast<uint64_t>(time.tv_sec) * 1000000000ull +
+           static_cast<uint64_t>(time.tv_usec) * 1000ull;
+  };
+  return ns(usage.ru_utime) + ns(usage.ru_stime);
+#endif
+}
+
+} // namespace WindowsAiMic
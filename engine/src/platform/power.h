@@ -0,0 +1,25 @@
+/**
+ * WindowsAiMic - Power Header
+ *
+ * Power source and process CPU time, for the engine's efficiency mode and
+ * its wake-up / CPU cost report.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+namespace WindowsAiMic {
+
+/**
+ * True when running on battery (no AC adapter online, battery
+ * discharging); false on mains or when it cannot be told
+ */
+bool onBatteryPower();
+
+/**
+ * User plus kernel CPU time of the whole process, in nanoseconds
+ */
+uint64_t processCpuTimeNs();
+
+} // namespace WindowsAiMic
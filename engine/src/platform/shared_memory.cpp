@@ -0,0 +1,149 @@
+/**
+ * WindowsAiMic - Shared Memory Implementation
+ */
+
+#include "shared_memory.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+#ifdef _WIN32
+// Per-session namespace: no SeCreateGlobalPrivilege needed
+std::string platformName(const std::string &name) { return "Local\\" + name; }
+#else
+std::string platformName(const std::string &name) { return "/" + name; }
+#endif
+
+} // namespace
+
+SharedMemoryRegion::~SharedMemoryRegion() { close(); }
+
+bool SharedMemoryRegion::create(const std::string &name, size_t size) {
+  close();
+
+#ifdef _WIN32
+  const unsigned long long size64 = size;
+  HANDLE mapping = CreateFileMappingA(
+      INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+      static_cast<DWORD>(size64 >> 32), static_cast<DWORD>(size64),
+      platformName(name).c_str());
+  if (mapping == nullptr) {
+    return false;
+  }
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  mapping_ = mapping;
+  data_ = view;
+#else
+  const std::string path = platformName(name);
+  int fd = shm_open(path.c_str(), O_CREAT | O_RDWR, 0600);
+  if (fd < 0) {
+    return false;
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+    ::close(fd);
+    return false;
+  }
+
+  void *view =
+      mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd); // The mapping keeps the object alive
+  if (view == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = view;
+#endif
+
+  size_ = size;
+  owner_ = true;
+  name_ = name;
+  return true;
+}
+
+bool SharedMemoryRegion::open(const std::string &name, size_t size) {
+  close();
+
+#ifdef _WIN32
+  HANDLE mapping =
+      OpenFileMappingA(FILE_MAP_READ, FALSE, platformName(name).c_str());
+  if (mapping == nullptr) {
+    return false;
+  }
+
+  void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+  if (view == nullptr) {
+    CloseHandle(mapping);
+    return false;
+  }
+
+  mapping_ = mapping;
+  data_ = view;
+#else
+  const std::string path = platformName(name);
+  int fd = shm_open(path.c_str(), O_RDONLY, 0);
+  if (fd < 0) {
+    return false;
+  }
+
+  // The creator may not have sized it yet
+  struct stat info = {};
+  if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < size) {
+    ::close(fd);
+    return false;
+  }
+
+  void *view = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (view == MAP_FAILED) {
+    return false;
+  }
+
+  data_ = view;
+#endif
+
+  size_ = size;
+  owner_ = false;
+  name_ = name;
+  return true;
+}
+
+void SharedMemoryRegion::close() {
+  if (!data_) {
+    return;
+  }
+
+#ifdef _WIN32
+  UnmapViewOfFile(data_);
+  CloseHandle(static_cast<HANDLE>(mapping_));
+  mapping_ = nullptr;
+#else
+  munmap(data_, size_);
+  if (owner_) {
+    shm_unlink(platformName(name_).c_str());
+  }
+#endif
+
+  data_ = nullptr;
+  size_ = 0;
+  owner_ = false;
+  name_.clear();
+}
+
+} // namespace WindowsAiMic
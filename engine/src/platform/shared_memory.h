@@ -0,0 +1,65 @@
+/**
+ * WindowsAiMic - Shared Memory Header
+ *
+ * Named shared memory region: a file mapping in the session's Local\
+ * namespace on Windows, POSIX shm elsewhere (used by Linux tests).
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace WindowsAiMic {
+
+/**
+ * One mapped view of a named shared memory region
+ *
+ * The creator maps it read-write; other processes open it read-only.
+ * On POSIX the creator unlinks the name on close, so readers that are
+ * still attached keep their (now orphaned) mapping until they reopen.
+ */
+class SharedMemoryRegion {
+public:
+  SharedMemoryRegion() = default;
+  ~SharedMemoryRegion();
+
+  // Non-copyable
+  SharedMemoryRegion(const SharedMemoryRegion &) = delete;
+  SharedMemoryRegion &operator=(const SharedMemoryRegion &) = delete;
+
+  /**
+   * Create (or attach to an existing) region for writing
+   * @param name Plain name without platform prefix, e.g. "WindowsAiMicFoo"
+   * @param size Size in bytes
+   * @return true on success
+   */
+  bool create(const std::string &name, size_t size);
+
+  /**
+   * Map an existing region read-only
+   * @return false if it does not exist or is smaller than size
+   */
+  bool open(const std::string &name, size_t size);
+
+  /**
+   * Unmap (and, for the creator on POSIX, unlink) the region
+   */
+  void close();
+
+  bool isOpen() const { return data_ != nullptr; }
+  void *data() const { return data_; }
+  size_t size() const { return size_; }
+
+private:
+  void *data_ = nullptr;
+  size_t size_ = 0;
+  bool owner_ = false;
+  std::string name_;
+
+#ifdef _WIN32
+  void *mapping_ = nullptr; // HANDLE
+#endif
+};
+
+} // namespace WindowsAiMic
@@ -255,14 +255,20 @@ inline void stereoToMono(float *mono, const float *stereo, size_t frames) {
     __m256 v0 = _mm256_loadu_ps(stereo + i * 2);     // L0,R0,L1,R1,L2,R2,L3,R3
     __m256 v1 = _mm256_loadu_ps(stereo + i * 2 + 8); // L4,R4,L5,R5,L6,R6,L7,R7
 
-    // Shuffle to separate L and R
-    // This is complex; for simplicity, use scalar for now
-    // A proper SIMD impl would use permutes
+    // Per 128-bit lane: L0,L1,L4,L5 | L2,L3,L6,L7 (R likewise)
+    __m256 vLeft = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 vRight = _mm256_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 vMono = _mm256_mul_ps(_mm256_add_ps(vLeft, vRight), vHalf);
+
+    // Restore sample order across the lanes: 0,1,4,5,2,3,6,7 -> 0..7
+    vMono = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(vMono),
+                                                   _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(mono + i, vMono);
   }
 
-  // Scalar fallback
-  for (size_t j = i; j < frames; ++j) {
-    mono[j] = (stereo[j * 2] + stereo[j * 2 + 1]) * 0.5f;
+  // Remainder
+  for (; i < frames; ++i) {
+    mono[i] = (stereo[i * 2] + stereo[i * 2 + 1]) * 0.5f;
   }
 #else
   for (size_t i = 0; i < frames; ++i) {
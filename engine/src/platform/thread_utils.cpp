@@ -0,0 +1,464 @@
+/**
+ * WindowsAiMic - Thread Utilities Implementation
+ */
+
+#include "thread_utils.h"
+#include "cpu_topology.h"
+
+#include <algorithm>
+#include <fstream>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <alloca.h>
+#include <cerrno>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace WindowsAiMic {
+
+namespace {
+
+#if defined(__SSE__) || defined(_M_X64)
+
+constexpr uint32_t MXCSR_DAZ = 0x0040; // Denormals are zero (inputs)
+constexpr uint32_t MXCSR_FTZ = 0x8000; // Flush to zero (results)
+constexpr uint32_t FLUSH_DENORMALS = MXCSR_FTZ | MXCSR_DAZ;
+
+uint32_t readFloatControl() { return _mm_getcsr(); }
+void writeFloatControl(uint32_t value) { _mm_setcsr(value); }
+
+#elif defined(__aarch64__) && defined(__GNUC__)
+
+// FPCR.FZ flushes both subnormal inputs and results; the register's
+// upper half is reserved, so 32 bits hold all of it
+constexpr uint32_t FPCR_FZ = 1u << 24;
+constexpr uint32_t FLUSH_DENORMALS = FPCR_FZ;
+
+uint32_t readFloatControl() {
+  uint64_t fpcr = 0;
+  __asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+  return static_cast<uint32_t>(fpcr);
+}
+void writeFloatControl(uint32_t value) {
+  const uint64_t fpcr = value;
+  __asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr));
+}
+
+#else
+
+// No known control register: denormals stay as the platform has them
+constexpr uint32_t FLUSH_DENORMALS = 0;
+
+uint32_t readFloatControl() { return 0; }
+void writeFloatControl(uint32_t) {}
+
+#endif
+
+// Current affinity of the calling thread (empty if unknown)
+std::vector<int> currentAffinity() {
+  std::vector<int> cpus;
+#ifdef _WIN32
+  // SetThreadAffinityMask is the only getter: set all, read the old mask
+  DWORD_PTR processMask = 0;
+  DWORD_PTR systemMask = 0;
+  GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask);
+  const DWORD_PTR previous =
+      SetThreadAffinityMask(GetCurrentThread(), processMask);
+  if (previous != 0) {
+    SetThreadAffinityMask(GetCurrentThread(), previous);
+    for (int cpu = 0; cpu < static_cast<int>(sizeof(DWORD_PTR) * 8); ++cpu) {
+      if (previous & (DWORD_PTR{1} << cpu)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      if (CPU_ISSET(cpu, &set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  return cpus;
+}
+
+#ifdef __linux__
+
+std::vector<int> readCpuList(const char *path) {
+  std::ifstream file(path);
+  std::string list;
+  std::getline(file, list);
+  return parseCpuList(list);
+}
+
+// Saved scheduling state for revertMultimediaMode()
+struct PosixSchedulingState {
+  int policy;
+  sched_param param;
+  int nice;
+  int tid;
+};
+
+// Raise a soft resource limit to its hard limit; returns the new soft limit
+rlim_t raiseSoftLimit(int resource) {
+  rlimit limit;
+  if (getrlimit(resource, &limit) != 0) {
+    return 0;
+  }
+  if (limit.rlim_cur != limit.rlim_max) {
+    limit.rlim_cur = limit.rlim_max;
+    setrlimit(resource, &limit);
+    getrlimit(resource, &limit);
+  }
+  return limit.rlim_cur;
+}
+
+bool acquireRealtimePolicy(pthread_t thread, int priority,
+                           std::string *detail) {
+  const rlim_t rtLimit = raiseSoftLimit(RLIMIT_RTPRIO);
+
+  for (const int policy : {SCHED_FIFO, SCHED_RR}) {
+    int wanted = std::clamp(priority, sched_get_priority_min(policy),
+                            sched_get_priority_max(policy));
+
+    // Try the requested priority (CAP_SYS_NICE), then what the limit allows
+    for (int attempt = 0; attempt < 2; ++attempt) {
+      sched_param param = {};
+      param.sched_priority = wanted;
+      if (pthread_setschedparam(thread, policy, &param) == 0) {
+        if (detail) {
+          *detail = (policy == SCHED_FIFO ? "SCHED_FIFO " : "SCHED_RR ") +
+                    std::to_string(wanted);
+        }
+        return true;
+      }
+      if (rtLimit == 0 || rtLimit == RLIM_INFINITY ||
+          static_cast<rlim_t>(wanted) <= rtLimit) {
+        break;
+      }
+      wanted = static_cast<int>(rtLimit);
+    }
+  }
+  return false;
+}
+
+// Lowest nice value we may set: -11 is what rtkit grants
+bool lowerNice(int tid, std::string *detail) {
+  const rlim_t niceLimit = raiseSoftLimit(RLIMIT_NICE);
+  int target = -11;
+  if (geteuid() != 0 && niceLimit != RLIM_INFINITY) {
+    target = std::max(target, 20 - static_cast<int>(niceLimit));
+  }
+  if (target >= 0 || setpriority(PRIO_PROCESS, tid, target) != 0) {
+    return false;
+  }
+  if (detail) {
+    *detail = "nice " + std::to_string(target);
+  }
+  return true;
+}
+
+#endif
+
+} // namespace
+
+// ============================================================================
+// Scheduling
+// ============================================================================
+
+#ifndef _WIN32
+
+int currentThreadId() {
+#ifdef __linux__
+  return static_cast<int>(syscall(SYS_gettid));
+#else
+  return 0;
+#endif
+}
+
+bool setPosixThreadPriority(pthread_t thread, int tid,
+                            ThreadPriority priority) {
+#ifdef __linux__
+  if (priority == ThreadPriority::Realtime) {
+    return acquireRealtimePolicy(thread, 80, nullptr) ||
+           (tid != 0 && lowerNice(tid, nullptr));
+  }
+
+  sched_param param = {};
+  const int policy =
+      priority == ThreadPriority::Low ? SCHED_BATCH : SCHED_OTHER;
+  if (pthread_setschedparam(thread, policy, &param) != 0) {
+    return false;
+  }
+  if (tid == 0) {
+    return priority != ThreadPriority::High; // Nice needs the thread ID
+  }
+
+  const int nice = priority == ThreadPriority::Low    ? 10
+                   : priority == ThreadPriority::High ? -10
+                                                      : 0;
+  return setpriority(PRIO_PROCESS, tid, nice) == 0;
+#else
+  (void)thread;
+  (void)tid;
+  (void)priority;
+  return false;
+#endif
+}
+
+void *setThreadMultimediaMode(const std::string &taskName) {
+  (void)taskName; // MMCSS task names have no Linux equivalent
+#ifdef __linux__
+  auto *state = new PosixSchedulingState{};
+  state->tid = currentThreadId();
+  pthread_getschedparam(pthread_self(), &state->policy, &state->param);
+  errno = 0;
+  state->nice = getpriority(PRIO_PROCESS, state->tid);
+  if (errno != 0) {
+    state->nice = 0;
+  }
+
+  if (acquireRealtimePolicy(pthread_self(), 80, nullptr)) {
+    return state;
+  }
+  delete state;
+#endif
+  return nullptr;
+}
+
+void revertMultimediaMode(void *taskHandle) {
+#ifdef __linux__
+  auto *state = static_cast<PosixSchedulingState *>(taskHandle);
+  if (!state) {
+    return;
+  }
+  pthread_setschedparam(pthread_self(), state->policy, &state->param);
+  setpriority(PRIO_PROCESS, state->tid, state->nice);
+  delete state;
+#else
+  (void)taskHandle;
+#endif
+}
+
+#endif
+
+// ============================================================================
+// Affinity
+// ============================================================================
+
+bool setThreadAffinity(const std::vector<int> &cpus) {
+#ifdef _WIN32
+  DWORD_PTR mask = 0;
+  if (cpus.empty()) {
+    DWORD_PTR systemMask = 0;
+    GetProcessAffinityMask(GetCurrentProcess(), &mask, &systemMask);
+  }
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < static_cast<int>(sizeof(DWORD_PTR) * 8)) {
+      mask |= DWORD_PTR{1} << cpu;
+    }
+  }
+  return mask != 0 && SetThreadAffinityMask(GetCurrentThread(), mask) != 0;
+#elif defined(__linux__)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (cpus.empty()) {
+    for (const int cpu : readCpuList("/sys/devices/system/cpu/online")) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  for (const int cpu : cpus) {
+    if (cpu >= 0 && cpu < CPU_SETSIZE) {
+      CPU_SET(cpu, &set);
+    }
+  }
+  return CPU_COUNT(&set) > 0 &&
+         pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  (void)cpus;
+  return false;
+#endif
+}
+
+std::vector<int> hybridCoreCpus(CorePreference preference) {
+  const CpuTopology &topology = CpuTopology::get();
+  switch (preference) {
+  case CorePreference::Performance:
+    return topology.cpusOfType(CoreType::Performance);
+  case CorePreference::Efficiency:
+    return topology.isHybrid() ? topology.workerCpus() : std::vector<int>{};
+  default:
+    return {};
+  }
+}
+
+bool setThreadCpuSets(const std::vector<int> &cpus) {
+#ifdef _WIN32
+  // Soft affinity the scheduler honours alongside MMCSS; empty clears it
+  const std::vector<uint32_t> ids = CpuTopology::get().cpuSetIds(cpus);
+  if (!cpus.empty() && ids.empty()) {
+    return false;
+  }
+  std::vector<ULONG> setIds(ids.begin(), ids.end());
+  return SetThreadSelectedCpuSets(GetCurrentThread(),
+                                  setIds.empty() ? nullptr : setIds.data(),
+                                  static_cast<ULONG>(setIds.size())) != 0;
+#else
+  return setThreadAffinity(cpus);
+#endif
+}
+
+// ============================================================================
+// Memory and floating point
+// ============================================================================
+
+bool lockProcessMemory() {
+#ifdef __linux__
+  // MCL_FUTURE with a small RLIMIT_MEMLOCK would make later allocations
+  // fail, so only lock future pages when the limit cannot be hit
+  const rlim_t limit = raiseSoftLimit(RLIMIT_MEMLOCK);
+  const bool unlimited = limit == RLIM_INFINITY || geteuid() == 0;
+  return mlockall(unlimited ? (MCL_CURRENT | MCL_FUTURE) : MCL_CURRENT) == 0;
+#else
+  return false;
+#endif
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((noinline))
+#elif defined(_MSC_VER)
+__declspec(noinline)
+#endif
+void prefaultStack(size_t bytes) {
+#ifdef _WIN32
+  auto *stack = static_cast<volatile unsigned char *>(_alloca(bytes));
+#else
+  auto *stack = static_cast<volatile unsigned char *>(alloca(bytes));
+#endif
+  // Top down, so Windows guard pages are committed in order
+  for (size_t offset = bytes; offset >= 4096; offset -= 4096) {
+    stack[offset - 1] = 0;
+  }
+  stack[0] = 0;
+}
+
+uint32_t enableFlushDenormals() {
+  const uint32_t previous = readFloatControl();
+  writeFloatControl(previous | FLUSH_DENORMALS);
+  return previous;
+}
+
+uint32_t disableFlushDenormals() {
+  const uint32_t previous = readFloatControl();
+  writeFloatControl(previous & ~FLUSH_DENORMALS);
+  return previous;
+}
+
+void restoreFloatControl(uint32_t previous) { writeFloatControl(previous); }
+
+// ============================================================================
+// RealtimeContext
+// ============================================================================
+
+RealtimeContext::RealtimeContext(const RealtimeOptions &options)
+    : options_(options) {
+  if (options_.flushDenormals) {
+    previousFloatControl_ = enableFlushDenormals();
+    report_.denormalsFlushed =
+        FLUSH_DENORMALS != 0 &&
+        (readFloatControl() & FLUSH_DENORMALS) == FLUSH_DENORMALS;
+  }
+
+  if (!options_.cpus.empty()) {
+#ifndef _WIN32
+    previousCpus_ = currentAffinity();
+#endif
+    report_.affinity = setThreadCpuSets(options_.cpus);
+  }
+
+#ifdef _WIN32
+  schedulingHandle_ = setThreadMultimediaMode("Pro Audio");
+  report_.scheduling = schedulingHandle_ != nullptr;
+  report_.schedulingDetail = report_.scheduling ? "MMCSS Pro Audio" : "";
+#elif defined(__linux__)
+  auto *state = new PosixSchedulingState{};
+  state->tid = currentThreadId();
+  pthread_getschedparam(pthread_self(), &state->policy, &state->param);
+  errno = 0;
+  state->nice = getpriority(PRIO_PROCESS, state->tid);
+  if (errno != 0) {
+    state->nice = 0;
+  }
+  schedulingHandle_ = state;
+
+  report_.scheduling = acquireRealtimePolicy(
+      pthread_self(), options_.priority, &report_.schedulingDetail);
+  if (!report_.scheduling) {
+    lowerNice(state->tid, &report_.schedulingDetail);
+  }
+#endif
+
+  if (options_.lockMemory) {
+    report_.memoryLocked = lockProcessMemory();
+  }
+  if (options_.prefaultStack > 0) {
+    prefaultStack(options_.prefaultStack);
+    report_.stackPrefaulted = true;
+  }
+}
+
+RealtimeContext::~RealtimeContext() {
+  // Memory stays locked: it is process-wide and other threads rely on it
+  revertMultimediaMode(schedulingHandle_);
+#ifdef _WIN32
+  if (report_.affinity) {
+    setThreadCpuSets({});
+  }
+#else
+  if (!previousCpus_.empty()) {
+    setThreadAffinity(previousCpus_);
+  }
+#endif
+  if (options_.flushDenormals) {
+    restoreFloatControl(previousFloatControl_);
+  }
+}
+
+std::string RealtimeReport::summary(const RealtimeOptions &options) const {
+  std::string acquired;
+  std::string missing;
+  auto add = [&](bool requested, bool ok, const std::string &what) {
+    if (!requested) {
+      return;
+    }
+    std::string &list = ok ? acquired : missing;
+    list += list.empty() ? what : ", " + what;
+  };
+
+  add(true, scheduling,
+      scheduling ? schedulingDetail : "real-time scheduling");
+  add(!scheduling && !schedulingDetail.empty(), true, schedulingDetail);
+  add(!options.cpus.empty(), affinity, "affinity");
+  add(options.lockMemory, memoryLocked, "mlockall");
+  add(options.prefaultStack > 0, stackPrefaulted, "stack prefault");
+  add(options.flushDenormals, denormalsFlushed, "FTZ/DAZ");
+
+  return "acquired: " + (acquired.empty() ? "none" : acquired) +
+         "; missing: " + (missing.empty() ? "none" : missing);
+}
+
+} // namespace WindowsAiMic
@@ -2,17 +2,24 @@
  * WindowsAiMic - Thread Utilities
  *
  * Thread management optimized for Intel hybrid architecture (P-core/E-core).
+ * Windows uses MMCSS and Thread Director hints; Linux uses SCHED_FIFO/RR,
+ * nice levels and CPU affinity.
  */
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <thread>
+#include <vector>
 
 #ifdef _WIN32
 #include <Windows.h>
 #include <avrt.h>
 #pragma comment(lib, "avrt.lib")
+#else
+#include <pthread.h>
 #endif
 
 namespace WindowsAiMic {
@@ -36,6 +43,18 @@ enum class CorePreference {
   Efficiency   // Prefer E-cores
 };
 
+#ifndef _WIN32
+/**
+ * Linux scheduling (thread_utils.cpp)
+ * Realtime tries SCHED_FIFO, then SCHED_RR, raising RLIMIT_RTPRIO to its
+ * hard limit first (the grant rtkit would hand out), then falls back to
+ * the lowest nice value RLIMIT_NICE allows. `tid` is needed for nice
+ * changes; pass 0 for another thread, which then only changes policy.
+ */
+bool setPosixThreadPriority(pthread_t thread, int tid, ThreadPriority priority);
+int currentThreadId();
+#endif
+
 /**
  * Set thread priority
  */
@@ -60,9 +79,7 @@ inline bool setThreadPriority(std::thread &thread, ThreadPriority priority) {
 
   return SetThreadPriority(thread.native_handle(), winPriority) != 0;
 #else
-  (void)thread;
-  (void)priority;
-  return false;
+  return setPosixThreadPriority(thread.native_handle(), 0, priority);
 #endif
 }
 
@@ -90,14 +107,33 @@ inline bool setCurrentThreadPriority(ThreadPriority priority) {
 
   return SetThreadPriority(GetCurrentThread(), winPriority) != 0;
 #else
-  (void)priority;
-  return false;
+  return setPosixThreadPriority(pthread_self(), currentThreadId(), priority);
 #endif
 }
 
+/**
+ * Pin the current thread to a set of logical CPUs
+ * An empty list allows every CPU.
+ */
+bool setThreadAffinity(const std::vector<int> &cpus);
+
+/**
+ * Pin the current thread to logical CPUs through the OS's preferred
+ * mechanism: CPU sets on Windows (soft, cleared by an empty list),
+ * affinity elsewhere
+ */
+bool setThreadCpuSets(const std::vector<int> &cpus);
+
+/**
+ * Logical CPUs of one core type (see CpuTopology)
+ * Efficiency includes the low-power E-cores; empty when the CPU is not
+ * hybrid.
+ */
+std::vector<int> hybridCoreCpus(CorePreference preference);
+
 /**
  * Set thread core preference (Intel hybrid architecture)
- * Uses Windows 11 Thread Director hints
+ * Windows: Thread Director hints. Linux: affinity to the P- or E-core set.
  */
 inline bool setThreadCorePreference(CorePreference preference) {
 #ifdef _WIN32
@@ -131,18 +167,23 @@ inline bool setThreadCorePreference(CorePreference preference) {
   return SetThreadInformation(GetCurrentThread(), ThreadPowerThrottling,
                               &throttle, sizeof(throttle)) != 0;
 #else
-  (void)preference;
-  return false;
+  if (preference == CorePreference::Any) {
+    return setThreadAffinity({});
+  }
+  const std::vector<int> cpus = hybridCoreCpus(preference);
+  return !cpus.empty() && setThreadAffinity(cpus);
 #endif
 }
 
 /**
  * Set thread for multimedia/audio work
- * Registers with MMCSS (Multimedia Class Scheduler Service)
+ * Windows registers with MMCSS (Multimedia Class Scheduler Service);
+ * Linux switches to a real-time policy. Returns a handle for
+ * revertMultimediaMode(), or nullptr if nothing was acquired.
  */
+#ifdef _WIN32
 inline void *
 setThreadMultimediaMode(const std::string &taskName = "Pro Audio") {
-#ifdef _WIN32
   DWORD taskIndex = 0;
   std::wstring wTaskName(taskName.begin(), taskName.end());
   HANDLE hTask = AvSetMmThreadCharacteristicsW(wTaskName.c_str(), &taskIndex);
@@ -153,37 +194,83 @@ setThreadMultimediaMode(const std::string &taskName = "Pro Audio") {
   }
 
   return hTask;
+}
 #else
-  (void)taskName;
-  return nullptr;
+void *setThreadMultimediaMode(const std::string &taskName = "Pro Audio");
 #endif
-}
 
 /**
  * Revert multimedia mode
  */
-inline void revertMultimediaMode(void *taskHandle) {
 #ifdef _WIN32
+inline void revertMultimediaMode(void *taskHandle) {
   if (taskHandle) {
     AvRevertMmThreadCharacteristics(static_cast<HANDLE>(taskHandle));
   }
+}
 #else
-  (void)taskHandle;
+void revertMultimediaMode(void *taskHandle);
 #endif
-}
 
 /**
  * Set thread name (for debugging)
+ * Linux truncates to 15 characters.
  */
 inline void setThreadName(const std::string &name) {
 #ifdef _WIN32
   std::wstring wname(name.begin(), name.end());
   SetThreadDescription(GetCurrentThread(), wname.c_str());
+#elif defined(__linux__)
+  pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
 #else
   (void)name;
 #endif
 }
 
+/**
+ * Lock the process's pages in RAM so the audio path never page-faults
+ * Future allocations are locked too when RLIMIT_MEMLOCK allows it.
+ * Process-wide and not undone. Linux only.
+ */
+bool lockProcessMemory();
+
+/**
+ * Touch `bytes` of the current thread's stack so first use does not fault
+ */
+void prefaultStack(size_t bytes);
+
+/**
+ * Set flush-to-zero and denormals-are-zero in the SSE control register
+ * (flush-to-zero in FPCR on ARM64; nothing elsewhere)
+ * @return Previous control word for restoreFloatControl()
+ */
+uint32_t enableFlushDenormals();
+
+/**
+ * Clear the bits enableFlushDenormals() sets
+ * @return Previous control word for restoreFloatControl()
+ */
+uint32_t disableFlushDenormals();
+void restoreFloatControl(uint32_t previous);
+
+/**
+ * RAII wrapper for FTZ/DAZ
+ * Every thread that runs filters or envelopes needs one: those states
+ * decay toward zero in silence, and subnormal arithmetic is 10-100x slower.
+ */
+class DenormalGuard {
+public:
+  DenormalGuard() : previous_(enableFlushDenormals()) {}
+  ~DenormalGuard() { restoreFloatControl(previous_); }
+
+  // Non-copyable
+  DenormalGuard(const DenormalGuard &) = delete;
+  DenormalGuard &operator=(const DenormalGuard &) = delete;
+
+private:
+  uint32_t previous_;
+};
+
 /**
  * RAII wrapper for multimedia thread mode
  */
@@ -212,4 +299,58 @@ public:
   ~PerformanceCoreScope() { setThreadCorePreference(CorePreference::Any); }
 };
 
+/**
+ * What a RealtimeContext should try to acquire
+ */
+struct RealtimeOptions {
+  int priority = 80;                 // SCHED_FIFO priority (Linux, 1-99)
+  std::vector<int> cpus;             // CPU set; empty = leave as is
+  bool lockMemory = true;            // mlockall (Linux)
+  size_t prefaultStack = 256 * 1024; // Bytes of stack to touch
+  bool flushDenormals = true;        // FTZ/DAZ
+};
+
+/**
+ * What a RealtimeContext actually got
+ */
+struct RealtimeReport {
+  bool scheduling = false; // Real-time policy or MMCSS
+  std::string schedulingDetail;
+  bool affinity = false;
+  bool memoryLocked = false;
+  bool stackPrefaulted = false;
+  bool denormalsFlushed = false;
+
+  /** "acquired: ...; missing: ..." for the log */
+  std::string summary(const RealtimeOptions &options) const;
+};
+
+/**
+ * Scoped real-time setup for the calling thread
+ *
+ * Acquires what it can (scheduling, affinity, locked memory, prefaulted
+ * stack, FTZ/DAZ), never fails, and restores scheduling, affinity and the
+ * float control word on destruction. Check report() for the outcome.
+ */
+class RealtimeContext {
+public:
+  explicit RealtimeContext(const RealtimeOptions &options = {});
+  ~RealtimeContext();
+
+  // Non-copyable
+  RealtimeContext(const RealtimeContext &) = delete;
+  RealtimeContext &operator=(const RealtimeContext &) = delete;
+
+  const RealtimeReport &report() const { return report_; }
+  std::string summary() const { return report_.summary(options_); }
+
+private:
+  RealtimeOptions options_;
+  RealtimeReport report_;
+
+  void *schedulingHandle_ = nullptr; // From setThreadMultimediaMode()
+  uint32_t previousFloatControl_ = 0;
+  std::vector<int> previousCpus_;
+};
+
 } // namespace WindowsAiMic
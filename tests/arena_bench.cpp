@@ -0,0 +1,341 @@
+/**
+ * WindowsAiMic - Arena Bench
+ *
+ * Builds the processing chain twice: once as separate heap objects with
+ * unrelated allocations in between (as at engine startup), once in an
+ * AudioArena in processing order. Runs the block loop on both, evicting
+ * the caches between blocks like the 10 ms gap in the engine does, and
+ * reports time plus L1D, last-level cache and dTLB misses per block from
+ * perf counters (Linux; timing only elsewhere or when perf is denied).
+ * Also checks the arena layout and that both chains produce identical
+ * output, so it doubles as a test under CTest.
+ *
+ * Usage: arena_bench [--blocks N]
+ */
+
+#include "ai/rnnoise_processor.h"
+#include "dsp/compressor.h"
+#include "dsp/equalizer.h"
+#include "dsp/expander.h"
+#include "dsp/limiter.h"
+#include "dsp/metering.h"
+#include "platform/audio_arena.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace WindowsAiMic;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t BLOCK_SIZE = 480;
+constexpr size_t EVICT_BYTES = 16 * 1024 * 1024; // Larger than any LLC
+constexpr size_t ARENA_SIZE = 2 * 1024 * 1024;   // As in the engine
+
+// ============================================================================
+// Perf counters
+// ============================================================================
+
+enum Event { L1D_MISS, LLC_MISS, DTLB_MISS, EVENT_COUNT };
+const char *const EVENT_NAMES[EVENT_COUNT] = {"L1D", "LLC", "dTLB"};
+
+class PerfCounters {
+public:
+  PerfCounters() {
+#ifdef __linux__
+    auto cache = [](uint64_t cache) {
+      return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+             (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    };
+    const uint32_t types[EVENT_COUNT] = {PERF_TYPE_HW_CACHE, PERF_TYPE_HARDWARE,
+                                         PERF_TYPE_HW_CACHE};
+    const uint64_t configs[EVENT_COUNT] = {cache(PERF_COUNT_HW_CACHE_L1D),
+                                           PERF_COUNT_HW_CACHE_MISSES,
+                                           cache(PERF_COUNT_HW_CACHE_DTLB)};
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+      perf_event_attr attr = {};
+      attr.size = sizeof(attr);
+      attr.type = types[i];
+      attr.config = configs[i];
+      attr.disabled = i == 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv = 1;
+      attr.read_format = PERF_FORMAT_GROUP;
+      fds_[i] = static_cast<int>(
+          syscall(SYS_perf_event_open, &attr, 0, -1, i == 0 ? -1 : fds_[0], 0));
+      if (fds_[i] < 0) {
+        close();
+        return;
+      }
+    }
+#endif
+  }
+
+  ~PerfCounters() { close(); }
+
+  bool available() const { return fds_[0] >= 0; }
+
+  void start() {
+#ifdef __linux__
+    if (available()) {
+      ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  void stop() {
+#ifdef __linux__
+    if (available()) {
+      ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+  }
+
+  // Totals since the counters were opened
+  void read(uint64_t totals[EVENT_COUNT]) const {
+    std::fill(totals, totals + EVENT_COUNT, 0);
+#ifdef __linux__
+    uint64_t values[1 + EVENT_COUNT] = {0};
+    if (available() && ::read(fds_[0], values, sizeof(values)) > 0) {
+      for (int i = 0; i < EVENT_COUNT && i < static_cast<int>(values[0]);
+           ++i) {
+        totals[i] = values[1 + i];
+      }
+    }
+#endif
+  }
+
+private:
+  void close() {
+#ifdef __linux__
+    for (int &fd : fds_) {
+      if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+      }
+    }
+#endif
+  }
+
+  int fds_[EVENT_COUNT] = {-1, -1, -1};
+};
+
+// ============================================================================
+// Chains
+// ============================================================================
+
+template <template <typename> class Ptr> struct Chain {
+  Ptr<Metering> inputMetering;
+  Ptr<RNNoiseProcessor> rnnoise;
+  Ptr<Expander> expander;
+  Ptr<Equalizer> equalizer;
+  Ptr<Compressor> compressor;
+  Ptr<Limiter> limiter;
+  Ptr<Metering> outputMetering;
+
+  void process(float *block) {
+    inputMetering->process(block, BLOCK_SIZE);
+    rnnoise->process(block, BLOCK_SIZE);
+    expander->process(block, BLOCK_SIZE);
+    equalizer->process(block, BLOCK_SIZE);
+    compressor->process(block, BLOCK_SIZE);
+    limiter->process(block, BLOCK_SIZE);
+    outputMetering->process(block, BLOCK_SIZE);
+  }
+};
+
+template <typename T> using HeapPtr = std::unique_ptr<T>;
+
+struct HeapChain : Chain<HeapPtr> {
+  std::vector<float> buffer = std::vector<float>(BLOCK_SIZE);
+  std::vector<std::unique_ptr<char[]>> clutter; // Other startup allocations
+
+  HeapChain() {
+    // Unrelated allocations between the processors, as in the engine
+    // where config, strings, devices and threads are set up in between
+    auto spacer = [this](size_t bytes) {
+      clutter.emplace_back(new char[bytes]);
+      std::memset(clutter.back().get(), 1, bytes);
+    };
+    inputMetering = std::make_unique<Metering>();
+    spacer(24 * 1024);
+    rnnoise = std::make_unique<RNNoiseProcessor>();
+    spacer(3000);
+    expander = std::make_unique<Expander>();
+    spacer(70 * 1024);
+    equalizer = std::make_unique<Equalizer>();
+    spacer(512);
+    compressor = std::make_unique<Compressor>();
+    spacer(130 * 1024);
+    limiter = std::make_unique<Limiter>();
+    spacer(9000);
+    outputMetering = std::make_unique<Metering>();
+  }
+};
+
+struct ArenaChain : Chain<ArenaPtr> {
+  AudioArena arena{ARENA_SIZE};
+  std::pmr::vector<float> buffer{BLOCK_SIZE, 0.0f, arena.resource()};
+
+  ArenaChain() {
+    std::pmr::memory_resource *memory = arena.resource();
+    inputMetering = arena.make<Metering>(memory);
+    rnnoise = arena.make<RNNoiseProcessor>(memory);
+    expander = arena.make<Expander>();
+    equalizer = arena.make<Equalizer>();
+    compressor = arena.make<Compressor>();
+    limiter = arena.make<Limiter>(memory);
+    outputMetering = arena.make<Metering>(memory);
+  }
+
+  ~ArenaChain() {
+    // Processors before the arena they live in
+    inputMetering.reset();
+    rnnoise.reset();
+    expander.reset();
+    equalizer.reset();
+    compressor.reset();
+    limiter.reset();
+    outputMetering.reset();
+    buffer = std::pmr::vector<float>(arena.resource());
+  }
+};
+
+struct RunResult {
+  double usPerBlock = 0.0;
+  double missesPerBlock[EVENT_COUNT] = {0.0, 0.0, 0.0};
+  std::vector<float> output;
+};
+
+template <typename ChainType>
+RunResult run(ChainType &chain, const std::vector<float> &input,
+              size_t blocks, PerfCounters &counters) {
+  std::vector<uint8_t> evict(EVICT_BYTES, 0);
+  uint64_t before[EVENT_COUNT];
+  uint64_t after[EVENT_COUNT];
+  RunResult result;
+  double totalUs = 0.0;
+
+  counters.read(before);
+  for (size_t block = 0; block < blocks; ++block) {
+    // The 10 ms between blocks: other threads take over the caches
+    for (size_t i = 0; i < evict.size(); i += CACHE_LINE_SIZE) {
+      evict[i] = static_cast<uint8_t>(evict[i] + 1);
+    }
+
+    const float *source = input.data() + (block * BLOCK_SIZE) % input.size();
+    std::copy_n(source, BLOCK_SIZE, chain.buffer.begin());
+
+    counters.start();
+    const Clock::time_point start = Clock::now();
+    chain.process(chain.buffer.data());
+    totalUs += std::chrono::duration<double, std::micro>(Clock::now() - start)
+                   .count();
+    counters.stop();
+
+    result.output.insert(result.output.end(), chain.buffer.begin(),
+                         chain.buffer.end());
+  }
+  counters.read(after);
+
+  result.usPerBlock = totalUs / static_cast<double>(blocks);
+  for (int i = 0; i < EVENT_COUNT; ++i) {
+    result.missesPerBlock[i] =
+        static_cast<double>(after[i] - before[i]) / static_cast<double>(blocks);
+  }
+  return result;
+}
+
+void report(const char *label, const RunResult &result, bool counters) {
+  std::printf("%-6s %8.1f us/block", label, result.usPerBlock);
+  if (counters) {
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+      std::printf("  %s misses %8.0f", EVENT_NAMES[i],
+                  result.missesPerBlock[i]);
+    }
+  }
+  std::printf("\n");
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t blocks = 500;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--blocks") == 0) {
+      blocks = static_cast<size_t>(std::atoi(argv[i + 1]));
+    }
+  }
+  blocks = std::max<size_t>(blocks, 10);
+
+  // One second of a voice-like tone with some noise
+  std::vector<float> input(48000);
+  uint32_t seed = 1;
+  for (size_t i = 0; i < input.size(); ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const float noise = static_cast<float>(seed >> 8) / 16777216.0f - 0.5f;
+    input[i] = 0.2f * std::sin(0.0289f * static_cast<float>(i)) + 0.01f * noise;
+  }
+
+  HeapChain heap;
+  ArenaChain arena;
+  CHECK(heap.rnnoise->initialize());
+  CHECK(arena.rnnoise->initialize());
+
+  // Layout: everything inside the block, cache-line aligned, in
+  // processing order, nothing spilled to the heap
+  const void *order[] = {arena.buffer.data(),      arena.inputMetering.get(),
+                         arena.rnnoise.get(),      arena.expander.get(),
+                         arena.equalizer.get(),    arena.compressor.get(),
+                         arena.limiter.get(),      arena.outputMetering.get()};
+  for (size_t i = 0; i < std::size(order); ++i) {
+    CHECK(arena.arena.contains(order[i]));
+    CHECK(reinterpret_cast<uintptr_t>(order[i]) % CACHE_LINE_SIZE == 0);
+    CHECK(i == 0 || order[i] > order[i - 1]);
+  }
+  CHECK(arena.arena.overflowBytes() == 0);
+  std::printf("arena: %s\n", arena.arena.describe().c_str());
+
+  PerfCounters counters;
+  if (!counters.available()) {
+    std::printf("perf counters unavailable; timing only\n");
+  }
+  const RunResult heapResult = run(heap, input, blocks, counters);
+  const RunResult arenaResult = run(arena, input, blocks, counters);
+
+  report("heap", heapResult, counters.available());
+  report("arena", arenaResult, counters.available());
+  if (counters.available()) {
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+      const double heapMisses = heapResult.missesPerBlock[i];
+      if (heapMisses > 0.0) {
+        std::printf("%s misses: %+.1f%%\n", EVENT_NAMES[i],
+                    100.0 * (arenaResult.missesPerBlock[i] - heapMisses) /
+                        heapMisses);
+      }
+    }
+  }
+
+  // Placement must not change the arithmetic
+  CHECK(heapResult.output == arenaResult.output);
+
+  std::printf("arena_bench: OK\n");
+  return 0;
+}
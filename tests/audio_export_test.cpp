@@ -0,0 +1,191 @@
+/**
+ * WindowsAiMic - Audio Export Test
+ *
+ * Publishes a ramp through the shared-memory audio ring while a separate
+ * reader process follows it, then checks the stream arrived in order and
+ * reports end-to-end latency and drop counts. A second case checks that a
+ * stalled reader counts exactly the frames it lost.
+ */
+
+#include "ipc/audio_export.h"
+#include "platform/clock.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr size_t BLOCK_FRAMES = 480;     // 10 ms engine block
+constexpr size_t CAPACITY_FRAMES = 8192; // Rounded up to a power of two
+constexpr size_t BLOCK_COUNT = 400;
+constexpr auto BLOCK_INTERVAL = std::chrono::microseconds(2500);
+
+// Sample n of the stream carries the value n (exact in float below 2^24)
+void fillRamp(std::vector<float> &block, uint64_t firstFrame) {
+  for (size_t i = 0; i < block.size(); ++i) {
+    block[i] = static_cast<float>(firstFrame + i);
+  }
+}
+
+int runReader(const std::string &name) {
+  AudioExportReader reader;
+  for (int attempt = 0; attempt < 500 && !reader.open(name.c_str());
+       ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  CHECK(reader.isOpen());
+  CHECK(reader.getSampleRate() == SAMPLE_RATE);
+  CHECK(reader.getChannels() == 1);
+
+  std::vector<float> buffer(BLOCK_FRAMES * 4);
+  std::vector<uint64_t> latenciesNs;
+  uint64_t framesRead = 0;
+  bool haveExpected = false;
+  float expected = 0.0f;
+  uint64_t discontinuities = 0;
+
+  while (true) {
+    const size_t frames = reader.read(buffer.data(), buffer.size());
+    if (frames == 0) {
+      if (!reader.isWriterActive()) {
+        break;
+      }
+      std::this_thread::sleep_for(std::chrono::microseconds(200));
+      continue;
+    }
+
+    // Time from the writer publishing the newest block to us having it
+    const uint64_t publishedNs = reader.latestTimestampNs();
+    const uint64_t now = nowNs();
+    latenciesNs.push_back(now > publishedNs ? now - publishedNs : 0);
+
+    for (size_t i = 0; i < frames; ++i) {
+      if (haveExpected && buffer[i] != expected) {
+        ++discontinuities;
+      }
+      expected = buffer[i] + 1.0f;
+      haveExpected = true;
+    }
+    framesRead += frames;
+  }
+
+  std::sort(latenciesNs.begin(), latenciesNs.end());
+  const auto percentileUs = [&](double q) {
+    if (latenciesNs.empty()) {
+      return 0.0;
+    }
+    const size_t index = std::min(
+        latenciesNs.size() - 1,
+        static_cast<size_t>(q * static_cast<double>(latenciesNs.size())));
+    return static_cast<double>(latenciesNs[index]) / 1000.0;
+  };
+
+  std::printf("reader: %llu frames, %llu dropped, %llu discontinuities, "
+              "latency p50 %.1f us p99 %.1f us max %.1f us\n",
+              static_cast<unsigned long long>(framesRead),
+              static_cast<unsigned long long>(reader.getDroppedFrames()),
+              static_cast<unsigned long long>(discontinuities),
+              percentileUs(0.50), percentileUs(0.99), percentileUs(1.0));
+
+  CHECK(framesRead > 0);
+  CHECK(discontinuities == 0);
+  CHECK(reader.getDroppedFrames() == 0);
+  CHECK(percentileUs(0.99) < 100000.0); // Generous for loaded CI hosts
+  return 0;
+}
+
+int testReaderProcess() {
+  const std::string name = "WindowsAiMicAudioTest" + std::to_string(getpid());
+
+  AudioExportWriter writer;
+  CHECK(writer.open(name.c_str(), SAMPLE_RATE, 1, CAPACITY_FRAMES));
+
+  std::fflush(stdout); // Don't let the child inherit buffered output
+  const pid_t child = fork();
+  CHECK(child >= 0);
+  if (child == 0) {
+    const int result = runReader(name);
+    std::fflush(stdout);
+    _exit(result);
+  }
+
+  // Give the reader time to attach at the live edge
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<float> block(BLOCK_FRAMES);
+  auto next = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < BLOCK_COUNT; ++i) {
+    fillRamp(block, i * BLOCK_FRAMES);
+    writer.write(block.data(), block.size(), nowNs());
+    next += BLOCK_INTERVAL;
+    std::this_thread::sleep_until(next);
+  }
+
+  // Let the reader drain before signalling shutdown
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  writer.close();
+
+  int status = 0;
+  CHECK(waitpid(child, &status, 0) == child);
+  CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  return 0;
+}
+
+int testStalledReader() {
+  const std::string name =
+      "WindowsAiMicAudioStall" + std::to_string(getpid());
+
+  AudioExportWriter writer;
+  CHECK(writer.open(name.c_str(), SAMPLE_RATE, 1, CAPACITY_FRAMES));
+
+  AudioExportReader reader;
+  CHECK(reader.open(name.c_str()));
+
+  // Write three ring lengths without reading
+  const size_t blocks = 3 * CAPACITY_FRAMES / BLOCK_FRAMES;
+  std::vector<float> block(BLOCK_FRAMES);
+  for (size_t i = 0; i < blocks; ++i) {
+    fillRamp(block, i * BLOCK_FRAMES);
+    writer.write(block.data(), block.size(), nowNs());
+  }
+
+  const uint64_t total = blocks * BLOCK_FRAMES;
+  CHECK(reader.available() == CAPACITY_FRAMES);
+
+  std::vector<float> out(CAPACITY_FRAMES);
+  const size_t frames = reader.read(out.data(), out.size());
+  CHECK(frames == CAPACITY_FRAMES);
+  CHECK(reader.getDroppedFrames() == total - CAPACITY_FRAMES);
+  CHECK(out.front() == static_cast<float>(total - CAPACITY_FRAMES));
+  CHECK(out.back() == static_cast<float>(total - 1));
+  CHECK(reader.available() == 0);
+
+  std::printf("stalled reader: dropped %llu of %llu frames\n",
+              static_cast<unsigned long long>(reader.getDroppedFrames()),
+              static_cast<unsigned long long>(total));
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  if (testStalledReader() != 0) {
+    return 1;
+  }
+  if (testReaderProcess() != 0) {
+    return 1;
+  }
+  std::printf("audio_export_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,201 @@
+/**
+ * WindowsAiMic - Auto Tuner Test
+ *
+ * Checks the start-up auto-tuner: the quantum / pipelining decision on
+ * fixed timings, input ring sizing, the cache key (machine plus the
+ * fields that change the chain's work), cache round trips including a
+ * corrupt file, and a short real calibration of the default chain.
+ */
+
+#include "config/presets.h"
+#include "core/auto_tuner.h"
+#include "core/processing_chain.h"
+#include "dsp/metering.h"
+#include "platform/cpu_topology.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+// Block time scales with the quantum: `aiUs` + `dspUs` per 480 frames
+std::vector<QuantumTiming> scaledTimings(double aiUs, double dspUs,
+                                         double maxFactor = 1.5) {
+  std::vector<QuantumTiming> timings;
+  for (size_t frames : TUNING_QUANTA) {
+    const double scale = static_cast<double>(frames) / 480.0;
+    QuantumTiming timing;
+    timing.frames = frames;
+    timing.blocks = 100;
+    timing.aiP99Us = aiUs * scale;
+    timing.dspP99Us = dspUs * scale;
+    timing.p99Us = timing.aiP99Us + timing.dspP99Us;
+    timing.p50Us = timing.p99Us * 0.8;
+    timing.maxUs = timing.p99Us * maxFactor;
+    timings.push_back(timing);
+  }
+  return timings;
+}
+
+int testDecision() {
+  // Light chain: smallest quantum, inline
+  TuningDecision light = chooseTuning(scaledTimings(300.0, 100.0), 4);
+  CHECK(light.quantumFrames == 480);
+  CHECK(!light.pipelineAi);
+  CHECK(light.withinBudget);
+  CHECK(light.inputRingFrames == MIN_INPUT_RING_FRAMES);
+  CHECK(light.load > 0.03 && light.load < 0.05);
+
+  // 60% load inline, but each half fits: pipeline on a second core...
+  TuningDecision heavy = chooseTuning(scaledTimings(4000.0, 2000.0), 2);
+  CHECK(heavy.quantumFrames == 480);
+  CHECK(heavy.pipelineAi);
+  CHECK(heavy.withinBudget);
+  CHECK(heavy.load > 0.39 && heavy.load < 0.41);
+
+  // ...not with one; nothing fits, so the lightest setting is kept
+  TuningDecision single = chooseTuning(scaledTimings(4000.0, 2000.0), 1);
+  CHECK(!single.pipelineAi);
+  CHECK(!single.withinBudget);
+
+  // Fixed per-block overhead: a larger quantum amortises it
+  std::vector<QuantumTiming> overhead = scaledTimings(1000.0, 500.0);
+  for (QuantumTiming &timing : overhead) {
+    timing.p99Us += 4000.0;
+    timing.aiP99Us += 4000.0;
+  }
+  TuningDecision amortised = chooseTuning(overhead, 4);
+  CHECK(amortised.quantumFrames == 960);
+  CHECK(!amortised.pipelineAi);
+
+  // A 100 ms worst block grows the input ring past the default
+  TuningDecision stall = chooseTuning(scaledTimings(300.0, 100.0, 250.0), 1);
+  CHECK(stall.inputRingFrames > MIN_INPUT_RING_FRAMES);
+  CHECK(stall.inputRingFrames % stall.quantumFrames == 0);
+
+  // Nothing measured: engine defaults
+  TuningDecision none = chooseTuning({}, 4);
+  CHECK(none.quantumFrames == ProcessingChain::FRAME_SIZE);
+  CHECK(!none.pipelineAi);
+  return 0;
+}
+
+int testCacheKey() {
+  Config config;
+  const std::string key = tuningCacheKey(config);
+  CHECK(key.size() == 33 && key[16] == '-');
+  CHECK(tuningCacheKey(config) == key);
+
+  // Devices and diagnostics don't change the chain's cost
+  Config devices = config;
+  devices.devices.inputDevice = L"another microphone";
+  devices.diagnostics.tracing = true;
+  devices.tuning.calibrationMs = 1000.0f;
+  CHECK(tuningCacheKey(devices) == key);
+
+  Config dsp = config;
+  dsp.compressor.threshold -= 3.0f;
+  CHECK(tuningCacheKey(dsp).substr(0, 16) == key.substr(0, 16));
+  CHECK(tuningCacheKey(dsp) != key);
+
+  Config preset = config;
+  CHECK(applyPresetSettings(preset, "streaming"));
+  CHECK(tuningCacheKey(preset) != key);
+  return 0;
+}
+
+int testCache() {
+  namespace fs = std::filesystem;
+  const fs::path path = fs::temp_directory_path() / "wam_tuning_cache.json";
+  std::error_code ec;
+  fs::remove(path, ec);
+
+  TuningDecision decision;
+  CHECK(!loadTuningCache(path.string(), "a-b", decision));
+
+  TuningDecision heavy = chooseTuning(scaledTimings(4000.0, 2000.0), 2);
+  TuningDecision light = chooseTuning(scaledTimings(300.0, 100.0), 2);
+  CHECK(saveTuningCache(path.string(), "heavy-key", heavy));
+  CHECK(saveTuningCache(path.string(), "light-key", light));
+
+  CHECK(loadTuningCache(path.string(), "heavy-key", decision));
+  CHECK(decision.cached);
+  CHECK(decision.quantumFrames == heavy.quantumFrames);
+  CHECK(decision.inputRingFrames == heavy.inputRingFrames);
+  CHECK(decision.pipelineAi);
+  CHECK(decision.timings.size() == 1);
+  CHECK(decision.timings[0].frames == heavy.quantumFrames);
+  CHECK(decision.timings[0].p99Us > 5999.0);
+  CHECK(decision.describe().find("cached") != std::string::npos);
+
+  CHECK(loadTuningCache(path.string(), "light-key", decision));
+  CHECK(!decision.pipelineAi);
+  CHECK(!loadTuningCache(path.string(), "other-key", decision));
+
+  // Entries that couldn't have come from the tuner are ignored
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << "{\"version\": 1, \"entries\": {\"odd\": {\"quantumFrames\": 500, "
+            "\"inputRingFrames\": 8000}}}";
+  }
+  CHECK(!loadTuningCache(path.string(), "odd", decision));
+
+  // A torn file is a miss, and the next save replaces it
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << "{\"version\": 1, \"entries\": {\"light-key\": {\"quantum";
+  }
+  CHECK(!loadTuningCache(path.string(), "light-key", decision));
+  CHECK(saveTuningCache(path.string(), "light-key", light));
+  CHECK(loadTuningCache(path.string(), "light-key", decision));
+
+  fs::remove(path, ec);
+  return 0;
+}
+
+int testCalibration() {
+  Config config;
+  ProcessingChain chain;
+  CHECK(chain.loadModel(config));
+  chain.configure(config);
+
+  const std::vector<int> cpus = CpuTopology::get().realtimeCpus();
+  const std::vector<QuantumTiming> timings = calibrateChain(chain, 60.0, cpus);
+  CHECK(timings.size() == std::size(TUNING_QUANTA));
+  for (const QuantumTiming &timing : timings) {
+    std::printf("  %zu frames: p50 %.0f us, p99 %.0f us, max %.0f us, "
+                "%zu blocks\n",
+                timing.frames, timing.p50Us, timing.p99Us, timing.maxUs,
+                timing.blocks);
+    CHECK(timing.blocks >= 20);
+    CHECK(timing.p50Us > 0.0);
+    CHECK(timing.p50Us <= timing.p99Us && timing.p99Us <= timing.maxUs);
+    CHECK(timing.aiP99Us > 0.0 && timing.dspP99Us > 0.0);
+  }
+
+  const TuningDecision decision = chooseTuning(timings, cpus.size());
+  std::printf("  %s\n", decision.describe().c_str());
+  CHECK(decision.quantumFrames % ProcessingChain::FRAME_SIZE == 0);
+  CHECK(decision.inputRingFrames >= MIN_INPUT_RING_FRAMES);
+
+  // State is cleared: the chain restarts from silence
+  CHECK(chain.outputMetering().getPeak() < -90.0f);
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  CHECK(testDecision() == 0);
+  CHECK(testCacheKey() == 0);
+  CHECK(testCache() == 0);
+  CHECK(testCalibration() == 0);
+  std::printf("auto_tuner_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * WindowsAiMic - Chain C API Test
+ *
+ * Drives the processing chain through wam_chain.h from plain C: creation
+ * and presets, parameters by config path (range clamping, unknown names),
+ * config documents, bypass, latency reporting, the limiter ceiling on a
+ * hot input, and saving state from one chain to carry on in another.
+ */
+
+#include "core/wam_chain.h"
+#include "test_check.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BLOCK_FRAMES WAM_CHAIN_FRAME_SIZE
+#define BLOCK_COUNT 200
+
+static unsigned int noiseState = 12345u;
+
+/* Voice-band tone at -3 dBFS plus a little noise, hot enough to limit */
+static void fillBlock(float *block, size_t frames, size_t offset) {
+  const float step = 2.0f * 3.14159265f * 220.0f / WAM_CHAIN_SAMPLE_RATE;
+  for (size_t i = 0; i < frames; ++i) {
+    noiseState = noiseState * 1664525u + 1013904223u;
+    const float noise = ((float)(noiseState >> 8) / 16777216.0f - 0.5f);
+    block[i] = 0.7f * sinf(step * (float)(offset + i)) + 0.02f * noise;
+  }
+}
+
+static int testParameters(void) {
+  wam_chain *chain = wam_chain_create(NULL);
+  CHECK(chain != NULL);
+
+  float value = 0.0f;
+  CHECK(wam_chain_set_param(chain, "compressor.threshold", -30.0f) ==
+        WAM_OK);
+  CHECK(wam_chain_get_param(chain, "compressor.threshold", &value) ==
+        WAM_OK);
+  CHECK(value == -30.0f);
+
+  /* Clamped to the schema range */
+  CHECK(wam_chain_set_param(chain, "limiter.ceiling", 12.0f) == WAM_OK);
+  CHECK(wam_chain_get_param(chain, "limiter.ceiling", &value) == WAM_OK);
+  CHECK(value == 0.0f);
+
+  CHECK(wam_chain_set_param(chain, "expander.enabled", 0.0f) == WAM_OK);
+  CHECK(wam_chain_get_param(chain, "expander.enabled", &value) == WAM_OK);
+  CHECK(value == 0.0f);
+
+  CHECK(wam_chain_set_param(chain, "compressor.nope", 1.0f) ==
+        WAM_ERROR_UNKNOWN_PARAM);
+  CHECK(wam_chain_set_param(chain, "aiModel", 1.0f) ==
+        WAM_ERROR_UNKNOWN_PARAM);
+  CHECK(wam_chain_get_param(chain, NULL, &value) == WAM_ERROR_UNKNOWN_PARAM);
+
+  CHECK(wam_chain_load_config(chain, "{\"compressor\": {\"ratio\": 3}}") ==
+        WAM_OK);
+  CHECK(wam_chain_get_param(chain, "compressor.ratio", &value) == WAM_OK);
+  CHECK(value == 3.0f);
+  CHECK(wam_chain_load_config(chain, "{\"compressor\": ") ==
+        WAM_ERROR_INVALID_CONFIG);
+  CHECK(wam_chain_get_param(chain, "compressor.ratio", &value) == WAM_OK);
+  CHECK(value == 3.0f);
+
+  CHECK(wam_chain_apply_preset(chain, "meeting") == WAM_OK);
+  CHECK(wam_chain_apply_preset(chain, "karaoke") ==
+        WAM_ERROR_UNKNOWN_PRESET);
+
+  wam_chain_destroy(chain);
+  CHECK(wam_chain_create("karaoke") == NULL);
+  return 0;
+}
+
+static int testProcessing(void) {
+  wam_chain *chain = wam_chain_create("podcast");
+  CHECK(chain != NULL);
+
+  float ceilingDb = 0.0f;
+  float lookaheadMs = 0.0f;
+  CHECK(wam_chain_get_param(chain, "limiter.ceiling", &ceilingDb) == WAM_OK);
+  CHECK(wam_chain_get_param(chain, "limiter.lookahead", &lookaheadMs) ==
+        WAM_OK);
+  const size_t lookahead =
+      (size_t)(lookaheadMs * WAM_CHAIN_SAMPLE_RATE / 1000.0f);
+  const float ceiling = powf(10.0f, ceilingDb / 20.0f);
+
+  float block[BLOCK_FRAMES];
+  float peak = 0.0f;
+  for (size_t n = 0; n < BLOCK_COUNT; ++n) {
+    fillBlock(block, BLOCK_FRAMES, n * BLOCK_FRAMES);
+    CHECK(wam_chain_process(chain, block, BLOCK_FRAMES) == WAM_OK);
+    for (size_t i = 0; i < BLOCK_FRAMES; ++i) {
+      CHECK(isfinite(block[i]));
+      if (n >= BLOCK_COUNT / 2 && fabsf(block[i]) > peak) {
+        peak = fabsf(block[i]);
+      }
+    }
+  }
+  printf("  peak %.4f, ceiling %.4f\n", peak, ceiling);
+  CHECK(peak > 0.01f);
+  CHECK(peak <= ceiling * 1.01f);
+
+  wam_chain_meters meters;
+  memset(&meters, 0, sizeof(meters));
+  wam_chain_get_meters(chain, &meters);
+  CHECK(meters.output_rms_db > -60.0f);
+  CHECK(meters.limiter_reduction_db != 0.0f ||
+        meters.compressor_reduction_db != 0.0f);
+
+  /* Whole frames: only the limiter's lookahead */
+  CHECK(wam_chain_latency_frames(chain) == lookahead);
+  CHECK(fabs(wam_chain_latency_ms(chain) - lookaheadMs) < 0.1);
+
+  /* A partial frame makes the model buffer */
+  CHECK(wam_chain_process(chain, block, 100) == WAM_OK);
+  CHECK(wam_chain_latency_frames(chain) ==
+        lookahead + WAM_CHAIN_FRAME_SIZE - 1);
+  CHECK(wam_chain_process(chain, NULL, 10) == WAM_ERROR_INVALID_ARGUMENT);
+
+  /* Bypass passes the input through untouched */
+  wam_chain_reset(chain);
+  wam_chain_set_bypass(chain, 1);
+  float reference[BLOCK_FRAMES];
+  fillBlock(block, BLOCK_FRAMES, 0);
+  memcpy(reference, block, sizeof(block));
+  CHECK(wam_chain_process(chain, block, BLOCK_FRAMES) == WAM_OK);
+  CHECK(memcmp(reference, block, sizeof(block)) == 0);
+
+  wam_chain_destroy(chain);
+  return 0;
+}
+
+static int testState(void) {
+  wam_chain *first = wam_chain_create("podcast");
+  wam_chain *second = wam_chain_create("podcast");
+  CHECK(first != NULL && second != NULL);
+
+  float block[BLOCK_FRAMES];
+  float copy[BLOCK_FRAMES];
+  for (size_t b = 0; b < 50; ++b) {
+    fillBlock(block, BLOCK_FRAMES, b * BLOCK_FRAMES);
+    CHECK(wam_chain_process(first, block, BLOCK_FRAMES) == WAM_OK);
+  }
+
+  const size_t size = wam_chain_state_size(first);
+  CHECK(size > 0);
+  unsigned char *state = (unsigned char *)malloc(size);
+  CHECK(state != NULL);
+  size_t written = 0;
+  CHECK(wam_chain_save_state(first, state, size - 1, &written) ==
+        WAM_ERROR_INVALID_ARGUMENT);
+  CHECK(wam_chain_save_state(first, state, size, &written) == WAM_OK);
+  CHECK(written == size);
+  CHECK(wam_chain_restore_state(second, state, written) == WAM_OK);
+
+  /* The second chain picks up exactly where the first stopped */
+  for (size_t b = 50; b < 60; ++b) {
+    fillBlock(block, BLOCK_FRAMES, b * BLOCK_FRAMES);
+    memcpy(copy, block, sizeof(block));
+    CHECK(wam_chain_process(first, block, BLOCK_FRAMES) == WAM_OK);
+    CHECK(wam_chain_process(second, copy, BLOCK_FRAMES) == WAM_OK);
+    CHECK(memcmp(block, copy, sizeof(block)) == 0);
+  }
+
+  /* Another limiter lookahead has another delay line */
+  CHECK(wam_chain_set_param(second, "limiter.lookahead", 2.0f) == WAM_OK);
+  CHECK(wam_chain_restore_state(second, state, written) ==
+        WAM_ERROR_STATE_MISMATCH);
+  CHECK(wam_chain_restore_state(second, state, 8) ==
+        WAM_ERROR_STATE_MISMATCH);
+
+  free(state);
+  wam_chain_destroy(first);
+  wam_chain_destroy(second);
+  return 0;
+}
+
+int main(void) {
+  CHECK(wam_version() != NULL && wam_version()[0] != '\0');
+  CHECK(testParameters() == 0);
+  CHECK(testProcessing() == 0);
+  CHECK(testState() == 0);
+  printf("chain_api_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,180 @@
+/**
+ * WindowsAiMic - Chain Snapshot Test
+ *
+ * Saves a running chain's state and restores it into a second chain: the
+ * two must then produce bit-identical output, including with blocks that
+ * leave a partial AI frame buffered. Also checks that saves reuse the
+ * reserved buffer, and that a snapshot from a chain with another limiter
+ * lookahead, a truncated one or a corrupt one is rejected.
+ */
+
+#include "core/processing_chain.h"
+#include "test_check.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+// Odd block size: the model keeps a partial frame between blocks
+constexpr size_t BLOCK_FRAMES = 317;
+
+// Syllable-like bursts over a quiet floor, so the gate opens and closes
+void fillBlock(std::vector<float> &block, size_t offset) {
+  for (size_t i = 0; i < block.size(); ++i) {
+    const float t = static_cast<float>(offset + i) / 48000.0f;
+    const float burst = std::sin(2.0f * 3.14159265f * 3.0f * t) > 0.0f;
+    block[i] = (0.5f * burst + 0.002f) *
+               std::sin(2.0f * 3.14159265f * 180.0f * t);
+  }
+}
+
+bool setUp(ProcessingChain &chain, const Config &config) {
+  if (!chain.loadModel(config)) {
+    return false;
+  }
+  chain.configure(config);
+  return true;
+}
+
+bool sameBytes(const ChainSnapshot &a, const ChainSnapshot &b) {
+  return a.size() == b.size() &&
+         std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+int testResume() {
+  Config config;
+  ProcessingChain first;
+  ProcessingChain second;
+  ProcessingChain fresh;
+  CHECK(setUp(first, config) && setUp(second, config) &&
+        setUp(fresh, config));
+
+  std::vector<float> block(BLOCK_FRAMES);
+  size_t offset = 0;
+  for (int b = 0; b < 200; ++b, offset += BLOCK_FRAMES) {
+    fillBlock(block, offset);
+    first.process(block.data(), block.size());
+  }
+
+  ChainSnapshot snapshot;
+  snapshot.reserve(first.snapshotSize());
+  CHECK(first.saveSnapshot(snapshot));
+  CHECK(snapshot.size() == first.snapshotSize());
+  CHECK(second.restoreSnapshot(snapshot));
+  CHECK(second.latencyFrames() == first.latencyFrames());
+
+  // Resumed output matches the original to the bit; a chain starting
+  // from reset does not
+  bool freshDiffers = false;
+  std::vector<float> resumed(BLOCK_FRAMES);
+  std::vector<float> restarted(BLOCK_FRAMES);
+  for (int b = 0; b < 50; ++b, offset += BLOCK_FRAMES) {
+    fillBlock(block, offset);
+    resumed = block;
+    restarted = block;
+    first.process(block.data(), block.size());
+    second.process(resumed.data(), resumed.size());
+    fresh.process(restarted.data(), restarted.size());
+    CHECK(std::memcmp(block.data(), resumed.data(),
+                      block.size() * sizeof(float)) == 0);
+    freshDiffers = freshDiffers || block != restarted;
+  }
+  CHECK(freshDiffers);
+  CHECK(second.getCompressorReduction() == first.getCompressorReduction());
+  CHECK(second.getLimiterReduction() == first.getLimiterReduction());
+  return 0;
+}
+
+int testReservedBuffer() {
+  Config config;
+  ProcessingChain chain;
+  CHECK(setUp(chain, config));
+
+  std::vector<float> block(BLOCK_FRAMES);
+  ChainSnapshot snapshot;
+  snapshot.reserve(chain.snapshotSize());
+  const uint8_t *data = snapshot.data();
+  const size_t capacity = snapshot.capacity();
+  for (int b = 0; b < 20; ++b) {
+    fillBlock(block, b * BLOCK_FRAMES);
+    chain.process(block.data(), block.size());
+    CHECK(chain.saveSnapshot(snapshot));
+    CHECK(chain.restoreSnapshot(snapshot));
+  }
+  CHECK(snapshot.data() == data);
+  CHECK(snapshot.capacity() == capacity);
+  return 0;
+}
+
+int testRejected() {
+  Config config;
+  ProcessingChain chain;
+  CHECK(setUp(chain, config));
+  std::vector<float> block(BLOCK_FRAMES);
+  for (int b = 0; b < 20; ++b) {
+    fillBlock(block, b * BLOCK_FRAMES);
+    chain.process(block.data(), block.size());
+  }
+  ChainSnapshot saved;
+  CHECK(chain.saveSnapshot(saved));
+
+  // Another lookahead is another delay line: refused, state untouched
+  Config shorter = config;
+  shorter.limiter.lookahead = config.limiter.lookahead / 2.0f;
+  ProcessingChain other;
+  CHECK(setUp(other, shorter));
+  fillBlock(block, 0);
+  other.process(block.data(), block.size());
+  ChainSnapshot before;
+  ChainSnapshot after;
+  CHECK(other.saveSnapshot(before));
+  CHECK(!other.restoreSnapshot(saved));
+  CHECK(other.saveSnapshot(after));
+  CHECK(sameBytes(before, after));
+
+  // Truncated, or not a snapshot at all
+  ChainSnapshot truncated;
+  truncated.assign(saved.data(), saved.size() - 1);
+  CHECK(!chain.restoreSnapshot(truncated));
+  CHECK(!chain.restoreSnapshot(ChainSnapshot()));
+  std::vector<uint8_t> bytes(saved.data(), saved.data() + saved.size());
+  bytes[0] ^= 0xff;
+  ChainSnapshot badMagic;
+  badMagic.assign(bytes.data(), bytes.size());
+  CHECK(!chain.restoreSnapshot(badMagic));
+
+  // A tap past the end of the shared lookahead line (whose section ends
+  // with it, before the limiter's: an empty line and two gains) leaves
+  // the chain reset
+  bytes.assign(saved.data(), saved.data() + saved.size());
+  const size_t limiterSection = 2 * sizeof(uint64_t) + 2 * sizeof(float);
+  const uint64_t position = ~0ull;
+  std::memcpy(bytes.data() + bytes.size() - limiterSection -
+                  sizeof(uint64_t),
+              &position, sizeof(position));
+  ChainSnapshot corrupt;
+  corrupt.assign(bytes.data(), bytes.size());
+  CHECK(!chain.restoreSnapshot(corrupt));
+  ChainSnapshot afterCorrupt;
+  CHECK(chain.saveSnapshot(afterCorrupt));
+  chain.reset();
+  ChainSnapshot reset;
+  CHECK(chain.saveSnapshot(reset));
+  CHECK(sameBytes(afterCorrupt, reset));
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  CHECK(testResume() == 0);
+  CHECK(testReservedBuffer() == 0);
+  CHECK(testRejected() == 0);
+  std::printf("chain_snapshot_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,82 @@
+/**
+ * WindowsAiMic - Config Reload Test
+ *
+ * A config file that fails to parse at start-up leaves every default in
+ * place but is still the file hot reload watches: changes made meanwhile
+ * are not written over it, and once the user fixes it a reload applies it.
+ */
+
+#include "config/config_manager.h"
+#include "config/config_schema.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+std::string readFile(const std::filesystem::path &path) {
+  std::ifstream file(path, std::ios::binary);
+  std::stringstream buffer;
+  buffer << file.rdbuf();
+  return buffer.str();
+}
+
+int testInvalidAtStartup() {
+  namespace fs = std::filesystem;
+  const fs::path path = fs::temp_directory_path() / "wam_config_reload.json";
+  const std::string broken = "{\"compressor\": {\"threshold\": ";
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << broken;
+  }
+
+  const Config defaults = ConfigManager().getConfig();
+  ConfigManager configManager;
+  CHECK(!configManager.load(path.string()));
+  CHECK(configManager.getConfigPath() == path.string());
+  CHECK(serializeConfig(configManager.getConfig()) ==
+        serializeConfig(defaults));
+
+  // A change from the tray while the file is broken leaves it alone
+  Config changed = configManager.getConfig();
+  changed.limiter.ceiling = -3.0f;
+  configManager.applyConfig(changed);
+  configManager.flush();
+  CHECK(readFile(path) == broken);
+
+  // Fixed by the user: the reload applies it and writes resume
+  Config fixed = defaults;
+  fixed.compressor.threshold = -30.0f;
+  {
+    std::ofstream file(path, std::ios::trunc);
+    file << serializeConfig(fixed);
+  }
+  ConfigDiff changes;
+  CHECK(configManager.reload(changes));
+  CHECK(changes.has(ConfigSection::Compressor));
+  CHECK(configManager.getConfig().compressor.threshold == -30.0f);
+
+  changed = configManager.getConfig();
+  changed.limiter.ceiling = -3.0f;
+  configManager.applyConfig(changed);
+  configManager.flush();
+  CHECK(readFile(path) == serializeConfig(changed));
+
+  std::error_code ec;
+  fs::remove(path, ec);
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  CHECK(testInvalidAtStartup() == 0);
+  std::printf("config_reload_test: OK\n");
+  return 0;
+}
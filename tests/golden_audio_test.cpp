@@ -0,0 +1,540 @@
+/**
+ * WindowsAiMic - Golden Audio Test
+ *
+ * Runs fixed inputs through each processor on its own and through the
+ * full chain for every preset, block by block as the engine does, and
+ * compares the output against checked-in golden WAV files in
+ * tests/golden/. Each case has a tolerance (max absolute sample error,
+ * 0 = bit-exact) and a CPU budget per 480-sample block on the reference
+ * machine class: an x86-64 core with AVX2 running the engine's release
+ * flags. A case fails if its median block time exceeds the budget by
+ * more than the margin.
+ *
+ * Inputs are synthetic (speech-like bursts, a sweep, transients, a loud
+ * signal) plus any 48 kHz mono WAV recordings in tests/golden/inputs/.
+ *
+ * Usage: golden_audio_test --golden-dir DIR [--update] [--exact]
+ *                          [--budget-margin PERCENT] [--no-budgets]
+ *                          [--filter TEXT]
+ *
+ * --update rewrites the goldens from the current code (review the diff
+ * by ear before committing). --exact requires every case to be
+ * bit-exact, for refactors checked against goldens made on the same
+ * machine with --update.
+ */
+
+#include "ai/rnnoise_processor.h"
+#include "audio/wav_file.h"
+#include "config/config_types.h"
+#include "config/presets.h"
+#include "diagnostics/logger.h"
+#include "dsp/compressor.h"
+#include "dsp/equalizer.h"
+#include "dsp/expander.h"
+#include "dsp/limiter.h"
+#include "dsp/metering.h"
+#include "platform/simd_dsp.h"
+#include "platform/thread_utils.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr size_t BLOCK_SIZE = 480;                 // As in the engine
+constexpr size_t INPUT_SAMPLES = SAMPLE_RATE / 4;  // 0.25 s, 25 blocks
+constexpr int TIMING_PASSES = 3;                   // Best median wins
+constexpr float PI = 3.14159265f;
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+struct Input {
+  std::string name;
+  std::vector<float> samples;
+};
+
+class Noise {
+public:
+  float next() {
+    seed_ = seed_ * 1664525u + 1013904223u;
+    return static_cast<float>(seed_ >> 8) / 8388608.0f - 1.0f;
+  }
+
+private:
+  uint32_t seed_ = 12345;
+};
+
+// Voiced syllables at 4 Hz over a -50 dBFS noise floor
+std::vector<float> makeSpeech() {
+  std::vector<float> samples(INPUT_SAMPLES);
+  Noise noise;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const float t = static_cast<float>(i) / SAMPLE_RATE;
+    const float syllable = std::max(0.0f, std::sin(2.0f * PI * 4.0f * t));
+    float voice = 0.0f;
+    for (int harmonic = 1; harmonic <= 20; ++harmonic) {
+      voice += std::sin(2.0f * PI * 140.0f * static_cast<float>(harmonic) *
+                        t) /
+               static_cast<float>(harmonic);
+    }
+    samples[i] = 0.2f * syllable * syllable * voice + 0.003f * noise.next();
+  }
+  return samples;
+}
+
+// Logarithmic sweep 40 Hz - 16 kHz at -12 dBFS
+std::vector<float> makeSweep() {
+  std::vector<float> samples(INPUT_SAMPLES);
+  const float duration = static_cast<float>(INPUT_SAMPLES) / SAMPLE_RATE;
+  const float rate = std::log(16000.0f / 40.0f);
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const float t = static_cast<float>(i) / SAMPLE_RATE;
+    const float phase = 2.0f * PI * 40.0f * duration / rate *
+                        (std::exp(rate * t / duration) - 1.0f);
+    samples[i] = 0.25f * std::sin(phase);
+  }
+  return samples;
+}
+
+// Decaying clicks every 60 ms with silence between: attack and release
+std::vector<float> makeTransients() {
+  std::vector<float> samples(INPUT_SAMPLES, 0.0f);
+  const size_t period = SAMPLE_RATE * 60 / 1000;
+  for (size_t start = 0; start < samples.size(); start += period) {
+    for (size_t i = 0; i < 480 && start + i < samples.size(); ++i) {
+      const float t = static_cast<float>(i) / SAMPLE_RATE;
+      samples[start + i] = 0.9f * std::exp(-t / 0.002f) *
+                           std::sin(2.0f * PI * 1000.0f * t);
+    }
+  }
+  return samples;
+}
+
+// Near full scale with peaks above the limiter ceiling
+std::vector<float> makeLoud() {
+  std::vector<float> samples(INPUT_SAMPLES);
+  Noise noise;
+  for (size_t i = 0; i < samples.size(); ++i) {
+    const float t = static_cast<float>(i) / SAMPLE_RATE;
+    const float tone = std::sin(2.0f * PI * 220.0f * t) +
+                       0.5f * std::sin(2.0f * PI * 660.0f * t);
+    samples[i] = std::clamp(0.8f * tone + 0.05f * noise.next(), -1.0f, 1.0f);
+  }
+  return samples;
+}
+
+std::vector<Input> loadInputs(const std::filesystem::path &goldenDir) {
+  std::vector<Input> inputs = {{"speech", makeSpeech()},
+                               {"sweep", makeSweep()},
+                               {"transients", makeTransients()},
+                               {"loud", makeLoud()}};
+
+  // Recordings: whole blocks of 48 kHz mono
+  std::error_code error;
+  const std::filesystem::path recordings = goldenDir / "inputs";
+  std::vector<std::filesystem::path> files;
+  for (const auto &entry :
+       std::filesystem::directory_iterator(recordings, error)) {
+    if (entry.path().extension() == ".wav") {
+      files.push_back(entry.path());
+    }
+  }
+  std::sort(files.begin(), files.end());
+  for (const std::filesystem::path &file : files) {
+    Input input{"rec_" + file.stem().string(), {}};
+    int sampleRate = 0;
+    int channels = 0;
+    if (!readWav(file.string(), input.samples, sampleRate, channels) ||
+        sampleRate != SAMPLE_RATE || channels != 1) {
+      std::fprintf(stderr, "Skipping %s: need a 48 kHz mono WAV\n",
+                   file.string().c_str());
+      continue;
+    }
+    input.samples.resize(input.samples.size() / BLOCK_SIZE * BLOCK_SIZE);
+    inputs.push_back(std::move(input));
+  }
+  return inputs;
+}
+
+// ============================================================================
+// Pipelines
+// ============================================================================
+
+/**
+ * Stages run in order on each block. The processed audio is what gets
+ * compared, unless the case fills `readings` instead.
+ */
+struct Pipeline {
+  std::vector<std::function<void(float *, size_t)>> stages;
+  std::shared_ptr<std::vector<float>> readings; // Replaces the audio
+
+  template <typename T> void add(std::unique_ptr<T> processor) {
+    stages.push_back(
+        [shared = std::shared_ptr<T>(std::move(processor))](
+            float *block, size_t frames) { shared->process(block, frames); });
+  }
+};
+
+// Configuration as Engine::initializeProcessors() applies it
+std::unique_ptr<Expander> makeExpander(const ExpanderConfig &config) {
+  auto expander = std::make_unique<Expander>();
+  expander->setEnabled(config.enabled);
+  expander->setThreshold(config.threshold);
+  expander->setRatio(config.ratio);
+  expander->setAttack(config.attack);
+  expander->setRelease(config.release);
+  expander->setHysteresis(config.hysteresis);
+  return expander;
+}
+
+std::unique_ptr<Compressor> makeCompressor(const CompressorConfig &config) {
+  auto compressor = std::make_unique<Compressor>();
+  compressor->setEnabled(config.enabled);
+  compressor->setThreshold(config.threshold);
+  compressor->setRatio(config.ratio);
+  compressor->setKnee(config.knee);
+  compressor->setAttack(config.attack);
+  compressor->setRelease(config.release);
+  compressor->setMakeupGain(config.makeupGain);
+  return compressor;
+}
+
+std::unique_ptr<Limiter> makeLimiter(const LimiterConfig &config) {
+  auto limiter = std::make_unique<Limiter>();
+  limiter->setEnabled(config.enabled);
+  limiter->setCeiling(config.ceiling);
+  limiter->setRelease(config.release);
+  limiter->setLookahead(config.lookahead);
+  return limiter;
+}
+
+std::unique_ptr<Equalizer> makeEqualizer(const EqualizerConfig &config) {
+  auto equalizer = std::make_unique<Equalizer>();
+  equalizer->setEnabled(config.enabled);
+  equalizer->setHighPass(config.highPass.freq, config.highPass.q);
+  equalizer->setLowShelf(config.lowShelf.freq, config.lowShelf.gain);
+  equalizer->setPresence(config.presence.freq, config.presence.gain,
+                         config.presence.q);
+  equalizer->setHighShelf(config.highShelf.freq, config.highShelf.gain);
+  equalizer->setDeEsser(config.deEsser.freq, config.deEsser.threshold);
+  equalizer->setDeEsserEnabled(config.deEsserEnabled);
+  return equalizer;
+}
+
+std::unique_ptr<RNNoiseProcessor> makeRNNoise(const Config &config) {
+  auto rnnoise = std::make_unique<RNNoiseProcessor>();
+  if (!rnnoise->initialize()) {
+    std::fprintf(stderr, "RNNoise failed to initialize\n");
+  }
+  rnnoise->setAttenuation(config.aiSettings.rnnoise.attenuation);
+  return rnnoise;
+}
+
+// The engine's order (Engine::processAudioBlock), skipping what it skips
+Pipeline makeChain(const std::string &preset) {
+  Config config;
+  applyPresetSettings(config, preset);
+
+  Pipeline pipeline;
+  if (config.aiModel == "rnnoise") {
+    pipeline.add(makeRNNoise(config));
+  }
+  if (config.expander.enabled) {
+    pipeline.add(makeExpander(config.expander));
+  }
+  if (config.equalizer.enabled) {
+    pipeline.add(makeEqualizer(config.equalizer));
+  }
+  if (config.compressor.enabled) {
+    pipeline.add(makeCompressor(config.compressor));
+  }
+  if (config.limiter.enabled) {
+    pipeline.add(makeLimiter(config.limiter));
+  }
+  return pipeline;
+}
+
+struct GoldenCase {
+  std::string name;
+  float tolerance;  // Max absolute error; 0 = bit-exact
+  double budgetUs;  // Median per 480-sample block, reference machine class
+  std::function<Pipeline()> make;
+};
+
+std::vector<GoldenCase> makeCases() {
+  const Config defaults;
+  std::vector<GoldenCase> cases = {
+      {"expander", 1e-4f, 30.0,
+       [=] {
+         Pipeline pipeline;
+         pipeline.add(makeExpander(defaults.expander));
+         return pipeline;
+       }},
+      {"equalizer", 1e-5f, 15.0,
+       [=] {
+         Pipeline pipeline;
+         pipeline.add(makeEqualizer(defaults.equalizer));
+         return pipeline;
+       }},
+      {"compressor", 1e-4f, 25.0,
+       [=] {
+         Pipeline pipeline;
+         pipeline.add(makeCompressor(defaults.compressor));
+         return pipeline;
+       }},
+      {"limiter", 1e-4f, 50.0,
+       [=] {
+         Pipeline pipeline;
+         pipeline.add(makeLimiter(defaults.limiter));
+         return pipeline;
+       }},
+      {"rnnoise", 1e-5f, 15.0,
+       [=] {
+         Pipeline pipeline;
+         pipeline.add(makeRNNoise(defaults));
+         return pipeline;
+       }},
+      // Output is the per-block peak, RMS and LUFS readings in dB
+      {"metering", 1e-3f, 40.0,
+       [] {
+         Pipeline pipeline;
+         auto metering = std::make_shared<Metering>();
+         auto readings = std::make_shared<std::vector<float>>();
+         pipeline.readings = readings;
+         pipeline.stages.push_back(
+             [metering, readings](float *block, size_t frames) {
+               metering->process(block, frames);
+               readings->push_back(metering->getPeak());
+               readings->push_back(metering->getRMS());
+               readings->push_back(metering->getLUFSShortTerm());
+             });
+         return pipeline;
+       }},
+  };
+  for (const char *preset : PRESET_NAMES) {
+    cases.push_back({std::string("chain-") + preset, 1e-3f, 120.0,
+                     [preset] { return makeChain(preset); }});
+  }
+  return cases;
+}
+
+// ============================================================================
+// Running and comparing
+// ============================================================================
+
+struct RunResult {
+  std::vector<float> output;
+  int channels = 1;
+  int sampleRate = SAMPLE_RATE;
+  double medianBlockUs = 0.0;
+};
+
+RunResult run(const GoldenCase &golden, const std::vector<float> &input) {
+  RunResult result;
+  result.medianBlockUs = 1e30;
+  std::vector<float> block(BLOCK_SIZE);
+
+  for (int pass = 0; pass < TIMING_PASSES; ++pass) {
+    Pipeline pipeline = golden.make();
+    std::vector<float> output;
+    output.reserve(input.size());
+    std::vector<double> blockUs;
+
+    for (size_t offset = 0; offset + BLOCK_SIZE <= input.size();
+         offset += BLOCK_SIZE) {
+      SIMD::copy(block.data(), input.data() + offset, BLOCK_SIZE);
+      const Clock::time_point start = Clock::now();
+      for (const auto &stage : pipeline.stages) {
+        stage(block.data(), BLOCK_SIZE);
+      }
+      blockUs.push_back(
+          std::chrono::duration<double, std::micro>(Clock::now() - start)
+              .count());
+      output.insert(output.end(), block.begin(), block.end());
+    }
+
+    std::sort(blockUs.begin(), blockUs.end());
+    result.medianBlockUs =
+        std::min(result.medianBlockUs, blockUs[blockUs.size() / 2]);
+
+    if (pipeline.readings) {
+      output = *pipeline.readings;
+      result.channels = 3;
+      result.sampleRate = SAMPLE_RATE / static_cast<int>(BLOCK_SIZE);
+    }
+    if (pass == 0) {
+      result.output = std::move(output);
+    } else if (output != result.output) {
+      // Fresh processors on the same input must agree exactly
+      std::fprintf(stderr, "%s: output differs between runs\n",
+                   golden.name.c_str());
+      result.output.clear();
+      return result;
+    }
+  }
+  return result;
+}
+
+struct Comparison {
+  bool sizeMatches = false;
+  float maxError = 0.0f;
+  double rmsError = 0.0;
+  bool exact = false;
+};
+
+Comparison compare(const std::vector<float> &actual,
+                   const std::vector<float> &expected) {
+  Comparison comparison;
+  comparison.sizeMatches = actual.size() == expected.size();
+  if (!comparison.sizeMatches) {
+    return comparison;
+  }
+  double sumSquares = 0.0;
+  for (size_t i = 0; i < actual.size(); ++i) {
+    const float error = std::abs(actual[i] - expected[i]);
+    comparison.maxError = std::max(comparison.maxError, error);
+    sumSquares += static_cast<double>(error) * error;
+  }
+  comparison.rmsError =
+      actual.empty() ? 0.0 : std::sqrt(sumSquares / actual.size());
+  comparison.exact =
+      actual.empty() || std::memcmp(actual.data(), expected.data(),
+                                    actual.size() * sizeof(float)) == 0;
+  return comparison;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::filesystem::path goldenDir;
+  std::string filter;
+  bool update = false;
+  bool exact = false;
+  bool budgets = true;
+  double budgetMargin = 25.0; // Percent over budget that still passes
+
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--golden-dir") == 0 && hasValue) {
+      goldenDir = argv[++i];
+    } else if (std::strcmp(argv[i], "--filter") == 0 && hasValue) {
+      filter = argv[++i];
+    } else if (std::strcmp(argv[i], "--budget-margin") == 0 && hasValue) {
+      budgetMargin = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--update") == 0) {
+      update = true;
+    } else if (std::strcmp(argv[i], "--exact") == 0) {
+      exact = true;
+    } else if (std::strcmp(argv[i], "--no-budgets") == 0) {
+      budgets = false;
+    }
+  }
+  if (goldenDir.empty()) {
+    std::fprintf(stderr, "Usage: golden_audio_test --golden-dir DIR "
+                         "[--update] [--exact] [--budget-margin PERCENT] "
+                         "[--no-budgets] [--filter TEXT]\n");
+    return 2;
+  }
+
+  // Budgets only mean something on the reference machine class
+  if (budgets && !SIMD::hasAVX2()) {
+    std::printf("No AVX2: not the reference machine class; budgets "
+                "skipped\n");
+    budgets = false;
+  }
+
+  // As on the processing thread; processor setup logging is noise here
+  DenormalGuard denormals;
+  Logger::instance().setLevel(LogLevel::Warning);
+
+  const std::vector<Input> inputs = loadInputs(goldenDir);
+  int failures = 0;
+  int checked = 0;
+
+  std::printf("%-32s %10s %10s %6s %9s %9s\n", "case", "max err", "rms err",
+              "exact", "us/block", "budget");
+  for (const GoldenCase &golden : makeCases()) {
+    for (const Input &input : inputs) {
+      const std::string name = golden.name + "-" + input.name;
+      if (!filter.empty() && name.find(filter) == std::string::npos) {
+        continue;
+      }
+      const std::filesystem::path path = goldenDir / (name + ".wav");
+      const RunResult result = run(golden, input.samples);
+      if (result.output.empty()) {
+        ++failures;
+        continue;
+      }
+      ++checked;
+
+      if (update) {
+        if (!writeWavFloat32(path.string(), result.output.data(),
+                             result.output.size() / result.channels,
+                             result.sampleRate, result.channels)) {
+          std::fprintf(stderr, "Cannot write %s\n", path.string().c_str());
+          ++failures;
+        }
+        std::printf("%-32s %10s %10s %6s %9.1f %9.1f\n", name.c_str(),
+                    "-", "-", "-", result.medianBlockUs, golden.budgetUs);
+        continue;
+      }
+
+      std::vector<float> expected;
+      int sampleRate = 0;
+      int channels = 0;
+      if (!readWav(path.string(), expected, sampleRate, channels)) {
+        std::fprintf(stderr, "%s: no golden at %s (run with --update)\n",
+                     name.c_str(), path.string().c_str());
+        ++failures;
+        continue;
+      }
+
+      const Comparison comparison = compare(result.output, expected);
+      const float tolerance = exact ? 0.0f : golden.tolerance;
+      const bool outputOk =
+          comparison.sizeMatches &&
+          (comparison.exact || comparison.maxError <= tolerance);
+      const bool budgetOk =
+          !budgets || result.medianBlockUs <=
+                          golden.budgetUs * (1.0 + budgetMargin / 100.0);
+
+      std::printf("%-32s %10.3g %10.3g %6s %9.1f %9.1f%s%s\n", name.c_str(),
+                  comparison.maxError, comparison.rmsError,
+                  comparison.exact ? "yes" : "no", result.medianBlockUs,
+                  golden.budgetUs, outputOk ? "" : "  OUTPUT CHANGED",
+                  budgetOk ? "" : "  OVER BUDGET");
+      if (!comparison.sizeMatches) {
+        std::fprintf(stderr, "%s: %zu samples, golden has %zu\n",
+                     name.c_str(), result.output.size(), expected.size());
+      }
+      failures += (outputOk ? 0 : 1) + (budgetOk ? 0 : 1);
+    }
+  }
+
+  if (checked == 0) {
+    std::fprintf(stderr, "No cases matched\n");
+    return 1;
+  }
+  if (failures > 0) {
+    std::fprintf(stderr, "golden_audio_test: %d failure(s)\n", failures);
+    return 1;
+  }
+  std::printf("golden_audio_test: OK\n");
+  return 0;
+}
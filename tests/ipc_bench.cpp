@@ -0,0 +1,275 @@
+/**
+ * WindowsAiMic - Control Plane Bench
+ *
+ * Runs the IPC server on a private endpoint and measures request latency
+ * (single round trips at several batch sizes) and throughput (several
+ * clients pipelining parameter batches at once). Also checks that every
+ * request was acknowledged and every update applied, and that batches
+ * with invalid values are refused, that frames sent right before a
+ * hang-up are still handled, and that the socket is owner-only, so it
+ * doubles as a protocol test under CTest.
+ *
+ * Usage: ipc_bench [--iterations N] [--clients N]
+ */
+
+#include "ipc/ipc_client.h"
+#include "ipc/pipe_server.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace WindowsAiMic;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t PIPELINE_DEPTH = 64; // Requests in flight per client
+constexpr size_t THROUGHPUT_BATCH = 16;
+
+double elapsedUs(Clock::time_point start) {
+  return std::chrono::duration<double, std::micro>(Clock::now() - start)
+      .count();
+}
+
+std::vector<ParamUpdate> makeBatch(size_t size) {
+  std::vector<ParamUpdate> batch(size);
+  for (size_t i = 0; i < size; ++i) {
+    batch[i] = {ParamId::CompressorThreshold, -static_cast<float>(i % 40)};
+  }
+  return batch;
+}
+
+int benchLatency(const std::string &name, size_t iterations) {
+  IpcClient client;
+  CHECK(client.connect(name));
+
+  for (size_t batchSize : {size_t{1}, size_t{16}, size_t{256}}) {
+    const std::vector<ParamUpdate> batch = makeBatch(batchSize);
+    std::vector<double> samples;
+    samples.reserve(iterations);
+
+    for (size_t i = 0; i < iterations; ++i) {
+      const auto start = Clock::now();
+      const uint32_t id = client.sendParameters(batch);
+      Ack ack;
+      CHECK(id != 0 && client.waitAck(id, ack));
+      samples.push_back(elapsedUs(start));
+      CHECK(ack.status == AckStatus::Ok && ack.applied == batchSize);
+    }
+
+    std::sort(samples.begin(), samples.end());
+    std::printf("latency  batch %4zu: p50 %7.1f us  p99 %7.1f us  "
+                "max %7.1f us\n",
+                batchSize, samples[samples.size() / 2],
+                samples[samples.size() * 99 / 100], samples.back());
+  }
+  return 0;
+}
+
+int benchThroughput(const std::string &name, size_t clients,
+                    size_t batchesPerClient, std::atomic<uint64_t> &applied) {
+  const uint64_t appliedBefore = applied.load();
+  std::atomic<int> failures{0};
+  std::vector<std::thread> threads;
+
+  const auto start = Clock::now();
+  for (size_t c = 0; c < clients; ++c) {
+    threads.emplace_back([&]() {
+      IpcClient client;
+      if (!client.connect(name)) {
+        ++failures;
+        return;
+      }
+      const std::vector<ParamUpdate> batch = makeBatch(THROUGHPUT_BATCH);
+
+      // Keep PIPELINE_DEPTH requests in flight; acks arrive in order
+      std::vector<uint32_t> inFlight;
+      size_t sent = 0;
+      while (sent < batchesPerClient || !inFlight.empty()) {
+        while (sent < batchesPerClient && inFlight.size() < PIPELINE_DEPTH) {
+          const uint32_t id = client.sendParameters(batch);
+          if (id == 0) {
+            ++failures;
+            return;
+          }
+          inFlight.push_back(id);
+          ++sent;
+        }
+        Ack ack;
+        if (!client.waitAck(inFlight.front(), ack, 5000) ||
+            ack.status != AckStatus::Ok) {
+          ++failures;
+          return;
+        }
+        inFlight.erase(inFlight.begin());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  const double seconds = elapsedUs(start) / 1e6;
+
+  const uint64_t expected = clients * batchesPerClient * THROUGHPUT_BATCH;
+  const uint64_t updates = applied.load() - appliedBefore;
+  std::printf("throughput %zu clients: %.0f batches/s, %.0f updates/s "
+              "(%.3f s)\n",
+              clients,
+              static_cast<double>(clients * batchesPerClient) / seconds,
+              static_cast<double>(updates) / seconds, seconds);
+
+  CHECK(failures.load() == 0);
+  CHECK(updates == expected);
+  return 0;
+}
+
+int checkCommands(const std::string &name, PipeServer &server,
+                  const std::atomic<uint64_t> &applied) {
+  IpcClient client;
+  CHECK(client.connect(name));
+
+  std::string response;
+  CHECK(client.request("PING", response) && response == "PONG");
+  CHECK(client.request("ECHO:hello", response) && response == "hello");
+
+  // Text CONFIG maps onto the same parameter batches
+  uint32_t id = client.sendCommand("CONFIG:compressor.threshold=-20,"
+                                   "limiter.enabled=off");
+  Ack ack;
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::Ok && ack.applied == 2);
+
+  id = client.sendCommand("CONFIG:no.such.param=1");
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::InvalidParameter);
+
+  id = client.sendCommand("NOT_A_COMMAND");
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::UnknownCommand);
+
+  // Unknown IDs in a batch are skipped, not fatal
+  const ParamUpdate mixed[] = {{ParamId::Bypass, 1.0f},
+                               {static_cast<ParamId>(9999), 0.0f}};
+  id = client.sendParameters(mixed, 2);
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::InvalidParameter && ack.applied == 1);
+
+  // A non-finite or out-of-range value refuses the whole batch
+  const uint64_t before = applied.load();
+  const ParamUpdate notANumber[] = {{ParamId::CompressorRatio, 4.0f},
+                                    {ParamId::CompressorThreshold, NAN}};
+  id = client.sendParameters(notANumber, 2);
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::InvalidParameter && ack.applied == 0);
+  const ParamUpdate outOfRange[] = {{ParamId::CompressorRatio, 50.0f}};
+  id = client.sendParameters(outOfRange, 1);
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::InvalidParameter && ack.applied == 0);
+  const ParamUpdate infinite[] = {{ParamId::Bypass, INFINITY}};
+  id = client.sendParameters(infinite, 1);
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::InvalidParameter && ack.applied == 0);
+  CHECK(applied.load() == before);
+
+  // The edges of a field's range are still accepted
+  const ParamUpdate edges[] = {{ParamId::CompressorRatio, 20.0f},
+                               {ParamId::CompressorThreshold, -40.0f}};
+  id = client.sendParameters(edges, 2);
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::Ok && ack.applied == 2);
+
+  // A batch sent right before a hang-up is still applied
+  const uint64_t beforeHangUp = applied.load();
+  {
+    IpcClient lastWords;
+    CHECK(lastWords.connect(name));
+    const ParamUpdate bypass[] = {{ParamId::Bypass, 0.0f}};
+    CHECK(lastWords.sendParameters(bypass, 1) != 0);
+  }
+  for (int i = 0; i < 100 && applied.load() == beforeHangUp; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  CHECK(applied.load() == beforeHangUp + 1);
+
+#ifndef _WIN32
+  // Other local users never get to connect
+  struct stat socketStat = {};
+  CHECK(stat(ipcEndpointPath(name).c_str(), &socketStat) == 0);
+  CHECK((socketStat.st_mode & 0077) == 0);
+#endif
+
+  // A second client is served while the first stays connected
+  IpcClient second;
+  CHECK(second.connect(name));
+  CHECK(second.request("PING", response) && response == "PONG");
+  CHECK(server.clientCount() == 2);
+  return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t iterations = 2000;
+  size_t clients = 4;
+  for (int i = 1; i + 1 < argc; i += 2) {
+    if (std::strcmp(argv[i], "--iterations") == 0) {
+      iterations = static_cast<size_t>(std::atoi(argv[i + 1]));
+    } else if (std::strcmp(argv[i], "--clients") == 0) {
+      clients = static_cast<size_t>(std::atoi(argv[i + 1]));
+    }
+  }
+  iterations = std::max<size_t>(iterations, 100);
+  clients = std::max<size_t>(clients, 1);
+
+  const std::string name =
+      "WindowsAiMicBench" + std::to_string(static_cast<int>(getpid()));
+
+  std::atomic<uint64_t> applied{0};
+  PipeServer server;
+  server.setParameterCallback([&](const std::vector<ParamUpdate> &updates) {
+    size_t known = 0;
+    for (const ParamUpdate &update : updates) {
+      known += paramName(update.id) ? 1 : 0;
+    }
+    applied += known;
+    return known;
+  });
+  server.registerCommand("ECHO", [](const std::string &data) { return data; });
+
+  if (!server.start(name)) {
+    std::fprintf(stderr, "ipc_bench: failed to start server\n");
+    return 1;
+  }
+
+  int result = checkCommands(name, server, applied);
+  if (result == 0) {
+    result = benchLatency(name, iterations);
+  }
+  if (result == 0) {
+    result = benchThroughput(name, clients, iterations * 4, applied);
+  }
+
+  server.stop();
+  if (result == 0) {
+    std::printf("ipc_bench: OK\n");
+  }
+  return result;
+}
@@ -0,0 +1,92 @@
+/**
+ * WindowsAiMic - Preset Switch Test
+ *
+ * A "PRESET:name" from the tray changes the processing settings of the
+ * running Engine and nothing else: devices, AI model, diagnostics, audio
+ * export and tuning stay as the user configured them.
+ */
+
+#include "audio/simulated_device.h"
+#include "config/config_manager.h"
+#include "config/presets.h"
+#include "engine.h"
+#include "ipc/ipc_client.h"
+#include "test_check.h"
+
+#include <cstdio>
+#include <memory>
+#include <string>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+int testPresetKeepsSettings() {
+  ConfigManager configManager;
+  configManager.loadDefaults();
+  Config config = configManager.getConfig();
+  config.devices.inputDevice = L"simulated-capture";
+  config.devices.outputDevice = L"simulated-render";
+  config.aiModel = "deepfilter";
+  config.aiSettings.deepfilter.modelPath = "models/deepfilter.onnx";
+  config.diagnostics.flightRecorder = false;
+  config.diagnostics.logLevel = "warning";
+  config.audioExport.enabled = false;
+  config.tuning.autoTune = false;
+  config.tuning.powerMode = "efficiency";
+  config.activePreset = "podcast";
+  applyPresetSettings(config, config.activePreset);
+  configManager.applyConfig(config);
+
+  AudioBackend backend;
+  backend.createCapture = []() {
+    return std::unique_ptr<CaptureDevice>(
+        std::make_unique<SimulatedCapture>(SimulatedDeviceConfig{}));
+  };
+  backend.createRender = []() {
+    return std::unique_ptr<RenderDevice>(
+        std::make_unique<SimulatedRender>(SimulatedDeviceConfig{}));
+  };
+  Engine engine(configManager, std::move(backend));
+  CHECK(engine.initialize());
+  engine.start();
+
+  IpcClient client;
+  CHECK(client.connect());
+  const uint32_t id = client.sendCommand("PRESET:meeting");
+  Ack ack;
+  CHECK(id != 0 && client.waitAck(id, ack));
+  CHECK(ack.status == AckStatus::Ok);
+  client.disconnect();
+  engine.stop();
+
+  // The preset's own settings changed...
+  Config expected = config;
+  CHECK(applyPresetSettings(expected, "meeting"));
+  const Config after = configManager.getConfig();
+  CHECK(after.activePreset == "meeting");
+  CHECK(after.compressor.threshold == expected.compressor.threshold);
+  CHECK(after.limiter.ceiling == expected.limiter.ceiling);
+  CHECK(after.equalizer.highPass.freq == expected.equalizer.highPass.freq);
+
+  // ...and nothing else did
+  CHECK(after.devices.inputDevice == config.devices.inputDevice);
+  CHECK(after.devices.outputDevice == config.devices.outputDevice);
+  CHECK(after.aiModel == config.aiModel);
+  CHECK(after.aiSettings.deepfilter.modelPath ==
+        config.aiSettings.deepfilter.modelPath);
+  CHECK(after.diagnostics.flightRecorder == config.diagnostics.flightRecorder);
+  CHECK(after.diagnostics.logLevel == config.diagnostics.logLevel);
+  CHECK(after.audioExport.enabled == config.audioExport.enabled);
+  CHECK(after.tuning.autoTune == config.tuning.autoTune);
+  CHECK(after.tuning.powerMode == config.tuning.powerMode);
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  CHECK(testPresetKeepsSettings() == 0);
+  std::printf("preset_switch_test: OK\n");
+  return 0;
+}
@@ -0,0 +1,743 @@
+/**
+ * WindowsAiMic - Real-Time Scheduling Stress Harness
+ *
+ * Runs the real Engine between a SimulatedCapture and a SimulatedRender
+ * whose device events jitter, go missing, arrive in 2-3 packet bursts or
+ * compete with background load threads, then reports:
+ *
+ *  - late blocks: processed blocks that reached the render ring more than
+ *    a deadline after their last frame was captured
+ *  - engine deadline misses: blocks that took longer than a block to run
+ *  - xruns: render underruns and overruns, capture gaps, and input
+ *    overflows (captured audio the processing thread had no room for)
+ *  - capture-to-playout latency distribution
+ *  - input ring, render ring and device buffer depth over time
+ *  - audio thread wake-ups per second and process CPU time per second of
+ *    audio, in latency or efficiency power mode
+ *
+ * Each named scenario carries thresholds for a shared CI runner; the
+ * process exits non-zero when one is exceeded.
+ *
+ * Usage: rt_stress [--scenario NAME|all] [--seconds N] [--list]
+ *                  [--jitter MODEL] [--jitter-us US] [--missing P]
+ *                  [--burst P] [--drop P] [--render-jitter-us US]
+ *                  [--load-threads N] [--deadline-ms MS] [--seed N]
+ *                  [--max-underrun-percent P] [--max-late-percent P]
+ *                  [--max-p99-ms MS] [--power-mode MODE] [--silent]
+ *                  [--no-thresholds]
+ *                  [--trajectory CSV] [--json PATH]
+ */
+
+#include "audio/simulated_device.h"
+#include "config/config_manager.h"
+#include "diagnostics/logger.h"
+#include "diagnostics/metrics.h"
+#include "engine.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int SAMPLE_RATE = 48000;
+constexpr size_t PERIOD_FRAMES = 480; // 10 ms device period
+constexpr double FRAMES_PER_MS = SAMPLE_RATE / 1000.0;
+constexpr int WARMUP_MS = 500;
+
+/**
+ * Pass/fail limits for one run
+ */
+struct Limits {
+  double maxLatePercent = 0.0;     // Blocks written after the deadline
+  double maxUnderrunPercent = 0.0; // Render events that ran dry
+  uint64_t maxOverruns = 0;        // Render ring overwrote audio
+  uint64_t maxInputOverflows = 0;  // Captured audio dropped by the engine
+  uint64_t maxDeadlineMisses = 0;  // Block processing over 10 ms
+  double maxP99LatencyMs = 0.0;    // Capture to playout
+  double maxRenderQueueMs = 0.0;   // Render ring depth at any sample
+};
+
+struct Scenario {
+  std::string name;
+  std::string description;
+  CallbackTiming capture;
+  CallbackTiming render;
+  int loadThreads = 0; // 0 = none, -1 = two per hardware thread
+  Limits limits;
+};
+
+/**
+ * The named scenarios; limits leave headroom for a loaded single-core
+ * runner without real-time priority. Underruns are expected whenever
+ * audio arrives later than the render clock's 5 ms phase lead. Each one
+ * leaves the silence it inserted in the queue as extra latency, so the
+ * latency limits only catch runaway growth.
+ */
+std::vector<Scenario> makeScenarios() {
+  std::vector<Scenario> scenarios;
+
+  Scenario baseline;
+  baseline.name = "baseline";
+  baseline.description = "Both devices exactly on their period clock";
+  baseline.limits = {3.0, 3.0, 0, 0, 2, 60.0, 60.0};
+  scenarios.push_back(baseline);
+
+  Scenario jitter;
+  jitter.name = "jitter";
+  jitter.description = "Capture 0-4 ms uniform, render 1 ms normal";
+  jitter.capture.jitter = JitterModel::Uniform;
+  jitter.capture.jitterUs = 4000.0f;
+  jitter.render.jitter = JitterModel::Normal;
+  jitter.render.jitterUs = 1000.0f;
+  jitter.limits = {5.0, 4.0, 0, 0, 2, 80.0, 80.0};
+  scenarios.push_back(jitter);
+
+  Scenario lateTail;
+  lateTail.name = "late-tail";
+  lateTail.description = "Capture exponential, mean 1 ms, up to 25 ms late";
+  lateTail.capture.jitter = JitterModel::Exponential;
+  lateTail.capture.jitterUs = 1000.0f;
+  lateTail.capture.maxLateUs = 25000.0f;
+  lateTail.limits = {8.0, 5.0, 0, 0, 2, 80.0, 80.0};
+  scenarios.push_back(lateTail);
+
+  Scenario missing;
+  missing.name = "missing";
+  missing.description = "5% of capture and 2% of render events never fire";
+  missing.capture.missingProbability = 0.05f;
+  missing.render.missingProbability = 0.02f;
+  missing.limits = {15.0, 5.0, 0, 0, 2, 100.0, 100.0};
+  scenarios.push_back(missing);
+
+  Scenario bursty;
+  bursty.name = "bursty";
+  bursty.description = "5% of capture events hold 2-3 packets back";
+  bursty.capture.burstProbability = 0.05f;
+  bursty.limits = {20.0, 5.0, 0, 0, 2, 100.0, 100.0};
+  scenarios.push_back(bursty);
+
+  Scenario load;
+  load.name = "load";
+  load.description = "Capture 0-1 ms uniform, two spinning threads per CPU";
+  load.capture.jitter = JitterModel::Uniform;
+  load.capture.jitterUs = 1000.0f;
+  load.loadThreads = -1;
+  load.limits = {5.0, 4.0, 0, 0, 5, 80.0, 80.0};
+  scenarios.push_back(load);
+
+  Scenario combined;
+  combined.name = "combined";
+  combined.description = "Jitter, late tail, missed events, bursts and load";
+  combined.capture.jitter = JitterModel::Exponential;
+  combined.capture.jitterUs = 1000.0f;
+  combined.capture.maxLateUs = 25000.0f;
+  combined.capture.missingProbability = 0.02f;
+  combined.capture.burstProbability = 0.03f;
+  combined.render.jitter = JitterModel::Normal;
+  combined.render.jitterUs = 1000.0f;
+  combined.render.missingProbability = 0.01f;
+  combined.loadThreads = -1;
+  combined.limits = {20.0, 6.0, 0, 0, 5, 120.0, 120.0};
+  scenarios.push_back(combined);
+
+  return scenarios;
+}
+
+// ============================================================================
+// Measurement
+// ============================================================================
+
+struct QueueSample {
+  double timeMs;
+  double inputFrames;
+  size_t renderFrames;
+  size_t deviceFrames;
+};
+
+struct QueueStats {
+  double min = 0.0;
+  double mean = 0.0;
+  double max = 0.0;
+  double drift = 0.0; // Last quarter mean minus second quarter mean
+};
+
+struct Result {
+  double seconds = 0.0;
+  uint64_t blocks = 0;
+  uint64_t lateBlocks = 0;
+  uint64_t deadlineMisses = 0;
+  uint64_t underruns = 0;
+  uint64_t overruns = 0;
+  uint64_t captureGaps = 0;
+  uint64_t inputOverflows = 0;
+  uint64_t captureCallbacks = 0;
+  uint64_t missedEvents = 0;
+  uint64_t bursts = 0;
+  uint64_t renderCallbacks = 0;
+  double firstAudioMs = -1.0; // initialize() to first rendered block
+  std::string powerMode;
+  Engine::PowerUsage power;
+  HistogramSummary playout;
+  HistogramSummary arrival;
+  QueueStats inputQueue;
+  QueueStats renderQueue;
+  QueueStats deviceQueue;
+  std::vector<QueueSample> trajectory;
+};
+
+template <typename Field>
+QueueStats summarize(const std::vector<QueueSample> &samples, Field field) {
+  QueueStats stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  auto meanOf = [&](size_t begin, size_t end) {
+    double sum = 0.0;
+    for (size_t i = begin; i < end; ++i) {
+      sum += static_cast<double>(field(samples[i]));
+    }
+    return end > begin ? sum / static_cast<double>(end - begin) : 0.0;
+  };
+  stats.min = stats.max = static_cast<double>(field(samples[0]));
+  for (const QueueSample &sample : samples) {
+    const double value = static_cast<double>(field(sample));
+    stats.min = std::min(stats.min, value);
+    stats.max = std::max(stats.max, value);
+  }
+  const size_t quarter = samples.size() / 4;
+  stats.mean = meanOf(0, samples.size());
+  stats.drift = meanOf(3 * quarter, samples.size()) -
+                meanOf(quarter, 2 * quarter);
+  return stats;
+}
+
+/**
+ * Competing work at normal priority, touching enough memory to disturb
+ * the caches as well as the scheduler
+ */
+void spinLoad(const std::atomic<bool> &running) {
+  std::vector<float> scratch(64 * 1024, 1.0f);
+  size_t index = 0;
+  while (running.load(std::memory_order_relaxed)) {
+    for (int i = 0; i < 4096; ++i) {
+      scratch[index] = scratch[index] * 0.999f + 0.001f;
+      index = (index + 4099) % scratch.size();
+    }
+  }
+}
+
+bool runScenario(const Scenario &scenario, double seconds, float deadlineMs,
+                 const std::string &powerMode, bool silent,
+                 Result &result) {
+  ConfigManager configManager;
+  configManager.loadDefaults();
+  Config config = configManager.getConfig();
+  config.devices.inputDevice = L"simulated-capture";
+  config.devices.outputDevice = L"simulated-render";
+  config.audioExport.enabled = false;        // No shared memory in CI
+  config.diagnostics.flightRecorder = false; // Glitches would write dumps
+  config.tuning.autoTune = false; // Budgets assume the 10 ms quantum
+  config.tuning.powerMode = powerMode;
+  configManager.applyConfig(config);
+
+  SimulatedDeviceConfig captureConfig;
+  captureConfig.name = "WindowsAiMic Simulated Microphone";
+  captureConfig.sampleRate = SAMPLE_RATE;
+  captureConfig.periodFrames = PERIOD_FRAMES;
+  captureConfig.timing = scenario.capture;
+  captureConfig.level = silent ? 0.0f : 0.1f;
+  SimulatedDeviceConfig renderConfig;
+  renderConfig.name = "WindowsAiMic Simulated Speaker";
+  renderConfig.sampleRate = SAMPLE_RATE;
+  renderConfig.periodFrames = PERIOD_FRAMES;
+  renderConfig.timing = scenario.render;
+  // Device clocks are never in phase; in phase, every period would race
+  // the processing thread for the same instant
+  renderConfig.phaseUs = 5000.0f;
+
+  SimulatedCapture *capture = nullptr;
+  SimulatedRender *render = nullptr;
+  AudioBackend backend;
+  backend.createCapture = [&]() {
+    auto device = std::make_unique<SimulatedCapture>(captureConfig);
+    capture = device.get();
+    return std::unique_ptr<CaptureDevice>(std::move(device));
+  };
+  backend.createRender = [&]() {
+    auto device = std::make_unique<SimulatedRender>(renderConfig);
+    render = device.get();
+    return std::unique_ptr<RenderDevice>(std::move(device));
+  };
+
+  Engine engine(configManager, std::move(backend));
+  if (!engine.initialize() || !capture || !render) {
+    std::fprintf(stderr, "%s: engine failed to initialize\n",
+                 scenario.name.c_str());
+    return false;
+  }
+  render->setLatencySource(capture, deadlineMs * 1000.0f);
+
+  std::atomic<bool> loadRunning{true};
+  std::vector<std::thread> load;
+  const int loadThreads =
+      scenario.loadThreads < 0
+          ? 2 * static_cast<int>(
+                    std::max(1u, std::thread::hardware_concurrency()))
+          : scenario.loadThreads;
+  for (int i = 0; i < loadThreads; ++i) {
+    load.emplace_back(spinLoad, std::cref(loadRunning));
+  }
+
+  const Gauge &inputQueue = MetricsRegistry::instance().gauge(
+      "wam_input_queue_frames", "Frames waiting in the input ring");
+  engine.start();
+
+  // Start-up (thread set-up, first blocks) is not what is measured
+  std::this_thread::sleep_for(std::chrono::milliseconds(WARMUP_MS));
+  render->resetLatency();
+  const Engine::Status warm = engine.getStatus();
+  const uint64_t warmUnderruns = render->getUnderrunCount();
+  const uint64_t warmOverruns = render->getOverrunCount();
+  const uint64_t warmGaps = capture->getGapCount();
+  const uint64_t warmCallbacks = capture->getCallbackCount();
+  const uint64_t warmMissed = capture->getMissedEvents();
+  const uint64_t warmBursts = capture->getBursts();
+  const uint64_t warmRenderCallbacks = render->getCallbackCount();
+  const Engine::PowerUsage warmPower = engine.getPowerUsage();
+
+  const auto start = Clock::now();
+  const auto end = start + std::chrono::duration_cast<Clock::duration>(
+                               std::chrono::duration<double>(seconds));
+  result.trajectory.reserve(static_cast<size_t>(seconds * 200.0) + 1);
+  for (auto next = start; next < end;
+       next += std::chrono::milliseconds(5)) {
+    std::this_thread::sleep_until(next);
+    const double timeMs =
+        std::chrono::duration<double, std::milli>(Clock::now() - start)
+            .count();
+    result.trajectory.push_back({timeMs, inputQueue.get(),
+                                 render->getQueuedFrames(),
+                                 render->getDevicePadding()});
+  }
+  result.seconds =
+      std::chrono::duration<double>(Clock::now() - start).count();
+  const Engine::Status status = engine.getStatus();
+  result.power = engine.getPowerUsage().since(warmPower);
+  result.powerMode = engine.powerModeName();
+  result.firstAudioMs = engine.getStartupTimeline().firstAudioMs();
+  engine.stop();
+
+  loadRunning = false;
+  for (std::thread &thread : load) {
+    thread.join();
+  }
+
+  result.arrival = render->arrivalLatency().summarize();
+  result.playout = render->playoutLatency().summarize();
+  result.blocks = result.arrival.count;
+  result.lateBlocks = render->getLateBlocks();
+  result.deadlineMisses = status.glitches.count(GlitchType::DeadlineMiss) -
+                          warm.glitches.count(GlitchType::DeadlineMiss);
+  result.inputOverflows = status.glitches.count(GlitchType::InputOverflow) -
+                          warm.glitches.count(GlitchType::InputOverflow);
+  result.underruns = render->getUnderrunCount() - warmUnderruns;
+  result.overruns = render->getOverrunCount() - warmOverruns;
+  result.captureGaps = capture->getGapCount() - warmGaps;
+  result.captureCallbacks = capture->getCallbackCount() - warmCallbacks;
+  result.missedEvents = capture->getMissedEvents() - warmMissed;
+  result.bursts = capture->getBursts() - warmBursts;
+  result.renderCallbacks = render->getCallbackCount() - warmRenderCallbacks;
+  result.inputQueue = summarize(
+      result.trajectory, [](const QueueSample &s) { return s.inputFrames; });
+  result.renderQueue = summarize(
+      result.trajectory, [](const QueueSample &s) { return s.renderFrames; });
+  result.deviceQueue = summarize(
+      result.trajectory, [](const QueueSample &s) { return s.deviceFrames; });
+  return true;
+}
+
+// ============================================================================
+// Reporting
+// ============================================================================
+
+double percent(uint64_t part, uint64_t whole) {
+  return whole > 0 ? 100.0 * static_cast<double>(part) /
+                         static_cast<double>(whole)
+                   : 0.0;
+}
+
+double latePercent(const Result &result) {
+  return percent(result.lateBlocks, result.blocks);
+}
+
+double underrunPercent(const Result &result) {
+  return percent(result.underruns, result.renderCallbacks);
+}
+
+void printQueue(const char *name, const QueueStats &stats) {
+  std::printf("  %-14s min %6.2f  mean %6.2f  max %6.2f  drift %+6.2f ms\n",
+              name, stats.min / FRAMES_PER_MS, stats.mean / FRAMES_PER_MS,
+              stats.max / FRAMES_PER_MS, stats.drift / FRAMES_PER_MS);
+}
+
+void printResult(const Scenario &scenario, const Result &result) {
+  std::printf("\n== %s: %s\n", scenario.name.c_str(),
+              scenario.description.c_str());
+  std::printf("  %.1f s, %llu blocks; capture %llu callbacks (%llu missed, "
+              "%llu bursts), render %llu callbacks\n",
+              result.seconds, static_cast<unsigned long long>(result.blocks),
+              static_cast<unsigned long long>(result.captureCallbacks),
+              static_cast<unsigned long long>(result.missedEvents),
+              static_cast<unsigned long long>(result.bursts),
+              static_cast<unsigned long long>(result.renderCallbacks));
+  std::printf("  first audio    %.2f ms after initialize()\n",
+              result.firstAudioMs);
+  std::printf("  late blocks    %llu (%.2f%%), engine deadline misses %llu\n",
+              static_cast<unsigned long long>(result.lateBlocks),
+              latePercent(result),
+              static_cast<unsigned long long>(result.deadlineMisses));
+  std::printf("  xruns          underruns %llu (%.2f%%), overruns %llu, "
+              "capture gaps %llu, input overflows %llu\n",
+              static_cast<unsigned long long>(result.underruns),
+              underrunPercent(result),
+              static_cast<unsigned long long>(result.overruns),
+              static_cast<unsigned long long>(result.captureGaps),
+              static_cast<unsigned long long>(result.inputOverflows));
+  std::printf("  arrival ms     p50 %6.2f  p99 %6.2f  max %6.2f\n",
+              result.arrival.p50 / 1000.0, result.arrival.p99 / 1000.0,
+              result.arrival.max / 1000.0);
+  std::printf("  playout ms     p50 %6.2f  p99 %6.2f  max %6.2f\n",
+              result.playout.p50 / 1000.0, result.playout.p99 / 1000.0,
+              result.playout.max / 1000.0);
+  std::printf("  power          %s: %.1f wake-ups/s, %.2f ms CPU per "
+              "audio s, %.1f%% blocks skipped\n",
+              result.powerMode.c_str(), result.power.wakeupsPerSecond(),
+              result.power.cpuMsPerAudioSecond(),
+              result.power.skippedPercent());
+  printQueue("input ring", result.inputQueue);
+  printQueue("render ring", result.renderQueue);
+  printQueue("device buffer", result.deviceQueue);
+}
+
+/**
+ * Compare against the limits
+ * @return Number of limits exceeded
+ */
+int checkLimits(const Limits &limits, const Result &result) {
+  int failures = 0;
+  auto fail = [&](const char *what, double value, double limit) {
+    std::printf("  FAIL %s: %.2f > %.2f\n", what, value, limit);
+    ++failures;
+  };
+  if (result.blocks == 0) {
+    std::printf("  FAIL no blocks reached the render device\n");
+    return 1;
+  }
+  if (result.firstAudioMs < 0.0) {
+    std::printf("  FAIL engine never recorded its first audio\n");
+    ++failures;
+  }
+  if (latePercent(result) > limits.maxLatePercent) {
+    fail("late blocks %", latePercent(result), limits.maxLatePercent);
+  }
+  if (underrunPercent(result) > limits.maxUnderrunPercent) {
+    fail("underrun %", underrunPercent(result), limits.maxUnderrunPercent);
+  }
+  if (result.overruns > limits.maxOverruns) {
+    fail("overruns", result.overruns, limits.maxOverruns);
+  }
+  if (result.inputOverflows > limits.maxInputOverflows) {
+    fail("input overflows", result.inputOverflows, limits.maxInputOverflows);
+  }
+  if (result.deadlineMisses > limits.maxDeadlineMisses) {
+    fail("engine deadline misses", result.deadlineMisses,
+         limits.maxDeadlineMisses);
+  }
+  if (result.playout.p99 / 1000.0 > limits.maxP99LatencyMs) {
+    fail("p99 playout latency ms", result.playout.p99 / 1000.0,
+         limits.maxP99LatencyMs);
+  }
+  if (result.renderQueue.max / FRAMES_PER_MS > limits.maxRenderQueueMs) {
+    fail("render ring ms", result.renderQueue.max / FRAMES_PER_MS,
+         limits.maxRenderQueueMs);
+  }
+  return failures;
+}
+
+bool writeTrajectory(const std::string &path,
+                     const std::vector<std::pair<std::string, Result>> &runs) {
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  std::fprintf(file, "scenario,time_ms,input_frames,render_frames,"
+                     "device_frames\n");
+  for (const auto &[name, result] : runs) {
+    for (const QueueSample &sample : result.trajectory) {
+      std::fprintf(file, "%s,%.2f,%.0f,%zu,%zu\n", name.c_str(),
+                   sample.timeMs, sample.inputFrames, sample.renderFrames,
+                   sample.deviceFrames);
+    }
+  }
+  return std::fclose(file) == 0;
+}
+
+bool writeJson(const std::string &path,
+               const std::vector<std::pair<std::string, Result>> &runs,
+               const std::vector<int> &failures) {
+  FILE *file = std::fopen(path.c_str(), "w");
+  if (!file) {
+    return false;
+  }
+  auto queue = [file](const char *name, const QueueStats &stats,
+                      const char *separator) {
+    std::fprintf(file,
+                 "      \"%s\": {\"min\": %.1f, \"mean\": %.1f, "
+                 "\"max\": %.1f, \"drift\": %.1f}%s\n",
+                 name, stats.min, stats.mean, stats.max, stats.drift,
+                 separator);
+  };
+  std::fprintf(file, "{\n  \"scenarios\": [\n");
+  for (size_t i = 0; i < runs.size(); ++i) {
+    const Result &result = runs[i].second;
+    std::fprintf(file, "    {\n");
+    std::fprintf(file, "      \"name\": \"%s\",\n", runs[i].first.c_str());
+    std::fprintf(file, "      \"passed\": %s,\n",
+                 failures[i] == 0 ? "true" : "false");
+    std::fprintf(file, "      \"seconds\": %.2f,\n", result.seconds);
+    std::fprintf(file, "      \"firstAudioMs\": %.3f,\n",
+                 result.firstAudioMs);
+    std::fprintf(file, "      \"blocks\": %llu,\n",
+                 static_cast<unsigned long long>(result.blocks));
+    std::fprintf(file, "      \"lateBlocks\": %llu,\n",
+                 static_cast<unsigned long long>(result.lateBlocks));
+    std::fprintf(file, "      \"deadlineMisses\": %llu,\n",
+                 static_cast<unsigned long long>(result.deadlineMisses));
+    std::fprintf(file, "      \"underruns\": %llu,\n",
+                 static_cast<unsigned long long>(result.underruns));
+    std::fprintf(file, "      \"overruns\": %llu,\n",
+                 static_cast<unsigned long long>(result.overruns));
+    std::fprintf(file, "      \"captureGaps\": %llu,\n",
+                 static_cast<unsigned long long>(result.captureGaps));
+    std::fprintf(file, "      \"inputOverflows\": %llu,\n",
+                 static_cast<unsigned long long>(result.inputOverflows));
+    std::fprintf(file,
+                 "      \"playoutUs\": {\"p50\": %llu, \"p90\": %llu, "
+                 "\"p99\": %llu, \"max\": %llu},\n",
+                 static_cast<unsigned long long>(result.playout.p50),
+                 static_cast<unsigned long long>(result.playout.p90),
+                 static_cast<unsigned long long>(result.playout.p99),
+                 static_cast<unsigned long long>(result.playout.max));
+    std::fprintf(file,
+                 "      \"arrivalUs\": {\"p50\": %llu, \"p90\": %llu, "
+                 "\"p99\": %llu, \"max\": %llu},\n",
+                 static_cast<unsigned long long>(result.arrival.p50),
+                 static_cast<unsigned long long>(result.arrival.p90),
+                 static_cast<unsigned long long>(result.arrival.p99),
+                 static_cast<unsigned long long>(result.arrival.max));
+    std::fprintf(file,
+                 "      \"power\": {\"mode\": \"%s\", "
+                 "\"wakeupsPerSecond\": %.2f, "
+                 "\"cpuMsPerAudioSecond\": %.3f, "
+                 "\"skippedBlockPercent\": %.2f},\n",
+                 result.powerMode.c_str(), result.power.wakeupsPerSecond(),
+                 result.power.cpuMsPerAudioSecond(),
+                 result.power.skippedPercent());
+    queue("inputQueueFrames", result.inputQueue, ",");
+    queue("renderQueueFrames", result.renderQueue, ",");
+    queue("deviceQueueFrames", result.deviceQueue, "");
+    std::fprintf(file, "    }%s\n", i + 1 < runs.size() ? "," : "");
+  }
+  std::fprintf(file, "  ]\n}\n");
+  return std::fclose(file) == 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  std::string scenarioName = "all";
+  double seconds = 5.0;
+  float deadlineMs = 10.0f; // One period from capture to the render ring
+  bool thresholds = true;
+  std::string trajectoryPath;
+  std::string jsonPath;
+  std::string powerMode = "latency";
+  bool silent = false; // Capture digital silence instead of the tone
+
+  // Overrides applied on top of the chosen scenarios
+  std::string jitter;
+  float jitterUs = -1.0f;
+  float missing = -1.0f;
+  float burst = -1.0f;
+  float drop = -1.0f;
+  float renderJitterUs = -1.0f;
+  int loadThreads = -2;
+  long seed = -1;
+  double maxUnderrunPercent = -1.0;
+  double maxLatePercent = -1.0;
+  double maxP99Ms = -1.0;
+
+  std::vector<Scenario> scenarios = makeScenarios();
+  for (int i = 1; i < argc; ++i) {
+    const bool hasValue = i + 1 < argc;
+    if (std::strcmp(argv[i], "--scenario") == 0 && hasValue) {
+      scenarioName = argv[++i];
+    } else if (std::strcmp(argv[i], "--seconds") == 0 && hasValue) {
+      seconds = std::max(std::atof(argv[++i]), 0.5);
+    } else if (std::strcmp(argv[i], "--deadline-ms") == 0 && hasValue) {
+      deadlineMs = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--jitter") == 0 && hasValue) {
+      jitter = argv[++i];
+    } else if (std::strcmp(argv[i], "--jitter-us") == 0 && hasValue) {
+      jitterUs = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--missing") == 0 && hasValue) {
+      missing = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--burst") == 0 && hasValue) {
+      burst = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--drop") == 0 && hasValue) {
+      drop = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--render-jitter-us") == 0 && hasValue) {
+      renderJitterUs = static_cast<float>(std::atof(argv[++i]));
+    } else if (std::strcmp(argv[i], "--load-threads") == 0 && hasValue) {
+      loadThreads = std::atoi(argv[++i]);
+    } else if (std::strcmp(argv[i], "--seed") == 0 && hasValue) {
+      seed = std::atol(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-underrun-percent") == 0 &&
+               hasValue) {
+      maxUnderrunPercent = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-late-percent") == 0 && hasValue) {
+      maxLatePercent = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--max-p99-ms") == 0 && hasValue) {
+      maxP99Ms = std::atof(argv[++i]);
+    } else if (std::strcmp(argv[i], "--trajectory") == 0 && hasValue) {
+      trajectoryPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--json") == 0 && hasValue) {
+      jsonPath = argv[++i];
+    } else if (std::strcmp(argv[i], "--power-mode") == 0 && hasValue) {
+      powerMode = argv[++i];
+    } else if (std::strcmp(argv[i], "--silent") == 0) {
+      silent = true;
+    } else if (std::strcmp(argv[i], "--no-thresholds") == 0) {
+      thresholds = false;
+    } else if (std::strcmp(argv[i], "--list") == 0) {
+      for (const Scenario &scenario : scenarios) {
+        std::printf("%-10s %s\n", scenario.name.c_str(),
+                    scenario.description.c_str());
+      }
+      return 0;
+    } else {
+      std::fprintf(stderr, "Unknown option: %s\n", argv[i]);
+      return 2;
+    }
+  }
+
+  JitterModel jitterModel = JitterModel::None;
+  if (!jitter.empty() && !parseJitterModel(jitter, jitterModel)) {
+    std::fprintf(stderr, "Unknown jitter model: %s\n", jitter.c_str());
+    return 2;
+  }
+
+  if (powerMode != "latency" && powerMode != "efficiency") {
+    std::fprintf(stderr, "Unknown power mode: %s\n", powerMode.c_str());
+    return 2;
+  }
+
+  std::vector<Scenario> selected;
+  for (Scenario scenario : scenarios) {
+    if (scenarioName != "all" && scenario.name != scenarioName) {
+      continue;
+    }
+    if (!jitter.empty()) {
+      scenario.capture.jitter = jitterModel;
+    }
+    if (jitterUs >= 0.0f) {
+      scenario.capture.jitterUs = jitterUs;
+      if (scenario.capture.jitter == JitterModel::None) {
+        scenario.capture.jitter = JitterModel::Uniform;
+      }
+    }
+    if (missing >= 0.0f) {
+      scenario.capture.missingProbability = missing;
+    }
+    if (burst >= 0.0f) {
+      scenario.capture.burstProbability = burst;
+    }
+    if (drop >= 0.0f) {
+      scenario.capture.dropProbability = drop;
+    }
+    if (renderJitterUs >= 0.0f) {
+      scenario.render.jitterUs = renderJitterUs;
+      if (scenario.render.jitter == JitterModel::None) {
+        scenario.render.jitter = JitterModel::Normal;
+      }
+    }
+    if (loadThreads >= -1) {
+      scenario.loadThreads = loadThreads;
+    }
+    if (seed >= 0) {
+      scenario.capture.seed = static_cast<uint32_t>(seed);
+      scenario.render.seed = static_cast<uint32_t>(seed) + 1;
+    }
+    if (maxUnderrunPercent >= 0.0) {
+      scenario.limits.maxUnderrunPercent = maxUnderrunPercent;
+    }
+    if (maxLatePercent >= 0.0) {
+      scenario.limits.maxLatePercent = maxLatePercent;
+    }
+    if (maxP99Ms >= 0.0) {
+      scenario.limits.maxP99LatencyMs = maxP99Ms;
+    }
+    selected.push_back(scenario);
+  }
+  if (selected.empty()) {
+    std::fprintf(stderr, "Unknown scenario: %s (see --list)\n",
+                 scenarioName.c_str());
+    return 2;
+  }
+
+  // Engine start-up logging is noise here; warnings still show
+  Logger::instance().setLevel(LogLevel::Warning);
+
+  std::vector<std::pair<std::string, Result>> runs;
+  std::vector<int> failures;
+  int totalFailures = 0;
+  for (const Scenario &scenario : selected) {
+    Result result;
+    if (!runScenario(scenario, seconds, deadlineMs, powerMode, silent,
+                     result)) {
+      return 1;
+    }
+    printResult(scenario, result);
+    const int failed = thresholds ? checkLimits(scenario.limits, result) : 0;
+    totalFailures += failed;
+    failures.push_back(failed);
+    runs.emplace_back(scenario.name, std::move(result));
+  }
+
+  if (!trajectoryPath.empty() && !writeTrajectory(trajectoryPath, runs)) {
+    std::fprintf(stderr, "Cannot write %s\n", trajectoryPath.c_str());
+    return 1;
+  }
+  if (!jsonPath.empty() && !writeJson(jsonPath, runs, failures)) {
+    std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+    return 1;
+  }
+  if (totalFailures > 0) {
+    std::printf("\nrt_stress: %d limit(s) exceeded\n", totalFailures);
+    return 1;
+  }
+  std::printf("\nrt_stress: OK\n");
+  return 0;
+}
@@ -0,0 +1,254 @@
+/**
+ * WindowsAiMic - Shared Lookahead Test
+ *
+ * The dynamics stages of a ProcessingChain look ahead through one delay
+ * line: latency is the largest lookahead, not the sum; with only the
+ * limiter looking ahead the chain matches the standalone processors to
+ * the bit; an expander lookahead lets a word's onset through the gate;
+ * the limiter still holds its ceiling behind lookahead stages; and
+ * lookahead and EQ changes from another thread land between blocks.
+ */
+
+#include "core/processing_chain.h"
+#include "dsp/compressor.h"
+#include "dsp/equalizer.h"
+#include "dsp/expander.h"
+#include "dsp/limiter.h"
+#include "test_check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace WindowsAiMic;
+
+namespace {
+
+constexpr size_t BLOCK_FRAMES = 480;
+constexpr size_t SAMPLES_PER_MS = 48;
+
+// Quiet floor, then a loud word starting at `onset`
+std::vector<float> makeWord(size_t frames, size_t onset, float level) {
+  std::vector<float> signal(frames);
+  for (size_t i = 0; i < frames; ++i) {
+    const float t = static_cast<float>(i) / 48000.0f;
+    const float amplitude = i < onset ? 0.001f : level;
+    signal[i] = amplitude * std::sin(2.0f * 3.14159265f * 220.0f * t);
+  }
+  return signal;
+}
+
+void runDsp(ProcessingChain &chain, std::vector<float> &signal) {
+  for (size_t offset = 0; offset < signal.size(); offset += BLOCK_FRAMES) {
+    chain.processDsp(signal.data() + offset,
+                     std::min(BLOCK_FRAMES, signal.size() - offset));
+  }
+}
+
+float rms(const float *samples, size_t count) {
+  double sum = 0.0;
+  for (size_t i = 0; i < count; ++i) {
+    sum += static_cast<double>(samples[i]) * samples[i];
+  }
+  return static_cast<float>(std::sqrt(sum / static_cast<double>(count)));
+}
+
+int testLatency() {
+  Config config;
+  ProcessingChain chain;
+  chain.configure(config);
+  CHECK(chain.latencyFrames() ==
+        static_cast<size_t>(config.limiter.lookahead * SAMPLES_PER_MS));
+
+  config.expander.lookahead = 8.0f;
+  config.compressor.lookahead = 2.0f;
+  chain.configure(config);
+  CHECK(chain.latencyFrames() == 8 * SAMPLES_PER_MS);
+
+  // A disabled stage's lookahead costs nothing
+  config.expander.enabled = false;
+  chain.configure(config);
+  CHECK(chain.latencyFrames() ==
+        static_cast<size_t>(config.limiter.lookahead * SAMPLES_PER_MS));
+  return 0;
+}
+
+int testMatchesStandalone() {
+  Config config;
+  ProcessingChain chain;
+  chain.configure(config);
+
+  // The processors on their own, each limiter with its own line
+  Expander expander;
+  expander.setEnabled(config.expander.enabled);
+  expander.setThreshold(config.expander.threshold);
+  expander.setRatio(config.expander.ratio);
+  expander.setAttack(config.expander.attack);
+  expander.setRelease(config.expander.release);
+  expander.setHysteresis(config.expander.hysteresis);
+  Equalizer equalizer;
+  equalizer.setEnabled(config.equalizer.enabled);
+  equalizer.setHighPass(config.equalizer.highPass.freq,
+                        config.equalizer.highPass.q);
+  equalizer.setLowShelf(config.equalizer.lowShelf.freq,
+                        config.equalizer.lowShelf.gain);
+  equalizer.setPresence(config.equalizer.presence.freq,
+                        config.equalizer.presence.gain,
+                        config.equalizer.presence.q);
+  equalizer.setHighShelf(config.equalizer.highShelf.freq,
+                         config.equalizer.highShelf.gain);
+  equalizer.setDeEsser(config.equalizer.deEsser.freq,
+                       config.equalizer.deEsser.threshold);
+  equalizer.setDeEsserEnabled(config.equalizer.deEsserEnabled);
+  Compressor compressor;
+  compressor.setEnabled(config.compressor.enabled);
+  compressor.setThreshold(config.compressor.threshold);
+  compressor.setRatio(config.compressor.ratio);
+  compressor.setKnee(config.compressor.knee);
+  compressor.setAttack(config.compressor.attack);
+  compressor.setRelease(config.compressor.release);
+  compressor.setMakeupGain(config.compressor.makeupGain);
+  Limiter limiter;
+  limiter.setEnabled(config.limiter.enabled);
+  limiter.setCeiling(config.limiter.ceiling);
+  limiter.setRelease(config.limiter.release);
+  limiter.setLookahead(config.limiter.lookahead);
+
+  std::vector<float> shared = makeWord(100 * BLOCK_FRAMES, 20000, 0.9f);
+  std::vector<float> standalone = shared;
+  runDsp(chain, shared);
+  for (size_t offset = 0; offset < standalone.size();
+       offset += BLOCK_FRAMES) {
+    float *block = standalone.data() + offset;
+    expander.process(block, BLOCK_FRAMES);
+    equalizer.process(block, BLOCK_FRAMES);
+    compressor.process(block, BLOCK_FRAMES);
+    limiter.process(block, BLOCK_FRAMES);
+  }
+  CHECK(std::memcmp(shared.data(), standalone.data(),
+                    shared.size() * sizeof(float)) == 0);
+  return 0;
+}
+
+int testOnset() {
+  // Only the gate, set so a reacting envelope takes a few milliseconds
+  // to open it
+  Config config;
+  config.equalizer.enabled = false;
+  config.compressor.enabled = false;
+  config.limiter.enabled = false;
+  config.expander.threshold = -20.0f;
+  config.expander.ratio = 4.0f;
+  config.expander.attack = 5.0f;
+
+  constexpr size_t ONSET = 30000;
+  constexpr size_t LOOKAHEAD = 8 * SAMPLES_PER_MS;
+  constexpr size_t WINDOW = 2 * SAMPLES_PER_MS;
+  const std::vector<float> input = makeWord(80 * BLOCK_FRAMES, ONSET, 0.3f);
+
+  ProcessingChain direct;
+  direct.configure(config);
+  std::vector<float> reacting = input;
+  runDsp(direct, reacting);
+  CHECK(direct.latencyFrames() == 0);
+
+  config.expander.lookahead = 8.0f;
+  ProcessingChain ahead;
+  ahead.configure(config);
+  std::vector<float> anticipating = input;
+  runDsp(ahead, anticipating);
+  CHECK(ahead.latencyFrames() == LOOKAHEAD);
+
+  // The first milliseconds of the word, relative to the input
+  const float in = rms(input.data() + ONSET, WINDOW);
+  const float late = rms(reacting.data() + ONSET, WINDOW) / in;
+  const float early =
+      rms(anticipating.data() + ONSET + LOOKAHEAD, WINDOW) / in;
+  std::printf("  onset gain: %.3f reacting, %.3f looking ahead\n", late,
+              early);
+  CHECK(early > late * 1.5f);
+  CHECK(early > 0.9f);
+
+  // The quiet floor before it is still attenuated
+  const float floorIn = rms(input.data() + ONSET - 4800, 2400);
+  const float floorOut =
+      rms(anticipating.data() + ONSET - 4800 + LOOKAHEAD, 2400);
+  CHECK(floorOut < floorIn * 0.5f);
+  return 0;
+}
+
+int testCeiling() {
+  Config config;
+  config.expander.lookahead = 8.0f;
+  config.compressor.lookahead = 3.0f;
+  config.compressor.makeupGain = 12.0f;
+  ProcessingChain chain;
+  chain.configure(config);
+
+  std::vector<float> signal = makeWord(100 * BLOCK_FRAMES, 12000, 0.95f);
+  runDsp(chain, signal);
+  float peak = 0.0f;
+  for (const float sample : signal) {
+    peak = std::max(peak, std::abs(sample));
+  }
+  const float ceiling = std::pow(10.0f, config.limiter.ceiling / 20.0f);
+  std::printf("  peak %.4f, ceiling %.4f\n", peak, ceiling);
+  CHECK(peak <= ceiling * 1.001f);
+  CHECK(chain.getLimiterReduction() > 0.0f);
+  return 0;
+}
+
+int testStagedChange() {
+  Config config;
+  ProcessingChain chain;
+  chain.configure(config);
+  const size_t before = chain.latencyFrames();
+
+  // Staged: the line moves when the next block starts, not before
+  LimiterConfig limiter = config.limiter;
+  limiter.lookahead = 10.0f;
+  chain.setLimiterParams(limiter);
+  CHECK(chain.latencyFrames() == before);
+  std::vector<float> block = makeWord(BLOCK_FRAMES, 0, 0.5f);
+  chain.processDsp(block.data(), block.size());
+  CHECK(chain.latencyFrames() == 10 * SAMPLES_PER_MS);
+
+  // Lookaheads and an EQ band changing under a running chain
+  std::atomic<bool> running{true};
+  std::thread control([&]() {
+    ExpanderConfig expander = config.expander;
+    EqualizerConfig equalizer = config.equalizer;
+    for (int i = 0; running.load(); ++i) {
+      expander.lookahead = static_cast<float>(i % 11);
+      limiter.lookahead = static_cast<float>((i * 7) % 11);
+      equalizer.presence.gain = static_cast<float>(i % 13) - 6.0f;
+      chain.setExpanderParams(expander);
+      chain.setLimiterParams(limiter);
+      chain.setEqualizerParams(equalizer);
+    }
+  });
+  std::vector<float> signal = makeWord(2000 * BLOCK_FRAMES, 0, 0.8f);
+  runDsp(chain, signal);
+  running.store(false);
+  control.join();
+  for (const float sample : signal) {
+    CHECK(std::isfinite(sample) && std::abs(sample) <= 1.0f);
+  }
+  return 0;
+}
+
+} // namespace
+
+int main() {
+  CHECK(testLatency() == 0);
+  CHECK(testMatchesStandalone() == 0);
+  CHECK(testOnset() == 0);
+  CHECK(testCeiling() == 0);
+  CHECK(testStagedChange() == 0);
+  std::printf("shared_lookahead_test: OK\n");
+  return 0;
+}
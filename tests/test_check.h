@@ -0,0 +1,20 @@
+/**
+ * WindowsAiMic - Test Checks
+ *
+ * CHECK(condition) reports the failed condition with its file and line
+ * and returns 1 from the enclosing function. Shared by the C and C++
+ * tests and benchmarks.
+ */
+
+#pragma once
+
+#include <stdio.h>
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__,         \
+              #condition);                                                     \
+      return 1;                                                                \
+    }                                                                          \
+  } while (0)